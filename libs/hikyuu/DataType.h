@@ -29,6 +29,7 @@
 #include <map>
 #include <unordered_map>
 
+#include "config.h"
 #include "Log.h"
 #include "utilities/Null.h"
 #include "datetime/Datetime.h"
@@ -55,6 +56,13 @@ typedef unsigned hku_uint32;
 
 typedef double price_t;
 
+/** K线数据及指标结果的存储类型，参见config.h中的HKU_USE_FLOAT32_STORAGE */
+#if HKU_USE_FLOAT32_STORAGE
+typedef float price_storage_t;
+#else
+typedef double price_storage_t;
+#endif
+
 //typedef boost::container::string string;
 typedef std::string string;
 
@@ -0,0 +1,119 @@
+/*
+ * KDataFlags.cpp
+ *
+ *  Created on: 2017年6月21日
+ *      Author: fasiondog
+ */
+
+#include <algorithm>
+#include "KDataFlags.h"
+
+namespace hku {
+
+KDataFlags::KDataFlags() {
+
+}
+
+KDataFlags::KDataFlags(const KData& kdata)
+: m_kdata(kdata), m_bits(kdata.size()) {
+
+}
+
+KDataFlags::~KDataFlags() {
+
+}
+
+void KDataFlags::setKData(const KData& kdata) {
+    m_kdata = kdata;
+    m_bits.clear();
+    m_bits.resize(kdata.size());
+    m_others.clear();
+}
+
+void KDataFlags::clear() {
+    m_bits.reset();
+    m_others.clear();
+}
+
+bool KDataFlags::set(size_t pos) {
+    if (pos >= m_bits.size()) {
+        return false;
+    }
+    m_bits.set(pos);
+    return true;
+}
+
+void KDataFlags::set(const Datetime& datetime) {
+    if (set(m_kdata.getPos(datetime))) {
+        return;
+    }
+
+    //_calculate中一般按日期顺序加入，直接追加即可
+    if (m_others.empty() || m_others.back() < datetime) {
+        m_others.push_back(datetime);
+        return;
+    }
+
+    DatetimeList::iterator iter = std::lower_bound(m_others.begin(),
+            m_others.end(), datetime);
+    if (*iter != datetime) {
+        m_others.insert(iter, datetime);
+    }
+}
+
+bool KDataFlags::test(const Datetime& datetime) const {
+    size_t pos = m_kdata.getPos(datetime);
+    if (pos != Null<size_t>()) {
+        return test(pos);
+    }
+    return std::binary_search(m_others.begin(), m_others.end(), datetime);
+}
+
+size_t KDataFlags::findNext(size_t pos) const {
+    if (pos >= m_bits.size()) {
+        return Null<size_t>();
+    }
+
+    if (m_bits[pos]) {
+        return pos;
+    }
+
+    size_t next = m_bits.find_next(pos);
+    return next == boost::dynamic_bitset<>::npos ? Null<size_t>() : next;
+}
+
+DatetimeList KDataFlags::getDatetimeList() const {
+    DatetimeList in_kdata;
+    in_kdata.reserve(m_bits.count());
+    size_t pos = m_bits.find_first();
+    while (pos != boost::dynamic_bitset<>::npos) {
+        in_kdata.push_back(m_kdata[pos].datetime);
+        pos = m_bits.find_next(pos);
+    }
+
+    if (m_others.empty()) {
+        return in_kdata;
+    }
+
+    DatetimeList result(in_kdata.size() + m_others.size());
+    std::merge(in_kdata.begin(), in_kdata.end(),
+               m_others.begin(), m_others.end(), result.begin());
+    return result;
+}
+
+boost::dynamic_bitset<> KDataFlags::align(const KData& kdata) const {
+    size_t total = kdata.size();
+    boost::dynamic_bitset<> result(total);
+    if (count() == 0) {
+        return result;
+    }
+
+    for (size_t i = 0; i < total; ++i) {
+        if (test(kdata[i].datetime)) {
+            result.set(i);
+        }
+    }
+    return result;
+}
+
+} /* namespace hku */
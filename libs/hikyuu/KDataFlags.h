@@ -0,0 +1,86 @@
+/*
+ * KDataFlags.h
+ *
+ *  Created on: 2017年6月21日
+ *      Author: fasiondog
+ */
+
+#ifndef KDATAFLAGS_H_
+#define KDATAFLAGS_H_
+
+#include <boost/dynamic_bitset.hpp>
+#include "KData.h"
+
+namespace hku {
+
+/**
+ * 按K线位置对齐的日期标记集合，如信号指示器的买入、卖出信号
+ * @details K线数据中的日期以位图保存，第i位对应第i根K线，按位置查询只需一次
+ *          位测试；不在K线数据中的日期另行保存在有序列表中，按日期查询时先在
+ *          K线数据中定位，找不到时再二分查找该列表。
+ * @ingroup StockManage
+ */
+class HKU_API KDataFlags {
+public:
+    KDataFlags();
+    KDataFlags(const KData& kdata);
+    virtual ~KDataFlags();
+
+    /** 重新对齐到指定的K线数据，同时清除所有标记 */
+    void setKData(const KData& kdata);
+
+    /** 获取对齐的K线数据 */
+    KData getKData() const {
+        return m_kdata;
+    }
+
+    /** 清除所有标记，保留对齐的K线数据 */
+    void clear();
+
+    /** 被标记的日期数量 */
+    size_t count() const {
+        return m_bits.count() + m_others.size();
+    }
+
+    /**
+     * 标记第pos根K线
+     * @return 越界时不做任何处理并返回false
+     */
+    bool set(size_t pos);
+
+    /** 标记指定日期，日期不在K线数据中时保存在有序列表中 */
+    void set(const Datetime& datetime);
+
+    /** 第pos根K线是否被标记，越界时返回false */
+    bool test(size_t pos) const {
+        return pos < m_bits.size() && m_bits[pos];
+    }
+
+    /** 指定日期是否被标记 */
+    bool test(const Datetime& datetime) const;
+
+    /**
+     * 查找第pos根及其之后第一根被标记的K线
+     * @return 被标记的K线位置，不存在时返回Null<size_t>()
+     */
+    size_t findNext(size_t pos) const;
+
+    /** 按日期顺序获取所有被标记的日期 */
+    DatetimeList getDatetimeList() const;
+
+    /**
+     * 获取按另一K线数据位置对齐的位图
+     * @param kdata 对齐的K线数据
+     * @return 第i位表示kdata[i]的日期是否被标记
+     */
+    boost::dynamic_bitset<> align(const KData& kdata) const;
+
+private:
+    KData m_kdata;
+    boost::dynamic_bitset<> m_bits;
+    DatetimeList m_others; //不在m_kdata中的日期，按日期排序
+};
+
+} /* namespace hku */
+
+#endif /* KDATAFLAGS_H_ */
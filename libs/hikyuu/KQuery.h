@@ -202,6 +202,8 @@ bool operator!=(const KQuery&, const KQuery&);
 inline bool operator!=(const KQuery& q1, const KQuery& q2) {
     if (q1.start() != q2.start()
             || q1.end() != q2.end()
+            || q1.startDatetime() != q2.startDatetime()
+            || q1.endDatetime() != q2.endDatetime()
             || q1.queryType() != q2.queryType()
             || q1.kType() != q2.kType()
             || q1.recoverType() != q2.recoverType()) {
@@ -18,13 +18,13 @@ namespace hku {
  */
 class KRecord {
 public:
-    Datetime   datetime;       ///<日期，格式：YYYYMMDDHHMM 如：200901010930
-    price_t    openPrice;      ///<开盘价
-    price_t    highPrice;      ///<最高价
-    price_t    lowPrice;       ///<最低价
-    price_t    closePrice;     ///<最低价
-    price_t    transAmount;    ///<成交金额
-    price_t    transCount;     ///<成交量
+    Datetime        datetime;       ///<日期，格式：YYYYMMDDHHMM 如：200901010930
+    price_storage_t openPrice;      ///<开盘价
+    price_storage_t highPrice;      ///<最高价
+    price_storage_t lowPrice;       ///<最低价
+    price_storage_t closePrice;     ///<最低价
+    price_storage_t transAmount;    ///<成交金额
+    price_storage_t transCount;     ///<成交量
 
     KRecord()
     : datetime(Null<Datetime>()), openPrice(0.0), highPrice(0.0),
@@ -52,6 +52,9 @@ public:
 /** @ingroup StockManage */
 typedef vector<KRecord> KRecordList;
 
+/** @ingroup StockManage */
+typedef shared_ptr<KRecordList> KRecordListPtr;
+
 /**
  * 输出KRecord信息，如：KRecord(datetime, open, high, low, close, transAmount, count)
  * @ingroup StockManage
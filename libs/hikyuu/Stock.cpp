@@ -8,6 +8,7 @@
 #include "StockManager.h"
 #include "data_driver/KDataDriver.h"
 #include "utilities/util.h"
+#include "indicator/IndicatorCache.h"
 
 namespace hku {
 
@@ -74,9 +75,7 @@ Stock::Data::Data()
   m_precision(default_precision),
   m_minTradeNumber(default_minTradeNumber),
   m_maxTradeNumber(default_maxTradeNumber) {
-    for (int i = 0; i < KQuery::INVALID_KTYPE; ++i) {
-        pKData[i] = NULL;
-    }
+
 }
 
 
@@ -106,15 +105,10 @@ Stock::Data::Data(const string& market, const string& code,
 
     boost::to_upper(m_market);
     m_market_code = m_market + m_code;
-    for (int i = 0; i < KQuery::INVALID_KTYPE; ++i) {
-        pKData[i] = NULL;
-    }
 }
 
 Stock::Data::~Data() {
-    for (int i = 0; i < KQuery::INVALID_KTYPE; ++i) {
-        delete pKData[i];
-    }
+
 }
 
 
@@ -138,6 +132,13 @@ Stock::Stock(const Stock& x) {
 }
 
 
+Stock::Stock(Stock&& x) noexcept
+: m_data(std::move(x.m_data)), m_kdataDriver(std::move(x.m_kdataDriver)) {
+    //被移动的对象恢复为默认构造的状态
+    x.m_kdataDriver = g_kdataDefaultDriver;
+}
+
+
 Stock& Stock::operator=(const Stock& x) {
     if(this == &x)
         return *this;
@@ -151,6 +152,16 @@ Stock& Stock::operator=(const Stock& x) {
 }
 
 
+Stock& Stock::operator=(Stock&& x) noexcept {
+    if (this != &x) {
+        m_data = std::move(x.m_data);
+        m_kdataDriver = std::move(x.m_kdataDriver);
+        x.m_kdataDriver = g_kdataDefaultDriver;
+    }
+    return *this;
+}
+
+
 Stock::Stock(const string& market,
         const string& code, const string& name) {
     m_data = shared_ptr<Data>(
@@ -300,8 +311,8 @@ void Stock::releaseKDataBuffer(KQuery::KType kType) {
     if (!m_data || kType >= KQuery::INVALID_KTYPE)
         return;
 
-    delete[] m_data->pKData[kType];
-    m_data->pKData[kType] = NULL;
+    m_data->pKData[kType].reset();
+    IndicatorCache::invalidate(*this);
     return;
 }
 
@@ -311,13 +322,23 @@ void Stock::loadKDataToBuffer(KQuery::KType kType) {
         return;
 
     releaseKDataBuffer(kType);
-    m_data->pKData[kType] = new KRecordList;
+    KRecordListPtr buffer = make_shared<KRecordList>();
     m_kdataDriver->loadKData(m_data->m_market, m_data->m_code,
-            kType, 0, Null<size_t>(), m_data->pKData[kType]);
+            kType, 0, Null<size_t>(), buffer.get());
+    m_data->pKData[kType] = buffer;
+    IndicatorCache::invalidate(*this);
     return;
 }
 
 
+KRecordListPtr Stock::getKDataBuffer(KQuery::KType kType) const {
+    if (!m_data || kType >= KQuery::INVALID_KTYPE)
+        return KRecordListPtr();
+
+    return m_data->pKData[kType];
+}
+
+
 StockWeightList Stock::getWeight(const Datetime& start,
                                  const Datetime& end) const {
     StockWeightList result;
@@ -639,12 +660,21 @@ void Stock::realtimeUpdate(const KRecord& record) {
         return;
     }
 
-    KRecord &tmp = m_data->pKData[KQuery::DAY]->back();
+    //缓存已被getKDataBuffer共享时，复制后再修改，避免改变他人持有的数据
+    KRecordListPtr& buffer = m_data->pKData[KQuery::DAY];
+    if (!buffer.unique()) {
+        buffer = KRecordListPtr(new KRecordList(*buffer));
+    }
+
+    KRecord &tmp = buffer->back();
     if (tmp.datetime == record.datetime) {
         tmp = record;
     } else {
-        m_data->pKData[KQuery::DAY]->push_back(record);
+        buffer->push_back(record);
     }
+
+    //K线数据已改变，基于该证券计算的指标缓存结果不再有效
+    IndicatorCache::invalidate(*this);
 }
 
 } /* namespace */
@@ -45,6 +45,13 @@ public:
     Stock();
 
     Stock(const Stock&);
+
+    /**
+     * 移动构造，仅转移内部指针，使TradeRecord等包含Stock的记录可廉价移动，
+     * 被移动的对象恢复为默认构造的状态
+     */
+    Stock(Stock&&) noexcept;
+
     Stock(const string& market, const string& code, const string& name);
 
     Stock(const string& market, const string& code,
@@ -57,6 +64,7 @@ public:
           size_t minTradeNumber, size_t maxTradeNumber);
     virtual ~Stock();
     Stock& operator=(const Stock&);
+    Stock& operator=(Stock&&) noexcept;
     bool operator==(const Stock&) const;
     bool operator!=(const Stock&) const;
 
@@ -165,7 +173,8 @@ public:
 
     /**
      * 将K线数据做自身缓存
-     * @note 一般不主动调用，谨慎
+     * @note 一般不主动调用，谨慎；多线程读取同一Stock的K线数据时，
+     *       不可同时加载、释放缓存或进行实时更新
      */
     void loadKDataToBuffer(KQuery::KType);
 
@@ -175,6 +184,14 @@ public:
     /** 指定类型的K线数据是否被缓存 */
     bool isBuffer(KQuery::KType) const;
 
+    /**
+     * 获取指定类型的K线缓存，与Stock共享所有权，未缓存时返回空指针
+     * @details 释放或重新加载缓存不会影响已取得的缓存；实时更新时如缓存
+     *          被共享，将先复制一份再更新，因此取得的缓存内容不会改变
+     * @note 调用者不应修改返回的缓存
+     */
+    KRecordListPtr getKDataBuffer(KQuery::KType) const;
+
     /** 是否为Null */
     bool isNull() const;
 
@@ -213,7 +230,7 @@ struct HKU_API Stock::Data {
     size_t  m_minTradeNumber;
     size_t  m_maxTradeNumber;
 
-    KRecordList *pKData[KQuery::INVALID_KTYPE];
+    KRecordListPtr pKData[KQuery::INVALID_KTYPE];
 
     Data();
     Data(const string& market, const string& code,
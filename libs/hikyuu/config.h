@@ -20,4 +20,22 @@
 //检查下标越界
 #define CHECK_ACCESS_BOUND 1
 
+//K线数据及指标结果使用32位浮点数存储（计算过程仍使用double），可节省一半内存带宽
+#ifndef HKU_USE_FLOAT32_STORAGE
+#define HKU_USE_FLOAT32_STORAGE 0
+#endif
+
+//TA-Lib支持，默认在能找到ta-lib头文件时开启
+#ifndef HKU_SUPPORT_TA_LIB
+#if defined(__has_include)
+#if __has_include(<ta-lib/ta_libc.h>)
+#define HKU_SUPPORT_TA_LIB 1
+#endif
+#endif
+#endif
+
+#ifndef HKU_SUPPORT_TA_LIB
+#define HKU_SUPPORT_TA_LIB 0
+#endif
+
 #endif /* CONFIG_H_ */
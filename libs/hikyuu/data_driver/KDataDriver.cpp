@@ -126,6 +126,7 @@ _getImpPtr(const string& market, KQuery::KType ktype) {
 void KDataDriver::
 loadKData(const string& market, const string& code, KQuery::KType kType,
         size_t start_ix, size_t end_ix, KRecordList* out_buffer) {
+    boost::mutex::scoped_lock lock(m_mutex);
     KDataDriverImpPtr imp = _getImpPtr(market, kType);
     if (imp)
         imp->loadKData(market, code, kType, start_ix, end_ix, out_buffer);
@@ -133,6 +134,7 @@ loadKData(const string& market, const string& code, KQuery::KType kType,
 
 size_t KDataDriver::
 getCount(const string& market, const string& code, KQuery::KType kType) {
+    boost::mutex::scoped_lock lock(m_mutex);
     KDataDriverImpPtr imp = _getImpPtr(market, kType);
     if (imp)
         return imp->getCount(market, code, kType);
@@ -142,6 +144,7 @@ getCount(const string& market, const string& code, KQuery::KType kType) {
 bool KDataDriver::
 getIndexRangeByDate(const string& market, const string& code,
         const KQuery& query, size_t& out_start, size_t& out_end) {
+    boost::mutex::scoped_lock lock(m_mutex);
     KDataDriverImpPtr imp = _getImpPtr(market, query.kType());
     if (imp)
         return imp->getIndexRangeByDate(market, code, query,
@@ -152,6 +155,7 @@ getIndexRangeByDate(const string& market, const string& code,
 KRecord KDataDriver::
 getKRecord(const string& market, const string& code,
         size_t pos, KQuery::KType kType) {
+    boost::mutex::scoped_lock lock(m_mutex);
     KDataDriverImpPtr imp = _getImpPtr(market, kType);
     if (imp)
         return imp->getKRecord(market, code, pos, kType);
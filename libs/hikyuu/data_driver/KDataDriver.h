@@ -8,12 +8,15 @@
 #ifndef KDATADRIVER_H_
 #define KDATADRIVER_H_
 
+#include <boost/thread/mutex.hpp>
 #include "KDataDriverImp.h"
 
 namespace hku {
 
 /**
  * K线数据驱动基类
+ * @note 底层数据源（如HDF5）并非线程安全，各接口内部串行访问，
+ *       因此可在多个线程中同时读取K线数据
  */
 class KDataDriver {
 public:
@@ -73,6 +76,7 @@ private:
 private:
     map<KQuery::KType, string> m_suffix;
     map<string, KDataDriverImpPtr> m_imp; /* key: market + _day */
+    boost::mutex m_mutex;
 };
 
 typedef shared_ptr<KDataDriver> KDataDriverPtr;
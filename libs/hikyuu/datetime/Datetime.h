@@ -35,7 +35,7 @@ public:
     /** 默认构造函数，Null<Datetime> */
     Datetime();
 
-    Datetime(const Datetime&);
+    Datetime(const Datetime&) noexcept;
     Datetime(int year, int month, int day,
              int hh = 0, int mm = 0, int sec = 0);
 
@@ -150,8 +150,8 @@ inline Datetime::Datetime() {
     m_data = bt::ptime(d, bt::time_duration(0,0,0));
 }
 
-inline Datetime::Datetime(const Datetime& d) {
-    m_data = d.m_data;
+inline Datetime::Datetime(const Datetime& d) noexcept : m_data(d.m_data) {
+
 }
 
 inline Datetime::Datetime(const bd::date& d) {
@@ -0,0 +1,89 @@
+/*
+ * Evaluate.cpp
+ *
+ *  Created on: 2017年6月12日
+ *      Author: fasiondog
+ */
+
+#include <boost/thread/mutex.hpp>
+#include "../StockManager.h"
+#include "../utilities/Parallel.h"
+#include "crt/KDATA.h"
+#include "Evaluate.h"
+
+namespace hku {
+
+Indicator HKU_API align(const Indicator& ind, const DatetimeList& ind_dates,
+        const DatetimeList& calendar) {
+    if (ind.size() != ind_dates.size()) {
+        HKU_ERROR("ind's size must be equal ind_dates's size! [align]");
+        return Indicator();
+    }
+
+    size_t result_num = ind.getResultNumber();
+    size_t total = calendar.size();
+    IndicatorImpPtr imp(new IndicatorImp(ind.name(), result_num));
+    imp->_readyBuffer(total, result_num);
+
+    size_t discard = total;
+    size_t pos = 0, ind_total = ind_dates.size();
+    for (size_t i = 0; i < total && pos < ind_total; ++i) {
+        while (pos < ind_total && ind_dates[pos] < calendar[i]) {
+            pos++;
+        }
+
+        if (pos >= ind_total || ind_dates[pos] != calendar[i]) {
+            continue;
+        }
+
+        if (pos >= ind.discard()) {
+            if (discard == total) {
+                discard = i;
+            }
+            for (size_t r = 0; r < result_num; ++r) {
+                imp->_set(ind.get(pos, r), i, r);
+            }
+        }
+    }
+
+    imp->setDiscard(discard);
+    imp->_buildMask();
+    return Indicator(imp);
+}
+
+IndicatorList HKU_API evaluate(const Operand& op, const StockList& stocks,
+        const KQuery& query, size_t threads, const string& kpart) {
+    size_t total = stocks.size();
+    IndicatorList result(total);
+    if (total == 0) {
+        return result;
+    }
+
+    StockManager& sm = StockManager::instance();
+    DatetimeList calendar = sm.getTradingCalendar(query);
+
+    //KDataDriver并非线程安全，K线数据的读取须串行
+    boost::mutex data_mutex;
+
+    parallel_for(total, threads, [&](size_t i) {
+        Indicator input;
+        DatetimeList dates;
+        {
+            boost::mutex::scoped_lock lock(data_mutex);
+            KData kdata = stocks[i].getKData(query);
+            input = KDATA_PART(kdata, kpart);
+            size_t len = kdata.size();
+            dates.reserve(len);
+            for (size_t j = 0; j < len; ++j) {
+                dates.push_back(kdata[j].datetime);
+            }
+        }
+
+        Operand tmp_op(op);
+        result[i] = align(tmp_op.calculate(input), dates, calendar);
+    });
+
+    return result;
+}
+
+} /* namespace hku */
@@ -0,0 +1,45 @@
+/*
+ * Evaluate.h
+ *
+ *  Created on: 2017年6月12日
+ *      Author: fasiondog
+ */
+
+#ifndef INDICATOR_EVALUATE_H_
+#define INDICATOR_EVALUATE_H_
+
+#include "../Stock.h"
+#include "Operand.h"
+
+namespace hku {
+
+/**
+ * 对多只证券并行计算同一指标公式，结果按交易日历对齐
+ * @details 各证券的K线数据读取串行进行（KDataDriver不保证线程安全），指标计算
+ *          在多个线程中并行执行。返回结果与StockManager::getTradingCalendar(query)
+ *          的日期一一对应，证券在某日无K线数据时该日结果为Null<price_t>()。
+ * @param op 指标公式
+ * @param stocks 证券列表
+ * @param query 查询条件
+ * @param threads 线程数，为0时使用default_thread_count()
+ * @param kpart 作为公式输入的K线数据部分，KDATA|OPEN|HIGH|LOW|CLOSE|AMO|VOL
+ * @return 与stocks一一对应的指标列表
+ * @ingroup Indicator
+ */
+IndicatorList HKU_API evaluate(const Operand& op, const StockList& stocks,
+        const KQuery& query, size_t threads = 0,
+        const string& kpart = "CLOSE");
+
+/**
+ * 将指标按交易日历对齐，缺失的日期以Null<price_t>()填充
+ * @param ind 待对齐的指标
+ * @param ind_dates 指标中各位置对应的日期，长度须与ind相同
+ * @param calendar 交易日历，须按日期升序排列
+ * @ingroup Indicator
+ */
+Indicator HKU_API align(const Indicator& ind, const DatetimeList& ind_dates,
+        const DatetimeList& calendar);
+
+} /* namespace hku */
+
+#endif /* INDICATOR_EVALUATE_H_ */
@@ -6,6 +6,7 @@
  */
 
 #include "Indicator.h"
+#include "IndicatorKernel.h"
 
 namespace hku {
 
@@ -80,695 +81,183 @@ size_t Indicator::size() const {
 }
 
 HKU_API Indicator operator+(const Indicator& ind1, const Indicator& ind2) {
-    if (ind1.size() == 0 || ind1.size() != ind2.size()) {
-        return Indicator();
-    }
-
-    size_t result_number = std::min(ind1.getResultNumber(), ind2.getResultNumber());
-    size_t total = ind1.size();
-    size_t discard = std::max(ind1.discard(), ind2.discard());
-    IndicatorImpPtr imp(new IndicatorImp());
-    imp->_readyBuffer(total, result_number);
-    imp->setDiscard(discard);
-    for (size_t i = discard; i < total; ++i) {
-        for (size_t r = 0; r < result_number; ++r) {
-            imp->_set(ind1.get(i, r) + ind2.get(i, r), i, r);
-        }
-    }
-
-    return Indicator(imp);
+    return ind_binary_kernel<IND_KERNEL_NULL_AWARE>(ind1, ind2, [](price_t a, price_t b) {
+        return a + b;
+    });
 }
 
-
 HKU_API Indicator operator+(const Indicator& ind, price_t val) {
-    if (ind.size() == 0) {
-        return Indicator();
-    }
-
-    size_t result_number = ind.getResultNumber();
-    size_t total = ind.size();
-    size_t discard = ind.discard();
-    IndicatorImpPtr imp(new IndicatorImp());
-    imp->_readyBuffer(total, result_number);
-    imp->setDiscard(discard);
-    for (size_t i = discard; i < total; ++i) {
-        for (size_t r = 0; r < result_number; ++r) {
-            imp->_set(ind.get(i, r) + val, i, r);
-        }
-    }
-
-    return Indicator(imp);
+    return ind_unary_kernel<IND_KERNEL_NULL_AWARE>(ind, [val](price_t a) {
+        return a + val;
+    }, val != Null<price_t>());
 }
 
-
 HKU_API Indicator operator+(price_t val, const Indicator& ind) {
-    if (ind.size() == 0) {
-        return Indicator();
-    }
-
-    size_t result_number = ind.getResultNumber();
-    size_t total = ind.size();
-    size_t discard = ind.discard();
-    IndicatorImpPtr imp(new IndicatorImp());
-    imp->_readyBuffer(total, result_number);
-    imp->setDiscard(discard);
-    for (size_t i = discard; i < total; ++i) {
-        for (size_t r = 0; r < result_number; ++r) {
-            imp->_set(ind.get(i, r) + val, i, r);
-        }
-    }
-
-    return Indicator(imp);
+    return ind_unary_kernel<IND_KERNEL_NULL_AWARE>(ind, [val](price_t a) {
+        return a + val;
+    }, val != Null<price_t>());
 }
 
 HKU_API Indicator operator-(const Indicator& ind1, const Indicator& ind2) {
-    if (ind1.size() != ind2.size() || ind1.size() == 0) {
-        return Indicator();
-    }
-
-    size_t result_number = std::min(ind1.getResultNumber(), ind2.getResultNumber());
-    size_t total = ind1.size();
-    size_t discard = std::max(ind1.discard(), ind2.discard());
-    IndicatorImpPtr imp(new IndicatorImp());
-    imp->_readyBuffer(total, result_number);
-    imp->setDiscard(discard);
-    for (size_t i = discard; i < total; ++i) {
-        for (size_t r = 0; r < result_number; ++r) {
-            imp->_set(ind1.get(i, r) - ind2.get(i, r), i, r);
-        }
-    }
-
-    return Indicator(imp);
+    return ind_binary_kernel<IND_KERNEL_NULL_AWARE>(ind1, ind2, [](price_t a, price_t b) {
+        return a - b;
+    });
 }
 
 HKU_API Indicator operator-(const Indicator& ind, price_t val) {
-    if (ind.size() == 0) {
-        return Indicator();
-    }
-
-    size_t result_number = ind.getResultNumber();
-    size_t total = ind.size();
-    size_t discard = ind.discard();
-    IndicatorImpPtr imp(new IndicatorImp());
-    imp->_readyBuffer(total, result_number);
-    imp->setDiscard(discard);
-    for (size_t i = discard; i < total; ++i) {
-        for (size_t r = 0; r < result_number; ++r) {
-            imp->_set(ind.get(i, r) - val, i, r);
-        }
-    }
-
-    return Indicator(imp);
+    return ind_unary_kernel<IND_KERNEL_NULL_AWARE>(ind, [val](price_t a) {
+        return a - val;
+    }, val != Null<price_t>());
 }
 
 HKU_API Indicator operator-(price_t val, const Indicator& ind) {
-    if (ind.size() == 0) {
-        return Indicator();
-    }
-
-    size_t result_number = ind.getResultNumber();
-    size_t total = ind.size();
-    size_t discard = ind.discard();
-    IndicatorImpPtr imp(new IndicatorImp());
-    imp->_readyBuffer(total, result_number);
-    imp->setDiscard(discard);
-    for (size_t i = discard; i < total; ++i) {
-        for (size_t r = 0; r < result_number; ++r) {
-            imp->_set(val - ind.get(i, r), i, r);
-        }
-    }
-
-    return Indicator(imp);
+    return ind_unary_kernel<IND_KERNEL_NULL_AWARE>(ind, [val](price_t a) {
+        return val - a;
+    }, val != Null<price_t>());
 }
 
-
 HKU_API Indicator operator*(const Indicator& ind1, const Indicator& ind2) {
-    if (ind1.size() != ind2.size() || ind1.size() == 0) {
-        return Indicator();
-    }
-
-    size_t result_number = std::min(ind1.getResultNumber(), ind2.getResultNumber());
-    size_t total = ind1.size();
-    size_t discard = std::max(ind1.discard(), ind2.discard());
-    IndicatorImpPtr imp(new IndicatorImp());
-    imp->_readyBuffer(total, result_number);
-    imp->setDiscard(discard);
-    for (size_t i = discard; i < total; ++i) {
-        for (size_t r = 0; r < result_number; ++r) {
-            imp->_set(ind1.get(i, r) * ind2.get(i, r), i, r);
-        }
-    }
-
-    return Indicator(imp);
+    return ind_binary_kernel<IND_KERNEL_NULL_AWARE>(ind1, ind2, [](price_t a, price_t b) {
+        return a * b;
+    });
 }
 
 HKU_API Indicator operator*(const Indicator& ind, price_t val) {
-    if (ind.size() == 0) {
-        return Indicator();
-    }
-
-    size_t result_number = ind.getResultNumber();
-    size_t total = ind.size();
-    size_t discard = ind.discard();
-    IndicatorImpPtr imp(new IndicatorImp());
-    imp->_readyBuffer(total, result_number);
-    imp->setDiscard(discard);
-    for (size_t i = discard; i < total; ++i) {
-        for (size_t r = 0; r < result_number; ++r) {
-            imp->_set(ind.get(i, r) * val, i, r);
-        }
-    }
-
-    return Indicator(imp);
+    return ind_unary_kernel<IND_KERNEL_NULL_AWARE>(ind, [val](price_t a) {
+        return a * val;
+    }, val != Null<price_t>());
 }
 
 HKU_API Indicator operator*(price_t val, const Indicator& ind) {
-    if (ind.size() == 0) {
-        return Indicator();
-    }
-
-    size_t result_number = ind.getResultNumber();
-    size_t total = ind.size();
-    size_t discard = ind.discard();
-    IndicatorImpPtr imp(new IndicatorImp());
-    imp->_readyBuffer(total, result_number);
-    imp->setDiscard(discard);
-    for (size_t i = discard; i < total; ++i) {
-        for (size_t r = 0; r < result_number; ++r) {
-            imp->_set(ind.get(i, r) * val, i, r);
-        }
-    }
-
-    return Indicator(imp);
+    return ind_unary_kernel<IND_KERNEL_NULL_AWARE>(ind, [val](price_t a) {
+        return a * val;
+    }, val != Null<price_t>());
 }
 
-
 HKU_API Indicator operator/(const Indicator& ind1, const Indicator& ind2) {
-    if (ind1.size() != ind2.size() || ind1.size() == 0) {
-        return Indicator();
-    }
-
-    size_t result_number = std::min(ind1.getResultNumber(), ind2.getResultNumber());
-    size_t total = ind1.size();
-    size_t discard = std::max(ind1.discard(), ind2.discard());
-    IndicatorImpPtr imp(new IndicatorImp());
-    imp->_readyBuffer(total, result_number);
-    imp->setDiscard(discard);
-    for (size_t i = discard; i < total; ++i) {
-        for (size_t r = 0; r < result_number; ++r) {
-            if (ind2.get(i, r) == 0.0) {
-                imp->_set(Null<price_t>(), i, r);
-            } else {
-                imp->_set(ind1.get(i, r) / ind2.get(i, r), i, r);
-            }
-        }
-    }
-
-    return Indicator(imp);
+    return ind_binary_kernel<IND_KERNEL_NULL_CHECK>(ind1, ind2, [](price_t a, price_t b) {
+        return b == 0.0 ? Null<price_t>() : a / b;
+    });
 }
 
 HKU_API Indicator operator/(const Indicator& ind, price_t val) {
-    if (ind.size() == 0) {
-        return Indicator();
-    }
-
-    size_t result_number = ind.getResultNumber();
-    size_t total = ind.size();
-    size_t discard = ind.discard();
-    IndicatorImpPtr imp(new IndicatorImp());
-    imp->_readyBuffer(total, result_number);
-    imp->setDiscard(discard);
-    for (size_t i = discard; i < total; ++i) {
-        for (size_t r = 0; r < result_number; ++r) {
-            if (val == 0.0) {
-                imp->_set(Null<price_t>(), i, r);
-            } else {
-                imp->_set(ind.get(i, r) / val, i, r);
-            }
-        }
-    }
-
-    return Indicator(imp);
+    return ind_unary_kernel<IND_KERNEL_NULL_CHECK>(ind, [val](price_t a) {
+        return val == 0.0 ? Null<price_t>() : a / val;
+    }, val != Null<price_t>());
 }
 
 HKU_API Indicator operator/(price_t val, const Indicator& ind) {
-    if (ind.size() == 0) {
-        return Indicator();
-    }
-
-    size_t result_number = ind.getResultNumber();
-    size_t total = ind.size();
-    size_t discard = ind.discard();
-    IndicatorImpPtr imp(new IndicatorImp());
-    imp->_readyBuffer(total, result_number);
-    imp->setDiscard(discard);
-    for (size_t i = discard; i < total; ++i) {
-        for (size_t r = 0; r < result_number; ++r) {
-            if (ind.get(i, r) == 0.0) {
-                imp->_set(Null<price_t>(), i, r);
-            } else {
-                imp->_set(val / ind.get(i, r), i, r);
-            }
-        }
-    }
-
-    return Indicator(imp);
+    return ind_unary_kernel<IND_KERNEL_NULL_CHECK>(ind, [val](price_t a) {
+        return a == 0.0 ? Null<price_t>() : val / a;
+    }, val != Null<price_t>());
 }
 
 HKU_API Indicator operator==(const Indicator& ind1, const Indicator& ind2) {
-    if (ind1.size() != ind2.size() || ind1.size() == 0) {
-        return Indicator();
-    }
-
-    size_t result_number = std::min(ind1.getResultNumber(), ind2.getResultNumber());
-    size_t total = ind1.size();
-    size_t discard = std::max(ind1.discard(), ind2.discard());
-    IndicatorImpPtr imp(new IndicatorImp());
-    imp->_readyBuffer(total, result_number);
-    imp->setDiscard(discard);
-    for (size_t i = discard; i < total; ++i) {
-        for (size_t r = 0; r < result_number; ++r) {
-            if (std::fabs(ind1.get(i, r) - ind2.get(i, r)) < IND_EQ_THRESHOLD) {
-                imp->_set(1, i, r);
-            } else {
-                imp->_set(0, i, r);
-            }
-        }
-    }
-
-    return Indicator(imp);
+    return ind_binary_kernel<IND_KERNEL_NUMERIC>(ind1, ind2, [](price_t a, price_t b) {
+        return (std::fabs(a - b) < IND_EQ_THRESHOLD) ? 1.0 : 0.0;
+    });
 }
 
 HKU_API Indicator operator==(const Indicator& ind, price_t val) {
-    if (ind.size() == 0) {
-        return Indicator();
-    }
-
-    size_t result_number = ind.getResultNumber();
-    size_t total = ind.size();
-    size_t discard = ind.discard();
-    IndicatorImpPtr imp(new IndicatorImp());
-    imp->_readyBuffer(total, result_number);
-    imp->setDiscard(discard);
-    for (size_t i = discard; i < total; ++i) {
-        for (size_t r = 0; r < result_number; ++r) {
-            if (std::fabs(ind.get(i, r) - val) < IND_EQ_THRESHOLD) {
-                imp->_set(1, i, r);
-            } else {
-                imp->_set(0, i, r);
-            }
-        }
-    }
-
-    return Indicator(imp);
+    return ind_unary_kernel<IND_KERNEL_NUMERIC>(ind, [val](price_t a) {
+        return (std::fabs(a - val) < IND_EQ_THRESHOLD) ? 1.0 : 0.0;
+    });
 }
 
 HKU_API Indicator operator==(price_t val, const Indicator& ind) {
-    if (ind.size() == 0) {
-        return Indicator();
-    }
-
-    size_t result_number = ind.getResultNumber();
-    size_t total = ind.size();
-    size_t discard = ind.discard();
-    IndicatorImpPtr imp(new IndicatorImp());
-    imp->_readyBuffer(total, result_number);
-    imp->setDiscard(discard);
-    for (size_t i = discard; i < total; ++i) {
-        for (size_t r = 0; r < result_number; ++r) {
-            if (std::fabs(ind.get(i, r) - val) < IND_EQ_THRESHOLD) {
-                imp->_set(1, i, r);
-            } else {
-                imp->_set(0, i, r);
-            }
-        }
-    }
-
-    return Indicator(imp);
+    return ind_unary_kernel<IND_KERNEL_NUMERIC>(ind, [val](price_t a) {
+        return (std::fabs(a - val) < IND_EQ_THRESHOLD) ? 1.0 : 0.0;
+    });
 }
 
-
 HKU_API Indicator operator!=(const Indicator& ind1, const Indicator& ind2) {
-    if (ind1.size() != ind2.size() || ind1.size() == 0) {
-        return Indicator();
-    }
-
-    size_t result_number = std::min(ind1.getResultNumber(), ind2.getResultNumber());
-    size_t total = ind1.size();
-    size_t discard = std::max(ind1.discard(), ind2.discard());
-    IndicatorImpPtr imp(new IndicatorImp());
-    imp->_readyBuffer(total, result_number);
-    imp->setDiscard(discard);
-    for (size_t i = discard; i < total; ++i) {
-        for (size_t r = 0; r < result_number; ++r) {
-            if (std::fabs(ind1.get(i, r) - ind2.get(i, r)) >= IND_EQ_THRESHOLD) {
-                imp->_set(1, i, r);
-            } else {
-                imp->_set(0, i, r);
-            }
-        }
-    }
-
-    return Indicator(imp);
+    return ind_binary_kernel<IND_KERNEL_NUMERIC>(ind1, ind2, [](price_t a, price_t b) {
+        return (std::fabs(a - b) >= IND_EQ_THRESHOLD) ? 1.0 : 0.0;
+    });
 }
 
 HKU_API Indicator operator!=(const Indicator& ind, price_t val) {
-    if (ind.size() == 0) {
-        return Indicator();
-    }
-
-    size_t result_number = ind.getResultNumber();
-    size_t total = ind.size();
-    size_t discard = ind.discard();
-    IndicatorImpPtr imp(new IndicatorImp());
-    imp->_readyBuffer(total, result_number);
-    imp->setDiscard(discard);
-    for (size_t i = discard; i < total; ++i) {
-        for (size_t r = 0; r < result_number; ++r) {
-            if (std::fabs(ind.get(i, r) - val) >= IND_EQ_THRESHOLD) {
-                imp->_set(1, i, r);
-            } else {
-                imp->_set(0, i, r);
-            }
-        }
-    }
-
-    return Indicator(imp);
+    return ind_unary_kernel<IND_KERNEL_NUMERIC>(ind, [val](price_t a) {
+        return (std::fabs(a - val) >= IND_EQ_THRESHOLD) ? 1.0 : 0.0;
+    });
 }
 
 HKU_API Indicator operator!=(price_t val, const Indicator& ind) {
-    if (ind.size() == 0) {
-        return Indicator();
-    }
-
-    size_t result_number = ind.getResultNumber();
-    size_t total = ind.size();
-    size_t discard = ind.discard();
-    IndicatorImpPtr imp(new IndicatorImp());
-    imp->_readyBuffer(total, result_number);
-    imp->setDiscard(discard);
-    for (size_t i = discard; i < total; ++i) {
-        for (size_t r = 0; r < result_number; ++r) {
-            if (std::fabs(ind.get(i, r) - val) >= IND_EQ_THRESHOLD) {
-                imp->_set(1, i, r);
-            } else {
-                imp->_set(0, i, r);
-            }
-        }
-    }
-
-    return Indicator(imp);
+    return ind_unary_kernel<IND_KERNEL_NUMERIC>(ind, [val](price_t a) {
+        return (std::fabs(a - val) >= IND_EQ_THRESHOLD) ? 1.0 : 0.0;
+    });
 }
 
-
 HKU_API Indicator operator>(const Indicator& ind1, const Indicator& ind2) {
-    if (ind1.size() != ind2.size() || ind1.size() == 0) {
-        return Indicator();
-    }
-
-    size_t result_number = std::min(ind1.getResultNumber(), ind2.getResultNumber());
-    size_t total = ind1.size();
-    size_t discard = std::max(ind1.discard(), ind2.discard());
-    IndicatorImpPtr imp(new IndicatorImp());
-    imp->_readyBuffer(total, result_number);
-    imp->setDiscard(discard);
-    for (size_t i = discard; i < total; ++i) {
-        for (size_t r = 0; r < result_number; ++r) {
-            if ((ind1.get(i, r) - ind2.get(i, r)) >= IND_EQ_THRESHOLD) {
-                imp->_set(1, i, r);
-            } else {
-                imp->_set(0, i, r);
-            }
-        }
-    }
-
-    return Indicator(imp);
+    return ind_binary_kernel<IND_KERNEL_NUMERIC>(ind1, ind2, [](price_t a, price_t b) {
+        return ((a - b) >= IND_EQ_THRESHOLD) ? 1.0 : 0.0;
+    });
 }
 
 HKU_API Indicator operator>(const Indicator& ind, price_t val) {
-    if (ind.size() == 0) {
-        return Indicator();
-    }
-
-    size_t result_number = ind.getResultNumber();
-    size_t total = ind.size();
-    size_t discard = ind.discard();
-    IndicatorImpPtr imp(new IndicatorImp());
-    imp->_readyBuffer(total, result_number);
-    imp->setDiscard(discard);
-    for (size_t i = discard; i < total; ++i) {
-        for (size_t r = 0; r < result_number; ++r) {
-            if ((ind.get(i, r) - val) >= IND_EQ_THRESHOLD) {
-                imp->_set(1, i, r);
-            } else {
-                imp->_set(0, i, r);
-            }
-        }
-    }
-
-    return Indicator(imp);
+    return ind_unary_kernel<IND_KERNEL_NUMERIC>(ind, [val](price_t a) {
+        return ((a - val) >= IND_EQ_THRESHOLD) ? 1.0 : 0.0;
+    });
 }
 
 HKU_API Indicator operator>(price_t val, const Indicator& ind) {
-    if (ind.size() == 0) {
-        return Indicator();
-    }
-
-    size_t result_number = ind.getResultNumber();
-    size_t total = ind.size();
-    size_t discard = ind.discard();
-    IndicatorImpPtr imp(new IndicatorImp());
-    imp->_readyBuffer(total, result_number);
-    imp->setDiscard(discard);
-    for (size_t i = discard; i < total; ++i) {
-        for (size_t r = 0; r < result_number; ++r) {
-            if ((val - ind.get(i, r)) >= IND_EQ_THRESHOLD) {
-                imp->_set(1, i, r);
-            } else {
-                imp->_set(0, i, r);
-            }
-        }
-    }
-
-    return Indicator(imp);
+    return ind_unary_kernel<IND_KERNEL_NUMERIC>(ind, [val](price_t a) {
+        return ((val - a) >= IND_EQ_THRESHOLD) ? 1.0 : 0.0;
+    });
 }
 
 HKU_API Indicator operator<(const Indicator& ind1, const Indicator& ind2) {
-    if (ind1.size() != ind2.size() || ind1.size() == 0) {
-        return Indicator();
-    }
-
-    size_t result_number = std::min(ind1.getResultNumber(), ind2.getResultNumber());
-    size_t total = ind1.size();
-    size_t discard = std::max(ind1.discard(), ind2.discard());
-    IndicatorImpPtr imp(new IndicatorImp());
-    imp->_readyBuffer(total, result_number);
-    imp->setDiscard(discard);
-    for (size_t i = discard; i < total; ++i) {
-        for (size_t r = 0; r < result_number; ++r) {
-            if ((ind2.get(i, r) - ind1.get(i, r)) >= IND_EQ_THRESHOLD) {
-                imp->_set(1, i, r);
-            } else {
-                imp->_set(0, i, r);
-            }
-        }
-    }
-
-    return Indicator(imp);
+    return ind_binary_kernel<IND_KERNEL_NUMERIC>(ind1, ind2, [](price_t a, price_t b) {
+        return ((b - a) >= IND_EQ_THRESHOLD) ? 1.0 : 0.0;
+    });
 }
 
 HKU_API Indicator operator<(const Indicator& ind, price_t val) {
-    if (ind.size() == 0) {
-        return Indicator();
-    }
-
-    size_t result_number = ind.getResultNumber();
-    size_t total = ind.size();
-    size_t discard = ind.discard();
-    IndicatorImpPtr imp(new IndicatorImp());
-    imp->_readyBuffer(total, result_number);
-    imp->setDiscard(discard);
-    for (size_t i = discard; i < total; ++i) {
-        for (size_t r = 0; r < result_number; ++r) {
-            if ((val - ind.get(i, r)) >= IND_EQ_THRESHOLD) {
-                imp->_set(1, i, r);
-            } else {
-                imp->_set(0, i, r);
-            }
-        }
-    }
-
-    return Indicator(imp);
+    return ind_unary_kernel<IND_KERNEL_NUMERIC>(ind, [val](price_t a) {
+        return ((val - a) >= IND_EQ_THRESHOLD) ? 1.0 : 0.0;
+    });
 }
 
 HKU_API Indicator operator<(price_t val, const Indicator& ind) {
-    if (ind.size() == 0) {
-        return Indicator();
-    }
-
-    size_t result_number = ind.getResultNumber();
-    size_t total = ind.size();
-    size_t discard = ind.discard();
-    IndicatorImpPtr imp(new IndicatorImp());
-    imp->_readyBuffer(total, result_number);
-    imp->setDiscard(discard);
-    for (size_t i = discard; i < total; ++i) {
-        for (size_t r = 0; r < result_number; ++r) {
-            if ((ind.get(i, r) - val) >= IND_EQ_THRESHOLD) {
-                imp->_set(1, i, r);
-            } else {
-                imp->_set(0, i, r);
-            }
-        }
-    }
-
-    return Indicator(imp);
+    return ind_unary_kernel<IND_KERNEL_NUMERIC>(ind, [val](price_t a) {
+        return ((a - val) >= IND_EQ_THRESHOLD) ? 1.0 : 0.0;
+    });
 }
 
-
 HKU_API Indicator operator>=(const Indicator& ind1, const Indicator& ind2) {
-    if (ind1.size() != ind2.size() || ind1.size() == 0) {
-        return Indicator();
-    }
-
-    size_t result_number = std::min(ind1.getResultNumber(), ind2.getResultNumber());
-    size_t total = ind1.size();
-    size_t discard = std::max(ind1.discard(), ind2.discard());
-    IndicatorImpPtr imp(new IndicatorImp());
-    imp->_readyBuffer(total, result_number);
-    imp->setDiscard(discard);
-    for (size_t i = discard; i < total; ++i) {
-        for (size_t r = 0; r < result_number; ++r) {
-            if (ind1.get(i, r) > ind2.get(i,r) - IND_EQ_THRESHOLD) {
-                imp->_set(1, i, r);
-            } else {
-                imp->_set(0, i, r);
-            }
-        }
-    }
-
-    return Indicator(imp);
+    return ind_binary_kernel<IND_KERNEL_NUMERIC>(ind1, ind2, [](price_t a, price_t b) {
+        return (a > b - IND_EQ_THRESHOLD) ? 1.0 : 0.0;
+    });
 }
 
 HKU_API Indicator operator>=(const Indicator& ind, price_t val) {
-    if (ind.size() == 0) {
-        return Indicator();
-    }
-
-    size_t result_number = ind.getResultNumber();
-    size_t total = ind.size();
-    size_t discard = ind.discard();
-    IndicatorImpPtr imp(new IndicatorImp());
-    imp->_readyBuffer(total, result_number);
-    imp->setDiscard(discard);
-    for (size_t i = discard; i < total; ++i) {
-        for (size_t r = 0; r < result_number; ++r) {
-            if (ind.get(i, r) > val - IND_EQ_THRESHOLD) {
-                imp->_set(1, i, r);
-            } else {
-                imp->_set(0, i, r);
-            }
-        }
-    }
-
-    return Indicator(imp);
+    return ind_unary_kernel<IND_KERNEL_NUMERIC>(ind, [val](price_t a) {
+        return (a > val - IND_EQ_THRESHOLD) ? 1.0 : 0.0;
+    });
 }
 
 HKU_API Indicator operator>=(price_t val, const Indicator& ind) {
-    if (ind.size() == 0) {
-        return Indicator();
-    }
-
-    size_t result_number = ind.getResultNumber();
-    size_t total = ind.size();
-    size_t discard = ind.discard();
-    IndicatorImpPtr imp(new IndicatorImp());
-    imp->_readyBuffer(total, result_number);
-    imp->setDiscard(discard);
-    for (size_t i = discard; i < total; ++i) {
-        for (size_t r = 0; r < result_number; ++r) {
-            if (val > ind.get(i,r) - IND_EQ_THRESHOLD) {
-                imp->_set(1, i, r);
-            } else {
-                imp->_set(0, i, r);
-            }
-        }
-    }
-
-    return Indicator(imp);
+    return ind_unary_kernel<IND_KERNEL_NUMERIC>(ind, [val](price_t a) {
+        return (val > a - IND_EQ_THRESHOLD) ? 1.0 : 0.0;
+    });
 }
 
 HKU_API Indicator operator<=(const Indicator& ind1, const Indicator& ind2) {
-    if (ind1.size() != ind2.size() || ind1.size() == 0) {
-        return Indicator();
-    }
-
-    size_t result_number = std::min(ind1.getResultNumber(), ind2.getResultNumber());
-    size_t total = ind1.size();
-    size_t discard = std::max(ind1.discard(), ind2.discard());
-    IndicatorImpPtr imp(new IndicatorImp());
-    imp->_readyBuffer(total, result_number);
-    imp->setDiscard(discard);
-    for (size_t i = discard; i < total; ++i) {
-        for (size_t r = 0; r < result_number; ++r) {
-            if (ind1.get(i, r) < ind2.get(i,r) + IND_EQ_THRESHOLD) {
-                imp->_set(1, i, r);
-            } else {
-                imp->_set(0, i, r);
-            }
-        }
-    }
-
-    return Indicator(imp);
+    return ind_binary_kernel<IND_KERNEL_NUMERIC>(ind1, ind2, [](price_t a, price_t b) {
+        return (a < b + IND_EQ_THRESHOLD) ? 1.0 : 0.0;
+    });
 }
 
 HKU_API Indicator operator<=(const Indicator& ind, price_t val) {
-    if (ind.size() == 0) {
-        return Indicator();
-    }
-
-    size_t result_number = ind.getResultNumber();
-    size_t total = ind.size();
-    size_t discard = ind.discard();
-    IndicatorImpPtr imp(new IndicatorImp());
-    imp->_readyBuffer(total, result_number);
-    imp->setDiscard(discard);
-    for (size_t i = discard; i < total; ++i) {
-        for (size_t r = 0; r < result_number; ++r) {
-            if (ind.get(i, r) < val + IND_EQ_THRESHOLD) {
-                imp->_set(1, i, r);
-            } else {
-                imp->_set(0, i, r);
-            }
-        }
-    }
-
-    return Indicator(imp);
+    return ind_unary_kernel<IND_KERNEL_NUMERIC>(ind, [val](price_t a) {
+        return (a < val + IND_EQ_THRESHOLD) ? 1.0 : 0.0;
+    });
 }
 
 HKU_API Indicator operator<=(price_t val, const Indicator& ind) {
-    if (ind.size() == 0) {
-        return Indicator();
-    }
-
-    size_t result_number = ind.getResultNumber();
-    size_t total = ind.size();
-    size_t discard = ind.discard();
-    IndicatorImpPtr imp(new IndicatorImp());
-    imp->_readyBuffer(total, result_number);
-    imp->setDiscard(discard);
-    for (size_t i = discard; i < total; ++i) {
-        for (size_t r = 0; r < result_number; ++r) {
-            if (val < ind.get(i, r) + IND_EQ_THRESHOLD) {
-                imp->_set(1, i, r);
-            } else {
-                imp->_set(0, i, r);
-            }
-        }
-    }
-
-    return Indicator(imp);
+    return ind_unary_kernel<IND_KERNEL_NUMERIC>(ind, [val](price_t a) {
+        return (val < a + IND_EQ_THRESHOLD) ? 1.0 : 0.0;
+    });
 }
 
-
 } /* namespace hku */
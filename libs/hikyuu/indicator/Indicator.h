@@ -127,6 +127,9 @@ private:
 #endif /* HKU_SUPPORT_SERIALIZATION */
 };
 
+/** @ingroup Indicator */
+typedef vector<Indicator> IndicatorList;
+
 
 /**
  * Indicator实例相加，两者的size必须相等，否在返回空
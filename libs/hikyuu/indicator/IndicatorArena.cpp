@@ -0,0 +1,211 @@
+/*
+ * IndicatorArena.cpp
+ */
+
+#include <map>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/tss.hpp>
+#include "IndicatorArena.h"
+
+namespace hku {
+
+/**
+ * 内存池的实际存储，由IndicatorArena及所有从中分配的缓存共同持有，
+ * 最后一个持有者释放时归还全部内存块
+ */
+class IndicatorArenaPool: boost::noncopyable {
+public:
+    IndicatorArenaPool(size_t block_size)
+    : m_block_size(block_size), m_current(NULL), m_current_size(0),
+      m_offset(0), m_allocated(0), m_alloc_count(0), m_reuse_count(0) {}
+
+    ~IndicatorArenaPool() {
+        for (size_t i = 0; i < m_blocks.size(); ++i) {
+            boost::alignment::aligned_free(m_blocks[i]);
+        }
+    }
+
+    void* allocate(size_t bytes) {
+        size_t size = _roundUp(bytes);
+        boost::mutex::scoped_lock lock(m_mutex);
+        m_alloc_count++;
+
+        FreeList::iterator iter = m_free.find(size);
+        if (iter != m_free.end() && !iter->second.empty()) {
+            char *p = iter->second.back();
+            iter->second.pop_back();
+            m_reuse_count++;
+            return p;
+        }
+
+        if (!m_current || m_offset + size > m_current_size) {
+            _newBlock(size);
+        }
+
+        char *p = m_current + m_offset;
+        m_offset += size;
+        m_allocated += size;
+        return p;
+    }
+
+    void deallocate(void *p, size_t bytes) {
+        boost::mutex::scoped_lock lock(m_mutex);
+        m_free[_roundUp(bytes)].push_back((char *)p);
+    }
+
+    size_t blockCount() const {
+        boost::mutex::scoped_lock lock(m_mutex);
+        return m_blocks.size();
+    }
+
+    size_t allocatedBytes() const {
+        boost::mutex::scoped_lock lock(m_mutex);
+        return m_allocated;
+    }
+
+    size_t allocCount() const {
+        boost::mutex::scoped_lock lock(m_mutex);
+        return m_alloc_count;
+    }
+
+    size_t reuseCount() const {
+        boost::mutex::scoped_lock lock(m_mutex);
+        return m_reuse_count;
+    }
+
+private:
+    //保持每次分配的起始地址按INDICATOR_BUFFER_ALIGN对齐
+    static size_t _roundUp(size_t bytes) {
+        return (bytes + INDICATOR_BUFFER_ALIGN - 1)
+               / INDICATOR_BUFFER_ALIGN * INDICATOR_BUFFER_ALIGN;
+    }
+
+    void _newBlock(size_t bytes) {
+        size_t size = bytes > m_block_size ? bytes : m_block_size;
+        char *p = (char *)boost::alignment::aligned_alloc(
+                INDICATOR_BUFFER_ALIGN, size);
+        if (!p) {
+            throw std::bad_alloc();
+        }
+        m_blocks.push_back(p);
+        m_current = p;
+        m_current_size = size;
+        m_offset = 0;
+    }
+
+private:
+    typedef std::map<size_t, vector<char *> > FreeList;
+
+    mutable boost::mutex m_mutex;
+    size_t m_block_size;
+    vector<char *> m_blocks;
+    char *m_current;        //当前用于分配的内存块
+    size_t m_current_size;
+    size_t m_offset;        //当前内存块中已使用的字节数
+    FreeList m_free;        //按大小分类的空闲内存
+    size_t m_allocated;
+    size_t m_alloc_count;
+    size_t m_reuse_count;
+};
+
+namespace {
+
+/**
+ * 从内存池中分配shared_ptr控制块的分配器，控制块中保存的分配器副本持有
+ * 内存池，保证控制块归还时内存池仍然有效
+ */
+template <class T>
+struct ArenaAllocator {
+    typedef T value_type;
+
+    template <class U>
+    struct rebind {
+        typedef ArenaAllocator<U> other;
+    };
+
+    ArenaAllocator(const shared_ptr<IndicatorArenaPool>& pool)
+    : m_pool(pool) {}
+
+    template <class U>
+    ArenaAllocator(const ArenaAllocator<U>& other): m_pool(other.m_pool) {}
+
+    T* allocate(size_t n) {
+        return (T *)m_pool->allocate(n * sizeof(T));
+    }
+
+    void deallocate(T *p, size_t n) {
+        m_pool->deallocate(p, n * sizeof(T));
+    }
+
+    template <class U>
+    bool operator==(const ArenaAllocator<U>& other) const {
+        return m_pool == other.m_pool;
+    }
+
+    template <class U>
+    bool operator!=(const ArenaAllocator<U>& other) const {
+        return m_pool != other.m_pool;
+    }
+
+    shared_ptr<IndicatorArenaPool> m_pool;
+};
+
+/** 缓存释放时放回内存池的空闲链表 */
+struct ArenaBufferDeleter {
+    ArenaBufferDeleter(IndicatorArenaPool *pool, size_t bytes)
+    : m_pool(pool), m_bytes(bytes) {}
+
+    void operator()(price_storage_t *p) {
+        m_pool->deallocate(p, m_bytes);
+    }
+
+    IndicatorArenaPool *m_pool;
+    size_t m_bytes;
+};
+
+void no_cleanup(IndicatorArena *) {}
+
+boost::thread_specific_ptr<IndicatorArena> g_current_arena(no_cleanup);
+
+} /* namespace */
+
+IndicatorArena::IndicatorArena(size_t block_size)
+: m_pool(make_shared<IndicatorArenaPool>(block_size)) {
+    m_prev = g_current_arena.get();
+    g_current_arena.reset(this);
+}
+
+IndicatorArena::~IndicatorArena() {
+    g_current_arena.reset(m_prev);
+}
+
+IndicatorArena* IndicatorArena::current() {
+    return g_current_arena.get();
+}
+
+IndicatorBufferPtr IndicatorArena::allocBuffer(size_t n) {
+    size_t bytes = n * sizeof(price_storage_t);
+    price_storage_t *p = (price_storage_t *)m_pool->allocate(bytes);
+
+    //控制块同样从内存池中分配；分配失败时shared_ptr会调用释放器归还p
+    return IndicatorBufferPtr(p, ArenaBufferDeleter(m_pool.get(), bytes),
+                              ArenaAllocator<char>(m_pool));
+}
+
+size_t IndicatorArena::blockCount() const {
+    return m_pool->blockCount();
+}
+
+size_t IndicatorArena::allocatedBytes() const {
+    return m_pool->allocatedBytes();
+}
+
+size_t IndicatorArena::allocCount() const {
+    return m_pool->allocCount();
+}
+
+size_t IndicatorArena::reuseCount() const {
+    return m_pool->reuseCount();
+}
+
+} /* namespace hku */
@@ -0,0 +1,69 @@
+/*
+ * IndicatorArena.h
+ */
+
+#ifndef INDICATOR_INDICATORARENA_H_
+#define INDICATOR_INDICATORARENA_H_
+
+#include <boost/noncopyable.hpp>
+#include "IndicatorImp.h"
+
+namespace hku {
+
+class IndicatorArenaPool;
+
+/**
+ * 指标结果缓存的内存池作用域
+ * @details 在其生存期内，当前线程中所有IndicatorImp的结果缓存，连同缓存
+ *          shared_ptr的控制块，均从该内存池中按块分配，不再单独调用malloc。
+ *          缓存释放后按大小放入空闲链表，后续相同大小的缓存直接复用，因此
+ *          反复创建同样长度的临时指标时内存池不会持续增长。内存块在内存池
+ *          析构且所有缓存均被释放后一次性归还，因此在作用域外继续持有的
+ *          Indicator仍然有效。适用于参数寻优等需要反复创建大量临时指标的
+ *          批量计算，如:
+ * <pre>
+ * for (...) {
+ *     IndicatorArena arena;
+ *     sys->run(stock, query);
+ *     ...
+ * }
+ * </pre>
+ * @note 内存池仅对创建它的线程有效，可嵌套，内层作用域优先；从中分配的
+ *       缓存可以在其他线程中释放
+ * @ingroup Indicator
+ */
+class HKU_API IndicatorArena: boost::noncopyable {
+public:
+    /**
+     * @param block_size 每次向系统申请的内存块大小（字节），超过该大小的
+     *                   缓存将单独占用一个内存块
+     */
+    explicit IndicatorArena(size_t block_size = 1024 * 1024);
+    virtual ~IndicatorArena();
+
+    /** 获取当前线程正在使用的内存池，如不存在返回NULL */
+    static IndicatorArena* current();
+
+    /** 从内存池中分配可容纳n个price_storage_t的对齐缓存 */
+    IndicatorBufferPtr allocBuffer(size_t n);
+
+    /** 已向系统申请的内存块数量 */
+    size_t blockCount() const;
+
+    /** 从内存块中划出的字节数，复用的空闲内存不重复计入 */
+    size_t allocatedBytes() const;
+
+    /** 内存池响应的分配次数，包括结果缓存及其控制块 */
+    size_t allocCount() const;
+
+    /** 由空闲链表直接满足的分配次数 */
+    size_t reuseCount() const;
+
+private:
+    shared_ptr<IndicatorArenaPool> m_pool;
+    IndicatorArena *m_prev;
+};
+
+} /* namespace hku */
+
+#endif /* INDICATOR_INDICATORARENA_H_ */
@@ -0,0 +1,202 @@
+/*
+ * IndicatorCache.cpp
+ *
+ *  Created on: 2017年6月14日
+ *      Author: fasiondog
+ */
+
+#include <list>
+#include <boost/thread/mutex.hpp>
+#include <boost/unordered_map.hpp>
+#include "IndicatorCache.h"
+
+namespace hku {
+
+namespace {
+
+struct CacheEntry {
+    string key;
+    Stock stock;
+    IndicatorImpPtr result;
+    size_t bytes;
+};
+
+typedef std::list<CacheEntry> CacheList;
+
+/** 缓存结果按最近使用的顺序排列，表头为最近使用 */
+struct CacheData {
+    CacheData()
+    : max_bytes(0), bytes(0), hits(0), misses(0), evictions(0) {}
+
+    void erase(CacheList::iterator iter) {
+        bytes -= iter->bytes;
+        index.erase(iter->key);
+        entries.erase(iter);
+    }
+
+    void shrink(size_t limit) {
+        while (bytes > limit && !entries.empty()) {
+            CacheList::iterator iter = entries.end();
+            --iter;
+            erase(iter);
+            evictions++;
+        }
+    }
+
+    CacheList entries;
+    boost::unordered_map<string, CacheList::iterator> index;
+    size_t max_bytes;
+    size_t bytes;
+    size_t hits;
+    size_t misses;
+    size_t evictions;
+    boost::mutex mutex;
+};
+
+CacheData& cache_data() {
+    static CacheData s_data;
+    return s_data;
+}
+
+/** 按日期查询时start()/end()均为Null，需以起止日期区分查询范围 */
+string make_key(const IndicatorSource& source) {
+    const KQuery& query = source.query;
+    std::stringstream buf;
+    buf << source.stock.market_code() << "|" << query.queryType() << ",";
+    if (query.queryType() == KQuery::DATE) {
+        buf << query.startDatetime().number() << ","
+            << query.endDatetime().number();
+    } else {
+        buf << query.start() << "," << query.end();
+    }
+    buf << "," << query.kType() << "," << query.recoverType() << "|"
+        << source.expression;
+    return buf.str();
+}
+
+} /* namespace */
+
+void IndicatorCache::setMaxBytes(size_t bytes) {
+    CacheData& data = cache_data();
+    boost::mutex::scoped_lock lock(data.mutex);
+    data.max_bytes = bytes;
+    data.shrink(bytes);
+}
+
+size_t IndicatorCache::getMaxBytes() {
+    return cache_data().max_bytes;
+}
+
+bool IndicatorCache::enabled() {
+    return cache_data().max_bytes != 0;
+}
+
+bool IndicatorCache::get(const IndicatorSource& source, IndicatorImp& result) {
+    string key(make_key(source));
+    CacheData& data = cache_data();
+    boost::mutex::scoped_lock lock(data.mutex);
+    boost::unordered_map<string, CacheList::iterator>::iterator iter
+            = data.index.find(key);
+    if (iter == data.index.end()) {
+        data.misses++;
+        return false;
+    }
+
+    data.entries.splice(data.entries.begin(), data.entries, iter->second);
+    result._assignResult(*(iter->second->result));
+    data.hits++;
+    return true;
+}
+
+void IndicatorCache::put(const IndicatorSource& source,
+        const IndicatorImp& result) {
+    size_t bytes = result.size() * result.getResultNumber()
+                 * sizeof(price_storage_t);
+    if (bytes == 0) {
+        return;
+    }
+
+    CacheEntry entry;
+    entry.key = make_key(source);
+    entry.stock = source.stock;
+    entry.result = IndicatorImpPtr(new IndicatorImp(result.name()));
+    entry.result->_assignResult(result);
+    entry.bytes = bytes;
+
+    CacheData& data = cache_data();
+    boost::mutex::scoped_lock lock(data.mutex);
+    if (bytes > data.max_bytes) {
+        return;
+    }
+
+    boost::unordered_map<string, CacheList::iterator>::iterator iter
+            = data.index.find(entry.key);
+    if (iter != data.index.end()) {
+        data.erase(iter->second);
+    }
+
+    data.entries.push_front(entry);
+    data.index[entry.key] = data.entries.begin();
+    data.bytes += bytes;
+    data.shrink(data.max_bytes);
+}
+
+void IndicatorCache::invalidate(const Stock& stock) {
+    CacheData& data = cache_data();
+    boost::mutex::scoped_lock lock(data.mutex);
+    CacheList::iterator iter = data.entries.begin();
+    while (iter != data.entries.end()) {
+        CacheList::iterator cur = iter++;
+        if (cur->stock == stock) {
+            data.erase(cur);
+        }
+    }
+}
+
+void IndicatorCache::clear() {
+    CacheData& data = cache_data();
+    boost::mutex::scoped_lock lock(data.mutex);
+    data.entries.clear();
+    data.index.clear();
+    data.bytes = 0;
+}
+
+size_t IndicatorCache::size() {
+    CacheData& data = cache_data();
+    boost::mutex::scoped_lock lock(data.mutex);
+    return data.entries.size();
+}
+
+size_t IndicatorCache::bytes() {
+    CacheData& data = cache_data();
+    boost::mutex::scoped_lock lock(data.mutex);
+    return data.bytes;
+}
+
+size_t IndicatorCache::hits() {
+    CacheData& data = cache_data();
+    boost::mutex::scoped_lock lock(data.mutex);
+    return data.hits;
+}
+
+size_t IndicatorCache::misses() {
+    CacheData& data = cache_data();
+    boost::mutex::scoped_lock lock(data.mutex);
+    return data.misses;
+}
+
+size_t IndicatorCache::evictions() {
+    CacheData& data = cache_data();
+    boost::mutex::scoped_lock lock(data.mutex);
+    return data.evictions;
+}
+
+void IndicatorCache::resetStatistics() {
+    CacheData& data = cache_data();
+    boost::mutex::scoped_lock lock(data.mutex);
+    data.hits = 0;
+    data.misses = 0;
+    data.evictions = 0;
+}
+
+} /* namespace hku */
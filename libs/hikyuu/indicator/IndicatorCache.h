@@ -0,0 +1,80 @@
+/*
+ * IndicatorCache.h
+ *
+ *  Created on: 2017年6月14日
+ *      Author: fasiondog
+ */
+
+#ifndef INDICATOR_INDICATORCACHE_H_
+#define INDICATOR_INDICATORCACHE_H_
+
+#include "IndicatorImp.h"
+
+namespace hku {
+
+/**
+ * 进程级指标结果缓存
+ * @details 以（证券，查询条件，完整计算表达式）为键值缓存指标计算结果，如在
+ *          参数寻优或多个策略部件中对同一证券反复计算 MA(CLOSE(kdata), 20)
+ *          时，仅第一次实际计算，其后直接共享第一次的结果缓存。
+ *          只有可追溯至某一证券K线数据的指标（即由KDATA/OPEN/CLOSE等从KData
+ *          创建的指标，及以其为输入逐级计算出的指标）才会使用缓存。
+ *          缓存按最近最少使用的顺序淘汰，总字节数不超过setMaxBytes指定的上限，
+ *          默认上限为0，即不启用缓存。Stock加载、释放或更新K线缓存时，自动
+ *          清除该证券的全部缓存结果。
+ * @note 仅适用于计算结果完全由参数及输入数据决定的指标，如自定义指标依赖
+ *       其他状态，应在该状态改变时调用clear()，或不启用缓存
+ * @ingroup Indicator
+ */
+class HKU_API IndicatorCache {
+public:
+    /**
+     * 设置缓存占用内存的上限（字节），为0时禁用缓存并清除已有缓存结果
+     */
+    static void setMaxBytes(size_t bytes);
+
+    /** 获取缓存占用内存的上限（字节） */
+    static size_t getMaxBytes();
+
+    /** 是否已启用缓存 */
+    static bool enabled();
+
+    /**
+     * 从缓存中获取结果，命中时result将共享缓存中的结果缓存
+     * @param source 计算来源
+     * @param result 命中时存放结果
+     * @return true 命中 | false 未命中
+     */
+    static bool get(const IndicatorSource& source, IndicatorImp& result);
+
+    /** 将计算结果加入缓存，缓存中只保存与result共享的结果缓存，不复制数据 */
+    static void put(const IndicatorSource& source, const IndicatorImp& result);
+
+    /** 清除指定证券的全部缓存结果 */
+    static void invalidate(const Stock& stock);
+
+    /** 清除全部缓存结果，不重置统计数据 */
+    static void clear();
+
+    /** 当前缓存的结果数量 */
+    static size_t size();
+
+    /** 当前缓存结果占用的字节数 */
+    static size_t bytes();
+
+    /** 命中次数 */
+    static size_t hits();
+
+    /** 未命中次数 */
+    static size_t misses();
+
+    /** 因超出内存上限而被淘汰的结果数量 */
+    static size_t evictions();
+
+    /** 重置命中、未命中及淘汰的统计数据 */
+    static void resetStatistics();
+};
+
+} /* namespace hku */
+
+#endif /* INDICATOR_INDICATORCACHE_H_ */
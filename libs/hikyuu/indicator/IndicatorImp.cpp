@@ -6,6 +6,8 @@
  */
 #include <stdexcept>
 #include "Indicator.h"
+#include "IndicatorArena.h"
+#include "IndicatorCache.h"
 #include "../Log.h"
 
 namespace hku {
@@ -27,21 +29,34 @@ HKU_API std::ostream & operator<<(std::ostream& os, const IndicatorImpPtr& imp)
 
 
 IndicatorImp::IndicatorImp()
-: m_name("IndicatorImp"), m_discard(0), m_result_num(0) {
-    memset(m_pBuffer, NULL, sizeof(PriceList*) * MAX_RESULT_NUM);
+: m_name("IndicatorImp"), m_discard(0), m_result_num(0),
+  m_data(NULL), m_size(0), m_capacity(0) {
 }
 
 IndicatorImp::IndicatorImp(const string& name)
-: m_name(name), m_discard(0), m_result_num(0) {
-    memset(m_pBuffer, NULL, sizeof(PriceList*) * MAX_RESULT_NUM);
+: m_name(name), m_discard(0), m_result_num(0),
+  m_data(NULL), m_size(0), m_capacity(0) {
 }
 
 IndicatorImp::IndicatorImp(const string& name, size_t result_num)
-: m_name(name), m_discard(0) {
-    memset(m_pBuffer, NULL, sizeof(PriceList*) * MAX_RESULT_NUM);
+: m_name(name), m_discard(0), m_data(NULL), m_size(0), m_capacity(0) {
     m_result_num = result_num < MAX_RESULT_NUM ? result_num : MAX_RESULT_NUM;
 }
 
+IndicatorBufferPtr IndicatorImp::_allocBuffer(size_t n) {
+    IndicatorArena *arena = IndicatorArena::current();
+    if (arena) {
+        return arena->allocBuffer(n);
+    }
+
+    void *p = boost::alignment::aligned_alloc(INDICATOR_BUFFER_ALIGN,
+                                              n * sizeof(price_storage_t));
+    if (!p) {
+        throw std::bad_alloc();
+    }
+    return IndicatorBufferPtr((price_storage_t *)p, IndicatorBufferDeleter());
+}
+
 void IndicatorImp::_readyBuffer(size_t len, size_t result_num) {
     if (result_num > MAX_RESULT_NUM) {
         throw(std::invalid_argument("result_num oiverload MAX_RESULT_NUM! "
@@ -49,33 +64,69 @@ void IndicatorImp::_readyBuffer(size_t len, size_t result_num) {
         return;
     }
 
-    price_t null_price = Null<price_t>();
+    m_masks.clear();
+    size_t total = len * result_num;
+    if (total == 0) {
+        m_buffer.reset();
+        m_data = NULL;
+        m_capacity = 0;
 
-    for (size_t i = 0; i < result_num; ++i) {
-        if (!m_pBuffer[i]) {
-            m_pBuffer[i] = new PriceList(len, null_price);
+    } else if (!m_buffer || !m_buffer.unique() || m_capacity < total) {
+        //缓存被getResult返回的视图共享时不能复用，否则会改写视图中的数据
+        m_buffer = _allocBuffer(total);
+        m_data = m_buffer.get();
+        m_capacity = total;
+    }
 
-        } else {
-            m_pBuffer[i]->clear();
-            m_pBuffer[i]->reserve(len);
-            for (size_t j = 0; j < len; ++j) {
-                m_pBuffer[i]->push_back(null_price);
-            }
-        }
+    price_storage_t null_price = Null<price_storage_t>();
+    std::fill(m_data, m_data + total, null_price);
+    m_size = result_num ? len : 0;
+    m_result_num = result_num;
+}
+
+void IndicatorImp::_resizeResultNum(size_t result_num) {
+    if (result_num > MAX_RESULT_NUM) {
+        throw(std::invalid_argument("result_num oiverload MAX_RESULT_NUM! "
+                "[IndicatorImp::_resizeResultNum]" + name()));
+        return;
     }
 
-    for (size_t i = result_num; i < m_result_num; ++i) {
-        delete m_pBuffer[i];
-        m_pBuffer[i] = NULL;
+    size_t old_total = m_size * m_result_num;
+    size_t total = m_size * result_num;
+    if (total > old_total
+            && (!m_buffer || !m_buffer.unique() || m_capacity < total)) {
+        IndicatorBufferPtr buffer = _allocBuffer(total);
+        std::copy(m_data, m_data + old_total, buffer.get());
+        m_buffer = buffer;
+        m_data = m_buffer.get();
+        m_capacity = total;
     }
 
+    if (total > old_total) {
+        price_storage_t null_price = Null<price_storage_t>();
+        std::fill(m_data + old_total, m_data + total, null_price);
+    }
     m_result_num = result_num;
+
+    if (!m_masks.empty()) {
+        _buildMask();
+    }
 }
 
-IndicatorImp::~IndicatorImp() {
-    for (size_t i = 0; i < m_result_num; ++i) {
-        delete m_pBuffer[i];
+void IndicatorImp::_detachBuffer() {
+    if (!m_data || (m_buffer.unique() && m_data == m_buffer.get())) {
+        return;
     }
+
+    size_t total = m_size * m_result_num;
+    IndicatorBufferPtr buffer = _allocBuffer(total);
+    std::copy(m_data, m_data + total, buffer.get());
+    m_buffer = buffer;
+    m_data = m_buffer.get();
+    m_capacity = total;
+}
+
+IndicatorImp::~IndicatorImp() {
 }
 
 
@@ -90,16 +141,26 @@ IndicatorImpPtr IndicatorImp::operator()(const Indicator& ind) {
     return result;
 }
 
+IndicatorImpPtr IndicatorImp::clone() {
+    IndicatorImpPtr p = _clone();
+    p->m_name = m_name;
+    p->m_params = m_params;
+    return p;
+}
+
 void IndicatorImp::setDiscard(size_t discard) {
     size_t tmp_discard = discard > size() ? size() : discard;
     if (tmp_discard > m_discard) {
-        price_t null_price = Null<price_t>();
+        _detachBuffer();
+        price_storage_t null_price = Null<price_storage_t>();
         for (size_t i = 0; i < m_result_num; ++i) {
-            for (size_t j = m_discard; j < tmp_discard; ++j) {
-                _set(null_price, j, i);
-            }
+            price_storage_t *p = m_data + i * m_size;
+            std::fill(p + m_discard, p + tmp_discard, null_price);
         }
         m_discard = tmp_discard;
+        if (!m_masks.empty()) {
+            _buildMask();
+        }
     }
 }
 
@@ -108,33 +169,100 @@ string IndicatorImp::long_name() const {
 }
 
 PriceList IndicatorImp::getResultAsPriceList(size_t result_num) {
-    if (result_num >= m_result_num || m_pBuffer[result_num] == NULL) {
+    if (result_num >= m_result_num || m_data == NULL) {
         return PriceList();
     }
 
-    return (*m_pBuffer[result_num]);
+#if HKU_USE_FLOAT32_STORAGE
+    PriceList result(m_size);
+    for (size_t i = 0; i < m_size; ++i) {
+        result[i] = get(i, result_num);
+    }
+    return result;
+#else
+    return PriceList(data(result_num), data(result_num) + m_size);
+#endif
 }
 
 
 Indicator IndicatorImp::getResult(size_t result_num) {
-    if (result_num >= m_result_num || m_pBuffer[result_num] == NULL) {
+    if (result_num >= m_result_num || m_data == NULL) {
         return Indicator();
     }
 
+    //返回共享同一缓存的视图，本实例或视图后续修改数据时会各自复制
     IndicatorImpPtr imp = make_shared<IndicatorImp>();
-    size_t total = size();
-    imp->_readyBuffer(total, 1);
-    imp->setDiscard(discard());
-    for (size_t i = discard(); i < total; ++i) {
-        imp->_set(get(i, result_num), i);
+    imp->m_buffer = m_buffer;
+    imp->m_data = m_data + result_num * m_size;
+    imp->m_size = m_size;
+    imp->m_capacity = 0;
+    imp->m_result_num = 1;
+    imp->m_discard = m_discard;
+    if (result_num < m_masks.size()) {
+        imp->m_masks.push_back(m_masks[result_num]);
     }
     return Indicator(imp);
 }
 
+void IndicatorImp::_assignResult(const IndicatorImp& other) {
+    m_buffer = other.m_buffer;
+    m_data = other.m_data;
+    m_size = other.m_size;
+    m_capacity = 0;
+    m_result_num = other.m_result_num;
+    m_discard = other.m_discard;
+    m_masks = other.m_masks;
+}
+
+void IndicatorImp::_buildMask() {
+    m_masks.clear();
+    if (!m_data) {
+        return;
+    }
+
+    m_masks.resize(m_result_num);
+    for (size_t i = 0; i < m_result_num; ++i) {
+        m_masks[i] = IndicatorMaskPtr(
+                new IndicatorMask(data(i), m_size, m_discard));
+    }
+}
+
+void IndicatorImp::_setMask(size_t num, const IndicatorMaskPtr& mask) {
+    if (num >= m_result_num) {
+        return;
+    }
+
+    if (m_masks.size() < m_result_num) {
+        m_masks.resize(m_result_num);
+    }
+    m_masks[num] = mask;
+}
+
 void IndicatorImp::calculate(const Indicator& data) {
+    //输入可追溯至K线数据时，记录本次结果的计算来源
+    IndicatorSourcePtr source;
+    IndicatorImpPtr data_imp = data.getImp();
+    if (data_imp && data_imp->m_source) {
+        source = IndicatorSourcePtr(new IndicatorSource(
+                data_imp->m_source->stock, data_imp->m_source->query,
+                long_name() + "(" + data_imp->m_source->expression + ")"));
+    }
+
+    bool use_cache = source && IndicatorCache::enabled();
+    if (use_cache && check() && IndicatorCache::get(*source, *this)) {
+        m_source = source;
+        return;
+    }
+
+    m_source.reset();
     _readyBuffer(data.size(), m_result_num);
     if (check()) {
         _calculate(data);
+        _buildMask();
+        m_source = source;
+        if (use_cache) {
+            IndicatorCache::put(*source, *this);
+        }
     } else {
         HKU_WARN("Invalid param! " << long_name());
     }
@@ -11,6 +11,8 @@
 #include "../KData.h"
 #include "../utilities/Parameter.h"
 #include "../utilities/util.h"
+#include "IndicatorMask.h"
+#include <boost/align/aligned_alloc.hpp>
 
 #if HKU_SUPPORT_SERIALIZATION
 #include <boost/serialization/string.hpp>
@@ -24,8 +26,47 @@ namespace hku {
 
 #define MAX_RESULT_NUM 6
 
+/** 指标结果缓存的内存对齐字节数 */
+#define INDICATOR_BUFFER_ALIGN 64
+
 class HKU_API Indicator;
 
+/**
+ * 指标结果缓存释放器，配合boost::alignment::aligned_alloc使用
+ * @ingroup Indicator
+ */
+struct IndicatorBufferDeleter {
+    void operator()(price_storage_t *p) const {
+        boost::alignment::aligned_free(p);
+    }
+};
+
+/**
+ * 指标结果缓存，所有结果集按结果集顺序连续存放于同一块对齐内存中，
+ * 可由多个IndicatorImp共享（如getResult返回的视图）
+ * @ingroup Indicator
+ */
+typedef shared_ptr<price_storage_t> IndicatorBufferPtr;
+
+/**
+ * 指标结果的计算来源，记录结果对应的证券、查询条件及从K线数据开始的完整计算
+ * 表达式（如：SMA(n=20)(CLOSE)），用作指标结果缓存的键值
+ * @see IndicatorCache
+ * @ingroup Indicator
+ */
+struct HKU_API IndicatorSource {
+    IndicatorSource() {}
+    IndicatorSource(const Stock& stock, const KQuery& query,
+            const string& expression)
+    : stock(stock), query(query), expression(expression) {}
+
+    Stock stock;
+    KQuery query;
+    string expression;
+};
+
+typedef shared_ptr<IndicatorSource> IndicatorSourcePtr;
+
 /**
  * 指标实现类，定义新指标时，应从此类继承
  * @ingroup Indicator
@@ -52,51 +93,144 @@ public:
     void setDiscard(size_t discard);
 
     size_t size() const {
-        return m_pBuffer[0] ? m_pBuffer[0]->size() : 0;
+        return m_size;
     }
 
-    price_t get(size_t pos, size_t num = 0) {
-        return (*m_pBuffer[num])[pos];
+    price_t get(size_t pos, size_t num = 0) const {
+#if HKU_USE_FLOAT32_STORAGE
+        price_storage_t val = m_data[num * m_size + pos];
+        return val == Null<price_storage_t>() ? Null<price_t>() : (price_t)val;
+#else
+        return m_data[num * m_size + pos];
+#endif
+    }
+
+    /**
+     * 获取指定结果集的首地址，结果集在内存中连续存放，长度为size()
+     * @note 不做越界检查，返回的指针在下一次计算前有效；存储类型为
+     *       price_storage_t，32位存储时Null值为Null<float>()
+     */
+    const price_storage_t* data(size_t num = 0) const {
+        return m_data + num * m_size;
+    }
+
+    /**
+     * 获取data()所在的结果缓存，持有该缓存可使data()返回的指针在本指标
+     * 重新计算或修改结果后仍然有效（此时将另行分配缓存，不会改写被共享的缓存）
+     */
+    IndicatorBufferPtr getBuffer() const {
+        return m_buffer;
     }
 
     /** 以PriceList方式获取指定的输出集 */
     PriceList getResultAsPriceList(size_t result_num);
 
-    /** 以Indicator的方式获取指定的输出集，该方式包含了discard的信息 */
+    /**
+     * 以Indicator的方式获取指定的输出集，该方式包含了discard的信息
+     * @note 返回的Indicator与本实例共享结果缓存，不复制数据
+     */
     Indicator getResult(size_t result_num);
 
     /**
      * 使用IndicatorImp(const Indicator&...)构造函数后，计算结果使用该函数,
-     * 未做越界保护
+     * 未做越界保护。结果缓存被其他实例共享时，先复制一份独占的缓存再写入。
+     * 不更新有效值位图，在calculate()之外改写结果后需调用_buildMask
      */
     void _set(price_t val, size_t pos, size_t num = 0) {
 #if CHECK_ACCESS_BOUND
-        if ((m_pBuffer[num] == NULL) || pos>= m_pBuffer[num]->size()) {
+        if (num >= m_result_num || pos >= m_size) {
             throw(std::out_of_range("Try to access value out of bounds! "
                         + name() + " [IndicatorImp::_set]"));
         }
-        (*m_pBuffer[num])[pos] = val;
+#endif
+        if (m_data != m_buffer.get() || !m_buffer.unique()) {
+            _detachBuffer();
+        }
+#if HKU_USE_FLOAT32_STORAGE
+        m_data[num * m_size + pos] = val == Null<price_t>()
+                ? Null<price_storage_t>() : (price_storage_t)val;
 #else
-        (*m_pBuffer[num])[pos] = val;
+        m_data[num * m_size + pos] = val;
 #endif
     }
 
     /**
-     * 准备内存
+     * 获取指定结果集的可写首地址，供批量写入结果的计算函数使用，需在
+     * _readyBuffer之后调用，不做越界检查。结果缓存被共享时先复制一份独占的
+     * 缓存，返回的指针在下一次调用_readyBuffer前有效。该结果集已有的
+     * 有效值位图将被丢弃，写入完毕后可调用_setMask或_buildMask重新设置
+     */
+    price_storage_t* _data(size_t num = 0) {
+        if (m_data != m_buffer.get() || !m_buffer.unique()) {
+            _detachBuffer();
+        }
+        if (num < m_masks.size()) {
+            m_masks[num].reset();
+        }
+        return m_data + num * m_size;
+    }
+
+    /**
+     * 获取指定结果集的有效值位图，未生成时返回空指针。calculate()计算完毕后
+     * 按discard及Null值为每个结果集生成位图，四则、比较及逻辑运算的结果
+     * 由运算内核直接生成位图
+     */
+    IndicatorMaskPtr getMask(size_t num = 0) const {
+        return num < m_masks.size() ? m_masks[num] : IndicatorMaskPtr();
+    }
+
+    /** 按当前结果数据为所有结果集生成有效值位图 */
+    void _buildMask();
+
+    /**
+     * 设置指定结果集的有效值位图，供已知结果有效性的计算函数在写入全部结果
+     * 后调用，调用者负责保证位图与数据一致
+     */
+    void _setMask(size_t num, const IndicatorMaskPtr& mask);
+
+    /**
+     * 准备内存，所有结果集使用同一块连续内存，并初始化为Null值。
+     * 如原有缓存未被共享且容量足够，则直接复用原有缓存。
      * @param len 长度，如果长度大于MAX_RESULT_NUM将抛出异常std::invalid_argument
      * @param result_num 结果集数量
      * @return true 成功 | false 失败
      */
     void _readyBuffer(size_t len, size_t result_num);
 
+    /**
+     * 在保留已有结果集数据的情况下，调整结果集数量，新增的结果集初始化为
+     * Null值，长度与原有结果集相同
+     * @param result_num 新的结果集数量，不能超过MAX_RESULT_NUM
+     */
+    void _resizeResultNum(size_t result_num);
+
     string name() const { return m_name; }
     void name(const string& name) { m_name = name; }
 
     /** 返回形如：Name(param1=val,param2=val,...) */
     string long_name() const;
 
+    /**
+     * 使用输入数据计算指标，如输入数据可追溯至某一证券的K线数据且已启用
+     * IndicatorCache，则优先从缓存中获取计算结果
+     */
     void calculate(const Indicator& data);
 
+    /** 获取计算来源，结果不是由某一证券的K线数据计算而来时返回空指针 */
+    IndicatorSourcePtr getSource() const {
+        return m_source;
+    }
+
+    void setSource(const IndicatorSourcePtr& source) {
+        m_source = source;
+    }
+
+    /**
+     * 以共享结果缓存的方式复制另一指标的计算结果（不复制名称及参数），
+     * 此后修改结果时将另行分配缓存，不会改写被共享的缓存
+     */
+    void _assignResult(const IndicatorImp& other);
+
     // ===================
     //  子类接口
     // ===================
@@ -107,11 +241,34 @@ public:
     typedef shared_ptr<IndicatorImp> IndicatorImpPtr;
     virtual IndicatorImpPtr operator()(const Indicator& ind);
 
+    /** 创建同类型、同名称及同参数的新实例，不复制计算结果 */
+    IndicatorImpPtr clone();
+
+    virtual IndicatorImpPtr _clone() {
+        return IndicatorImpPtr(new IndicatorImp());
+    }
+
+private:
+    /** 如结果缓存被其他实例共享，则复制一份独占的缓存 */
+    void _detachBuffer();
+
+    /** 分配可容纳n个price_storage_t的对齐内存，当前线程存在IndicatorArena时从中分配 */
+    static IndicatorBufferPtr _allocBuffer(size_t n);
+
 protected:
     string m_name;
     size_t m_discard;
     size_t m_result_num;
-    PriceList *m_pBuffer[MAX_RESULT_NUM];
+
+    IndicatorBufferPtr m_buffer; //结果缓存的所有者
+    price_storage_t *m_data;     //第一个结果集的首地址
+    size_t m_size;               //每个结果集的长度
+    size_t m_capacity;           //m_buffer可容纳的元素数量，视图为0
+
+    IndicatorSourcePtr m_source; //计算来源，不参与序列化
+
+    //各结果集的有效值位图，为空表示未生成，不参与序列化
+    vector<IndicatorMaskPtr> m_masks;
 
 #if HKU_SUPPORT_SERIALIZATION
 private:
@@ -124,18 +281,17 @@ private:
         ar & BOOST_SERIALIZATION_NVP(m_params);
         ar & BOOST_SERIALIZATION_NVP(m_discard);
         ar & BOOST_SERIALIZATION_NVP(m_result_num);
-        int act_result_num = 0;
-        size_t i = 0;
-        while (i < m_result_num) {
-            if (m_pBuffer[i++])
-                act_result_num++;
-        }
+        int act_result_num = m_data ? m_result_num : 0;
         ar & BOOST_SERIALIZATION_NVP(act_result_num);
 
         for (size_t i = 0; i < act_result_num; ++i) {
             std::stringstream buf;
             buf << "result_" << i;
-            ar & bs::make_nvp<PriceList>(buf.str().c_str(), *m_pBuffer[i]);
+            PriceList result(m_size);
+            for (size_t j = 0; j < m_size; ++j) {
+                result[j] = get(j, i);
+            }
+            ar & bs::make_nvp<PriceList>(buf.str().c_str(), result);
         }
     }
 
@@ -148,12 +304,21 @@ private:
         ar & BOOST_SERIALIZATION_NVP(m_result_num);
         int act_result_num = 0;
         ar & BOOST_SERIALIZATION_NVP(act_result_num);
+        size_t result_num = m_result_num;
         for (size_t i = 0; i < act_result_num; ++i) {
-            m_pBuffer[i] = new PriceList();
+            PriceList result;
             std::stringstream buf;
             buf << "result_" << i;
-            ar & bs::make_nvp<PriceList>(buf.str().c_str(), *m_pBuffer[i]);
+            ar & bs::make_nvp<PriceList>(buf.str().c_str(), result);
+            if (i == 0) {
+                _readyBuffer(result.size(), act_result_num);
+            }
+            for (size_t j = 0; j < m_size; ++j) {
+                _set(result[j], j, i);
+            }
         }
+        _buildMask();
+        m_result_num = result_num;
     }
 
     BOOST_SERIALIZATION_SPLIT_MEMBER()
@@ -178,6 +343,9 @@ BOOST_SERIALIZATION_ASSUME_ABSTRACT(IndicatorImp)
 #define INDICATOR_IMP(classname) public: \
     virtual bool check(); \
     virtual void _calculate(const Indicator& data); \
+    virtual IndicatorImpPtr _clone() { \
+        return IndicatorImpPtr(new classname()); \
+    } \
     virtual IndicatorImpPtr operator()(const Indicator& ind) { \
         IndicatorImpPtr p = make_shared<classname>(); \
         p->setParameter(m_params); \
@@ -0,0 +1,226 @@
+/*
+ * IndicatorKernel.h
+ *
+ *  Created on: 2017年6月16日
+ *      Author: fasiondog
+ */
+
+#ifndef INDICATOR_INDICATORKERNEL_H_
+#define INDICATOR_INDICATORKERNEL_H_
+
+#include "Indicator.h"
+
+namespace hku {
+
+/**
+ * @defgroup IndicatorKernel 指标逐元素运算内核
+ * @details 供指标四则运算、比较运算及逻辑运算使用。按结果集直接读写连续内存，
+ *          并按64位一组的有效值位图（IndicatorMask）处理Null值：全部有效的
+ *          字直接计算，无需逐个判断或转换Null值；全部无效的字直接跳过；
+ *          部分有效的字按位选择结果。输出结果的位图由输入位图按字合并得到，
+ *          无需再次扫描结果数据。输入没有位图时，按其数据临时生成。
+ * @ingroup Indicator
+ * @{
+ */
+
+/** 读取存储值，Null值转换为Null<price_t>() */
+inline price_t ind_load(price_storage_t val) {
+#if HKU_USE_FLOAT32_STORAGE
+    return val == Null<price_storage_t>() ? Null<price_t>() : (price_t)val;
+#else
+    return val;
+#endif
+}
+
+/** 转换为存储值，同IndicatorImp::_set */
+inline price_storage_t ind_store(price_t val) {
+#if HKU_USE_FLOAT32_STORAGE
+    return val == Null<price_t>() ? Null<price_storage_t>() : (price_storage_t)val;
+#else
+    return val;
+#endif
+}
+
+/** 运算内核对Null值的处理方式 */
+enum IndKernelMode {
+    /** 比较及逻辑运算：Null值按数值参与运算，discard之后的结果均有效 */
+    IND_KERNEL_NUMERIC,
+
+    /**
+     * 四则运算：任一操作数为Null时结果为Null，操作数均有效时运算结果视为
+     * 有效，不再检查（有效值之间的运算不会恰好得到Null值）
+     */
+    IND_KERNEL_NULL_AWARE,
+
+    /** 同IND_KERNEL_NULL_AWARE，但运算本身可能返回Null，如除数为0 */
+    IND_KERNEL_NULL_CHECK
+};
+
+/** 获取指标指定结果集的有效值位图，指标未生成位图时按其数据临时生成 */
+inline IndicatorMaskPtr ind_mask(const IndicatorImpPtr& imp, size_t num) {
+    IndicatorMaskPtr mask = imp->getMask(num);
+    if (!mask) {
+        mask = IndicatorMaskPtr(new IndicatorMask(imp->data(num),
+                imp->size(), imp->discard()));
+    }
+    return mask;
+}
+
+/**
+ * 按字计算一个结果集，src1/src2为同一位置的两个操作数
+ * @param bits 操作数均有效的位，IND_KERNEL_NUMERIC模式下为输入有效的位
+ * @param range 该字中[discard, total)所对应的位
+ * @return 结果有效的位
+ */
+template <IndKernelMode mode, class Op>
+IndicatorMask::word_type ind_kernel_word(const price_storage_t *src1,
+        const price_storage_t *src2, price_storage_t *dst,
+        size_t start, size_t end, size_t word_start,
+        IndicatorMask::word_type bits, IndicatorMask::word_type range, Op op) {
+    typedef IndicatorMask::word_type word_type;
+    if (mode == IND_KERNEL_NUMERIC) {
+        if (bits == range) {
+            for (size_t i = start; i < end; ++i) {
+                dst[i] = ind_store(op((price_t)src1[i], (price_t)src2[i]));
+            }
+        } else {
+            for (size_t i = start; i < end; ++i) {
+                dst[i] = ind_store(op(ind_load(src1[i]), ind_load(src2[i])));
+            }
+        }
+        return range;
+    }
+
+    if (bits == 0) {
+        return 0; //结果缓存已初始化为Null
+    }
+
+    if (bits == range) {
+        for (size_t i = start; i < end; ++i) {
+            dst[i] = mode == IND_KERNEL_NULL_CHECK
+                   ? ind_store(op((price_t)src1[i], (price_t)src2[i]))
+                   : (price_storage_t)op((price_t)src1[i], (price_t)src2[i]);
+        }
+    } else {
+        const price_storage_t null_price = Null<price_storage_t>();
+        for (size_t i = start; i < end; ++i) {
+            price_storage_t val = ind_store(op((price_t)src1[i], (price_t)src2[i]));
+            dst[i] = ((bits >> (i - word_start)) & 1) ? val : null_price;
+        }
+    }
+
+    if (mode == IND_KERNEL_NULL_CHECK) {
+        const price_storage_t null_price = Null<price_storage_t>();
+        word_type valid = 0;
+        for (size_t i = start; i < end; ++i) {
+            valid |= word_type(dst[i] != null_price) << (i - word_start);
+        }
+        bits &= valid;
+    }
+    return bits;
+}
+
+/**
+ * 两个指标的逐元素运算
+ * @param ind1 左操作数
+ * @param ind2 右操作数
+ * @param op 运算函数，形如 price_t op(price_t, price_t)
+ * @return 长度不等或为空时返回空指标，结果集数量取两者中的较小者
+ */
+template <IndKernelMode mode, class Op>
+Indicator ind_binary_kernel(const Indicator& ind1, const Indicator& ind2,
+        Op op) {
+    if (ind1.size() != ind2.size() || ind1.size() == 0) {
+        return Indicator();
+    }
+
+    typedef IndicatorMask::word_type word_type;
+    size_t result_number = std::min(ind1.getResultNumber(), ind2.getResultNumber());
+    size_t total = ind1.size();
+    size_t discard = std::max(ind1.discard(), ind2.discard());
+    IndicatorImpPtr imp1 = ind1.getImp();
+    IndicatorImpPtr imp2 = ind2.getImp();
+    IndicatorImpPtr imp(new IndicatorImp());
+    imp->_readyBuffer(total, result_number);
+    imp->setDiscard(discard);
+
+    for (size_t r = 0; r < result_number; ++r) {
+        const price_storage_t *src1 = imp1->data(r);
+        const price_storage_t *src2 = imp2->data(r);
+        price_storage_t *dst = imp->_data(r);
+        IndicatorMaskPtr mask1 = ind_mask(imp1, r);
+        IndicatorMaskPtr mask2 = ind_mask(imp2, r);
+        IndicatorMaskPtr mask(new IndicatorMask(total, discard));
+        for (size_t w = discard / IndicatorMask::WORD_BITS;
+                w < mask->wordCount(); ++w) {
+            size_t word_start = w * IndicatorMask::WORD_BITS;
+            size_t start = std::max(word_start, discard);
+            size_t end = std::min(word_start + IndicatorMask::WORD_BITS, total);
+            word_type range = mask->word(w);
+            word_type bits = mode == IND_KERNEL_NUMERIC
+                           ? mask1->word(w) & mask2->word(w) & range
+                           : mask1->word(w) & mask2->word(w);
+            mask->setWord(w, ind_kernel_word<mode>(src1, src2, dst, start,
+                    end, word_start, bits, range, op));
+        }
+        imp->_setMask(r, mask);
+    }
+
+    return Indicator(imp);
+}
+
+/**
+ * 指标的逐元素运算，用于指标与数值之间的运算
+ * @param ind 输入指标
+ * @param op 运算函数，形如 price_t op(price_t)
+ * @param valid 参与运算的数值是否有效，IND_KERNEL_NUMERIC以外的模式下，
+ *              数值为Null时结果全部为Null
+ * @return 输入为空时返回空指标
+ */
+template <IndKernelMode mode, class Op>
+Indicator ind_unary_kernel(const Indicator& ind, Op op, bool valid = true) {
+    if (ind.size() == 0) {
+        return Indicator();
+    }
+
+    typedef IndicatorMask::word_type word_type;
+    size_t result_number = ind.getResultNumber();
+    size_t total = ind.size();
+    size_t discard = ind.discard();
+    IndicatorImpPtr src_imp = ind.getImp();
+    IndicatorImpPtr imp(new IndicatorImp());
+    imp->_readyBuffer(total, result_number);
+    imp->setDiscard(discard);
+
+    //以同一结果集作为两个操作数，复用二元运算的按字计算
+    auto unary_op = [&op](price_t a, price_t) {
+        return op(a);
+    };
+
+    for (size_t r = 0; r < result_number; ++r) {
+        const price_storage_t *src = src_imp->data(r);
+        price_storage_t *dst = imp->_data(r);
+        IndicatorMaskPtr src_mask = ind_mask(src_imp, r);
+        IndicatorMaskPtr mask(new IndicatorMask(total, discard));
+        for (size_t w = discard / IndicatorMask::WORD_BITS;
+                w < mask->wordCount(); ++w) {
+            size_t word_start = w * IndicatorMask::WORD_BITS;
+            size_t start = std::max(word_start, discard);
+            size_t end = std::min(word_start + IndicatorMask::WORD_BITS, total);
+            word_type range = mask->word(w);
+            word_type bits = mode == IND_KERNEL_NUMERIC || valid
+                           ? src_mask->word(w) & range : 0;
+            mask->setWord(w, ind_kernel_word<mode>(src, src, dst, start,
+                    end, word_start, bits, range, unary_op));
+        }
+        imp->_setMask(r, mask);
+    }
+
+    return Indicator(imp);
+}
+
+/** @} */
+
+} /* namespace hku */
+
+#endif /* INDICATOR_INDICATORKERNEL_H_ */
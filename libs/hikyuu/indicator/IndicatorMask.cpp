@@ -0,0 +1,69 @@
+/*
+ * IndicatorMask.cpp
+ *
+ *  Created on: 2017年6月16日
+ *      Author: fasiondog
+ */
+
+#include "IndicatorMask.h"
+
+namespace hku {
+
+IndicatorMask::IndicatorMask(): m_size(0), m_discard(0) {
+
+}
+
+IndicatorMask::IndicatorMask(size_t len, size_t discard)
+: m_words((len + WORD_BITS - 1) / WORD_BITS, 0),
+  m_size(len), m_discard(discard > len ? len : discard) {
+    for (size_t w = m_discard / WORD_BITS; w < m_words.size(); ++w) {
+        m_words[w] = rangeBits(w, m_discard, m_size);
+    }
+}
+
+IndicatorMask::IndicatorMask(const price_storage_t *data, size_t len,
+        size_t discard)
+: m_words((len + WORD_BITS - 1) / WORD_BITS, 0),
+  m_size(len), m_discard(discard > len ? len : discard) {
+    const price_storage_t null_price = Null<price_storage_t>();
+    for (size_t w = m_discard / WORD_BITS; w < m_words.size(); ++w) {
+        size_t start = w * WORD_BITS;
+        size_t end = start + WORD_BITS < m_size ? start + WORD_BITS : m_size;
+        word_type bits = 0;
+        //无分支地逐位生成，便于编译器向量化
+        for (size_t i = start; i < end; ++i) {
+            bits |= word_type(data[i] != null_price) << (i - start);
+        }
+        m_words[w] = bits & rangeBits(w, m_discard, m_size);
+    }
+}
+
+size_t IndicatorMask::count() const {
+    size_t result = 0;
+    for (size_t w = 0; w < m_words.size(); ++w) {
+        word_type bits = m_words[w];
+        while (bits) {
+            bits &= bits - 1;
+            result++;
+        }
+    }
+    return result;
+}
+
+IndicatorMask::word_type IndicatorMask::rangeBits(size_t word_index,
+        size_t start, size_t end) {
+    size_t word_start = word_index * WORD_BITS;
+    size_t word_end = word_start + WORD_BITS;
+    size_t first = start > word_start ? start : word_start;
+    size_t last = end < word_end ? end : word_end;
+    if (first >= last) {
+        return 0;
+    }
+
+    size_t len = last - first;
+    word_type bits = len == WORD_BITS ? ~word_type(0)
+                   : ((word_type(1) << len) - 1);
+    return bits << (first - word_start);
+}
+
+} /* namespace hku */
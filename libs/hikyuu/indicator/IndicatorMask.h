@@ -0,0 +1,97 @@
+/*
+ * IndicatorMask.h
+ *
+ *  Created on: 2017年6月16日
+ *      Author: fasiondog
+ */
+
+#ifndef INDICATOR_INDICATORMASK_H_
+#define INDICATOR_INDICATORMASK_H_
+
+#include "../DataType.h"
+
+namespace hku {
+
+/**
+ * 指标结果集的有效值位图
+ * @details 每一位对应结果集中的一个位置，1表示有效值，0表示Null值，第i个位置
+ *          对应第i/64个字的第i%64位。discard之前的位置固定为0，可直接按
+ *          discard跳过，无需逐位检查。
+ * @ingroup Indicator
+ */
+class HKU_API IndicatorMask {
+public:
+    typedef hku_uint64 word_type;
+
+    /** 每个字包含的位数 */
+    static const size_t WORD_BITS = 64;
+
+    IndicatorMask();
+
+    /**
+     * 生成discard之后全部有效的位图
+     * @param len 结果集长度
+     * @param discard 抛弃数量
+     */
+    IndicatorMask(size_t len, size_t discard);
+
+    /**
+     * 按结果集数据生成位图，值为Null<price_storage_t>()的位置为无效
+     * @param data 结果集首地址
+     * @param len 结果集长度
+     * @param discard 抛弃数量，此前的位置直接视为无效
+     */
+    IndicatorMask(const price_storage_t *data, size_t len, size_t discard);
+
+    size_t size() const {
+        return m_size;
+    }
+
+    size_t discard() const {
+        return m_discard;
+    }
+
+    /** 字的数量 */
+    size_t wordCount() const {
+        return m_words.size();
+    }
+
+    /** 获取第i个字，未做越界检查 */
+    word_type word(size_t i) const {
+        return m_words[i];
+    }
+
+    /**
+     * 设置第i个字，未做越界检查，discard之前的位由调用者保证为0。
+     * 仅供生成位图的计算函数使用，位图设置给指标后不应再修改
+     */
+    void setWord(size_t i, word_type bits) {
+        m_words[i] = bits;
+    }
+
+    /** 指定位置是否为有效值，越界时返回false */
+    bool valid(size_t pos) const {
+        return pos < m_size && ((m_words[pos / WORD_BITS]
+                >> (pos % WORD_BITS)) & 1);
+    }
+
+    /** 有效值的数量 */
+    size_t count() const;
+
+    /**
+     * 获取第word_index个字中，位置[start, end)所对应的位，用于判断某一区间
+     * 是否全部有效，如：(mask.word(w) & bits) == bits
+     */
+    static word_type rangeBits(size_t word_index, size_t start, size_t end);
+
+private:
+    vector<word_type> m_words;
+    size_t m_size;
+    size_t m_discard;
+};
+
+typedef shared_ptr<IndicatorMask> IndicatorMaskPtr;
+
+} /* namespace hku */
+
+#endif /* INDICATOR_INDICATORMASK_H_ */
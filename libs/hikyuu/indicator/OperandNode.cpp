@@ -5,11 +5,72 @@
  *      Author: fasiondog
  */
 
+#include <boost/atomic.hpp>
+#include <boost/thread/mutex.hpp>
+#include "../utilities/Parallel.h"
 #include "OperandNode.h"
+#include "IndicatorCache.h"
 #include "crt/IND_LOGIC.h"
 
 namespace hku {
 
+static boost::atomic<size_t> g_parallel_threshold(100000);
+
+void OperandNode::setParallelThreshold(size_t threshold) {
+    g_parallel_threshold.store(threshold);
+}
+
+size_t OperandNode::getParallelThreshold() {
+    return g_parallel_threshold.load();
+}
+
+/**
+ * 一次计算过程中共享的上下文
+ * @details 公式树中被多处引用的同一节点（如 op - op）对同一输入只计算一次，
+ *          并限制同时用于计算子树的线程数不超过CPU的硬件线程数
+ */
+struct OperandNode::CalculateContext {
+    typedef std::pair<OperandNode*, IndicatorImp*> key_type;
+
+    CalculateContext()
+    : m_free_threads(default_thread_count() - 1),
+      m_threshold(g_parallel_threshold.load()) {}
+
+    bool find(const key_type& key, Indicator& result) {
+        boost::mutex::scoped_lock lock(m_mutex);
+        map<key_type, Indicator>::iterator iter = m_cache.find(key);
+        if (iter == m_cache.end()) {
+            return false;
+        }
+        result = iter->second;
+        return true;
+    }
+
+    void save(const key_type& key, const Indicator& result) {
+        boost::mutex::scoped_lock lock(m_mutex);
+        m_cache[key] = result;
+    }
+
+    bool acquireThread() {
+        boost::mutex::scoped_lock lock(m_mutex);
+        if (m_free_threads == 0) {
+            return false;
+        }
+        m_free_threads--;
+        return true;
+    }
+
+    void releaseThread() {
+        boost::mutex::scoped_lock lock(m_mutex);
+        m_free_threads++;
+    }
+
+    map<key_type, Indicator> m_cache;
+    size_t m_free_threads;
+    size_t m_threshold; //计算开始时的并行计算阈值，同一次计算中保持不变
+    boost::mutex m_mutex;
+};
+
 string OperandNode::getOPTypeName(OPType op) {
     if (LEAF == op) {
         return "LEAF";
@@ -71,70 +132,161 @@ void OperandNode::add(OPType op, OperandNodePtr left, OperandNodePtr right) {
 }
 
 
+/**
+ * 左右子树的结果来源于同一证券的同一查询时，返回二元运算结果的计算来源，
+ * 否则返回空指针
+ */
+static IndicatorSourcePtr binary_source(OperandNode::OPType op,
+        const Indicator& left, const Indicator& right) {
+    IndicatorImpPtr left_imp = left.getImp();
+    IndicatorImpPtr right_imp = right.getImp();
+    if (!left_imp || !right_imp) {
+        return IndicatorSourcePtr();
+    }
+
+    IndicatorSourcePtr left_src = left_imp->getSource();
+    IndicatorSourcePtr right_src = right_imp->getSource();
+    if (!left_src || !right_src || left_src->stock != right_src->stock
+            || left_src->query != right_src->query) {
+        return IndicatorSourcePtr();
+    }
+
+    return IndicatorSourcePtr(new IndicatorSource(left_src->stock,
+            left_src->query, OperandNode::getOPTypeName(op) + "("
+            + left_src->expression + "," + right_src->expression + ")"));
+}
+
 Indicator OperandNode::calculate(const Indicator& ind) {
+    CalculateContext ctx;
+    return _calculate(ind, ctx);
+}
+
+void OperandNode::_calculateChildren(const Indicator& ind,
+        CalculateContext& ctx, Indicator& left, Indicator& right) {
+    if (m_left == m_right) {
+        left = m_left->_calculate(ind, ctx);
+        right = left;
+        return;
+    }
+
+    if (ind.size() < ctx.m_threshold || !ctx.acquireThread()) {
+        left = m_left->_calculate(ind, ctx);
+        right = m_right->_calculate(ind, ctx);
+        return;
+    }
+
+    try {
+        parallel_for(2, 2, [&](size_t i) {
+            if (i == 0) {
+                left = m_left->_calculate(ind, ctx);
+            } else {
+                right = m_right->_calculate(ind, ctx);
+            }
+        });
+    } catch (...) {
+        ctx.releaseThread();
+        throw;
+    }
+    ctx.releaseThread();
+}
+
+Indicator OperandNode::_calculate(const Indicator& ind,
+        CalculateContext& ctx) {
     Indicator result;
+    CalculateContext::key_type key(this, ind.getImp().get());
+    if (ctx.find(key, result)) {
+        return result;
+    }
 
-    switch (m_optype) {
-    case LEAF:
+    if (LEAF == m_optype) {
         result = m_ind(ind);
-        break;
 
-    case OP:
-        result = m_left->calculate(m_right->calculate(ind));
-        break;
+    } else if (OP == m_optype) {
+        result = m_left->_calculate(m_right->_calculate(ind, ctx), ctx);
+
+    } else {
+        Indicator left, right;
+        _calculateChildren(ind, ctx, left, right);
+
+        IndicatorSourcePtr source = binary_source(m_optype, left, right);
+        bool use_cache = source && IndicatorCache::enabled();
+        if (use_cache) {
+            IndicatorImpPtr imp(new IndicatorImp());
+            if (IndicatorCache::get(*source, *imp)) {
+                imp->setSource(source);
+                result = Indicator(imp);
+                if (m_name != "")
+                    result.name(m_name);
+                ctx.save(key, result);
+                return result;
+            }
+        }
+
+        switch (m_optype) {
+        case ADD:
+            result = left + right;
+            break;
+
+        case SUB:
+            result = left - right;
+            break;
 
-    case ADD:
-        result = m_left->calculate(ind) + m_right->calculate(ind);
-        break;
+        case MUL:
+            result = left * right;
+            break;
 
-    case SUB:
-        result = m_left->calculate(ind) - m_right->calculate(ind);
-        break;
+        case DIV:
+            result = left / right;
+            break;
 
-    case MUL:
-        result = m_left->calculate(ind) * m_right->calculate(ind);
-        break;
+        case EQ:
+            result = left == right;
+            break;
 
-    case DIV:
-        result = m_left->calculate(ind) / m_right->calculate(ind);
-        break;
+        case NE:
+            result = left != right;
+            break;
 
-    case EQ:
-        result = m_left->calculate(ind) == m_right->calculate(ind);
-        break;
+        case GT:
+            result = left > right;
+            break;
 
-    case NE:
-        result = m_left->calculate(ind) != m_right->calculate(ind);
-        break;
+        case LT:
+            result = left < right;
+            break;
 
-    case GT:
-        result = m_left->calculate(ind) > m_right->calculate(ind);
-        break;
+        case GE:
+            result = left >= right;
+            break;
 
-    case LT:
-        result = m_left->calculate(ind) < m_right->calculate(ind);
-        break;
+        case LE:
+            result = left <= right;
+            break;
 
-    case GE:
-        result = m_left->calculate(ind) >= m_right->calculate(ind);
-        break;
+        case AND:
+            result = IND_AND(left, right);
+            break;
 
-    case LE:
-        result = m_left->calculate(ind) <= m_right->calculate(ind);
-        break;
+        case OR:
+            result = IND_OR(left, right);
+            break;
 
-    case AND:
-        result = IND_AND(m_left->calculate(ind), m_right->calculate(ind));
-        break;
+        default:
+            break;
+        }
 
-    case OR:
-        result = IND_OR(m_left->calculate(ind), m_right->calculate(ind));
-        break;
+        if (source && result.getImp()) {
+            result.getImp()->setSource(source);
+            if (use_cache) {
+                IndicatorCache::put(*source, *result.getImp());
+            }
+        }
     }
 
     if (m_name != "")
         result.name(m_name);
 
+    ctx.save(key, result);
     return result;
 }
 
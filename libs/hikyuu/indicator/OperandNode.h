@@ -48,6 +48,22 @@ public:
 
     static string getOPTypeName(OPType);
 
+    /**
+     * 设置并行计算阈值，输入数据长度不小于该值时，二元运算的左右子树将在不同
+     * 线程中同时计算。默认为100000，设为Null<size_t>()时禁止并行计算。
+     */
+    static void setParallelThreshold(size_t threshold);
+
+    /** 获取并行计算阈值 */
+    static size_t getParallelThreshold();
+
+private:
+    struct CalculateContext;
+
+    Indicator _calculate(const Indicator&, CalculateContext&);
+    void _calculateChildren(const Indicator& ind, CalculateContext& ctx,
+            Indicator& left, Indicator& right);
+
 private:
     OPType m_optype;
     Indicator m_ind;
@@ -0,0 +1,53 @@
+/*
+ * Rolling.cpp
+ *
+ *  Created on: 2017年6月18日
+ *      Author: fasiondog
+ */
+
+#include "Rolling.h"
+
+namespace hku {
+
+RollingWindow::RollingWindow(size_t n, int stats)
+: m_n(n ? n : 1), m_stats(stats) {
+    if (m_stats & STAT_SUM) {
+        m_values.resize(m_n);
+    }
+    if (m_stats & STAT_MIN) {
+        m_min_queue.resize(m_n);
+    }
+    if (m_stats & STAT_MAX) {
+        m_max_queue.resize(m_n);
+    }
+    reset();
+}
+
+void RollingWindow::reset() {
+    m_pushed = 0;
+    m_slot = 0;
+    m_shift = 0.0;
+    m_sum = 0.0;
+    m_sumsq = 0.0;
+    m_min_head = 0;
+    m_min_size = 0;
+    m_max_head = 0;
+    m_max_size = 0;
+}
+
+EmaBank::EmaBank(): m_started(false) {
+
+}
+
+size_t EmaBank::add(price_t alpha) {
+    m_alpha.push_back(alpha);
+    m_value.push_back(0.0);
+    return m_alpha.size() - 1;
+}
+
+void EmaBank::reset() {
+    std::fill(m_value.begin(), m_value.end(), 0.0);
+    m_started = false;
+}
+
+} /* namespace hku */
@@ -0,0 +1,245 @@
+/*
+ * Rolling.h
+ *
+ *  Created on: 2017年6月18日
+ *      Author: fasiondog
+ */
+
+#ifndef INDICATOR_ROLLING_H_
+#define INDICATOR_ROLLING_H_
+
+#include <cmath>
+#include <algorithm>
+#include "../DataType.h"
+
+namespace hku {
+
+/**
+ * 固定窗口的单遍滚动统计
+ * @details 每次push一个新值，即可同时得到最近n个值的和、均值、样本方差、
+ *          最小值及最大值，每次push的开销与窗口长度无关。用于在一次遍历中
+ *          产生多个结果集的指标（如BOLL、KDJ），避免由MA、STDEV、HHV等
+ *          基础指标组合时对同一输入的重复遍历。
+ * <pre>
+ * RollingWindow win(n);
+ * for (size_t i = discard; i < total; ++i) {
+ *     win.push(data[i]);
+ *     if (win.full()) {
+ *         _set(win.mean(), i, 0);
+ *         _set(win.stdev(), i, 1);
+ *     }
+ * }
+ * </pre>
+ * @ingroup Indicator
+ */
+class HKU_API RollingWindow {
+public:
+    /** 需要计算的统计量 */
+    enum Stat {
+        STAT_SUM = 1, ///<和、均值及方差
+        STAT_MIN = 2, ///<最小值
+        STAT_MAX = 4, ///<最大值
+        STAT_ALL = 7
+    };
+
+    /**
+     * @param n 窗口长度，为0时视为1
+     * @param stats 需要计算的统计量，Stat的组合
+     */
+    explicit RollingWindow(size_t n, int stats = STAT_ALL);
+
+    /** 清除已加入的数据 */
+    void reset();
+
+    /** 加入新值，窗口已满时移出最早加入的值 */
+    void push(price_t val) {
+        if (m_stats & STAT_SUM) {
+            if (m_pushed == 0) {
+                m_shift = val;
+            }
+            price_t x = val - m_shift;
+            if (m_pushed >= m_n) {
+                price_t old = m_values[m_slot] - m_shift;
+                m_sum -= old;
+                m_sumsq -= old * old;
+            }
+            m_sum += x;
+            m_sumsq += x * x;
+            m_values[m_slot] = val;
+            if (++m_slot == m_n) {
+                m_slot = 0;
+            }
+        }
+
+        if (m_stats & STAT_MIN) {
+            _pushQueue(m_min_queue, m_min_head, m_min_size, val, false);
+        }
+        if (m_stats & STAT_MAX) {
+            _pushQueue(m_max_queue, m_max_head, m_max_size, val, true);
+        }
+        m_pushed++;
+    }
+
+    /** 窗口长度 */
+    size_t n() const {
+        return m_n;
+    }
+
+    /** 窗口内当前值的数量 */
+    size_t count() const {
+        return m_pushed < m_n ? m_pushed : m_n;
+    }
+
+    /** 窗口是否已满 */
+    bool full() const {
+        return m_pushed >= m_n;
+    }
+
+    /** 窗口内值的和 */
+    price_t sum() const {
+        return m_sum + m_shift * count();
+    }
+
+    /** 窗口内值的均值，窗口为空时返回Null */
+    price_t mean() const {
+        size_t c = count();
+        return c ? m_shift + m_sum / c : Null<price_t>();
+    }
+
+    /** 窗口内值的样本方差（除以count-1），数量小于2时返回0 */
+    price_t variance() const {
+        size_t c = count();
+        if (c < 2) {
+            return 0.0;
+        }
+        price_t var = (m_sumsq - m_sum * m_sum / c) / (c - 1);
+        return var > 0.0 ? var : 0.0;
+    }
+
+    /** 窗口内值的样本标准差 */
+    price_t stdev() const {
+        return std::sqrt(variance());
+    }
+
+    /** 窗口内的最小值，需指定STAT_MIN，窗口为空时返回Null */
+    price_t min() const {
+        return m_min_size ? m_min_queue[m_min_head].value : Null<price_t>();
+    }
+
+    /** 窗口内的最大值，需指定STAT_MAX，窗口为空时返回Null */
+    price_t max() const {
+        return m_max_size ? m_max_queue[m_max_head].value : Null<price_t>();
+    }
+
+private:
+    struct QueueItem {
+        size_t index;  //加入序号
+        price_t value;
+    };
+
+    /**
+     * 单调队列，队首为当前窗口的最值。
+     * 队列以长度为n的环形缓冲实现，无需动态分配。
+     */
+    void _pushQueue(vector<QueueItem>& queue, size_t& head, size_t& size,
+            price_t val, bool is_max) {
+        if (size && queue[head].index + m_n <= m_pushed) {
+            if (++head == m_n) {
+                head = 0;
+            }
+            size--;
+        }
+        while (size) {
+            size_t back = head + size - 1;
+            if (back >= m_n) {
+                back -= m_n;
+            }
+            price_t back_val = queue[back].value;
+            if (is_max ? back_val > val : back_val < val) {
+                break;
+            }
+            size--;
+        }
+        size_t tail = head + size;
+        if (tail >= m_n) {
+            tail -= m_n;
+        }
+        queue[tail].index = m_pushed;
+        queue[tail].value = val;
+        size++;
+    }
+
+private:
+    size_t m_n;
+    int m_stats;
+    size_t m_pushed;     //已加入值的总数
+    size_t m_slot;       //m_values中下一个值的写入位置
+    vector<price_t> m_values;   //环形缓冲，保存最近n个值，仅STAT_SUM时使用
+    price_t m_shift;     //以第一个值为偏移计算和与平方和，减少相消误差
+    price_t m_sum;
+    price_t m_sumsq;
+    vector<QueueItem> m_min_queue;
+    size_t m_min_head;
+    size_t m_min_size;
+    vector<QueueItem> m_max_queue;
+    size_t m_max_head;
+    size_t m_max_size;
+};
+
+/**
+ * 同一输入上的多个EMA，一次遍历同时更新所有EMA，计算方式与EMA指标相同，
+ * 第一个值作为所有EMA的初始值
+ * @ingroup Indicator
+ */
+class HKU_API EmaBank {
+public:
+    EmaBank();
+
+    /**
+     * 添加平滑系数为alpha的EMA
+     * @return 该EMA的序号
+     */
+    size_t add(price_t alpha);
+
+    /**
+     * 添加周期为n的EMA，平滑系数为2/(n+1)，同EMA指标
+     * @return 该EMA的序号
+     */
+    size_t addPeriod(int n) {
+        return add(2.0 / (n + 1));
+    }
+
+    /** EMA的数量 */
+    size_t size() const {
+        return m_alpha.size();
+    }
+
+    /** 清除已加入的数据，保留已添加的EMA */
+    void reset();
+
+    /** 加入新值，更新所有EMA */
+    void push(price_t val) {
+        if (!m_started) {
+            std::fill(m_value.begin(), m_value.end(), val);
+            m_started = true;
+            return;
+        }
+        for (size_t i = 0; i < m_value.size(); ++i) {
+            m_value[i] = (val - m_value[i]) * m_alpha[i] + m_value[i];
+        }
+    }
+
+    /** 第i个EMA的当前值，未做越界检查 */
+    price_t value(size_t i) const {
+        return m_value[i];
+    }
+
+private:
+    vector<price_t> m_alpha;
+    vector<price_t> m_value;
+    bool m_started;
+};
+
+} /* namespace hku */
+
+#endif /* INDICATOR_ROLLING_H_ */
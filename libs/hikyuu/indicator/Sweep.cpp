@@ -0,0 +1,261 @@
+/*
+ * Sweep.cpp
+ *
+ *  Created on: 2017年6月19日
+ *      Author: fasiondog
+ */
+
+#include <cmath>
+#include <algorithm>
+#include "../utilities/Parallel.h"
+#include "imp/Sma.h"
+#include "imp/Ema.h"
+#include "imp/Ama.h"
+#include "IndicatorKernel.h"
+#include "Rolling.h"
+#include "Sweep.h"
+
+namespace hku {
+
+namespace {
+
+/**
+ * 一次遍历计算多个参数组合的函数
+ * @param x 输入数据，discard之后不含Null值
+ * @param start 输入数据的discard
+ * @param imps 已设置好参数且check通过的指标实例
+ */
+typedef void (*sweep_func_t)(const PriceList& x, size_t start,
+        const vector<IndicatorImpPtr>& imps);
+
+//SMA：前缀和之差即为任意窗口的和
+void sweep_sma(const PriceList& x, size_t start,
+        const vector<IndicatorImpPtr>& imps) {
+    size_t total = x.size();
+    size_t len = total - start;
+
+    //以第一个值为偏移计算前缀和，减少相消误差
+    price_t shift = x[start];
+    PriceList prefix(len + 1);
+    prefix[0] = 0.0;
+    for (size_t i = 0; i < len; ++i) {
+        prefix[i + 1] = prefix[i] + (x[start + i] - shift);
+    }
+
+    for (size_t k = 0; k < imps.size(); ++k) {
+        IndicatorImp& imp = *imps[k];
+        size_t n = imp.getParam<int>("n");
+        imp._readyBuffer(total, 1);
+        price_storage_t *dst = imp._data(0) + start;
+        size_t first_end = n < len ? n : len;
+        for (size_t i = 0; i < first_end; ++i) {
+            dst[i] = ind_store(shift + prefix[i + 1] / (i + 1));
+        }
+        for (size_t i = first_end; i < len; ++i) {
+            dst[i] = ind_store(shift + (prefix[i + 1] - prefix[i + 1 - n]) / n);
+        }
+        imp.setDiscard(start);
+        imp._buildMask();
+    }
+}
+
+//EMA：每组平滑系数在同一个EmaBank中逐点更新。分组是为了限制同时写入的
+//结果缓存数量，参数组合较多时逐点写入全部缓存会导致频繁的TLB缺失
+#define SWEEP_EMA_GROUP 16
+
+void sweep_ema(const PriceList& x, size_t start,
+        const vector<IndicatorImpPtr>& imps) {
+    size_t total = x.size();
+    size_t count = imps.size();
+
+    for (size_t first = 0; first < count; first += SWEEP_EMA_GROUP) {
+        size_t last = first + SWEEP_EMA_GROUP < count
+                    ? first + SWEEP_EMA_GROUP : count;
+        size_t group = last - first;
+
+        EmaBank bank;
+        price_storage_t *dst[SWEEP_EMA_GROUP];
+        for (size_t k = 0; k < group; ++k) {
+            IndicatorImp& imp = *imps[first + k];
+            bank.addPeriod(imp.getParam<int>("n"));
+            imp._readyBuffer(total, 1);
+            dst[k] = imp._data(0);
+        }
+
+        for (size_t i = start; i < total; ++i) {
+            bank.push(x[i]);
+            for (size_t k = 0; k < group; ++k) {
+                dst[k][i] = ind_store(bank.value(k));
+            }
+        }
+
+        for (size_t k = 0; k < group; ++k) {
+            imps[first + k]->setDiscard(start);
+            imps[first + k]->_buildMask();
+        }
+    }
+}
+
+//AMA：各组合共享相邻差值的绝对值，波动总和的递推方式与Ama::_calculate
+//完全相同，保证结果一致
+void sweep_ama(const PriceList& x, size_t start,
+        const vector<IndicatorImpPtr>& imps) {
+    size_t total = x.size();
+    size_t len = total - start;
+    const price_t *val = &x[start];
+
+    //absdiff[i] = |val[i] - val[i-1]|
+    PriceList absdiff(len);
+    absdiff[0] = 0.0;
+    for (size_t i = 1; i < len; ++i) {
+        absdiff[i] = std::fabs(val[i] - val[i - 1]);
+    }
+
+    for (size_t k = 0; k < imps.size(); ++k) {
+        IndicatorImp& imp = *imps[k];
+        size_t n = imp.getParam<int>("n");
+        price_t fastest = 2.0 / (imp.getParam<int>("fast_n") + 1);
+        price_t slowest = 2.0 / (imp.getParam<int>("slow_n") + 1);
+        price_t delta = fastest - slowest;
+
+        imp._readyBuffer(total, 2);
+        price_storage_t *dst_ama = imp._data(0) + start;
+        price_storage_t *dst_er = imp._data(1) + start;
+
+        price_t prevol = 0.0, vol = 0.0, er = 1.0, c = 0.0;
+        price_t ama = val[0];
+        size_t first_end = n + 1 >= len ? len : n + 1;
+        dst_ama[0] = ind_store(ama);
+        dst_er[0] = ind_store(er);
+        for (size_t i = 1; i < first_end; ++i) {
+            vol += absdiff[i];
+            er = (vol == 0.0) ? 1.0 : (val[i] - val[0]) / vol;
+            if (er > 1.0) er = 1.0;
+            c = std::pow((std::fabs(er) * delta + slowest), 2);
+            ama += c * (val[i] - ama);
+            dst_ama[i] = ind_store(ama);
+            dst_er[i] = ind_store(er);
+        }
+
+        prevol = vol;
+        for (size_t i = first_end; i < len; ++i) {
+            vol = prevol + absdiff[i] - absdiff[i + 1 - n];
+            er = (vol == 0.0) ? 1.0 : (val[i] - val[i - n]) / vol;
+            if (er > 1.0) er = 1.0;
+            if (er < -1.0) er = -1.0;
+            c = std::pow((std::fabs(er) * delta + slowest), 2);
+            ama += c * (val[i] - ama);
+            prevol = vol;
+            dst_ama[i] = ind_store(ama);
+            dst_er[i] = ind_store(er);
+        }
+        imp.setDiscard(start);
+        imp._buildMask();
+    }
+}
+
+//参数网格仅包含names中的参数时，返回可一次遍历计算的函数
+sweep_func_t find_sweep_func(const IndicatorImpPtr& imp,
+        const ParamGrid& grid) {
+    sweep_func_t func = NULL;
+    StringList names;
+    if (dynamic_cast<Sma *>(imp.get())) {
+        func = sweep_sma;
+        names.push_back("n");
+    } else if (dynamic_cast<Ema *>(imp.get())) {
+        func = sweep_ema;
+        names.push_back("n");
+    } else if (dynamic_cast<Ama *>(imp.get())) {
+        func = sweep_ama;
+        names.push_back("n");
+        names.push_back("fast_n");
+        names.push_back("slow_n");
+    } else {
+        return NULL;
+    }
+
+    StringList grid_names = grid.getNameList();
+    for (size_t i = 0; i < grid_names.size(); ++i) {
+        if (std::find(names.begin(), names.end(), grid_names[i])
+                == names.end()) {
+            return NULL;
+        }
+    }
+    return func;
+}
+
+} /* namespace */
+
+
+IndicatorList HKU_API sweep(const Indicator& ind, const Indicator& data,
+        const ParamGrid& grid, size_t threads) {
+    IndicatorImpPtr tmpl = ind.getImp();
+    size_t count = grid.size();
+    if (!tmpl || count == 0) {
+        return IndicatorList();
+    }
+
+    vector<IndicatorImpPtr> imps(count);
+    for (size_t i = 0; i < count; ++i) {
+        Parameter param = tmpl->getParameter();
+        grid.apply(i, param);
+        imps[i] = tmpl->clone();
+        imps[i]->setParameter(param);
+    }
+
+    vector<size_t> pending; //需逐一计算的参数组合
+    sweep_func_t func = find_sweep_func(tmpl, grid);
+    size_t total = data.size();
+    size_t start = data.discard();
+
+    //输入数据只读取一次，含Null值时无法使用前缀和，改为逐一计算
+    PriceList x;
+    if (func && start < total) {
+        x.resize(total);
+        const price_storage_t *src = data.getImp()->data(0);
+        for (size_t i = start; i < total; ++i) {
+            x[i] = ind_load(src[i]);
+            if (x[i] == Null<price_t>()) {
+                func = NULL;
+                break;
+            }
+        }
+    } else {
+        func = NULL;
+    }
+
+    if (func) {
+        IndicatorSourcePtr src = data.getImp()->getSource();
+        vector<IndicatorImpPtr> batch;
+        for (size_t i = 0; i < count; ++i) {
+            if (!imps[i]->check()) {
+                pending.push_back(i);
+                continue;
+            }
+            batch.push_back(imps[i]);
+            if (src) {
+                imps[i]->setSource(IndicatorSourcePtr(new IndicatorSource(
+                        src->stock, src->query,
+                        imps[i]->long_name() + "(" + src->expression + ")")));
+            }
+        }
+        func(x, start, batch);
+
+    } else {
+        for (size_t i = 0; i < count; ++i) {
+            pending.push_back(i);
+        }
+    }
+
+    parallel_for(pending.size(), threads, [&](size_t i) {
+        imps[pending[i]]->calculate(data);
+    });
+
+    IndicatorList result(count);
+    for (size_t i = 0; i < count; ++i) {
+        result[i] = Indicator(imps[i]);
+    }
+    return result;
+}
+
+} /* namespace hku */
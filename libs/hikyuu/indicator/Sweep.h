@@ -0,0 +1,38 @@
+/*
+ * Sweep.h
+ *
+ *  Created on: 2017年6月19日
+ *      Author: fasiondog
+ */
+
+#ifndef INDICATOR_SWEEP_H_
+#define INDICATOR_SWEEP_H_
+
+#include "../utilities/ParamGrid.h"
+#include "Indicator.h"
+
+namespace hku {
+
+/**
+ * 使用参数网格中的每一组参数计算同一指标
+ * @details 对以下指标，在一次遍历中同时计算所有参数组合，输入数据只读取一次：
+ * <pre>
+ * SMA/MA   参数n：通过前缀和计算任意窗口长度的均值
+ * EMA      参数n：所有平滑系数在同一个EmaBank中逐点更新
+ * AMA      参数n、fast_n、slow_n：共享相邻差值的绝对值
+ * </pre>
+ *          其他指标按参数组合逐一计算，threads不为1时并行执行。
+ *          结果与逐一调用ind(data)相同（SMA的前缀和方式可能存在浮点舍入误差）。
+ * @param ind 指标模板，使用其类型及网格中未包含的参数
+ * @param data 待计算的数据
+ * @param grid 参数网格，参数类型须与指标中的同名参数一致，否则抛出异常
+ * @param threads 逐一计算时使用的线程数，为0时使用default_thread_count()
+ * @return 结果矩阵，与grid.get(i)一一对应，每个指标均带有各自的参数
+ * @ingroup Indicator
+ */
+IndicatorList HKU_API sweep(const Indicator& ind, const Indicator& data,
+        const ParamGrid& grid, size_t threads = 1);
+
+} /* namespace hku */
+
+#endif /* INDICATOR_SWEEP_H_ */
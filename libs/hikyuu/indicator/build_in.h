@@ -10,6 +10,11 @@
 
 #include "Operand.h"
 #include "Indicator.h"
+#include "IndicatorArena.h"
+#include "IndicatorCache.h"
+#include "Rolling.h"
+#include "Evaluate.h"
+#include "Sweep.h"
 #include "crt/IND_LOGIC.h"
 #include "crt/KDATA.h"
 #include "crt/PRICELIST.h"
@@ -20,6 +25,9 @@
 #include "crt/ATR.h"
 #include "crt/POS.h"
 #include "crt/MACD.h"
+#include "crt/BOLL.h"
+#include "crt/KDJ.h"
+#include "crt/RSI.h"
 #include "crt/VIGOR.h"
 #include "crt/SAFTYLOSS.h"
 #include "crt/DIFF.h"
@@ -29,5 +37,6 @@
 #include "crt/LLV.h"
 #include "crt/WEAVE.h"
 #include "crt/CVAL.h"
+#include "crt/TA_LIB.h"
 
 #endif /* INDICATOR_BUILD_IN_H_ */
@@ -0,0 +1,46 @@
+/*
+ * BOLL.h
+ *
+ *  Created on: 2017年6月18日
+ *      Author: fasiondog
+ */
+
+#ifndef INDICATOR_CRT_BOLL_H_
+#define INDICATOR_CRT_BOLL_H_
+
+#include "../Indicator.h"
+
+namespace hku {
+
+/**
+ * 布林带，一次遍历同时计算三个结果集，结果与 MA(n) ± p * STDEV(n) 相同
+ * @param n 计算均值及标准差的时间窗口，默认20
+ * @param p 标准差的倍数，默认2.0
+ * @return
+ * <pre>
+ * MID: 中轨，即n周期均值
+ * UPPER: 上轨，即中轨 + p倍n周期样本标准差
+ * LOWER: 下轨，即中轨 - p倍n周期样本标准差
+ * </pre>
+ * @ingroup Indicator
+ */
+Indicator HKU_API BOLL(int n = 20, double p = 2.0);
+
+/**
+ * 布林带，一次遍历同时计算三个结果集，结果与 MA(n) ± p * STDEV(n) 相同
+ * @param data 待计算数据
+ * @param n 计算均值及标准差的时间窗口，默认20
+ * @param p 标准差的倍数，默认2.0
+ * @return
+ * <pre>
+ * MID: 中轨，即n周期均值
+ * UPPER: 上轨，即中轨 + p倍n周期样本标准差
+ * LOWER: 下轨，即中轨 - p倍n周期样本标准差
+ * </pre>
+ * @ingroup Indicator
+ */
+Indicator HKU_API BOLL(const Indicator& data, int n = 20, double p = 2.0);
+
+} /* namespace */
+
+#endif /* INDICATOR_CRT_BOLL_H_ */
@@ -0,0 +1,46 @@
+/*
+ * KDJ.h
+ *
+ *  Created on: 2017年6月18日
+ *      Author: fasiondog
+ */
+
+#ifndef INDICATOR_CRT_KDJ_H_
+#define INDICATOR_CRT_KDJ_H_
+
+#include "../Indicator.h"
+
+namespace hku {
+
+/**
+ * KDJ随机指标
+ * @details RSV = (收盘价 - n周期最低价) / (n周期最高价 - n周期最低价) * 100，
+ *          最高价等于最低价时RSV取50；K、D以第一个值为初始值平滑。
+ *          输入为KDATA时使用其最高价、最低价及收盘价，否则均使用第一个结果集。
+ * @param n 计算RSV的时间窗口，默认9
+ * @param m1 K值的平滑周期，默认3
+ * @param m2 D值的平滑周期，默认3
+ * @return
+ * <pre>
+ * K: RSV的m1周期平滑，K = (m1-1)/m1 * 前K + 1/m1 * RSV
+ * D: K的m2周期平滑
+ * J: 3K - 2D
+ * </pre>
+ * @ingroup Indicator
+ */
+Indicator HKU_API KDJ(int n = 9, int m1 = 3, int m2 = 3);
+
+/**
+ * KDJ随机指标
+ * @param data 待计算数据，一般为KDATA
+ * @param n 计算RSV的时间窗口，默认9
+ * @param m1 K值的平滑周期，默认3
+ * @param m2 D值的平滑周期，默认3
+ * @see KDJ(int, int, int)
+ * @ingroup Indicator
+ */
+Indicator HKU_API KDJ(const Indicator& data, int n = 9, int m1 = 3, int m2 = 3);
+
+} /* namespace */
+
+#endif /* INDICATOR_CRT_KDJ_H_ */
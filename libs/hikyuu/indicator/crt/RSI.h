@@ -0,0 +1,36 @@
+/*
+ * RSI.h
+ *
+ *  Created on: 2017年6月18日
+ *      Author: fasiondog
+ */
+
+#ifndef INDICATOR_CRT_RSI_H_
+#define INDICATOR_CRT_RSI_H_
+
+#include "../Indicator.h"
+
+namespace hku {
+
+/**
+ * 相对强弱指标
+ * @details RSI = 涨幅的n周期平滑 / 涨跌幅绝对值的n周期平滑 * 100，
+ *          平滑方式为 Y = (n-1)/n * 前Y + 1/n * X，以第一个涨跌幅为初始值，
+ *          涨跌幅绝对值的平滑为0时取50
+ * @param n 平滑周期，默认14
+ * @ingroup Indicator
+ */
+Indicator HKU_API RSI(int n = 14);
+
+/**
+ * 相对强弱指标
+ * @param data 待计算数据
+ * @param n 平滑周期，默认14
+ * @see RSI(int)
+ * @ingroup Indicator
+ */
+Indicator HKU_API RSI(const Indicator& data, int n = 14);
+
+} /* namespace */
+
+#endif /* INDICATOR_CRT_RSI_H_ */
@@ -0,0 +1,40 @@
+/*
+ * TA_LIB.h
+ *
+ *  Created on: 2017年6月12日
+ *      Author: fasiondog
+ */
+
+#ifndef INDICATOR_CRT_TA_LIB_H_
+#define INDICATOR_CRT_TA_LIB_H_
+
+#include "../Indicator.h"
+
+#if HKU_SUPPORT_TA_LIB
+
+namespace hku {
+
+/**
+ * 直接调用TA-Lib中的指标函数，计算在C++中完成，无需经过Python复制数据
+ * @details 指标参数与TA-Lib函数的可选参数一致，参数名为去掉"optIn"前缀后的
+ *          小写形式（如 "timeperiod"、"fastk_period"），可通过setParam修改。
+ *          需要开、高、低、收、量的函数应以KDATA作为输入，其余函数依次使用
+ *          输入指标的各个结果集。
+ * @param func_name TA-Lib函数名，如 "SMA"、"BBANDS"，不存在时抛出std::invalid_argument
+ * @ingroup Indicator
+ */
+Indicator HKU_API TA_LIB(const string& func_name);
+
+/**
+ * 直接调用TA-Lib中的指标函数
+ * @param data 待计算的数据
+ * @param func_name TA-Lib函数名，如 "SMA"、"BBANDS"，不存在时抛出std::invalid_argument
+ * @ingroup Indicator
+ */
+Indicator HKU_API TA_LIB(const Indicator& data, const string& func_name);
+
+} /* namespace hku */
+
+#endif /* HKU_SUPPORT_TA_LIB */
+
+#endif /* INDICATOR_CRT_TA_LIB_H_ */
@@ -28,31 +28,38 @@
 
 #include "imp/Ama.h"
 #include "imp/Atr.h"
+#include "imp/Boll.h"
 #include "imp/Diff.h"
 #include "imp/Ema.h"
 #include "imp/HighLine.h"
 #include "imp/LowLine.h"
 #include "imp/IKData.h"
 #include "imp/IPriceList.h"
+#include "imp/Kdj.h"
 #include "imp/Sma.h"
 #include "imp/Macd.h"
 #include "imp/RightShift.h"
+#include "imp/Rsi.h"
 #include "imp/SaftyLoss.h"
 #include "imp/StdDeviation.h"
 #include "imp/Vigor.h"
 #include "imp/Weave.h"
 #include "imp/ConstantValue.h"
+#include "imp/TaLib.h"
 
 BOOST_CLASS_EXPORT(hku::Ama)
 BOOST_CLASS_EXPORT(hku::Atr)
+BOOST_CLASS_EXPORT(hku::Boll)
 BOOST_CLASS_EXPORT(hku::Diff)
 BOOST_CLASS_EXPORT(hku::Ema)
 BOOST_CLASS_EXPORT(hku::HighLine)
 BOOST_CLASS_EXPORT(hku::IKData)
 BOOST_CLASS_EXPORT(hku::IPriceList)
+BOOST_CLASS_EXPORT(hku::Kdj)
 BOOST_CLASS_EXPORT(hku::LowLine)
 BOOST_CLASS_EXPORT(hku::Macd)
 BOOST_CLASS_EXPORT(hku::RightShift)
+BOOST_CLASS_EXPORT(hku::Rsi)
 BOOST_CLASS_EXPORT(hku::SaftyLoss)
 BOOST_CLASS_EXPORT(hku::Sma)
 BOOST_CLASS_EXPORT(hku::StdDeviation)
@@ -60,5 +67,9 @@ BOOST_CLASS_EXPORT(hku::Vigor)
 BOOST_CLASS_EXPORT(hku::Weave)
 BOOST_CLASS_EXPORT(hku::ConstantValue)
 
+#if HKU_SUPPORT_TA_LIB
+BOOST_CLASS_EXPORT(hku::TaLib)
+#endif
+
 #endif /* HKU_SUPPORT_SERIALIZATION */
 
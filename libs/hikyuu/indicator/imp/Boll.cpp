@@ -0,0 +1,73 @@
+/*
+ * Boll.cpp
+ *
+ *  Created on: 2017年6月18日
+ *      Author: fasiondog
+ */
+
+#include "Boll.h"
+#include "../Rolling.h"
+
+namespace hku {
+
+Boll::Boll(): IndicatorImp("BOLL", 3) {
+    setParam<int>("n", 20);
+    setParam<double>("p", 2.0);
+}
+
+Boll::~Boll() {
+
+}
+
+bool Boll::check() {
+    if (getParam<int>("n") < 2) {
+        HKU_ERROR("Invalid param[n] ! (n >= 2) " << m_params
+                << " [Boll::check]");
+        return false;
+    }
+    return true;
+}
+
+void Boll::_calculate(const Indicator& data) {
+    size_t total = data.size();
+    int n = getParam<int>("n");
+    price_t p = getParam<double>("p");
+
+    m_discard = data.discard() + n - 1;
+    if (m_discard >= total) {
+        m_discard = total;
+        return;
+    }
+
+    //一次遍历同时得到均值及标准差
+    RollingWindow win(n, RollingWindow::STAT_SUM);
+    for (size_t i = data.discard(); i < m_discard; ++i) {
+        win.push(data[i]);
+    }
+
+    for (size_t i = m_discard; i < total; ++i) {
+        win.push(data[i]);
+        price_t mid = win.mean();
+        price_t width = p * win.stdev();
+        _set(mid, i, 0);
+        _set(mid + width, i, 1);
+        _set(mid - width, i, 2);
+    }
+}
+
+Indicator HKU_API BOLL(int n, double p) {
+    IndicatorImpPtr p_imp = make_shared<Boll>();
+    p_imp->setParam<int>("n", n);
+    p_imp->setParam<double>("p", p);
+    return Indicator(p_imp);
+}
+
+Indicator HKU_API BOLL(const Indicator& data, int n, double p) {
+    IndicatorImpPtr p_imp = make_shared<Boll>();
+    p_imp->setParam<int>("n", n);
+    p_imp->setParam<double>("p", p);
+    p_imp->calculate(data);
+    return Indicator(p_imp);
+}
+
+} /* namespace hku */
@@ -0,0 +1,34 @@
+/*
+ * Boll.h
+ *
+ *  Created on: 2017年6月18日
+ *      Author: fasiondog
+ */
+
+#ifndef INDICATOR_IMP_BOLL_H_
+#define INDICATOR_IMP_BOLL_H_
+
+#include "../Indicator.h"
+
+namespace hku {
+
+/*
+ * 布林带
+ * 参数： n: 计算均值及标准差的时间窗口
+ *       p: 标准差的倍数
+ * 返回：1)MID: 中轨，即n周期均值
+ *      2)UPPER: 上轨，即中轨 + p倍n周期样本标准差
+ *      3)LOWER: 下轨，即中轨 - p倍n周期样本标准差
+ */
+class Boll: public IndicatorImp {
+    INDICATOR_IMP(Boll)
+    INDICATOR_IMP_NO_PRIVATE_MEMBER_SERIALIZATION
+
+public:
+    Boll();
+    virtual ~Boll();
+};
+
+} /* namespace hku */
+
+#endif /* INDICATOR_IMP_BOLL_H_ */
@@ -78,6 +78,14 @@ IKData::IKData(const KData& kdata, const string& part)
         m_name = "Unknow";
         m_discard = total;
         HKU_INFO("Unkown ValueType of KData [IKData::IKData]");
+        return;
+    }
+
+    //作为指标结果缓存的计算起点
+    Stock stock = kdata.getStock();
+    if (!stock.isNull()) {
+        m_source = IndicatorSourcePtr(new IndicatorSource(stock,
+                kdata.getQuery(), m_name));
     }
 }
 
@@ -29,6 +29,7 @@ IPriceList::IPriceList(const PriceList& data, int in_discard) {
 
     //更新抛弃数量
     m_discard = discard;
+    _buildMask();
 }
 
 
@@ -58,6 +59,7 @@ IPriceList::IPriceList(price_t *data, size_t size): IndicatorImp("PRICELIST") {
     for (size_t i = 0; i < m_discard; ++i) {
         _set(null_price, i);
     }
+    _buildMask();
 }
 
 
@@ -0,0 +1,97 @@
+/*
+ * Kdj.cpp
+ *
+ *  Created on: 2017年6月18日
+ *      Author: fasiondog
+ */
+
+#include "Kdj.h"
+#include "../Rolling.h"
+#include "../IndicatorKernel.h"
+
+namespace hku {
+
+Kdj::Kdj(): IndicatorImp("KDJ", 3) {
+    setParam<int>("n", 9);
+    setParam<int>("m1", 3);
+    setParam<int>("m2", 3);
+}
+
+Kdj::~Kdj() {
+
+}
+
+bool Kdj::check() {
+    if (getParam<int>("n") < 1 || getParam<int>("m1") < 1
+            || getParam<int>("m2") < 1) {
+        HKU_ERROR("Invalid param! (n >= 1, m1 >= 1, m2 >= 1) " << m_params
+                << " [Kdj::check]");
+        return false;
+    }
+    return true;
+}
+
+void Kdj::_calculate(const Indicator& data) {
+    size_t total = data.size();
+    int n = getParam<int>("n");
+    int m1 = getParam<int>("m1");
+    int m2 = getParam<int>("m2");
+
+    m_discard = data.discard() + n - 1;
+    if (m_discard >= total) {
+        m_discard = total;
+        return;
+    }
+
+    //输入为KDATA时使用最高价、最低价及收盘价，否则三者均取第一个结果集
+    bool is_kdata = data.getResultNumber() >= 4;
+    IndicatorImpPtr src = data.getImp();
+    const price_storage_t *high = src->data(is_kdata ? 1 : 0);
+    const price_storage_t *low = src->data(is_kdata ? 2 : 0);
+    const price_storage_t *close = src->data(is_kdata ? 3 : 0);
+
+    RollingWindow high_win(n, RollingWindow::STAT_MAX);
+    RollingWindow low_win(n, RollingWindow::STAT_MIN);
+    EmaBank k_ema, d_ema;
+    k_ema.add(1.0 / m1);
+    d_ema.add(1.0 / m2);
+
+    for (size_t i = data.discard(); i < total; ++i) {
+        high_win.push(ind_load(high[i]));
+        low_win.push(ind_load(low[i]));
+        if (i < m_discard) {
+            continue;
+        }
+
+        price_t hh = high_win.max();
+        price_t ll = low_win.min();
+        price_t rsv = hh == ll ? 50.0
+                    : (ind_load(close[i]) - ll) / (hh - ll) * 100.0;
+        k_ema.push(rsv);
+        price_t k = k_ema.value(0);
+        d_ema.push(k);
+        price_t d = d_ema.value(0);
+        _set(k, i, 0);
+        _set(d, i, 1);
+        _set(3.0 * k - 2.0 * d, i, 2);
+    }
+}
+
+Indicator HKU_API KDJ(int n, int m1, int m2) {
+    IndicatorImpPtr p = make_shared<Kdj>();
+    p->setParam<int>("n", n);
+    p->setParam<int>("m1", m1);
+    p->setParam<int>("m2", m2);
+    return Indicator(p);
+}
+
+Indicator HKU_API KDJ(const Indicator& data, int n, int m1, int m2) {
+    IndicatorImpPtr p = make_shared<Kdj>();
+    p->setParam<int>("n", n);
+    p->setParam<int>("m1", m1);
+    p->setParam<int>("m2", m2);
+    p->calculate(data);
+    return Indicator(p);
+}
+
+} /* namespace hku */
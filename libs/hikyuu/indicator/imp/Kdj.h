@@ -0,0 +1,35 @@
+/*
+ * Kdj.h
+ *
+ *  Created on: 2017年6月18日
+ *      Author: fasiondog
+ */
+
+#ifndef INDICATOR_IMP_KDJ_H_
+#define INDICATOR_IMP_KDJ_H_
+
+#include "../Indicator.h"
+
+namespace hku {
+
+/*
+ * KDJ随机指标
+ * 参数： n: 计算RSV的时间窗口
+ *       m1: K值的平滑周期
+ *       m2: D值的平滑周期
+ * 返回：1)K: RSV的m1周期平滑，K = (m1-1)/m1 * 前K + 1/m1 * RSV
+ *      2)D: K的m2周期平滑
+ *      3)J: 3K - 2D
+ */
+class Kdj: public IndicatorImp {
+    INDICATOR_IMP(Kdj)
+    INDICATOR_IMP_NO_PRIVATE_MEMBER_SERIALIZATION
+
+public:
+    Kdj();
+    virtual ~Kdj();
+};
+
+} /* namespace hku */
+
+#endif /* INDICATOR_IMP_KDJ_H_ */
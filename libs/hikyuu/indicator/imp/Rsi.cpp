@@ -0,0 +1,70 @@
+/*
+ * Rsi.cpp
+ *
+ *  Created on: 2017年6月18日
+ *      Author: fasiondog
+ */
+
+#include "Rsi.h"
+#include "../Rolling.h"
+
+namespace hku {
+
+Rsi::Rsi(): IndicatorImp("RSI", 1) {
+    setParam<int>("n", 14);
+}
+
+Rsi::~Rsi() {
+
+}
+
+bool Rsi::check() {
+    if (getParam<int>("n") < 1) {
+        HKU_ERROR("Invalid param[n] ! (n >= 1) " << m_params
+                << " [Rsi::check]");
+        return false;
+    }
+    return true;
+}
+
+void Rsi::_calculate(const Indicator& data) {
+    size_t total = data.size();
+    int n = getParam<int>("n");
+
+    m_discard = data.discard() + 1;
+    if (m_discard >= total) {
+        m_discard = total;
+        return;
+    }
+
+    //平滑系数为1/n，即 Y = (n-1)/n * 前Y + 1/n * X
+    EmaBank up_ema, all_ema;
+    up_ema.add(1.0 / n);
+    all_ema.add(1.0 / n);
+
+    price_t pre = data[m_discard - 1];
+    for (size_t i = m_discard; i < total; ++i) {
+        price_t cur = data[i];
+        price_t diff = cur - pre;
+        pre = cur;
+        up_ema.push(diff > 0.0 ? diff : 0.0);
+        all_ema.push(std::fabs(diff));
+        price_t total_move = all_ema.value(0);
+        _set(total_move == 0.0 ? 50.0 : up_ema.value(0) / total_move * 100.0, i);
+    }
+}
+
+Indicator HKU_API RSI(int n) {
+    IndicatorImpPtr p = make_shared<Rsi>();
+    p->setParam<int>("n", n);
+    return Indicator(p);
+}
+
+Indicator HKU_API RSI(const Indicator& data, int n) {
+    IndicatorImpPtr p = make_shared<Rsi>();
+    p->setParam<int>("n", n);
+    p->calculate(data);
+    return Indicator(p);
+}
+
+} /* namespace hku */
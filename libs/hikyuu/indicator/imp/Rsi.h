@@ -0,0 +1,31 @@
+/*
+ * Rsi.h
+ *
+ *  Created on: 2017年6月18日
+ *      Author: fasiondog
+ */
+
+#ifndef INDICATOR_IMP_RSI_H_
+#define INDICATOR_IMP_RSI_H_
+
+#include "../Indicator.h"
+
+namespace hku {
+
+/*
+ * 相对强弱指标
+ * 参数： n: 平滑周期
+ * 返回：涨幅的n周期平滑 / 涨跌幅绝对值的n周期平滑 * 100
+ */
+class Rsi: public IndicatorImp {
+    INDICATOR_IMP(Rsi)
+    INDICATOR_IMP_NO_PRIVATE_MEMBER_SERIALIZATION
+
+public:
+    Rsi();
+    virtual ~Rsi();
+};
+
+} /* namespace hku */
+
+#endif /* INDICATOR_IMP_RSI_H_ */
@@ -0,0 +1,288 @@
+/*
+ * TaLib.cpp
+ *
+ *  Created on: 2017年6月12日
+ *      Author: fasiondog
+ */
+
+#include "TaLib.h"
+
+#if HKU_SUPPORT_TA_LIB
+
+#include <boost/algorithm/string.hpp>
+#include <boost/thread/once.hpp>
+#include <ta-lib/ta_libc.h>
+#include "../crt/TA_LIB.h"
+
+namespace hku {
+
+namespace {
+
+boost::once_flag g_ta_init_flag = BOOST_ONCE_INIT;
+
+void ta_initialize() {
+    TA_RetCode ret = TA_Initialize();
+    if (ret != TA_SUCCESS) {
+        HKU_ERROR("TA_Initialize failed! (" << ret << ") [TaLib]");
+    }
+}
+
+const TA_FuncHandle* ta_get_handle(const string& func_name) {
+    boost::call_once(ta_initialize, g_ta_init_flag);
+    const TA_FuncHandle *handle = NULL;
+    if (TA_GetFuncHandle(func_name.c_str(), &handle) != TA_SUCCESS) {
+        return NULL;
+    }
+    return handle;
+}
+
+/** "optInFastK_Period" -> "fastk_period" */
+string ta_param_name(const char *opt_name) {
+    string name(opt_name);
+    if (boost::starts_with(name, "optIn")) {
+        name = name.substr(5);
+    }
+    boost::to_lower(name);
+    return name;
+}
+
+/** 获取第num个结果集自discard开始的数据，浮点存储模式下需先复制为double */
+const TA_Real* ta_input(const IndicatorImpPtr& imp, size_t num,
+        size_t discard, size_t len, vector<PriceList>& copy) {
+#if HKU_USE_FLOAT32_STORAGE
+    const price_storage_t *src = imp->data(num) + discard;
+    copy.push_back(PriceList(src, src + len));
+    return &copy.back().front();
+#else
+    return imp->data(num) + discard;
+#endif
+}
+
+struct ParamHolderGuard {
+    ParamHolderGuard(): m_params(NULL) {}
+    ~ParamHolderGuard() {
+        if (m_params) {
+            TA_ParamHolderFree(m_params);
+        }
+    }
+    TA_ParamHolder *m_params;
+};
+
+} /* namespace */
+
+TaLib::TaLib(): IndicatorImp("TA_LIB", 1), m_handle(NULL) {
+
+}
+
+TaLib::TaLib(const string& func_name)
+: IndicatorImp("TA_" + boost::to_upper_copy(func_name), 1),
+  m_func_name(boost::to_upper_copy(func_name)), m_handle(NULL) {
+    _init();
+}
+
+TaLib::~TaLib() {
+
+}
+
+void TaLib::_init() {
+    const TA_FuncHandle *handle = ta_get_handle(m_func_name);
+    m_handle = handle;
+    if (!handle) {
+        return;
+    }
+
+    const TA_FuncInfo *info = NULL;
+    TA_GetFuncInfo(handle, &info);
+    m_result_num = info->nbOutput;
+
+    for (unsigned int i = 0; i < info->nbOptInput; ++i) {
+        const TA_OptInputParameterInfo *opt = NULL;
+        TA_GetOptInputParameterInfo(handle, i, &opt);
+        string name = ta_param_name(opt->paramName);
+        if (opt->type == TA_OptInput_IntegerRange
+                || opt->type == TA_OptInput_IntegerList) {
+            setParam<int>(name, int(opt->defaultValue));
+        } else {
+            setParam<double>(name, opt->defaultValue);
+        }
+    }
+}
+
+bool TaLib::check() {
+    if (!m_handle && !m_func_name.empty()) {
+        m_handle = ta_get_handle(m_func_name);
+    }
+    return m_handle != NULL;
+}
+
+IndicatorImpPtr TaLib::operator()(const Indicator& ind) {
+    IndicatorImpPtr p(new TaLib(m_func_name));
+    p->setParameter(m_params);
+    p->calculate(ind);
+    return p;
+}
+
+void TaLib::_calculate(const Indicator& data) {
+    const TA_FuncHandle *handle = (const TA_FuncHandle *)m_handle;
+    const TA_FuncInfo *info = NULL;
+    TA_GetFuncInfo(handle, &info);
+
+    size_t total = data.size();
+    m_discard = data.discard();
+    if (total <= m_discard) {
+        m_discard = total;
+        return;
+    }
+
+    IndicatorImpPtr data_imp = data.getImp();
+    size_t data_result_num = data.getResultNumber();
+    size_t len = total - m_discard;
+    vector<PriceList> input_copy;
+    input_copy.reserve(info->nbInput * 5); //避免扩容导致已取得的指针失效
+    size_t next_result = 0;
+    bool is_kdata = data_result_num >= 6;
+
+    ParamHolderGuard holder;
+    if (TA_ParamHolderAlloc(handle, &holder.m_params) != TA_SUCCESS) {
+        HKU_ERROR("TA_ParamHolderAlloc failed! [TaLib::_calculate] "
+                << m_func_name);
+        return;
+    }
+
+    for (unsigned int i = 0; i < info->nbInput; ++i) {
+        const TA_InputParameterInfo *in = NULL;
+        TA_GetInputParameterInfo(handle, i, &in);
+        if (in->type == TA_Input_Price) {
+            //KDATA结果集依次为: 开、高、低、收、成交金额、成交量
+            static const TA_InputFlags flags[5] = {TA_IN_PRICE_OPEN,
+                TA_IN_PRICE_HIGH, TA_IN_PRICE_LOW, TA_IN_PRICE_CLOSE,
+                TA_IN_PRICE_VOLUME};
+            static const size_t kdata_pos[5] = {0, 1, 2, 3, 5};
+            const TA_Real *ptr[5] = {NULL, NULL, NULL, NULL, NULL};
+            for (size_t j = 0; j < 5; ++j) {
+                if (!(in->flags & flags[j])) {
+                    continue;
+                }
+                size_t num = is_kdata ? kdata_pos[j] : next_result++;
+                if (num >= data_result_num) {
+                    HKU_ERROR("Input indicator result number is not enough! "
+                            "[TaLib::_calculate] " << m_func_name);
+                    m_discard = total;
+                    return;
+                }
+                ptr[j] = ta_input(data_imp, num, m_discard, len,
+                                          input_copy);
+            }
+            TA_SetInputParamPricePtr(holder.m_params, i, ptr[0], ptr[1],
+                                     ptr[2], ptr[3], ptr[4], NULL);
+
+        } else if (in->type == TA_Input_Real) {
+            size_t num = next_result++;
+            if (num >= data_result_num) {
+                HKU_ERROR("Input indicator result number is not enough! "
+                        "[TaLib::_calculate] " << m_func_name);
+                m_discard = total;
+                return;
+            }
+            TA_SetInputParamRealPtr(holder.m_params, i,
+                    ta_input(data_imp, num, m_discard, len,
+                                     input_copy));
+
+        } else {
+            HKU_ERROR("Unsupported TA-Lib input type! [TaLib::_calculate] "
+                    << m_func_name);
+            m_discard = total;
+            return;
+        }
+    }
+
+    for (unsigned int i = 0; i < info->nbOptInput; ++i) {
+        const TA_OptInputParameterInfo *opt = NULL;
+        TA_GetOptInputParameterInfo(handle, i, &opt);
+        string name = ta_param_name(opt->paramName);
+        if (opt->type == TA_OptInput_IntegerRange
+                || opt->type == TA_OptInput_IntegerList) {
+            TA_SetOptInputParamInteger(holder.m_params, i,
+                                       getParam<int>(name));
+        } else {
+            TA_SetOptInputParamReal(holder.m_params, i,
+                                    getParam<double>(name));
+        }
+    }
+
+    TA_Integer lookback = 0;
+    if (TA_GetLookback(holder.m_params, &lookback) != TA_SUCCESS
+            || lookback < 0 || size_t(lookback) >= len) {
+        m_discard = total;
+        return;
+    }
+
+    //输出直接写入结果缓存中从m_discard + lookback开始的位置
+    size_t out_start = m_discard + lookback;
+    size_t out_len = total - out_start;
+    vector<vector<TA_Integer> > int_outputs(info->nbOutput);
+    vector<PriceList> real_outputs(info->nbOutput);
+    for (unsigned int i = 0; i < info->nbOutput; ++i) {
+        const TA_OutputParameterInfo *out = NULL;
+        TA_GetOutputParameterInfo(handle, i, &out);
+        if (out->type == TA_Output_Integer) {
+            int_outputs[i].resize(out_len);
+            TA_SetOutputParamIntegerPtr(holder.m_params, i,
+                                        &int_outputs[i].front());
+        } else {
+#if HKU_USE_FLOAT32_STORAGE
+            real_outputs[i].resize(out_len);
+            TA_SetOutputParamRealPtr(holder.m_params, i,
+                                     &real_outputs[i].front());
+#else
+            TA_SetOutputParamRealPtr(holder.m_params, i,
+                                     m_data + i * m_size + out_start);
+#endif
+        }
+    }
+
+    TA_Integer out_beg = 0, out_num = 0;
+    TA_RetCode ret = TA_CallFunc(holder.m_params, 0, TA_Integer(len - 1),
+                                 &out_beg, &out_num);
+    if (ret != TA_SUCCESS) {
+        HKU_ERROR("TA_CallFunc failed! (" << ret << ") [TaLib::_calculate] "
+                << m_func_name);
+        _readyBuffer(total, m_result_num);
+        m_discard = total;
+        return;
+    }
+
+    for (unsigned int i = 0; i < info->nbOutput; ++i) {
+        if (!int_outputs[i].empty()) {
+            for (TA_Integer j = 0; j < out_num; ++j) {
+                _set(int_outputs[i][j], out_start + j, i);
+            }
+        } else if (!real_outputs[i].empty()) {
+            for (TA_Integer j = 0; j < out_num; ++j) {
+                _set(real_outputs[i][j], out_start + j, i);
+            }
+        }
+    }
+
+    m_discard = out_start;
+}
+
+
+Indicator HKU_API TA_LIB(const string& func_name) {
+    IndicatorImpPtr p(new TaLib(func_name));
+    if (!p->check()) {
+        throw std::invalid_argument("Can't find TA-Lib function: "
+                + func_name + " [TA_LIB]");
+    }
+    return Indicator(p);
+}
+
+Indicator HKU_API TA_LIB(const Indicator& data, const string& func_name) {
+    Indicator result = TA_LIB(func_name);
+    result.getImp()->calculate(data);
+    return result;
+}
+
+} /* namespace hku */
+
+#endif /* HKU_SUPPORT_TA_LIB */
@@ -0,0 +1,73 @@
+/*
+ * TaLib.h
+ *
+ *  Created on: 2017年6月12日
+ *      Author: fasiondog
+ */
+
+#ifndef INDICATOR_IMP_TALIB_H_
+#define INDICATOR_IMP_TALIB_H_
+
+#include "../Indicator.h"
+
+#if HKU_SUPPORT_TA_LIB
+
+namespace hku {
+
+/*
+ * 通过TA-Lib抽象接口直接在指标结果缓存上计算TA-Lib中的指标
+ * 参数：与TA-Lib函数的可选参数一致，名称为去掉"optIn"前缀后的小写形式，
+ *      如 SMA 的 "timeperiod"，默认值取自TA-Lib
+ * 输入：Price类型的输入从KDATA中按开、高、低、收、量取值，其余输入依次
+ *      取输入指标的第0、1、...个结果集
+ * 返回：与TA-Lib函数的输出一致
+ */
+class TaLib: public IndicatorImp {
+public:
+    TaLib();
+    TaLib(const string& func_name);
+    virtual ~TaLib();
+
+    const string& getFuncName() const {
+        return m_func_name;
+    }
+
+    virtual bool check();
+    virtual void _calculate(const Indicator& data);
+    virtual IndicatorImpPtr operator()(const Indicator& ind);
+    virtual IndicatorImpPtr _clone() {
+        return IndicatorImpPtr(new TaLib(m_func_name));
+    }
+
+private:
+    void _init();
+
+private:
+    string m_func_name;
+    const void *m_handle;  //TA_FuncHandle，无效时为NULL
+
+#if HKU_SUPPORT_SERIALIZATION
+private:
+    friend class boost::serialization::access;
+    template<class Archive>
+    void save(Archive & ar, const unsigned int version) const {
+        ar & BOOST_SERIALIZATION_BASE_OBJECT_NVP(IndicatorImp);
+        ar & BOOST_SERIALIZATION_NVP(m_func_name);
+    }
+
+    template<class Archive>
+    void load(Archive & ar, const unsigned int version) {
+        ar & BOOST_SERIALIZATION_BASE_OBJECT_NVP(IndicatorImp);
+        ar & BOOST_SERIALIZATION_NVP(m_func_name);
+        m_handle = NULL;
+    }
+
+    BOOST_SERIALIZATION_SPLIT_MEMBER()
+#endif
+};
+
+} /* namespace hku */
+
+#endif /* HKU_SUPPORT_TA_LIB */
+
+#endif /* INDICATOR_IMP_TALIB_H_ */
@@ -33,23 +33,29 @@ void Weave::_calculate(const Indicator& ind) {
     }
 
     size_t old_m_result_num = m_result_num;
-    m_result_num = ind.getResultNumber() + m_result_num;
-    if (m_result_num > MAX_RESULT_NUM) {
+    size_t result_num = ind.getResultNumber() + m_result_num;
+    if (result_num > MAX_RESULT_NUM) {
         HKU_WARN("Weave only can contains " << MAX_RESULT_NUM <<
                  "reult_num! [Weave::_calculate]");
-        m_result_num = MAX_RESULT_NUM;
+        result_num = MAX_RESULT_NUM;
+    }
+
+    if (old_m_result_num == 0) {
+        _readyBuffer(total, result_num);
+    } else {
+        _resizeResultNum(result_num);
     }
 
     if (m_discard < ind.discard()) {
         m_discard = ind.discard();
     }
 
-    price_t null_price = Null<price_t>();
+    //结果集连续存放，按结果集整段复制
+    IndicatorImpPtr src = ind.getImp();
     for (size_t i = old_m_result_num; i < m_result_num; ++i) {
-        m_pBuffer[i] = new PriceList(total, null_price);
-        for (size_t j = m_discard; j < total; ++j) {
-            (*m_pBuffer[i])[j] = ind.get(j, i-old_m_result_num);
-        }
+        const price_storage_t *src_data = src->data(i - old_m_result_num);
+        std::copy(src_data + m_discard, src_data + total,
+                  _data(i) + m_discard);
     }
 }
 
@@ -63,9 +69,8 @@ IndicatorImpPtr Weave::operator()(const Indicator& ind) {
         p->_readyBuffer(self_size, m_result_num);
         if (self_size != 0) {
             for (size_t i = 0; i < m_result_num; ++i) {
-                for (size_t j = m_discard; j < self_size; ++j) {
-                    p->_set(get(j,i), j, i);
-                }
+                std::copy(data(i) + m_discard, data(i) + self_size,
+                          p->_data(i) + m_discard);
             }
         }
     }
@@ -22,6 +22,9 @@ public:
     virtual bool check();
     virtual void _calculate(const Indicator& data);
     virtual IndicatorImpPtr operator()(const Indicator& ind);
+    virtual IndicatorImpPtr _clone() {
+        return IndicatorImpPtr(new Weave());
+    }
 };
 
 } /* namespace hku */
@@ -0,0 +1,66 @@
+/*
+ * KDataFlags_serialization.h
+ *
+ *  Created on: 2017年6月21日
+ *      Author: fasiondog
+ */
+
+#ifndef KDATAFLAGS_SERIALIZATION_H_
+#define KDATAFLAGS_SERIALIZATION_H_
+
+#include "../config.h"
+#include "../KDataFlags.h"
+
+#if HKU_SUPPORT_SERIALIZATION
+#include <set>
+#include <boost/serialization/set.hpp>
+#include "Datetime_serialization.h"
+#include "KData_serialization.h"
+
+namespace boost {
+namespace serialization {
+template<class Archive>
+void save(Archive & ar, const hku::KDataFlags& flags, unsigned int version) {
+    hku::KData kdata = flags.getKData();
+    hku::DatetimeList datetime_list = flags.getDatetimeList();
+    ar & BOOST_SERIALIZATION_NVP(kdata);
+    ar & BOOST_SERIALIZATION_NVP(datetime_list);
+}
+
+template<class Archive>
+void load(Archive & ar, hku::KDataFlags& flags, unsigned int version) {
+    hku::KData kdata;
+    hku::DatetimeList datetime_list;
+    ar & BOOST_SERIALIZATION_NVP(kdata);
+    ar & BOOST_SERIALIZATION_NVP(datetime_list);
+    //按重新加载的K线数据对齐
+    flags.setKData(kdata);
+    for (size_t i = 0; i < datetime_list.size(); ++i) {
+        flags.set(datetime_list[i]);
+    }
+}
+}} /* namespace boost::serailization */
+
+BOOST_SERIALIZATION_SPLIT_FREE(hku::KDataFlags)
+
+namespace hku {
+
+/**
+ * 读取旧版本中以std::set<Datetime>保存的日期集合，全部按日期加入flags，
+ * 供SignalBase、ConditionBase、EnvironmentBase加载版本0的数据使用
+ */
+template<class Archive>
+void load_datetime_set(Archive & ar, const char *name, KDataFlags& flags) {
+    std::set<Datetime> datetime_set;
+    ar & boost::serialization::make_nvp(name, datetime_set);
+    std::set<Datetime>::const_iterator iter = datetime_set.begin();
+    for (; iter != datetime_set.end(); ++iter) {
+        flags.set(*iter);
+    }
+}
+
+} /* namespace hku */
+
+#endif /* HKU_SUPPORT_SERIALIZATION */
+
+#endif /* KDATAFLAGS_SERIALIZATION_H_ */
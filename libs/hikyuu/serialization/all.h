@@ -10,6 +10,7 @@
 
 #include "Datetime_serialization.h"
 #include "KData_serialization.h"
+#include "KDataFlags_serialization.h"
 #include "KQuery_serialization.h"
 #include "KRecord_serialization.h"
 #include "MarketInfo_serialization.h"
@@ -66,6 +66,12 @@ private:
 };
 
 
+/**
+ * 资产情况记录列表
+ * @ingroup TradeManagerClass
+ */
+typedef vector<FundsRecord> FundsList;
+
 /**
  * 输出TradeRecord信息
  * @ingroup TradeManagerClass
@@ -88,6 +88,10 @@ double Performance::get(const string& name) const {
     return Null<double>();
 }
 
+StringList Performance::names() const {
+    return StringList(m_name_list.begin(), m_name_list.end());
+}
+
 string Performance::report(const TradeManagerPtr& tm, const Datetime& datetime) {
     std::stringstream buf;
     if (!tm) {
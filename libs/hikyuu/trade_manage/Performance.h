@@ -26,6 +26,9 @@ public:
     double get(const string& name) const;
     double operator[](const string& name) const { return get(name); }
 
+    /** 获取所有统计项名称，顺序与report相同 */
+    StringList names() const;
+
     string report(const TradeManagerPtr& tm,
             const Datetime& datetime = Datetime::now());
 
@@ -43,5 +46,7 @@ private:
     map_type m_result;
 };
 
+typedef vector<Performance> PerformanceList;
+
 } /* namespace hku */
 #endif /* PERFORMANCE_H_ */
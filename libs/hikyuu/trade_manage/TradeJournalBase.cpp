@@ -0,0 +1,34 @@
+/*
+ * TradeJournalBase.cpp
+ *
+ *  Created on: 2017年6月22日
+ *      Author: fasiondog
+ */
+
+#include "TradeJournalBase.h"
+
+namespace hku {
+
+TradeJournalBase::TradeJournalBase(): m_name("TradeJournalBase") {
+
+}
+
+TradeJournalBase::TradeJournalBase(const string& name): m_name(name) {
+
+}
+
+TradeJournalBase::~TradeJournalBase() {
+
+}
+
+void TradeJournalBase::write(const TradeRecord& record) {
+    try {
+        _write(record);
+    } catch (std::exception& e) {
+        HKU_ERROR(e.what() << " [TradeJournalBase::write] " << m_name);
+    } catch (...) {
+        HKU_ERROR("Unknow error! [TradeJournalBase::write] " << m_name);
+    }
+}
+
+} /* namespace hku */
@@ -0,0 +1,59 @@
+/*
+ * TradeJournalBase.h
+ *
+ *  Created on: 2017年6月22日
+ *      Author: fasiondog
+ */
+
+#ifndef TRADE_MANAGE_TRADEJOURNALBASE_H_
+#define TRADE_MANAGE_TRADEJOURNALBASE_H_
+
+#include "TradeRecord.h"
+
+namespace hku {
+
+/**
+ * 交易流水基类，在交易记录产生时逐条写出至外部存储，不在内存中累积
+ * @details 通过TradeManager::regJournal注册后，账户的每一条交易记录（包括
+ *          建立账户、权息、融资融券等记录）都会按产生的顺序写入
+ * @ingroup TradeManagerClass
+ */
+class HKU_API TradeJournalBase {
+public:
+    TradeJournalBase();
+    TradeJournalBase(const string& name);
+    virtual ~TradeJournalBase();
+
+    /** 流水名称 */
+    const string& name() const {
+        return m_name;
+    }
+
+    /**
+     * 写入一条交易记录，由TradeManager在交易记录产生时调用
+     * @note 写入失败时只记录错误日志，不影响交易操作
+     */
+    void write(const TradeRecord& record);
+
+    /** 将缓冲中的记录写出至存储介质 */
+    virtual void flush() {}
+
+    /**
+     * 子类实际写入交易记录的接口
+     * @param record 交易记录
+     */
+    virtual void _write(const TradeRecord& record) = 0;
+
+private:
+    string m_name;
+};
+
+/**
+ * 客户程序应使用此类型进行实际操作
+ * @ingroup TradeManagerClass
+ */
+typedef shared_ptr<TradeJournalBase> TradeJournalPtr;
+
+} /* namespace hku */
+
+#endif /* TRADE_MANAGE_TRADEJOURNALBASE_H_ */
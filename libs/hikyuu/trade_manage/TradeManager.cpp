@@ -149,7 +149,7 @@ TradeManager::TradeManager(const Datetime& datetime, price_t initcash,
         const TradeCostPtr& costfunc, const string& name)
 : m_name(name), m_init_datetime(datetime), m_costfunc(costfunc),
   m_checkout_cash(0.0), m_checkin_stock(0.0), m_checkout_stock(0.0),
-  m_borrow_cash(0.0) {
+  m_borrow_cash(0.0), m_reset_count(0) {
     setParam<bool>("reinvest", false);  //红利是否再投资
     setParam<int>("precision", 2);      //计算精度
     setParam<bool>("support_borrow_cash", false);   //是否自动融资
@@ -158,10 +158,11 @@ TradeManager::TradeManager(const Datetime& datetime, price_t initcash,
     m_init_cash = roundEx(initcash, 2);
     m_cash = m_init_cash;
     m_checkin_cash = m_init_cash;
-    m_trade_list.push_back(TradeRecord(Null<Stock>(), m_init_datetime,
+    _addTradeRecord(TradeRecord(Null<Stock>(), m_init_datetime,
             BUSINESS_INIT, m_init_cash, m_init_cash, 0.0, 0,
             CostRecord(), 0.0,  m_cash, PART_INVALID));
     m_broker_last_datetime = Datetime::now();
+    m_weight_datetime = Datetime::min();
     _saveAction(m_trade_list.back());
 }
 
@@ -183,15 +184,18 @@ void TradeManager::reset() {
     m_borrow_stock.clear();
 
     m_trade_list.clear();
-    m_trade_list.push_back(TradeRecord(Null<Stock>(), m_init_datetime,
+    _addTradeRecord(TradeRecord(Null<Stock>(), m_init_datetime,
             BUSINESS_INIT, m_init_cash, m_init_cash, 0.0, 0, CostRecord(),
             0.0,  m_cash,  PART_INVALID));
 
     m_position.clear();
     m_position_history.clear();
+    m_snapshots.clear();
+    m_weight_datetime = Datetime::min();
     //m_broker_list
     //m_broker_last_datetime = Datetime::now();
     m_actions.clear();
+    m_reset_count++;
 }
 
 
@@ -212,7 +216,9 @@ TradeManagerPtr TradeManager::clone() {
     p->m_loan_list = m_loan_list;
     p->m_borrow_stock = m_borrow_stock;
     p->m_trade_list = m_trade_list;
+    p->m_snapshots = m_snapshots;
     p->m_position = m_position;
+    p->m_weight_datetime = m_weight_datetime;
     p->m_position_history = m_position_history;
     p->m_broker_list = m_broker_list;
     p->m_broker_last_datetime = m_broker_last_datetime;
@@ -228,182 +234,64 @@ void TradeManager::clearBroker() {
     m_broker_list.clear();
 }
 
-double TradeManager::getMarginRate(const Datetime& datetime, const Stock& stock) {
-    //TODO 获取保证金比率，默认固定取60%
-    return 0.6;
-}
-
-
-Datetime TradeManager::firstDatetime() const {
-    Datetime result;
-    TradeRecordList::const_iterator iter = m_trade_list.begin();
-    for(; iter != m_trade_list.end(); iter++){
-        if( iter->business == BUSINESS_BUY ){
-            result = iter->datetime;
-            break;
-        }
-    }
-    return result;
-}
-
-
-size_t TradeManager
-::getHoldNumber(const Datetime& datetime, const Stock& stock) {
-    //日期小于账户建立日期，返回0
-    if( datetime < m_init_datetime ){
-        return 0;
-    }
-
-    //根据权息信息调整持仓数量
-    _update(datetime);
 
-    //如果指定的日期大于等于最后交易日期，则直接取当前持仓记录
-    if (datetime >= lastDatetime()) {
-        position_map_type::const_iterator pos_iter = m_position.find(stock.id());
-        if (pos_iter != m_position.end()) {
-            return pos_iter->second.number;
-        }
-        return 0;
+void TradeManager::regJournal(const TradeJournalPtr& journal) {
+    if (!journal) {
+        HKU_WARN("journal is null! [TradeManager::regJournal]");
+        return;
     }
 
-    //在历史交易记录中，重新计算在指定的查询日期时，该交易对象的持仓数量
-    size_t number = 0;
+    //先写入已有的交易记录，使流水从建立账户的记录开始
     TradeRecordList::const_iterator iter = m_trade_list.begin();
-    for(; iter != m_trade_list.end(); iter++){
-        //交易记录中的交易日期已经大于查询日期，则跳出循环
-        if( iter->datetime > datetime ){
-            break;
-        }
-
-        if( iter->stock == stock ){
-            if (BUSINESS_BUY == iter->business
-                    || BUSINESS_GIFT == iter->business
-                    || BUSINESS_CHECKIN_STOCK == iter->business) {
-                number += iter->number;
-
-            } else if (BUSINESS_SELL == iter->business
-                    || BUSINESS_CHECKOUT_STOCK == iter->business) {
-                number -= iter->number;
-
-            } else {
-                //其他情况忽略
-            }
-        }
-    }
-    return number;
-}
-
-
-size_t TradeManager
-::getShortHoldNumber(const Datetime& datetime, const Stock& stock) {
-    //日期小于账户建立日期，返回0
-    if( datetime < m_init_datetime ){
-        return 0;
-    }
-
-    //根据权息信息调整持仓数量
-    _update(datetime);
-
-    //如果指定的日期大于等于最后交易日期，则直接取当前持仓记录
-    if (datetime >= lastDatetime()) {
-        position_map_type::const_iterator pos_iter = m_short_position.find(stock.id());
-        if (pos_iter != m_short_position.end()) {
-            return pos_iter->second.number;
-        }
-        return 0;
+    for (; iter != m_trade_list.end(); ++iter) {
+        journal->write(*iter);
     }
+    m_journal_list.push_back(journal);
 
-    //在历史交易记录中，重新计算在指定的查询日期时，该交易对象的持仓数量
-    size_t number = 0;
-    TradeRecordList::const_iterator iter = m_trade_list.begin();
-    for(; iter != m_trade_list.end(); iter++){
-        //交易记录中的交易日期已经大于查询日期，则跳出循环
-        if( iter->datetime > datetime ){
-            break;
-        }
-
-        if( iter->stock == stock ){
-            if (BUSINESS_SELL_SHORT == iter->business) {
-                number += iter->number;
-
-            } else if (BUSINESS_BUY_SHORT == iter->business) {
-                number -= iter->number;
-
-            } else {
-                //其他情况忽略
-            }
-        }
-    }
-    return number;
+    //交易记录已全部由流水保存，不再需要内存中的交易动作
+    m_actions.clear();
 }
 
 
-size_t TradeManager
-::getDebtNumber(const Datetime& datetime, const Stock& stock) {
-    if (datetime < m_init_datetime) {
-        return 0;
-    }
-
-    //根据权息信息调整持仓数量
-    _update(datetime);
-
-    if (datetime >= lastDatetime()) {
-        borrow_stock_map_type::const_iterator bor_iter;
-        bor_iter = m_borrow_stock.find(stock.id());
-        if (bor_iter != m_borrow_stock.end()) {
-            return bor_iter->second.number;
-        }
-        return 0;
+void TradeManager::clearJournal() {
+    list<TradeJournalPtr>::const_iterator iter = m_journal_list.begin();
+    for (; iter != m_journal_list.end(); ++iter) {
+        (*iter)->flush();
     }
-
-    size_t debt_n = 0;
-    TradeRecordList::const_iterator iter = m_trade_list.begin();
-    for (; iter != m_trade_list.end(); ++iter) {
-        if (iter->datetime > datetime) {
-            break;
-        }
-        if (iter->stock == stock) {
-            if (iter->business == BUSINESS_BORROW_STOCK) {
-                debt_n += iter->number;
-            } else if (iter->business == BUSINESS_RETURN_STOCK) {
-                debt_n -= iter->number;
-            }
-        }
-    }
-    return debt_n;
+    m_journal_list.clear();
 }
 
 
-price_t TradeManager::getDebtCash(const Datetime& datetime) {
-    if (datetime < m_init_datetime) {
-        return 0.0;
+void TradeManager::_addTradeRecord(const TradeRecord& record) {
+    m_trade_list.push_back(record);
+    list<TradeJournalPtr>::const_iterator iter = m_journal_list.begin();
+    for (; iter != m_journal_list.end(); ++iter) {
+        (*iter)->write(record);
     }
+}
 
-    //根据权息信息调整持仓数量
-    _update(datetime);
+double TradeManager::getMarginRate(const Datetime& datetime, const Stock& stock) {
+    //TODO 获取保证金比率，默认固定取60%
+    return 0.6;
+}
 
-    if (datetime >= lastDatetime()) {
-        return m_borrow_cash;
-    }
 
-    price_t debt_cash = 0.0;
+Datetime TradeManager::firstDatetime() const {
+    Datetime result;
     TradeRecordList::const_iterator iter = m_trade_list.begin();
-    for (; iter != m_trade_list.end(); ++iter) {
-        if (iter->datetime > datetime) {
+    for(; iter != m_trade_list.end(); iter++){
+        if( iter->business == BUSINESS_BUY ){
+            result = iter->datetime;
             break;
         }
-        if (iter->business == BUSINESS_BORROW_CASH) {
-            debt_cash += iter->realPrice;
-        } else if (iter->business == BUSINESS_RETURN_CASH) {
-            debt_cash -= iter->realPrice;
-        }
     }
-    return debt_cash;
+    return result;
 }
 
 
 PositionRecordList TradeManager::getPositionList() const {
     PositionRecordList result;
+    result.reserve(m_position.size());
     position_map_type::const_iterator iter = m_position.begin();
     for (; iter != m_position.end(); iter++){
         result.push_back(iter->second);
@@ -414,6 +302,7 @@ PositionRecordList TradeManager::getPositionList() const {
 
 PositionRecordList TradeManager::getShortPositionList() const {
     PositionRecordList result;
+    result.reserve(m_short_position.size());
     position_map_type::const_iterator iter = m_short_position.begin();
     for (; iter != m_short_position.end(); iter++){
         result.push_back(iter->second);
@@ -478,7 +367,7 @@ bool TradeManager::checkin(const Datetime& datetime, price_t cash) {
     price_t in_cash = roundEx(cash, precision);
     m_cash = roundEx(m_cash + in_cash, precision);
     m_checkin_cash = roundEx(m_checkin_cash + in_cash, precision);
-    m_trade_list.push_back(TradeRecord(Null<Stock>(), datetime,
+    _addTradeRecord(TradeRecord(Null<Stock>(), datetime,
             BUSINESS_CHECKIN, in_cash, in_cash, 0.0, 0,
             CostRecord(), 0.0, m_cash, PART_INVALID));
     _saveAction(m_trade_list.back());
@@ -513,7 +402,7 @@ bool TradeManager::checkout(const Datetime& datetime, price_t cash) {
 
     m_cash = roundEx(m_cash - out_cash, precision);
     m_checkout_cash = roundEx(m_checkout_cash + out_cash, precision);
-    m_trade_list.push_back(TradeRecord(Null<Stock>(), datetime,
+    _addTradeRecord(TradeRecord(Null<Stock>(), datetime,
             BUSINESS_CHECKOUT, out_cash, out_cash, 0.0, 0,
             CostRecord(), 0.0, m_cash, PART_INVALID));
     _saveAction(m_trade_list.back());
@@ -561,6 +450,7 @@ bool TradeManager
         m_position[stock.id()] = PositionRecord(stock, datetime,
                 Null<Datetime>(), number, 0.0, 0.0, number, market_value,
                 0.0, 0.0, 0.0);
+        _addWeightDatetime(stock, datetime);
     } else {
         PositionRecord& pos = pos_iter->second;
         pos.number += number;
@@ -573,7 +463,7 @@ bool TradeManager
     }
 
     //加入交易记录
-    m_trade_list.push_back(TradeRecord(stock, datetime, BUSINESS_CHECKIN_STOCK,
+    _addTradeRecord(TradeRecord(stock, datetime, BUSINESS_CHECKIN_STOCK,
             price, price, 0.0, number, CostRecord(), 0.0, m_cash, PART_INVALID));
 
     //更新累计存入资产价值记录
@@ -644,7 +534,7 @@ bool TradeManager
     }
 
     //更新交易记录
-    m_trade_list.push_back(TradeRecord(stock, datetime,
+    _addTradeRecord(TradeRecord(stock, datetime,
             BUSINESS_CHECKOUT_STOCK,price, price, 0.0, number,
             CostRecord(), 0.0, m_cash, PART_INVALID));
 
@@ -678,7 +568,7 @@ bool TradeManager::borrowCash(const Datetime& datetime, price_t cash) {
     m_cash = roundEx(m_cash + in_cash - cost.total, precision);
     m_borrow_cash = roundEx(m_borrow_cash + in_cash, precision);
     m_loan_list.push_back(LoanRecord(datetime, in_cash));
-    m_trade_list.push_back(TradeRecord(Null<Stock>(), datetime,
+    _addTradeRecord(TradeRecord(Null<Stock>(), datetime,
             BUSINESS_BORROW_CASH, in_cash, in_cash, 0.0, 0,
             cost, 0.0, m_cash, PART_INVALID));
     return true;
@@ -769,7 +659,7 @@ bool TradeManager::returnCash(const Datetime& datetime, price_t cash) {
 
     m_cash = roundEx(m_cash - out_cash, precision);
     m_borrow_cash = roundEx(m_borrow_cash - in_cash, precision);
-    m_trade_list.push_back(TradeRecord(Null<Stock>(), datetime,
+    _addTradeRecord(TradeRecord(Null<Stock>(), datetime,
             BUSINESS_RETURN_CASH, in_cash, in_cash, 0.0, 0,
             cost, 0.0, m_cash, PART_INVALID));
     return true;
@@ -817,7 +707,7 @@ bool TradeManager
     m_cash = roundEx(m_cash - cost.total, precision);
 
     //加入交易记录
-    m_trade_list.push_back(TradeRecord(stock, datetime, BUSINESS_BORROW_STOCK,
+    _addTradeRecord(TradeRecord(stock, datetime, BUSINESS_BORROW_STOCK,
             price, price, 0.0, number, cost, 0.0, m_cash, PART_INVALID));
 
     //更新当前借入股票信息
@@ -945,7 +835,7 @@ bool TradeManager
     m_cash = roundEx(m_cash - cost.total, precision);
 
     //更新交易记录
-    m_trade_list.push_back(TradeRecord(stock, datetime,
+    _addTradeRecord(TradeRecord(stock, datetime,
             BUSINESS_RETURN_STOCK, price, price, 0.0, number,
             cost, 0.0, m_cash, PART_INVALID));
 
@@ -1053,7 +943,7 @@ TradeRecord TradeManager::buy(const Datetime& datetime, const Stock& stock,
     //加入交易记录
     result = TradeRecord(stock, datetime, BUSINESS_BUY, planPrice, realPrice,
                          goalPrice, number, cost, stoploss, m_cash, from);
-    m_trade_list.push_back(result);
+    _addTradeRecord(result);
 
     //更新当前持仓记录
     position_map_type::iterator pos_iter = m_position.find(stock.id());
@@ -1070,6 +960,7 @@ TradeRecord TradeManager::buy(const Datetime& datetime, const Stock& stock,
                 cost.total,
                 roundEx((realPrice - stoploss) * number * stock.unit(), precision),
                 0.0);
+        _addWeightDatetime(stock, datetime);
     } else {
         PositionRecord& position = pos_iter->second;
         position.number += number;
@@ -1177,7 +1068,7 @@ TradeRecord TradeManager::sell(const Datetime& datetime, const Stock& stock,
     //更新交易记录
     result = TradeRecord(stock, datetime, BUSINESS_SELL, planPrice, realPrice,
             goalPrice, real_number, cost, stoploss, m_cash, from);
-    m_trade_list.push_back(result);
+    _addTradeRecord(result);
 
     //更新当前持仓情况
     position.number -= real_number;
@@ -1326,7 +1217,7 @@ TradeRecord TradeManager::sellShort(const Datetime& datetime, const Stock& stock
     //加入交易记录
     result = TradeRecord(stock, datetime, BUSINESS_SELL_SHORT, planPrice, realPrice,
                          goalPrice, sell_num, cost, stoploss, m_cash, from);
-    m_trade_list.push_back(result);
+    _addTradeRecord(result);
 
     //更新当前空头持仓记录
     price_t risk = roundEx((stoploss - realPrice) * sell_num * stock.unit(), precision);
@@ -1427,7 +1318,7 @@ TradeRecord TradeManager::buyShort(const Datetime& datetime, const Stock& stock,
     //更新交易记录
     result = TradeRecord(stock, datetime, BUSINESS_BUY_SHORT, planPrice, realPrice,
             goalPrice, real_number, cost, stoploss, m_cash, from);
-    m_trade_list.push_back(result);
+    _addTradeRecord(result);
 
     //更新当前空头持仓情况
     position.number -= real_number;
@@ -1450,6 +1341,519 @@ TradeRecord TradeManager::buyShort(const Datetime& datetime, const Stock& stock,
 }
 
 
+namespace {
+
+/*
+ * 按日期递增的顺序读取单个证券的收盘价，结果与Stock::getMarketValue相同。
+ * 初始化时一次读入[start, end]范围内的K线及其前一根K线，之后每次查询只需
+ * 向后移动位置，不再按日期检索
+ */
+class ClosePriceCursor {
+public:
+    ClosePriceCursor()
+    : m_ktype(KQuery::DAY), m_pos(0), m_inited(false), m_loaded(false) {}
+
+    bool inited() const {
+        return m_inited;
+    }
+
+    void init(const Stock& stock, const Datetime& start, const Datetime& end,
+            KQuery::KType ktype) {
+        m_inited = true;
+        m_stock = stock;
+        m_ktype = ktype;
+        m_start = start;
+        m_end = end;
+
+        size_t out_start = 0, out_end = 0;
+        KQuery query = KQueryByDate(start,
+                Datetime(end.ptime() + bt::minutes(1)), ktype);
+        if (!stock.getIndexRange(query, out_start, out_end)) {
+            return;
+        }
+
+        //多读入起始日期之前的一根K线，作为起始日期无交易时的价格
+        size_t first = out_start > 0 ? out_start - 1 : 0;
+        if (first >= out_end) {
+            return;
+        }
+        m_records = stock.getKRecordList(first, out_end, ktype);
+        m_loaded = true;
+    }
+
+    price_t get(const Datetime& datetime) {
+        if (!m_loaded || datetime < m_start || datetime > m_end) {
+            return m_stock.getMarketValue(datetime, m_ktype);
+        }
+
+        if (!m_stock.valid() && datetime > m_stock.lastDatetime()) {
+            return 0.0;
+        }
+
+        m_start = datetime;
+        while (m_pos < m_records.size()
+                && m_records[m_pos].datetime <= datetime) {
+            m_pos++;
+        }
+        return m_pos > 0 ? m_records[m_pos - 1].closePrice : 0.0;
+    }
+
+private:
+    Stock m_stock;
+    KQuery::KType m_ktype;
+    Datetime m_start; //最近一次查询的日期，查询日期不能小于该日期
+    Datetime m_end;
+    KRecordList m_records;
+    size_t m_pos;     //m_records中日期小于等于最近一次查询日期的记录数
+    bool m_inited;
+    bool m_loaded;
+};
+
+} /* namespace */
+
+
+/*
+ * 按顺序回放交易记录，计算历史日期的现金、持仓及借入情况。
+ * 回放的中间状态同时作为TradeManager的历史快照保存，历史查询时从快照继续回放
+ */
+class FundsReplay {
+public:
+    FundsReplay(price_t init_cash, int precision)
+    : m_precision(precision), m_pos(0), m_cash(init_cash),
+      m_checkin_cash(0.0), m_checkout_cash(0.0),
+      m_checkin_stock(0.0), m_checkout_stock(0.0),
+      m_borrow_cash(0.0), m_borrow_asset(0.0) {}
+
+    int precision() const {
+        return m_precision;
+    }
+
+    /** 已回放的交易记录数 */
+    size_t pos() const {
+        return m_pos;
+    }
+
+    /** 已回放的交易记录中的最大日期，未回放任何记录时为Null<Datetime>() */
+    Datetime lastDatetime() const {
+        return m_last_datetime;
+    }
+
+    /** 回放trade_list中的下一条记录 */
+    void next(const TradeRecordList& trade_list) {
+        const TradeRecord& record = trade_list[m_pos++];
+        if (m_last_datetime == Null<Datetime>()
+                || m_last_datetime < record.datetime) {
+            m_last_datetime = record.datetime;
+        }
+        apply(record);
+    }
+
+    /** 继续回放，直至遇到日期大于datetime的记录 */
+    void advance(const TradeRecordList& trade_list, const Datetime& datetime) {
+        while (m_pos < trade_list.size()
+                && trade_list[m_pos].datetime <= datetime) {
+            next(trade_list);
+        }
+    }
+
+    void apply(const TradeRecord& record);
+
+    size_t holdNumber(const Stock& stock) const {
+        return _number(m_stock_map, stock);
+    }
+
+    size_t shortHoldNumber(const Stock& stock) const {
+        return _number(m_short_stock_map, stock);
+    }
+
+    size_t debtNumber(const Stock& stock) const;
+
+    price_t debtCash() const {
+        return m_borrow_cash;
+    }
+
+    /**
+     * 获取当前回放状态的资产情况
+     * @param price 获取证券价格的函数，参数为const Stock&
+     */
+    template <class PriceFunc>
+    FundsRecord funds(PriceFunc price) const;
+
+private:
+    struct Stock_Number {
+        Stock_Number(): number(0) {}
+        Stock_Number(const Stock& stock, size_t number)
+        : stock(stock), number(number) {}
+
+        Stock stock;
+        size_t number;
+    };
+
+    typedef map<hku_uint64, Stock_Number> stock_number_map;
+
+    static size_t _number(const stock_number_map& stock_map,
+            const Stock& stock) {
+        stock_number_map::const_iterator iter = stock_map.find(stock.id());
+        return iter != stock_map.end() ? iter->second.number : 0;
+    }
+
+    //持仓市值，按证券id的顺序累加
+    template <class PriceFunc>
+    price_t _marketValue(const stock_number_map& stock_map,
+            PriceFunc price) const;
+
+private:
+    int m_precision;
+    size_t m_pos;
+    Datetime m_last_datetime;
+    price_t m_cash;
+    price_t m_checkin_cash;
+    price_t m_checkout_cash;
+    price_t m_checkin_stock;
+    price_t m_checkout_stock;
+    price_t m_borrow_cash;
+    price_t m_borrow_asset;
+    stock_number_map m_stock_map;
+    stock_number_map m_short_stock_map;
+    map<hku_uint64, BorrowRecord> m_bor_stock_map;
+};
+
+size_t FundsReplay::debtNumber(const Stock& stock) const {
+    map<hku_uint64, BorrowRecord>::const_iterator iter
+            = m_bor_stock_map.find(stock.id());
+    if (iter == m_bor_stock_map.end()) {
+        return 0;
+    }
+
+    size_t number = 0;
+    const list<BorrowRecord::Data>& record_list = iter->second.record_list;
+    list<BorrowRecord::Data>::const_iterator data_iter = record_list.begin();
+    for (; data_iter != record_list.end(); ++data_iter) {
+        number += data_iter->number;
+    }
+    return number;
+}
+
+void FundsReplay::apply(const TradeRecord& record) {
+    stock_number_map::iterator stock_iter;
+    stock_number_map::iterator short_stock_iter;
+    map<hku_uint64, BorrowRecord>::iterator bor_stock_iter;
+
+    m_cash = record.cash;
+    switch (record.business) {
+    case BUSINESS_INIT:
+        m_checkin_cash += record.realPrice;
+        break;
+
+    case BUSINESS_BUY:
+    case BUSINESS_GIFT:
+        stock_iter = m_stock_map.find(record.stock.id());
+        if (stock_iter != m_stock_map.end()) {
+            stock_iter->second.number += record.number;
+        } else {
+            m_stock_map[record.stock.id()] = Stock_Number(record.stock,
+                    record.number);
+        }
+        break;
+
+    case BUSINESS_SELL:
+        stock_iter = m_stock_map.find(record.stock.id());
+        if (stock_iter != m_stock_map.end()) {
+            stock_iter->second.number -= record.number;
+        } else {
+            HKU_WARN(record.datetime << " " << record.stock.market_code()
+                    << " Sell error in m_trade_list! [TradeManager::getFunds]" );
+        }
+        break;
+
+    case BUSINESS_SELL_SHORT:
+        short_stock_iter = m_short_stock_map.find(record.stock.id());
+        if (short_stock_iter != m_short_stock_map.end()) {
+            short_stock_iter->second.number += record.number;
+        } else {
+            m_short_stock_map[record.stock.id()] = Stock_Number(record.stock,
+                    record.number);
+        }
+        break;
+
+    case BUSINESS_BUY_SHORT:
+        short_stock_iter = m_short_stock_map.find(record.stock.id());
+        if (short_stock_iter != m_short_stock_map.end()) {
+            short_stock_iter->second.number -= record.number;
+        } else {
+            HKU_WARN(record.datetime << " " << record.stock.market_code()
+                    << " BuyShort Error in m_trade_list! [TradeManager::getFunds");
+        }
+        break;
+
+    case BUSINESS_BONUS:
+        break;
+
+    case BUSINESS_CHECKIN:
+        m_checkin_cash += record.realPrice;
+        break;
+
+    case BUSINESS_CHECKOUT:
+        m_checkout_cash += record.realPrice;
+        break;
+
+    case BUSINESS_CHECKIN_STOCK:
+        stock_iter = m_stock_map.find(record.stock.id());
+        if (stock_iter != m_stock_map.end()) {
+            stock_iter->second.number += record.number;
+        } else {
+            m_stock_map[record.stock.id()] = Stock_Number(record.stock,
+                    record.number);
+        }
+        m_checkin_stock = roundEx(m_checkin_stock
+                + record.realPrice * record.number * record.stock.unit(),
+                m_precision);
+        break;
+
+    case BUSINESS_CHECKOUT_STOCK:
+        stock_iter = m_stock_map.find(record.stock.id());
+        if (stock_iter != m_stock_map.end()) {
+            stock_iter->second.number -= record.number;
+        } else {
+            HKU_WARN(record.datetime << " " << record.stock.market_code()
+                    <<" CheckoutStock Error in m_trade_list! [TradeManager::getFunds]" );
+        }
+        m_checkout_stock = roundEx(m_checkout_stock
+                + record.realPrice * record.number * record.stock.unit(),
+                m_precision);
+        break;
+
+    case BUSINESS_BORROW_CASH:
+        m_borrow_cash += record.realPrice;
+        break;
+
+    case BUSINESS_RETURN_CASH:
+        m_borrow_cash -= record.realPrice;
+        break;
+
+    case BUSINESS_BORROW_STOCK:
+        m_borrow_asset = roundEx(m_borrow_asset
+                + record.realPrice * record.number * record.stock.unit(),
+                m_precision);
+        bor_stock_iter = m_bor_stock_map.find(record.stock.id());
+        if (bor_stock_iter == m_bor_stock_map.end()) {
+            BorrowRecord bor;
+            BorrowRecord::Data data(record.datetime, record.realPrice, record.number);
+            bor.record_list.push_back(data);
+            m_bor_stock_map[record.stock.id()] = bor;
+        } else {
+            BorrowRecord::Data data(record.datetime, record.realPrice, record.number);
+            bor_stock_iter->second.record_list.push_back(data);
+        }
+        break;
+
+    case BUSINESS_RETURN_STOCK:
+        bor_stock_iter = m_bor_stock_map.find(record.stock.id());
+        if (bor_stock_iter == m_bor_stock_map.end()) {
+            HKU_WARN(record.datetime << " " << record.stock.market_code()
+                    << " Error return stock in m_trade_list! TradeManager::getFunds]");
+
+        } else {
+            BorrowRecord& bor = bor_stock_iter->second;
+            list<BorrowRecord::Data>::iterator bor_iter = bor.record_list.begin();
+            size_t remain_num = record.number;
+            do {
+                bor_iter = bor.record_list.begin();
+                if (remain_num == bor_iter->number) {
+                    m_borrow_asset -= roundEx(bor_iter->price
+                       * remain_num * record.stock.unit(), m_precision);
+                    bor.record_list.pop_front();
+                    break;
+
+                } else if (remain_num < bor_iter->number) {
+                    m_borrow_asset -= roundEx(bor_iter->price
+                       * remain_num * record.stock.unit(), m_precision);
+                    bor_iter->number -= remain_num;
+                    break;
+
+                } else { //remain_num > bor_iter->number
+                    m_borrow_asset -= roundEx(bor_iter->price
+                       * bor_iter->number * record.stock.unit(), m_precision);
+                    remain_num -= bor_iter->number;
+                    bor.record_list.pop_front();
+                }
+            } while (!bor.record_list.empty());
+
+            if (bor.record_list.empty()) {
+                m_bor_stock_map.erase(bor_stock_iter);
+            }
+        }
+
+        break;
+
+    default:
+        HKU_WARN(record.datetime << " " << record.stock.market_code()
+                << "Unknow business in m_trade_list! [TradeManager::getFunds]");
+        break;
+    }
+}
+
+template <class PriceFunc>
+price_t FundsReplay::_marketValue(const stock_number_map& stock_map,
+        PriceFunc price) const {
+    price_t market_value = 0.0;
+    stock_number_map::const_iterator iter = stock_map.begin();
+    for (; iter != stock_map.end(); ++iter) {
+        const size_t& number = iter->second.number;
+        if (number == 0) {
+            continue;
+        }
+
+        market_value = roundEx(market_value + price(iter->second.stock) * number,
+                               m_precision);
+    }
+    return market_value;
+}
+
+template <class PriceFunc>
+FundsRecord FundsReplay::funds(PriceFunc price) const {
+    FundsRecord funds;
+    funds.cash = m_cash;
+    funds.market_value = _marketValue(m_stock_map, price);
+    funds.short_market_value = _marketValue(m_short_stock_map, price);
+    funds.base_cash = m_checkin_cash - m_checkout_cash;
+    funds.base_asset = m_checkin_stock - m_checkout_stock;
+    funds.borrow_cash = m_borrow_cash;
+    funds.borrow_asset = m_borrow_asset;
+    return funds;
+}
+
+
+//每回放多少条交易记录保存一次历史快照
+static const size_t SNAPSHOT_INTERVAL = 64;
+
+FundsReplay TradeManager::_replay(const Datetime& datetime) {
+    int precision = getParam<int>("precision");
+    if (!m_snapshots.empty()
+            && (m_snapshots.back()->pos() > m_trade_list.size()
+                || m_snapshots.back()->precision() != precision)) {
+        m_snapshots.clear();
+    }
+
+    //交易记录只会追加，按需将快照补充至最新的交易记录
+    if (m_snapshots.empty()) {
+        m_snapshots.push_back(FundsReplayPtr(
+                new FundsReplay(m_init_cash, precision)));
+    }
+    if (m_snapshots.back()->pos() + SNAPSHOT_INTERVAL <= m_trade_list.size()) {
+        FundsReplay builder(*m_snapshots.back());
+        while (builder.pos() + SNAPSHOT_INTERVAL <= m_trade_list.size()) {
+            for (size_t i = 0; i < SNAPSHOT_INTERVAL; ++i) {
+                builder.next(m_trade_list);
+            }
+            m_snapshots.push_back(FundsReplayPtr(new FundsReplay(builder)));
+        }
+    }
+
+    //快照中的最大日期递增，查找最后一个最大日期不超过指定日期的快照，
+    //此前的交易记录一定都在跳出回放的第一条记录之前。第一个快照未回放任何记录
+    size_t low = 1, high = m_snapshots.size();
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        if (m_snapshots[mid]->lastDatetime() <= datetime) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    FundsReplay result(*m_snapshots[low - 1]);
+    result.advance(m_trade_list, datetime);
+    return result;
+}
+
+
+size_t TradeManager
+::getHoldNumber(const Datetime& datetime, const Stock& stock) {
+    //日期小于账户建立日期，返回0
+    if( datetime < m_init_datetime ){
+        return 0;
+    }
+
+    //根据权息信息调整持仓数量
+    _update(datetime);
+
+    //如果指定的日期大于等于最后交易日期，则直接取当前持仓记录
+    if (datetime >= lastDatetime()) {
+        position_map_type::const_iterator pos_iter = m_position.find(stock.id());
+        if (pos_iter != m_position.end()) {
+            return pos_iter->second.number;
+        }
+        return 0;
+    }
+
+    //在历史交易记录中，从最近的快照回放至指定的查询日期，获取该交易对象的持仓数量
+    return _replay(datetime).holdNumber(stock);
+}
+
+
+size_t TradeManager
+::getShortHoldNumber(const Datetime& datetime, const Stock& stock) {
+    //日期小于账户建立日期，返回0
+    if( datetime < m_init_datetime ){
+        return 0;
+    }
+
+    //根据权息信息调整持仓数量
+    _update(datetime);
+
+    //如果指定的日期大于等于最后交易日期，则直接取当前持仓记录
+    if (datetime >= lastDatetime()) {
+        position_map_type::const_iterator pos_iter = m_short_position.find(stock.id());
+        if (pos_iter != m_short_position.end()) {
+            return pos_iter->second.number;
+        }
+        return 0;
+    }
+
+    //在历史交易记录中，从最近的快照回放至指定的查询日期，获取该交易对象的空头持仓数量
+    return _replay(datetime).shortHoldNumber(stock);
+}
+
+
+size_t TradeManager
+::getDebtNumber(const Datetime& datetime, const Stock& stock) {
+    if (datetime < m_init_datetime) {
+        return 0;
+    }
+
+    //根据权息信息调整持仓数量
+    _update(datetime);
+
+    if (datetime >= lastDatetime()) {
+        borrow_stock_map_type::const_iterator bor_iter;
+        bor_iter = m_borrow_stock.find(stock.id());
+        if (bor_iter != m_borrow_stock.end()) {
+            return bor_iter->second.number;
+        }
+        return 0;
+    }
+
+    return _replay(datetime).debtNumber(stock);
+}
+
+
+price_t TradeManager::getDebtCash(const Datetime& datetime) {
+    if (datetime < m_init_datetime) {
+        return 0.0;
+    }
+
+    //根据权息信息调整持仓数量
+    _update(datetime);
+
+    if (datetime >= lastDatetime()) {
+        return m_borrow_cash;
+    }
+
+    return _replay(datetime).debtCash();
+}
+
+
 price_t TradeManager::cash(const Datetime& datetime, KQuery::KType ktype) {
     FundsRecord funds = getFunds(datetime, ktype);
     return funds.cash;
@@ -1544,218 +1948,64 @@ FundsRecord TradeManager
     } // if datetime >= lastDatetime()
 
 
-    //当查询日期小于最后交易日期时，遍历交易记录，计算当日的市值和现金
-    price_t cash = m_init_cash;
-    struct Stock_Number {
-        Stock_Number(): number(0) {}
-        Stock_Number(const Stock& stock, size_t number)
-        : stock(stock), number(number) {}
-
-        Stock stock;
-        size_t number;
-    };
-
-    price_t checkin_cash = 0.0;
-    price_t checkout_cash = 0.0;
-    price_t checkin_stock = 0.0;
-    price_t checkout_stock = 0.0;
-    map<hku_uint64, Stock_Number> stock_map;
-    map<hku_uint64, Stock_Number> short_stock_map;
-    map<hku_uint64, Stock_Number>::iterator stock_iter;
-    map<hku_uint64, Stock_Number>::iterator short_stock_iter;
-    map<hku_uint64, BorrowRecord> bor_stock_map;
-    map<hku_uint64, BorrowRecord>::iterator bor_stock_iter;
-
-    TradeRecordList::const_iterator iter = m_trade_list.begin();
-    for (; iter != m_trade_list.end(); ++iter) {
-        if (iter->datetime > datetime) {
-            //如果交易记录的日期大于指定的日期则跳出循环，处理完毕
-            break;
-        }
-
-        cash = iter->cash;
-        switch (iter->business) {
-        case BUSINESS_INIT:
-            checkin_cash += iter->realPrice;
-            break;
-
-        case BUSINESS_BUY:
-        case BUSINESS_GIFT:
-            stock_iter = stock_map.find(iter->stock.id());
-            if (stock_iter != stock_map.end()) {
-                stock_iter->second.number += iter->number;
-            } else {
-                stock_map[iter->stock.id()] = Stock_Number(iter->stock,
-                        iter->number);
-            }
-            break;
-
-        case BUSINESS_SELL:
-            stock_iter = stock_map.find(iter->stock.id());
-            if (stock_iter != stock_map.end()) {
-                stock_iter->second.number -= iter->number;
-            } else {
-                HKU_WARN(datetime << " " << iter->stock.market_code()
-                        << " Sell error in m_trade_list! [TradeManager::getFunds]" );
-            }
-            break;
-
-        case BUSINESS_SELL_SHORT:
-            short_stock_iter = short_stock_map.find(iter->stock.id());
-            if (short_stock_iter != short_stock_map.end()) {
-                short_stock_iter->second.number += iter->number;
-            } else {
-                short_stock_map[iter->stock.id()] = Stock_Number(iter->stock, iter->number);
-            }
-            break;
-
-        case BUSINESS_BUY_SHORT:
-            short_stock_iter = short_stock_map.find(iter->stock.id());
-            if (short_stock_iter != short_stock_map.end()) {
-                short_stock_iter->second.number -= iter->number;
-            } else {
-                HKU_WARN(datetime << " " << iter->stock.market_code()
-                        << " BuyShort Error in m_trade_list! [TradeManager::getFunds");
-            }
-            break;
-
-        case BUSINESS_BONUS:
-            break;
-
-        case BUSINESS_CHECKIN:
-            checkin_cash += iter->realPrice;
-            break;
-
-        case BUSINESS_CHECKOUT:
-            checkout_cash += iter->realPrice;
-            break;
-
-        case BUSINESS_CHECKIN_STOCK:
-            stock_iter = stock_map.find(iter->stock.id());
-            if (stock_iter != stock_map.end()) {
-                stock_map[iter->stock.id()].number += iter->number;
-            } else {
-                stock_map[iter->stock.id()] = Stock_Number(iter->stock,
-                        iter->number);
-            }
-            checkin_stock = roundEx(checkin_stock
-                    + iter->realPrice * iter->number * iter->stock.unit(),
-                    precision);
-            break;
-
-        case BUSINESS_CHECKOUT_STOCK:
-            stock_iter = stock_map.find(iter->stock.id());
-            if (stock_iter != stock_map.end()) {
-                stock_map[iter->stock.id()].number -= iter->number;
-            } else {
-                HKU_WARN(datetime << " " << iter->stock.market_code()
-                        <<" CheckoutStock Error in m_trade_list! [TradeManager::getFunds]" );
-            }
-            checkout_stock = roundEx(checkout_stock
-                    + iter->realPrice * iter->number * iter->stock.unit(),
-                    precision);
-            break;
-
-        case BUSINESS_BORROW_CASH:
-            funds.borrow_cash += iter->realPrice;
-            break;
+    //当查询日期小于最后交易日期时，从最近的快照回放交易记录，计算当日的市值和现金
+    return _replay(datetime).funds([&](const Stock& stock) {
+        return stock.getMarketValue(datetime, ktype);
+    });
+}
 
-        case BUSINESS_RETURN_CASH:
-            funds.borrow_cash -= iter->realPrice;
-            break;
 
-        case BUSINESS_BORROW_STOCK:
-            funds.borrow_asset = roundEx(funds.borrow_asset
-                    + iter->realPrice * iter->number * iter->stock.unit(),
-                    precision);
-            bor_stock_iter = bor_stock_map.find(iter->stock.id());
-            if (bor_stock_iter == bor_stock_map.end()) {
-                BorrowRecord bor;
-                BorrowRecord::Data data(iter->datetime, iter->realPrice, iter->number);
-                bor.record_list.push_back(data);
-                bor_stock_map[iter->stock.id()] = bor;
-            } else {
-                BorrowRecord::Data data(iter->datetime, iter->realPrice, iter->number);
-                bor_stock_iter->second.record_list.push_back(data);
-            }
-            break;
+FundsList TradeManager
+::getFundsList(const DatetimeList& dates, KQuery::KType ktype) {
+    size_t total = dates.size();
+    FundsList result(total);
+    if (total == 0) {
+        return result;
+    }
 
-        case BUSINESS_RETURN_STOCK:
-            bor_stock_iter = bor_stock_map.find(iter->stock.id());
-            if (bor_stock_iter == bor_stock_map.end()) {
-                HKU_WARN(iter->datetime << " " << iter->stock.market_code()
-                        << " Error return stock in m_trade_list! TradeManager::getFunds]");
-
-            } else {
-                BorrowRecord& bor = bor_stock_iter->second;
-                list<BorrowRecord::Data>::iterator bor_iter = bor.record_list.begin();
-                size_t remain_num = iter->number;
-                do {
-                    bor_iter = bor.record_list.begin();
-                    if (remain_num == bor_iter->number) {
-                        funds.borrow_asset -= roundEx(bor_iter->price
-                           * remain_num * iter->stock.unit(), precision);
-                        bor.record_list.pop_front();
-                        break;
-
-                    } else if (remain_num < bor_iter->number) {
-                        funds.borrow_asset -= roundEx(bor_iter->price
-                           * remain_num * iter->stock.unit(), precision);
-                        bor_iter->number -= remain_num;
-                        break;
-
-                    } else { //remain_num > bor_iter->number
-                        funds.borrow_asset -= roundEx(bor_iter->price
-                           * bor_iter->number * iter->stock.unit(), precision);
-                        remain_num -= bor_iter->number;
-                        bor.record_list.pop_front();
-                    }
-                } while (!bor.record_list.empty());
-
-                if (bor.record_list.empty()) {
-                    bor_stock_map.erase(bor_stock_iter);
-                }
-            }
+    FundsReplay replay(m_init_cash, getParam<int>("precision"));
+    Datetime replay_datetime; //已回放至的日期
 
-            break;
+    //历史日期不会超过当前的最后交易日期，各证券的K线只需预读至该日期
+    Datetime last_datetime = lastDatetime();
+    map<hku_uint64, ClosePriceCursor> cursors;
 
-        default:
-            HKU_WARN(datetime << " " << iter->stock.market_code()
-                    << "Unknow business in m_trade_list! [TradeManager::getFunds]");
-            break;
+    for (size_t i = 0; i < total; ++i) {
+        const Datetime& indatetime = dates[i];
+        if (indatetime == Null<Datetime>()
+                || indatetime == lastDatetime()) {
+            result[i] = getFunds(ktype);
+            continue;
         }
-    }
 
-    stock_iter = stock_map.begin();
-    for (; stock_iter != stock_map.end(); ++stock_iter) {
-        const size_t& number = stock_iter->second.number;
-        if (number == 0) {
+        //与getFunds(datetime, ktype)的判断相同；日期未按顺序排列时无法
+        //继续回放，也逐一计算
+        Datetime datetime(indatetime.year(), indatetime.month(),
+                          indatetime.day(), 11, 59);
+        if (datetime > lastDatetime() || (replay_datetime != Null<Datetime>()
+                && datetime < replay_datetime)) {
+            result[i] = getFunds(indatetime, ktype);
             continue;
         }
 
-        price_t price = stock_iter->second.stock.getMarketValue(datetime, ktype);
-        market_value = roundEx(market_value + price * number,
-                               precision);
-    }
-
-    short_stock_iter = short_stock_map.begin();
-    for (; short_stock_iter != short_stock_map.end(); ++short_stock_iter) {
-        const size_t& number = short_stock_iter->second.number;
-        if (number == 0) {
-            continue;
+        //第一个历史日期从最近的快照开始回放，之后继续向后回放
+        if (replay_datetime == Null<Datetime>()) {
+            replay = _replay(datetime);
+        } else {
+            replay.advance(m_trade_list, datetime);
         }
+        replay_datetime = datetime;
 
-        price_t price = short_stock_iter->second.stock.getMarketValue(datetime, ktype);
-        short_market_value = roundEx(short_market_value + price * number,
-                               precision);
+        result[i] = replay.funds([&](const Stock& stock) {
+            ClosePriceCursor& cursor = cursors[stock.id()];
+            if (!cursor.inited()) {
+                cursor.init(stock, datetime, last_datetime, ktype);
+            }
+            return cursor.get(datetime);
+        });
     }
 
-    funds.cash = cash;
-    funds.market_value = market_value;
-    funds.short_market_value = short_market_value;
-    funds.base_cash = checkin_cash - checkout_cash;
-    funds.base_asset = checkin_stock - checkout_stock;
-    return funds;
+    return result;
 }
 
 
@@ -1764,8 +2014,9 @@ PriceList TradeManager
     size_t total = dates.size();
     PriceList result(total);
     int precision = getParam<int>("precision");
+    FundsList funds_list = getFundsList(dates, ktype);
     for (size_t i = 0; i < total; ++i) {
-        FundsRecord funds = getFunds(dates[i], ktype);
+        const FundsRecord& funds = funds_list[i];
         result[i] = roundEx(funds.cash + funds.market_value - funds.borrow_cash
                   - funds.borrow_asset, precision);
     }
@@ -1777,14 +2028,21 @@ PriceList TradeManager
 ::getProfitCurve(const DatetimeList& dates, KQuery::KType ktype) {
     size_t total = dates.size();
     PriceList result(total);
-    size_t i = 0;
-    while (dates[i] < m_init_datetime && i < total) {
-        result[i] = 0;
-        i++;
+    size_t start = 0;
+    while (start < total && dates[start] < m_init_datetime) {
+        result[start] = 0;
+        start++;
     }
+
+    if (start == total) {
+        return result;
+    }
+
     int precision = getParam<int>("precision");
-    for (; i < total; ++i) {
-        FundsRecord funds = getFunds(dates[i], ktype);
+    DatetimeList valid_dates(dates.begin() + start, dates.end());
+    FundsList funds_list = getFundsList(valid_dates, ktype);
+    for (size_t i = start; i < total; ++i) {
+        const FundsRecord& funds = funds_list[i - start];
         result[i] = roundEx(funds.cash + funds.market_value - funds.borrow_cash
                   - funds.borrow_asset - funds.base_cash - funds.base_asset,
                   precision);
@@ -1794,6 +2052,25 @@ PriceList TradeManager
 }
 
 
+/*
+ * 证券在datetime所在日之后第一个会引起持仓或现金变化的权息日期，
+ * 没有时返回Null<Datetime>()
+ */
+static Datetime next_weight_datetime(const Stock& stock,
+        const Datetime& datetime) {
+    StockWeightList weights = stock.getWeight(
+            Datetime(datetime.date() + bd::days(1)), Null<Datetime>());
+    StockWeightList::const_iterator iter = weights.begin();
+    for (; iter != weights.end(); ++iter) {
+        if (iter->bonus() != 0.0 || iter->countAsGift() != 0.0
+                || iter->increasement() != 0.0) {
+            return iter->datetime();
+        }
+    }
+    return Null<Datetime>();
+}
+
+
 /******************************************************************************
  *  每次执行交易操作时，先根据权息信息调整持有仓位及现金记录
  *  采用滞后更新的策略，即只在需要获取当前持仓情况及卖出时更新当前的持仓及资产情况
@@ -1802,6 +2079,8 @@ PriceList TradeManager
  *****************************************************************************/
 void TradeManager::_update(const Datetime& datetime){
     if(!getParam<bool>("reinvest")){
+        //不处理权息期间不维护下一权息日期，重新处理时需全部重新计算
+        m_weight_datetime = Datetime::min();
         return;
     }
 
@@ -1811,6 +2090,11 @@ void TradeManager::_update(const Datetime& datetime){
         return;
     }
 
+    //在下一权息日期之前，持仓证券均无需要处理的权息
+    if (Datetime(datetime.date()) < m_weight_datetime) {
+        return;
+    }
+
     //权息信息查询日期范围
     bd::date start_date = lastDatetime().date() + bd::days(1);
     bd::date end_date = datetime.date() + bd::days(1);
@@ -1881,13 +2165,40 @@ void TradeManager::_update(const Datetime& datetime){
     }
 
     for (size_t i = 0; i < total; ++i) {
-        m_trade_list.push_back(new_trade_buffer[i]);
+        _addTradeRecord(new_trade_buffer[i]);
+    }
+
+    //以更新后的最后交易日期为起点，重新计算持仓证券的下一权息日期
+    m_weight_datetime = Null<Datetime>();
+    position_iter = m_position.begin();
+    for (; position_iter != m_position.end(); ++position_iter) {
+        Datetime next = next_weight_datetime(position_iter->second.stock,
+                                             lastDatetime());
+        if (next < m_weight_datetime) {
+            m_weight_datetime = next;
+        }
+    }
+}
+
+
+void TradeManager::_addWeightDatetime(const Stock& stock,
+        const Datetime& datetime) {
+    //下一权息日期未知时，等待_update重新计算
+    if (m_weight_datetime == Datetime::min()
+            || !getParam<bool>("reinvest")) {
+        return;
+    }
+
+    Datetime next = next_weight_datetime(stock, datetime);
+    if (next < m_weight_datetime) {
+        m_weight_datetime = next;
     }
 }
 
 
 void TradeManager::_saveAction(const TradeRecord& record) {
-    if (getParam<bool>("save_action") == false)
+    //已注册交易流水时由流水记录交易，不在内存中累积交易动作
+    if (!m_journal_list.empty() || getParam<bool>("save_action") == false)
         return;
 
     std::stringstream buf(std::stringstream::out);
@@ -9,6 +9,7 @@
 #define TRADEMANAGER_H_
 
 #include <boost/tuple/tuple.hpp>
+#include <boost/container/flat_map.hpp>
 #include "../utilities/Parameter.h"
 #include "../utilities/util.h"
 #include "TradeRecord.h"
@@ -17,6 +18,7 @@
 #include "FundsRecord.h"
 #include "LoanRecord.h"
 #include "OrderBrokerBase.h"
+#include "TradeJournalBase.h"
 #include "crt/TC_Zero.h"
 
 #if HKU_SUPPORT_SERIALIZATION
@@ -27,6 +29,8 @@
 
 namespace hku {
 
+class FundsReplay;
+
 /**
  * 账户交易管理模块，管理帐户的交易记录及资金使用情况
  * @details
@@ -43,6 +47,12 @@ class HKU_API TradeManager {
     PARAMETER_SUPPORT
 
 public:
+    /**
+     * 证券id到持仓记录的映射，按证券id排序连续存放，查找为对连续内存的二分查找，
+     * 遍历时顺序访问
+     */
+    typedef boost::container::flat_map<hku_uint64, PositionRecord> position_map_type;
+
     TradeManager(const Datetime& datetime = Datetime(199001010000LL),
             price_t initcash = 100000.0,
             const TradeCostPtr& costfunc = TC_Zero(),
@@ -63,6 +73,20 @@ public:
      */
     void clearBroker();
 
+    /**
+     * 注册交易流水，之后产生的每条交易记录都会写入该流水
+     * @details 注册时先写入当前已有的全部交易记录。流水在交易记录产生时即写出，
+     *          并代替内存中的交易动作记录：注册后清除已保存的交易动作，在清空流水
+     *          之前不再保存新的交易动作（参数save_action不起作用），长时间回测时
+     *          交易动作不会在内存中不断累积，也不会被序列化或由tocsv导出
+     * @note 克隆的账户不包含已注册的流水
+     * @param journal 交易流水实例
+     */
+    void regJournal(const TradeJournalPtr& journal);
+
+    /** 写出缓冲中的记录并清空已注册的交易流水 */
+    void clearJournal();
+
     /** 从哪个时刻开始启动订单代理进行下单操作   */
     Datetime getBrokerLastDatetime() const { return m_broker_last_datetime; }
 
@@ -95,12 +119,26 @@ public:
     /** 第一笔买入交易发生日期，如未发生交易返回Null<Datetime>() */
     Datetime firstDatetime() const;
 
+    /**
+     * 复位次数，每次调用reset后加1，克隆及序列化的实例从0开始。按位置引用
+     * 交易记录的使用者（如System）据此判断所引用的交易记录是否已被清除
+     */
+    size_t resetCount() const { return m_reset_count; }
+
     /** 最后一笔交易日期，注意和交易类型无关，如未发生交易返回账户建立日期 */
     Datetime lastDatetime() const {
         return m_trade_list.empty()
                 ? m_init_datetime : m_trade_list.back().datetime;
     }
 
+    /**
+     * 处理截至指定日期的权息，各交易操作会自动处理，多个系统共享同一账户
+     * 逐时刻运行时，可在每个时刻开始前统一处理一次，之后同一时刻的交易操作
+     * 无需再次查询权息
+     * @param datetime 处理截至日期，不能小于lastDatetime()
+     */
+    void updateWeight(const Datetime& datetime) { _update(datetime); }
+
     /** 红利/股息/送股再投资标志，即是否忽略权息信息 **/
     bool reinvest() const { return getParam<bool>("reinvest"); }
 
@@ -169,6 +207,15 @@ public:
     /** 获取当前全部持仓记录 */
     PositionRecordList getPositionList() const;
 
+    /**
+     * 获取当前全部持仓记录，不复制持仓记录，按证券id排序
+     * @note 买入、卖出等交易操作会使其中的迭代器及引用失效，遍历过程中需要进行
+     *       交易时，应先取出待处理的证券id
+     */
+    const position_map_type& getPositionMap() const {
+        return m_position;
+    }
+
     /** 获取全部历史持仓记录，即已平仓记录 */
     const PositionRecordList& getHistoryPositionList() const {
         return m_position_history;
@@ -177,6 +224,11 @@ public:
     /** 获取当前全部空头仓位记录 */
     PositionRecordList getShortPositionList() const;
 
+    /** 获取当前全部空头仓位记录，不复制仓位记录，注意事项同getPositionMap */
+    const position_map_type& getShortPositionMap() const {
+        return m_short_position;
+    }
+
     /** 获取全部空头历史仓位记录 */
     const PositionRecordList& getShortHistoryPositionList() const {
         return m_short_position_history;
@@ -450,6 +502,17 @@ public:
     FundsRecord getFunds(const Datetime& datetime,
             KQuery::KType ktype = KQuery::DAY);
 
+    /**
+     * 获取日期列表中各日期的资产市值详情，结果与逐一调用getFunds(datetime, ktype)相同
+     * @details 对于早于最后交易日期的历史日期，只遍历一次交易记录及各持仓证券
+     *          的K线，逐日累计现金及持仓，而不是对每个日期都从头回放交易记录
+     * @param dates 日期列表，应为递增顺序，否则无序部分逐一调用getFunds计算
+     * @param ktype K线类型，必须与日期列表匹配，默认KQuery::DAY
+     * @return 与日期列表一一对应的资产详情
+     */
+    FundsList getFundsList(const DatetimeList& dates,
+            KQuery::KType ktype = KQuery::DAY);
+
     /**
      * 获取资产净值曲线，含借入的资产
      * @param dates 日期列表，根据该日期列表获取其对应的资产净值曲线
@@ -480,9 +543,18 @@ private:
     //根据权息信息，更新交易记录及持仓
     void _update(const Datetime&);
 
+    //新增持仓时，以该证券在datetime之后的权息日期更新下一权息日期
+    void _addWeightDatetime(const Stock& stock, const Datetime& datetime);
+
     //以脚本的形式保存交易动作，便于修正和校准
     void _saveAction(const TradeRecord&);
 
+    //加入交易记录，并写入已注册的交易流水
+    void _addTradeRecord(const TradeRecord&);
+
+    //从最近的历史快照开始，回放交易记录至第一条日期大于datetime的记录之前
+    FundsReplay _replay(const Datetime& datetime);
+
 private:
     string       m_name;            //账户名称
     Datetime     m_init_datetime;   //账户建立日期
@@ -498,12 +570,17 @@ private:
 
     list<LoanRecord> m_loan_list;   //当前融资情况
 
-    typedef map<hku_uint64, BorrowRecord> borrow_stock_map_type;
+    typedef boost::container::flat_map<hku_uint64, BorrowRecord> borrow_stock_map_type;
     borrow_stock_map_type m_borrow_stock;  //当前借入的股票及其数量
 
     TradeRecordList m_trade_list;  //交易记录
 
-    typedef map<hku_uint64, PositionRecord > position_map_type;
+    //交易记录的历史快照，每隔固定条数的交易记录保存一次回放状态，在历史查询时
+    //按需生成，使历史查询只需二分查找快照并回放其后的少量记录。快照生成后不再修改，
+    //可在克隆的实例间共享
+    typedef shared_ptr<FundsReplay> FundsReplayPtr;
+    vector<FundsReplayPtr> m_snapshots;
+
     position_map_type m_position; //当前持仓交易对象的持仓记录 ["sh000001"-> ]
     PositionRecordList m_position_history; //持仓历史记录
     position_map_type m_short_position; //空头仓位记录
@@ -512,8 +589,16 @@ private:
     list<OrderBrokerPtr>  m_broker_list; //订单代理列表
     Datetime m_broker_last_datetime; //订单代理最近一次执行操作的时刻
 
+    list<TradeJournalPtr> m_journal_list; //交易流水列表
+
     list<string> m_actions; //记录交易动作，便于修改或校准实盘时的交易
 
+    //持仓证券在最后交易日期之后第一个需要处理的权息日期的下限，在此之前_update
+    //无需查询权息；Null<Datetime>()表示没有，Datetime::min()表示未知需重新计算
+    Datetime m_weight_datetime;
+
+    size_t m_reset_count; //复位次数，不参与克隆及序列化
+
 //==================================================
 // 支持序列化
 //==================================================
@@ -588,6 +673,8 @@ private:
         ar & BOOST_SERIALIZATION_NVP(m_short_position_history);
         ar & BOOST_SERIALIZATION_NVP(m_trade_list);
         ar & BOOST_SERIALIZATION_NVP(m_actions);
+        m_snapshots.clear();
+        m_weight_datetime = Datetime::min();
     }
 
     BOOST_SERIALIZATION_SPLIT_MEMBER()
@@ -601,6 +688,7 @@ private:
  */
 typedef shared_ptr<TradeManager> TradeManagerPtr;
 typedef shared_ptr<TradeManager> TMPtr;
+typedef vector<TradeManagerPtr> TradeManagerList;
 
 HKU_API std::ostream & operator<<(std::ostream &, const TradeManager&);
 HKU_API std::ostream & operator<<(std::ostream &, const TradeManagerPtr&);
@@ -13,5 +13,7 @@
 #include "crt/TC_Zero.h"
 #include "crt/TC_FixedA.h"
 #include "crt/TC_FixedA2015.h"
+#include "crt/TJ_Binary.h"
+#include "crt/TJ_Csv.h"
 
 #endif /* TRADE_MANAGE_BUILD_IN_H_ */
@@ -0,0 +1,25 @@
+/*
+ * TJ_Binary.h
+ *
+ *  Created on: 2017年6月22日
+ *      Author: fasiondog
+ */
+
+#ifndef TRADE_MANAGE_CRT_TJ_BINARY_H_
+#define TRADE_MANAGE_CRT_TJ_BINARY_H_
+
+#include "../TradeJournalBase.h"
+
+namespace hku {
+
+/**
+ * 创建二进制格式的交易流水，可通过crtTMFromJournal重建交易账户
+ * @param filename 流水文件名，文件已存在时在其后追加
+ * @see BinaryTradeJournal
+ * @ingroup TradeManagerClass
+ */
+TradeJournalPtr HKU_API TJ_Binary(const string& filename);
+
+} /* namespace hku */
+
+#endif /* TRADE_MANAGE_CRT_TJ_BINARY_H_ */
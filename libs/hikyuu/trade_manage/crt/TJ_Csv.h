@@ -0,0 +1,25 @@
+/*
+ * TJ_Csv.h
+ *
+ *  Created on: 2017年6月22日
+ *      Author: fasiondog
+ */
+
+#ifndef TRADE_MANAGE_CRT_TJ_CSV_H_
+#define TRADE_MANAGE_CRT_TJ_CSV_H_
+
+#include "../TradeJournalBase.h"
+
+namespace hku {
+
+/**
+ * 创建csv格式的交易流水
+ * @param filename csv文件名，文件已存在时在其后追加
+ * @see CsvTradeJournal
+ * @ingroup TradeManagerClass
+ */
+TradeJournalPtr HKU_API TJ_Csv(const string& filename);
+
+} /* namespace hku */
+
+#endif /* TRADE_MANAGE_CRT_TJ_CSV_H_ */
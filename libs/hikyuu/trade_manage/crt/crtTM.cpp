@@ -5,7 +5,9 @@
  *      Author: fasiondog
  */
 
+#include <algorithm>
 #include "crtTM.h"
+#include "../imp/BinaryTradeJournal.h"
 
 namespace hku {
 
@@ -14,4 +16,172 @@ TradeManagerPtr HKU_API crtTM(const Datetime& datetime, price_t initcash,
     return TradeManagerPtr(new TradeManager(datetime, initcash, costfunc, name));
 }
 
+namespace {
+
+//按交易记录重新执行对应的操作，分红、送股记录由账户根据权息信息生成，直接忽略
+bool replay_trade_record(const TradeManagerPtr& tm, const TradeRecord& r) {
+    switch (r.business) {
+    case BUSINESS_BUY:
+        return tm->buy(r.datetime, r.stock, r.realPrice, r.number,
+                r.stoploss, r.goalPrice, r.planPrice, r.from).business
+                != INVALID_BUSINESS;
+
+    case BUSINESS_SELL:
+        return tm->sell(r.datetime, r.stock, r.realPrice, r.number,
+                r.stoploss, r.goalPrice, r.planPrice, r.from).business
+                != INVALID_BUSINESS;
+
+    case BUSINESS_SELL_SHORT:
+        return tm->sellShort(r.datetime, r.stock, r.realPrice, r.number,
+                r.stoploss, r.goalPrice, r.planPrice, r.from).business
+                != INVALID_BUSINESS;
+
+    case BUSINESS_BUY_SHORT:
+        return tm->buyShort(r.datetime, r.stock, r.realPrice, r.number,
+                r.stoploss, r.goalPrice, r.planPrice, r.from).business
+                != INVALID_BUSINESS;
+
+    case BUSINESS_GIFT:
+    case BUSINESS_BONUS:
+        return true;
+
+    case BUSINESS_CHECKIN:
+        return tm->checkin(r.datetime, r.realPrice);
+
+    case BUSINESS_CHECKOUT:
+        return tm->checkout(r.datetime, r.realPrice);
+
+    case BUSINESS_CHECKIN_STOCK:
+        return tm->checkinStock(r.datetime, r.stock, r.realPrice, r.number);
+
+    case BUSINESS_CHECKOUT_STOCK:
+        return tm->checkoutStock(r.datetime, r.stock, r.realPrice, r.number);
+
+    case BUSINESS_BORROW_CASH:
+        return tm->borrowCash(r.datetime, r.realPrice);
+
+    case BUSINESS_RETURN_CASH:
+        return tm->returnCash(r.datetime, r.realPrice);
+
+    case BUSINESS_BORROW_STOCK:
+        return tm->borrowStock(r.datetime, r.stock, r.realPrice, r.number);
+
+    case BUSINESS_RETURN_STOCK:
+        return tm->returnStock(r.datetime, r.stock, r.realPrice, r.number);
+
+    default:
+        return false;
+    }
+}
+
+//合并时待重放的交易记录，相同日期时按账户序号、账户内的顺序排列
+struct MergeItem {
+    Datetime datetime;
+    size_t tm_index;
+    size_t record_index;
+
+    bool operator<(const MergeItem& other) const {
+        if (datetime != other.datetime) {
+            return datetime < other.datetime;
+        }
+        if (tm_index != other.tm_index) {
+            return tm_index < other.tm_index;
+        }
+        return record_index < other.record_index;
+    }
+};
+
+} /* namespace */
+
+TradeManagerPtr HKU_API crtTMFromJournal(const string& filename,
+        const TradeCostPtr& costfunc, const string& name) {
+    TradeRecordList records = BinaryTradeJournal::read(filename);
+    if (records.empty() || records[0].business != BUSINESS_INIT) {
+        HKU_ERROR("Invalid trade journal(" << filename
+                << ")! [crtTMFromJournal]");
+        return TradeManagerPtr();
+    }
+
+    bool reinvest = false;
+    TradeRecordList::const_iterator iter = records.begin();
+    for (; iter != records.end(); ++iter) {
+        if (iter->business == BUSINESS_BONUS || iter->business == BUSINESS_GIFT) {
+            reinvest = true;
+            break;
+        }
+    }
+
+    TradeManagerPtr tm;
+    for (iter = records.begin(); iter != records.end(); ++iter) {
+        const TradeRecord& r = *iter;
+        if (r.business == BUSINESS_INIT) {
+            tm = crtTM(r.datetime, r.realPrice, costfunc, name);
+            tm->setParam<bool>("reinvest", reinvest);
+            continue;
+        }
+
+        if (!replay_trade_record(tm, r)) {
+            HKU_WARN(r.datetime << " " << getBusinessName(r.business)
+                    << " can't be replayed! [crtTMFromJournal]");
+        }
+    }
+
+    return tm;
+}
+
+TradeManagerPtr HKU_API crtTMFromMerge(const TradeManagerList& tm_list,
+        const string& name) {
+    TradeManagerList::const_iterator tm_iter = tm_list.begin();
+    for (; tm_iter != tm_list.end(); ++tm_iter) {
+        if (!(*tm_iter)) {
+            HKU_ERROR("Exist null TradeManager! [crtTMFromMerge]");
+            return TradeManagerPtr();
+        }
+    }
+
+    if (tm_list.empty()) {
+        HKU_WARN("TradeManager list is empty! [crtTMFromMerge]");
+        return TradeManagerPtr();
+    }
+
+    Datetime init_datetime = tm_list[0]->initDatetime();
+    price_t init_cash = 0.0;
+    size_t total = 0;
+    for (size_t i = 0; i < tm_list.size(); ++i) {
+        if (tm_list[i]->initDatetime() < init_datetime) {
+            init_datetime = tm_list[i]->initDatetime();
+        }
+        init_cash += tm_list[i]->initCash();
+        total += tm_list[i]->getTradeList().size();
+    }
+
+    TradeManagerPtr result = crtTM(init_datetime, init_cash,
+            tm_list[0]->costFunc(), name);
+    result->setParameter(tm_list[0]->getParameter());
+
+    vector<MergeItem> items;
+    items.reserve(total);
+    for (size_t i = 0; i < tm_list.size(); ++i) {
+        const TradeRecordList& trades = tm_list[i]->getTradeList();
+        for (size_t j = 0; j < trades.size(); ++j) {
+            if (trades[j].business != BUSINESS_INIT) {
+                MergeItem item = {trades[j].datetime, i, j};
+                items.push_back(item);
+            }
+        }
+    }
+    std::sort(items.begin(), items.end());
+
+    for (size_t i = 0; i < items.size(); ++i) {
+        const TradeRecord& r =
+                tm_list[items[i].tm_index]->getTradeList()[items[i].record_index];
+        if (!replay_trade_record(result, r)) {
+            HKU_WARN(r.datetime << " " << getBusinessName(r.business)
+                    << " can't be replayed! [crtTMFromMerge]");
+        }
+    }
+
+    return result;
+}
+
 } /* namespace */
@@ -29,6 +29,38 @@ TradeManagerPtr HKU_API crtTM(
         const TradeCostPtr& costfunc = TC_Zero(),
         const string& name = "SYS");
 
+/**
+ * 根据二进制交易流水重建交易管理模块
+ * @details 按流水中的顺序重新执行存取资金、买卖、融资融券等操作；分红、送股
+ *          记录由账户根据权息信息重新生成，流水中存在此类记录时开启参数reinvest。
+ *          流水中每条建立账户的记录都会重新建立账户，返回的是最后一个账户
+ * @ingroup TradeManagerClass
+ * @param filename 由TJ_Binary写入的流水文件名
+ * @param costfunc 交易成本算法，应与写入流水的账户相同，默认零成本算法
+ * @param name 账户名称，默认“SYS”
+ * @return 文件不存在、格式错误或不是以建立账户的记录开始时返回空指针
+ * @see TJ_Binary
+ */
+TradeManagerPtr HKU_API crtTMFromJournal(const string& filename,
+        const TradeCostPtr& costfunc = TC_Zero(),
+        const string& name = "SYS");
+
+/**
+ * 将多个独立账户合并为一个汇总账户，如各证券独立运行系统后统计整体绩效
+ * @details 汇总账户的建立日期为各账户中最早的建立日期，初始资金为各账户初始
+ *          资金之和，交易成本算法及参数与第一个账户相同。各账户中除建立账户外
+ *          的交易记录按日期顺序在汇总账户中重新执行，从而得到合并后的持仓、
+ *          已平仓记录及现金；日期相同时按账户在列表中的顺序、账户内的记录顺序
+ *          执行，因此合并结果只与列表顺序有关。分红、送股记录由汇总账户根据
+ *          权息信息重新生成
+ * @ingroup TradeManagerClass
+ * @param tm_list 待合并的账户列表，应使用相同的交易成本算法
+ * @param name 汇总账户名称，默认“SYS”
+ * @return 列表为空或存在空指针时返回空指针
+ */
+TradeManagerPtr HKU_API crtTMFromMerge(const TradeManagerList& tm_list,
+        const string& name = "SYS");
+
 } /* namespace */
 
 #endif /* CRTTM_H_ */
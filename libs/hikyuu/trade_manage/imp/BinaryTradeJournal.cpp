@@ -0,0 +1,152 @@
+/*
+ * BinaryTradeJournal.cpp
+ *
+ *  Created on: 2017年6月22日
+ *      Author: fasiondog
+ */
+
+#include "BinaryTradeJournal.h"
+
+namespace hku {
+
+static const char JOURNAL_MAGIC[] = "HKUTJ001";
+static const size_t JOURNAL_MAGIC_SIZE = 8;
+
+template <class T>
+inline void write_value(std::ofstream& file, const T& value) {
+    file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <class T>
+inline bool read_value(std::ifstream& file, T& value) {
+    return file.read(reinterpret_cast<char*>(&value), sizeof(T)) ? true : false;
+}
+
+BinaryTradeJournal::BinaryTradeJournal(const string& filename)
+: TradeJournalBase("BinaryTradeJournal"), m_filename(filename) {
+    m_file.open(filename.c_str(),
+                std::ios::out | std::ios::binary | std::ios::app);
+    if (!m_file) {
+        HKU_ERROR("Can't open file(" << filename
+                << ")! [BinaryTradeJournal::BinaryTradeJournal]");
+        return;
+    }
+
+    //新文件写入文件标识
+    m_file.seekp(0, std::ios::end);
+    if (m_file.tellp() == std::streampos(0)) {
+        m_file.write(JOURNAL_MAGIC, JOURNAL_MAGIC_SIZE);
+    }
+}
+
+BinaryTradeJournal::~BinaryTradeJournal() {
+    if (m_file.is_open()) {
+        m_file.close();
+    }
+}
+
+void BinaryTradeJournal::_write(const TradeRecord& record) {
+    if (!m_file) {
+        return;
+    }
+
+    write_value(m_file, (hku_uint64)record.datetime.number());
+    write_value(m_file, (hku_int32)record.business);
+    write_value(m_file, (hku_int32)record.from);
+
+    hku_uint32 len = 0;
+    if (!record.stock.isNull()) {
+        const string& code = record.stock.market_code();
+        len = (hku_uint32)code.size();
+        write_value(m_file, len);
+        m_file.write(code.c_str(), len);
+    } else {
+        write_value(m_file, len);
+    }
+
+    write_value(m_file, (double)record.planPrice);
+    write_value(m_file, (double)record.realPrice);
+    write_value(m_file, (double)record.goalPrice);
+    write_value(m_file, (double)record.stoploss);
+    write_value(m_file, (double)record.cash);
+    write_value(m_file, (double)record.cost.commission);
+    write_value(m_file, (double)record.cost.stamptax);
+    write_value(m_file, (double)record.cost.transferfee);
+    write_value(m_file, (double)record.cost.others);
+    write_value(m_file, (double)record.cost.total);
+    write_value(m_file, (hku_uint64)record.number);
+}
+
+void BinaryTradeJournal::flush() {
+    if (m_file.is_open()) {
+        m_file.flush();
+    }
+}
+
+TradeRecordList BinaryTradeJournal::read(const string& filename) {
+    TradeRecordList result;
+    std::ifstream file(filename.c_str(), std::ios::in | std::ios::binary);
+    if (!file) {
+        HKU_ERROR("Can't open file(" << filename
+                << ")! [BinaryTradeJournal::read]");
+        return result;
+    }
+
+    char magic[JOURNAL_MAGIC_SIZE];
+    if (!file.read(magic, JOURNAL_MAGIC_SIZE)
+            || string(magic, JOURNAL_MAGIC_SIZE) != JOURNAL_MAGIC) {
+        HKU_ERROR("Invalid trade journal file(" << filename
+                << ")! [BinaryTradeJournal::read]");
+        return result;
+    }
+
+    StockManager& sm = StockManager::instance();
+    while (true) {
+        hku_uint64 datetime, number;
+        hku_int32 business, from;
+        hku_uint32 len;
+        double plan_price, real_price, goal_price, stoploss, cash;
+        CostRecord cost;
+        if (!read_value(file, datetime) || !read_value(file, business)
+                || !read_value(file, from) || !read_value(file, len)) {
+            break;
+        }
+
+        string code(len, '\0');
+        if (len > 0 && !file.read(&code[0], len)) {
+            break;
+        }
+
+        if (!read_value(file, plan_price) || !read_value(file, real_price)
+                || !read_value(file, goal_price) || !read_value(file, stoploss)
+                || !read_value(file, cash) || !read_value(file, cost.commission)
+                || !read_value(file, cost.stamptax)
+                || !read_value(file, cost.transferfee)
+                || !read_value(file, cost.others)
+                || !read_value(file, cost.total)
+                || !read_value(file, number)) {
+            break;
+        }
+
+        Stock stock;
+        if (len > 0) {
+            stock = sm.getStock(code);
+            if (stock.isNull()) {
+                HKU_WARN("Can't find stock(" << code
+                        << ")! [BinaryTradeJournal::read]");
+            }
+        }
+
+        result.push_back(TradeRecord(stock, Datetime(datetime),
+                (BUSINESS)business, plan_price, real_price, goal_price,
+                (size_t)number, cost, stoploss, cash, (SystemPart)from));
+    }
+
+    return result;
+}
+
+TradeJournalPtr HKU_API TJ_Binary(const string& filename) {
+    return TradeJournalPtr(new BinaryTradeJournal(filename));
+}
+
+} /* namespace hku */
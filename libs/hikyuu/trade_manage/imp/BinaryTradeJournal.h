@@ -0,0 +1,61 @@
+/*
+ * BinaryTradeJournal.h
+ *
+ *  Created on: 2017年6月22日
+ *      Author: fasiondog
+ */
+
+#ifndef TRADE_MANAGE_IMP_BINARYTRADEJOURNAL_H_
+#define TRADE_MANAGE_IMP_BINARYTRADEJOURNAL_H_
+
+#include <fstream>
+#include "../TradeJournalBase.h"
+
+namespace hku {
+
+/**
+ * 二进制格式的交易流水文件，以追加方式写入
+ * @details 文件以8字节的标识"HKUTJ001"开头，其后每条交易记录依次为：
+ * <pre>
+ * 日期(hku_uint64, Datetime::number())
+ * 业务类型(hku_int32)   系统部件(hku_int32)
+ * 证券代码长度(hku_uint32) 证券代码(market_code，不含结束符，Null<Stock>时长度为0)
+ * 计划价格 实际价格 目标价格 止损价 现金余额(均为double)
+ * 佣金 印花税 过户费 其他费用 总成本(均为double)
+ * 成交数量(hku_uint64)
+ * </pre>
+ * 数值均按本机字节序保存。文件只在打开时定位到末尾，写入时不在内存中累积记录
+ * @see TJ_Binary, crtTMFromJournal
+ * @ingroup TradeManagerClass
+ */
+class HKU_API BinaryTradeJournal: public TradeJournalBase {
+public:
+    /**
+     * @param filename 流水文件名，文件已存在时在其后追加
+     */
+    BinaryTradeJournal(const string& filename);
+    virtual ~BinaryTradeJournal();
+
+    /** 流水文件名 */
+    const string& filename() const {
+        return m_filename;
+    }
+
+    virtual void _write(const TradeRecord& record);
+    virtual void flush();
+
+    /**
+     * 读取流水文件中的全部交易记录
+     * @param filename 流水文件名
+     * @return 文件不存在或格式错误时返回空列表；文件末尾不完整的记录被忽略
+     */
+    static TradeRecordList read(const string& filename);
+
+private:
+    string m_filename;
+    std::ofstream m_file;
+};
+
+} /* namespace hku */
+
+#endif /* TRADE_MANAGE_IMP_BINARYTRADEJOURNAL_H_ */
@@ -0,0 +1,81 @@
+/*
+ * CsvTradeJournal.cpp
+ *
+ *  Created on: 2017年6月22日
+ *      Author: fasiondog
+ */
+
+#include "CsvTradeJournal.h"
+#include "../../utilities/util.h"
+
+namespace hku {
+
+CsvTradeJournal::CsvTradeJournal(const string& filename)
+: TradeJournalBase("CsvTradeJournal"), m_filename(filename) {
+    m_file.open(filename.c_str(), std::ios::out | std::ios::app);
+    if (!m_file) {
+        HKU_ERROR("Can't open file(" << filename
+                << ")! [CsvTradeJournal::CsvTradeJournal]");
+        return;
+    }
+
+    m_file.setf(std::ios_base::fixed);
+    m_file.precision(3);
+    m_file.seekp(0, std::ios::end);
+    if (m_file.tellp() == std::streampos(0)) {
+        m_file << "#成交日期,证券代码,证券名称,业务名称,计划交易价格,"
+                "实际成交价格,目标价格,成交数量,佣金,印花税,过户费,其他成本,"
+                "交易总成本,止损价,现金余额,信号来源" << std::endl;
+    }
+}
+
+CsvTradeJournal::~CsvTradeJournal() {
+    if (m_file.is_open()) {
+        m_file.close();
+    }
+}
+
+void CsvTradeJournal::_write(const TradeRecord& record) {
+    if (!m_file) {
+        return;
+    }
+
+    string sep(",");
+    m_file << record.datetime << sep;
+    if (!record.stock.isNull()) {
+        m_file << record.stock.market_code() << sep
+#if defined(BOOST_WINDOWS) && (PY_VERSION_HEX >= 0x03000000)
+               << utf8_to_gb(record.stock.name()) << sep;
+#else
+               << record.stock.name() << sep;
+#endif
+    } else {
+        m_file << sep << sep;
+    }
+
+    m_file << getBusinessName(record.business) << sep
+           << record.planPrice << sep
+           << record.realPrice << sep
+           << record.goalPrice << sep
+           << record.number << sep
+           << record.cost.commission << sep
+           << record.cost.stamptax << sep
+           << record.cost.transferfee << sep
+           << record.cost.others << sep
+           << record.cost.total << sep
+           << record.stoploss << sep
+           << record.cash << sep
+           << getSystemPartName(record.from) << "\n";
+}
+
+void CsvTradeJournal::flush() {
+    if (m_file.is_open()) {
+        m_file.flush();
+    }
+}
+
+TradeJournalPtr HKU_API TJ_Csv(const string& filename) {
+    return TradeJournalPtr(new CsvTradeJournal(filename));
+}
+
+} /* namespace hku */
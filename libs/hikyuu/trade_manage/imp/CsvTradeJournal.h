@@ -0,0 +1,45 @@
+/*
+ * CsvTradeJournal.h
+ *
+ *  Created on: 2017年6月22日
+ *      Author: fasiondog
+ */
+
+#ifndef TRADE_MANAGE_IMP_CSVTRADEJOURNAL_H_
+#define TRADE_MANAGE_IMP_CSVTRADEJOURNAL_H_
+
+#include <fstream>
+#include "../TradeJournalBase.h"
+
+namespace hku {
+
+/**
+ * csv格式的交易流水文件，以追加方式写入，列与TradeManager::tocsv导出的
+ * 交易记录相同（不含当日K线数据）
+ * @see TJ_Csv
+ * @ingroup TradeManagerClass
+ */
+class HKU_API CsvTradeJournal: public TradeJournalBase {
+public:
+    /**
+     * @param filename csv文件名，文件已存在时在其后追加，否则先写入表头
+     */
+    CsvTradeJournal(const string& filename);
+    virtual ~CsvTradeJournal();
+
+    /** csv文件名 */
+    const string& filename() const {
+        return m_filename;
+    }
+
+    virtual void _write(const TradeRecord& record);
+    virtual void flush();
+
+private:
+    string m_filename;
+    std::ofstream m_file;
+};
+
+} /* namespace hku */
+
+#endif /* TRADE_MANAGE_IMP_CSVTRADEJOURNAL_H_ */
@@ -52,8 +52,9 @@ ConditionPtr ConditionBase::clone() {
 
 
 void ConditionBase::setTO(const KData& kdata) {
-    reset();
     m_kdata = kdata;
+    m_valid.setKData(kdata);
+    reset();
     if (!m_sg) {
         HKU_WARN("m_sg is NULL! [ConditionBase::setTO]");
         return;
@@ -64,14 +65,13 @@ void ConditionBase::setTO(const KData& kdata) {
 }
 
 void ConditionBase::_addValid(const Datetime& datetime) {
-    m_valid.insert(datetime);
+    m_valid.set(datetime);
 }
 
-bool ConditionBase::isValid(const Datetime& datetime) {
-    if (m_valid.count(datetime) != 0) {
-        return true;
+void ConditionBase::_addValid(size_t pos) {
+    if (!m_valid.set(pos)) {
+        HKU_WARN("pos out of range! [ConditionBase::_addValid]");
     }
-    return false;
 }
 
 } /* namespace hku */
@@ -8,10 +8,9 @@
 #ifndef CONDITIONBASE_H_
 #define CONDITIONBASE_H_
 
-#include <set>
 #include "../../utilities/Parameter.h"
 #include "../../utilities/util.h"
-#include "../../KData.h"
+#include "../../KDataFlags.h"
 #include "../../trade_manage/TradeManager.h"
 #include "../signal/SignalBase.h"
 
@@ -19,7 +18,8 @@
 #include <boost/serialization/shared_ptr.hpp>
 #include <boost/serialization/assume_abstract.hpp>
 #include <boost/serialization/base_object.hpp>
-#include <boost/serialization/set.hpp>
+#include <boost/serialization/version.hpp>
+#include "../../serialization/KDataFlags_serialization.h"
 #endif
 
 namespace hku {
@@ -70,6 +70,12 @@ public:
      */
     void _addValid(const Datetime& datetime);
 
+    /**
+     * 按K线位置加入有效时间，在_calculate中调用
+     * @param pos 系统有效的K线在交易对象中的位置
+     */
+    void _addValid(size_t pos);
+
     typedef shared_ptr<ConditionBase> ConditionPtr;
     /** 克隆操作 */
     ConditionPtr clone();
@@ -79,7 +85,14 @@ public:
      * @param datetime 指定时间
      * @return true 有效 | false 失效
      */
-    bool isValid(const Datetime& datetime);
+    bool isValid(const Datetime& datetime) const;
+
+    /**
+     * 交易对象中第pos根K线时系统是否有效
+     * @param pos K线位置，越界时返回false
+     * @return true 有效 | false 失效
+     */
+    bool isValid(size_t pos) const;
 
     /** 子类计算接口 */
     virtual void _calculate() = 0;
@@ -95,7 +108,7 @@ protected:
     KData  m_kdata;
     TMPtr m_tm;
     SGPtr m_sg;
-    std::set<Datetime> m_valid;
+    KDataFlags m_valid; //按m_kdata位置对齐
 
 //============================================
 // 序列化支持
@@ -108,9 +121,8 @@ private:
         string name(GBToUTF8(m_name));
         ar & boost::serialization::make_nvp("m_name", name);
         ar & BOOST_SERIALIZATION_NVP(m_params);
+        //m_valid中已包含对齐的K线数据，加载后据此恢复m_kdata
         ar & BOOST_SERIALIZATION_NVP(m_valid);
-        // m_kdata是系统运行时临时设置，不需要序列化
-        //ar & BOOST_SERIALIZATION_NVP(m_ktype);
     }
 
     template<class Archive>
@@ -119,9 +131,13 @@ private:
         ar & boost::serialization::make_nvp("m_name", name);
         m_name = UTF8ToGB(name);
         ar & BOOST_SERIALIZATION_NVP(m_params);
-        ar & BOOST_SERIALIZATION_NVP(m_valid);
-        // m_kdata是系统运行时临时设置，不需要序列化
-        //ar & BOOST_SERIALIZATION_NVP(m_ktype);
+        if (version < 1) {
+            //版本0以std::set<Datetime>保存，不含K线数据，只能按日期查询
+            load_datetime_set(ar, "m_valid", m_valid);
+        } else {
+            ar & BOOST_SERIALIZATION_NVP(m_valid);
+        }
+        m_kdata = m_valid.getKData();
     }
 
     BOOST_SERIALIZATION_SPLIT_MEMBER()
@@ -206,5 +222,19 @@ inline TradeManagerPtr ConditionBase::getTM() const {
     return m_tm;
 }
 
+inline bool ConditionBase::isValid(const Datetime& datetime) const {
+    return m_valid.test(datetime);
+}
+
+inline bool ConditionBase::isValid(size_t pos) const {
+    return m_valid.test(pos);
+}
+
 } /* namespace hku */
+
+#if HKU_SUPPORT_SERIALIZATION
+//版本1：有效时间由std::set<Datetime>改为KDataFlags
+BOOST_CLASS_VERSION(hku::ConditionBase, 1)
+#endif
+
 #endif /* CONDITIONBASE_H_ */
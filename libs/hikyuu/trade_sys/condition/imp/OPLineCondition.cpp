@@ -62,7 +62,7 @@ void OPLineCondition::_calculate() {
     Indicator x = profit - op;
     for (size_t i = 0; i < x.size(); i++) {
         if (x[i] > 0) {
-            _addValid(dates[i]);
+            _addValid(i);
         }
     }
 }
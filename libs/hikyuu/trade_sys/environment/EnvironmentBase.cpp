@@ -57,14 +57,7 @@ void EnvironmentBase::setQuery(const KQuery& query) {
 }
 
 void EnvironmentBase::_addValid(const Datetime& datetime) {
-    m_valid.insert(datetime);
-}
-
-bool EnvironmentBase::isValid(const Datetime& datetime) {
-    if (m_valid.count(datetime) != 0) {
-        return true;
-    }
-    return false;
+    m_valid.set(datetime);
 }
 
 } /* namespace hku */
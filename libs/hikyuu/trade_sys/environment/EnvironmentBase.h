@@ -8,8 +8,8 @@
 #ifndef ENVIRONMENT_H_
 #define ENVIRONMENT_H_
 
-#include <set>
 #include "../../KQuery.h"
+#include "../../KDataFlags.h"
 #include "../../utilities/Parameter.h"
 #include "../../utilities/util.h"
 
@@ -17,8 +17,9 @@
 #include <boost/serialization/shared_ptr.hpp>
 #include <boost/serialization/assume_abstract.hpp>
 #include <boost/serialization/base_object.hpp>
-#include <boost/serialization/set.hpp>
+#include <boost/serialization/version.hpp>
 #include "../../serialization/Datetime_serialization.h"
+#include "../../serialization/KDataFlags_serialization.h"
 #include "../../serialization/KQuery_serialization.h"
 #endif
 
@@ -73,7 +74,18 @@ public:
      * @param datetime 指定日期
      * @return true 有效 | false 无效
      */
-    bool isValid(const Datetime& datetime);
+    bool isValid(const Datetime& datetime) const {
+        return m_valid.test(datetime);
+    }
+
+    /**
+     * 获取按指定K线数据位置对齐的有效标记，供系统逐根K线按位置判断
+     * @param kdata 交易对象的K线数据
+     * @return 第i位表示kdata[i]对应日期的外部环境是否有效
+     */
+    boost::dynamic_bitset<> getValidMask(const KData& kdata) const {
+        return m_valid.align(kdata);
+    }
 
     /** 子类计算接口 */
     virtual void _calculate() = 0;
@@ -87,7 +99,7 @@ public:
 protected:
     string m_name;
     KQuery m_query;
-    std::set<Datetime> m_valid;
+    KDataFlags m_valid; //外部环境与交易对象无关，全部按日期保存
 
 //============================================
 // 序列化支持
@@ -110,8 +122,14 @@ private:
         string name;
         ar & boost::serialization::make_nvp("m_name", name);
         m_name = UTF8ToGB(name);
+        ar & BOOST_SERIALIZATION_NVP(m_params);
         ar & BOOST_SERIALIZATION_NVP(m_query);
-        ar & BOOST_SERIALIZATION_NVP(m_valid);
+        if (version < 1) {
+            //版本0以std::set<Datetime>保存
+            load_datetime_set(ar, "m_valid", m_valid);
+        } else {
+            ar & BOOST_SERIALIZATION_NVP(m_valid);
+        }
     }
 
     BOOST_SERIALIZATION_SPLIT_MEMBER()
@@ -170,4 +188,10 @@ HKU_API std::ostream& operator <<(std::ostream &os, const EnvironmentPtr&);
 HKU_API std::ostream& operator <<(std::ostream &os, const EnvironmentBase&);
 
 } /* namespace hku */
+
+#if HKU_SUPPORT_SERIALIZATION
+//版本1：有效日期由std::set<Datetime>改为KDataFlags
+BOOST_CLASS_VERSION(hku::EnvironmentBase, 1)
+#endif
+
 #endif /* ENVIRONMENT_H_ */
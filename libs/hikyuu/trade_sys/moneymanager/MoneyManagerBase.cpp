@@ -25,13 +25,15 @@ HKU_API std::ostream & operator<<(std::ostream& os, const MoneyManagerPtr& mm) {
 }
 
 MoneyManagerBase::MoneyManagerBase()
-: m_name("MoneyManagerBase") {
+: m_name("MoneyManagerBase"), m_param_auto_checkin("auto-checkin"),
+  m_param_max_stock("max-stock") {
     setParam<bool>("auto-checkin", false);
     setParam<int>("max-stock", 200);
 }
 
 MoneyManagerBase::MoneyManagerBase(const string& name)
-: m_name(name) {
+: m_name(name), m_param_auto_checkin("auto-checkin"),
+  m_param_max_stock("max-stock") {
     setParam<bool>("auto-checkin", false);
     setParam<int>("max-stock", 200);
 }
@@ -103,7 +105,7 @@ size_t MoneyManagerBase
         return 0;
     }
 
-    if (m_tm->getStockNumber() >= getParam<int>("max-stock")) {
+    if (m_tm->getStockNumber() >= m_param_max_stock.get(m_params)) {
         return 0;
     }
 
@@ -125,7 +127,7 @@ size_t MoneyManagerBase
     }
 
     //在现金不足时，自动补充存入现金
-    if (getParam<bool>("auto-checkin")) {
+    if (m_param_auto_checkin.get(m_params)) {
         price_t cash = m_tm->currentCash();
         CostRecord cost = m_tm->getBuyCost(datetime, stock, price, n);
         price_t money = price * n + cost.total;
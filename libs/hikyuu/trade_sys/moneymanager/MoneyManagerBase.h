@@ -139,6 +139,10 @@ protected:
     KQuery m_query;
     TradeManagerPtr m_tm;
 
+private:
+    CachedParam<bool> m_param_auto_checkin;
+    CachedParam<int>  m_param_max_stock;
+
 //============================================
 // 序列化支持
 //============================================
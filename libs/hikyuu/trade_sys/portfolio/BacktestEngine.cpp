@@ -0,0 +1,129 @@
+/*
+ * BacktestEngine.cpp
+ *
+ *  Created on: 2017年6月23日
+ *      Author: fasiondog
+ */
+
+#include <queue>
+#include "BacktestEngine.h"
+
+namespace hku {
+
+BacktestEngine::BacktestEngine(): m_event_count(0) {
+
+}
+
+BacktestEngine::BacktestEngine(const TradeManagerPtr& tm,
+        const SystemPtr& sys)
+: m_tm(tm), m_sys(sys), m_event_count(0) {
+
+}
+
+BacktestEngine::~BacktestEngine() {
+
+}
+
+void BacktestEngine::addStock(const Stock& stock) {
+    if (stock.isNull()) {
+        HKU_WARN("Try add Null stock, will be discard! "
+                "[BacktestEngine::addStock]");
+        return;
+    }
+
+    for (size_t i = 0; i < m_stock_list.size(); ++i) {
+        if (m_stock_list[i] == stock) {
+            return;
+        }
+    }
+    m_stock_list.push_back(stock);
+}
+
+void BacktestEngine::addStockList(const StockList& stock_list) {
+    m_stock_list.reserve(m_stock_list.size() + stock_list.size());
+    for (size_t i = 0; i < stock_list.size(); ++i) {
+        addStock(stock_list[i]);
+    }
+}
+
+void BacktestEngine::run(const KQuery& query) {
+    m_sys_list.clear();
+    m_event_count = 0;
+
+    if (!m_tm) {
+        HKU_ERROR("m_tm is null! [BacktestEngine::run]");
+        return;
+    }
+
+    if (!m_sys) {
+        HKU_ERROR("m_sys is null! [BacktestEngine::run]");
+        return;
+    }
+
+    m_tm->reset();
+    Datetime init_datetime = m_tm->initDatetime();
+
+    //为每只证券克隆系统并共享账户，同时定位各系统第一根需要运行的K线
+    vector<KData> kdata_list;
+    vector<size_t> cursor;
+    kdata_list.reserve(m_stock_list.size());
+    cursor.reserve(m_stock_list.size());
+    m_sys_list.reserve(m_stock_list.size());
+    for (size_t i = 0; i < m_stock_list.size(); ++i) {
+        KData kdata = m_stock_list[i].getKData(query);
+        if (kdata.empty()) {
+            continue;
+        }
+
+        SystemPtr sys = m_sys->clone();
+        sys->reset();
+        sys->setTM(m_tm);
+        if (!sys->readyForRun()) {
+            m_sys_list.clear();
+            return;
+        }
+        sys->setTO(kdata);
+
+        size_t pos = 0, total = kdata.size();
+        while (pos < total && kdata[pos].datetime < init_datetime) {
+            pos++;
+        }
+
+        m_sys_list.push_back(sys);
+        kdata_list.push_back(kdata);
+        cursor.push_back(pos);
+    }
+
+    //全局时钟：按(下一根K线时间, 系统序号)的最小堆归并各系统的K线，
+    //同一时刻按系统序号即证券加入顺序派发
+    typedef std::pair<Datetime, size_t> BarEvent;
+    std::priority_queue<BarEvent, vector<BarEvent>,
+                        std::greater<BarEvent> > clock;
+    for (size_t i = 0; i < m_sys_list.size(); ++i) {
+        if (cursor[i] < kdata_list[i].size()) {
+            clock.push(BarEvent(kdata_list[i][cursor[i]].datetime, i));
+        }
+    }
+
+    while (!clock.empty()) {
+        Datetime current = clock.top().first;
+
+        //同一时刻的所有系统共享一次权息处理
+        m_tm->updateWeight(current);
+
+        while (!clock.empty() && clock.top().first == current) {
+            size_t i = clock.top().second;
+            clock.pop();
+
+            m_sys_list[i]->runMomentAt(cursor[i]);
+            m_event_count++;
+
+            size_t next = ++cursor[i];
+            if (next < kdata_list[i].size()) {
+                clock.push(BarEvent(kdata_list[i][next].datetime, i));
+            }
+        }
+    }
+}
+
+} /* namespace hku */
@@ -0,0 +1,75 @@
+/*
+ * BacktestEngine.h
+ *
+ *  Created on: 2017年6月23日
+ *      Author: fasiondog
+ */
+
+#ifndef TRADE_SYS_PORTFOLIO_BACKTESTENGINE_H_
+#define TRADE_SYS_PORTFOLIO_BACKTESTENGINE_H_
+
+#include "../system/System.h"
+
+namespace hku {
+
+/**
+ * 多证券共享账户的事件驱动回测引擎
+ * @details 以模板系统为每只证券克隆一个系统，所有系统共享同一交易管理实例。
+ *          运行时各系统的K线时间按时间顺序归并为全局时钟，每个时刻只向在该
+ *          时刻有K线的系统按K线位置派发，无需按日期查找K线；同一时刻先统一
+ *          处理一次账户权息，再按证券加入的顺序依次运行各系统。运行开销只与
+ *          实际的K线数量有关，而与交易日历长度×证券数量无关。如:
+ * <pre>
+ * BacktestEngine engine(tm, sys);
+ * engine.addStockList(stocks);
+ * engine.run(KQuery(-2500));
+ * engine.getTM()->getTradeList();
+ * </pre>
+ * @note 与Portfolio不同，不进行选股和资金分配，所有证券的系统在其每根K线上均运行
+ * @ingroup Portfolio
+ */
+class HKU_API BacktestEngine {
+public:
+    BacktestEngine();
+    BacktestEngine(const TradeManagerPtr& tm, const SystemPtr& sys);
+    virtual ~BacktestEngine();
+
+    TradeManagerPtr getTM() const { return m_tm; }
+    void setTM(const TradeManagerPtr& tm) { m_tm = tm; }
+
+    /** 获取模板系统，运行时不会修改该系统 */
+    SystemPtr getSYS() const { return m_sys; }
+    void setSYS(const SystemPtr& sys) { m_sys = sys; }
+
+    /** 加入证券，忽略空证券及重复加入的证券 */
+    void addStock(const Stock& stock);
+    void addStockList(const StockList& stock_list);
+
+    const StockList& getStockList() const { return m_stock_list; }
+    void clearStockList() { m_stock_list.clear(); }
+
+    /**
+     * 运行回测，运行前复位交易管理实例
+     * @param query 各证券的K线查询条件
+     */
+    void run(const KQuery& query);
+
+    /** 最近一次运行中各证券对应的系统，按加入顺序，不含无K线数据的证券 */
+    const SystemList& getSystemList() const { return m_sys_list; }
+
+    /** 最近一次运行中派发的K线事件总数 */
+    size_t getEventCount() const { return m_event_count; }
+
+private:
+    TradeManagerPtr m_tm;
+    SystemPtr m_sys;
+    StockList m_stock_list;
+    SystemList m_sys_list;
+    size_t m_event_count;
+};
+
+typedef shared_ptr<BacktestEngine> BacktestEnginePtr;
+
+} /* namespace hku */
+
+#endif /* TRADE_SYS_PORTFOLIO_BACKTESTENGINE_H_ */
@@ -0,0 +1,86 @@
+/*
+ * ParallelRunner.cpp
+ *
+ *  Created on: 2017年6月23日
+ *      Author: fasiondog
+ */
+
+#include "../../utilities/Parallel.h"
+#include "../../indicator/IndicatorArena.h"
+#include "../../trade_manage/crt/crtTM.h"
+#include "ParallelRunner.h"
+
+namespace hku {
+
+ParallelRunner::ParallelRunner() {
+
+}
+
+ParallelRunner::ParallelRunner(const SystemPtr& sys): m_sys(sys) {
+
+}
+
+ParallelRunner::~ParallelRunner() {
+
+}
+
+void ParallelRunner::addStock(const Stock& stock) {
+    if (stock.isNull()) {
+        HKU_WARN("Try add Null stock, will be discard! "
+                "[ParallelRunner::addStock]");
+        return;
+    }
+
+    for (size_t i = 0; i < m_stock_list.size(); ++i) {
+        if (m_stock_list[i] == stock) {
+            return;
+        }
+    }
+    m_stock_list.push_back(stock);
+}
+
+void ParallelRunner::addStockList(const StockList& stock_list) {
+    m_stock_list.reserve(m_stock_list.size() + stock_list.size());
+    for (size_t i = 0; i < stock_list.size(); ++i) {
+        addStock(stock_list[i]);
+    }
+}
+
+TradeManagerPtr ParallelRunner::run(const KQuery& query, size_t threads) {
+    m_sys_list.clear();
+
+    if (!m_sys || !m_sys->getTM() || !m_sys->getMM() || !m_sys->getSG()) {
+        HKU_ERROR("System is incomplete! [ParallelRunner::run]");
+        return TradeManagerPtr();
+    }
+
+    //在调用线程中读取K线数据并完成所有克隆，避免多个线程同时读取模板系统
+    vector<KData> kdata_list;
+    kdata_list.reserve(m_stock_list.size());
+    m_sys_list.reserve(m_stock_list.size());
+    for (size_t i = 0; i < m_stock_list.size(); ++i) {
+        KData kdata = m_stock_list[i].getKData(query);
+        if (!kdata.empty()) {
+            kdata_list.push_back(kdata);
+            m_sys_list.push_back(m_sys->clone());
+        }
+    }
+
+    if (m_sys_list.empty()) {
+        HKU_WARN("All KData is empty! [ParallelRunner::run]");
+        return TradeManagerPtr();
+    }
+
+    parallel_for(m_sys_list.size(), threads, [&](size_t i) {
+        IndicatorArena arena;
+        m_sys_list[i]->run(kdata_list[i]);
+    });
+
+    TradeManagerList tm_list(m_sys_list.size());
+    for (size_t i = 0; i < m_sys_list.size(); ++i) {
+        tm_list[i] = m_sys_list[i]->getTM();
+    }
+    return crtTMFromMerge(tm_list, m_sys->getTM()->name());
+}
+
+} /* namespace hku */
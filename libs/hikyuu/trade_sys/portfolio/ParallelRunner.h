@@ -0,0 +1,71 @@
+/*
+ * ParallelRunner.h
+ *
+ *  Created on: 2017年6月23日
+ *      Author: fasiondog
+ */
+
+#ifndef TRADE_SYS_PORTFOLIO_PARALLELRUNNER_H_
+#define TRADE_SYS_PORTFOLIO_PARALLELRUNNER_H_
+
+#include "../system/System.h"
+
+namespace hku {
+
+/**
+ * 各证券独立资金的多证券并行运行
+ * @details 以模板系统为每只证券克隆一个系统，每个系统使用模板中交易管理实例的
+ *          克隆，即各证券的初始资金均与模板账户相同、互不影响。各系统在多个
+ *          线程中并行运行，完成后按证券加入的顺序合并为一个汇总账户，可用于
+ *          统计整体绩效。如:
+ * <pre>
+ * ParallelRunner runner(sys);
+ * runner.addStockList(stocks);
+ * TradeManagerPtr tm = runner.run(KQuery(-2500));
+ * Performance per;
+ * per.statistics(tm, Datetime::now());
+ * </pre>
+ * @note 合并结果只与证券加入的顺序有关，与线程数及调度无关
+ * @see crtTMFromMerge, BacktestEngine
+ * @ingroup Portfolio
+ */
+class HKU_API ParallelRunner {
+public:
+    ParallelRunner();
+    ParallelRunner(const SystemPtr& sys);
+    virtual ~ParallelRunner();
+
+    /** 获取模板系统，运行时不会修改该系统 */
+    SystemPtr getSYS() const { return m_sys; }
+    void setSYS(const SystemPtr& sys) { m_sys = sys; }
+
+    /** 加入证券，忽略空证券及重复加入的证券 */
+    void addStock(const Stock& stock);
+    void addStockList(const StockList& stock_list);
+
+    const StockList& getStockList() const { return m_stock_list; }
+    void clearStockList() { m_stock_list.clear(); }
+
+    /**
+     * 运行所有证券的系统并合并账户
+     * @param query 各证券的K线查询条件
+     * @param threads 线程数，为0时使用default_thread_count()
+     * @return 汇总账户，系统不完整或所有证券均无K线数据时返回空指针
+     */
+    TradeManagerPtr run(const KQuery& query, size_t threads = 0);
+
+    /**
+     * 最近一次运行中各证券对应的系统，按加入顺序，不含无K线数据的证券，
+     * 各系统的交易管理实例即合并前的独立账户
+     */
+    const SystemList& getSystemList() const { return m_sys_list; }
+
+private:
+    SystemPtr m_sys;
+    StockList m_stock_list;
+    SystemList m_sys_list;
+};
+
+} /* namespace hku */
+
+#endif /* TRADE_SYS_PORTFOLIO_PARALLELRUNNER_H_ */
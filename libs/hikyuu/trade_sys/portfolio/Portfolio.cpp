@@ -123,14 +123,20 @@ void Portfolio::run(const KQuery& query) {
     map<hku_uint64, SystemPtr>::iterator stock_map_iter;
 
     SystemList pre_selected_sys;
+    vector<hku_uint64> position_ids; //当前持仓股的id，在各交易日间复用
     DatetimeList datelist = StockManager::instance().getTradingCalendar(query);
     DatetimeList::const_iterator date_iter = datelist.begin();
     for(; date_iter != datelist.end(); ++date_iter) {
-        //处理当前持仓股
-        PositionRecordList positions = m_tm->getPositionList();
-        PositionRecordList::const_iterator pos_iter = positions.begin();
+        //处理当前持仓股，运行中可能卖出持仓，先取出持仓股的id，无需复制持仓记录
+        const TradeManager::position_map_type& positions = m_tm->getPositionMap();
+        position_ids.clear();
+        TradeManager::position_map_type::const_iterator pos_iter = positions.begin();
         for (; pos_iter != positions.end(); ++pos_iter) {
-            stock_map_iter = stock_map_buffer.find(pos_iter->stock.id());
+            position_ids.push_back(pos_iter->first);
+        }
+
+        for (size_t i = 0; i < position_ids.size(); ++i) {
+            stock_map_iter = stock_map_buffer.find(position_ids[i]);
             //有可能TM中已经存在持仓的股票，而该股票并不在预定的股票范围内，则忽略
             if (stock_map_iter != stock_map_buffer.end()) {
                 stock_map_iter->second->runMoment(*date_iter);
@@ -10,5 +10,7 @@
 
 #include "AllocateMoneyBase.h"
 #include "Portfolio.h"
+#include "BacktestEngine.h"
+#include "ParallelRunner.h"
 
 #endif /* TRADE_SYS_PORTFOLIO_BUILD_IN_H_ */
@@ -45,6 +45,17 @@ ProfitGoalPtr ProfitGoalBase::clone() {
 }
 
 
+price_t ProfitGoalBase::getGoalAt(size_t pos, price_t price) {
+    return pos < m_kdata.size() ? getGoal(m_kdata[pos].datetime, price) : 0.0;
+}
+
+
+price_t ProfitGoalBase::getShortGoalAt(size_t pos, price_t price) {
+    return pos < m_kdata.size()
+           ? getShortGoal(m_kdata[pos].datetime, price) : 0.0;
+}
+
+
 void ProfitGoalBase::setTO(const KData& kdata) {
     reset();
     m_kdata = kdata;
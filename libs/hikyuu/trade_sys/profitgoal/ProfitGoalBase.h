@@ -71,6 +71,20 @@ public:
         return 0.0;
     }
 
+    /**
+     * 按交易对象中的K线位置计算买入时的目标价格，供系统逐根K线运行时使用
+     * @param pos 在交易对象中的位置
+     * @param price 买入价格
+     * @note 默认实现按第pos根K线的日期调用getGoal，越界时返回0
+     */
+    virtual price_t getGoalAt(size_t pos, price_t price);
+
+    /**
+     * 按交易对象中的K线位置计算卖空时的目标价格
+     * @note 默认实现按第pos根K线的日期调用getShortGoal，越界时返回0
+     */
+    virtual price_t getShortGoalAt(size_t pos, price_t price);
+
     /** 子类复位接口 */
     virtual void _reset() {}
 
@@ -26,6 +26,10 @@ price_t FixedPercentProfitGoal::getGoal(const Datetime& datetime, price_t price)
     return price * (1 + getParam<double>("p"));
 }
 
+price_t FixedPercentProfitGoal::getGoalAt(size_t pos, price_t price) {
+    return price * (1 + getParam<double>("p"));
+}
+
 ProfitGoalPtr HKU_API PG_FixedPercent(double p) {
     FixedPercentProfitGoal *ptr = new FixedPercentProfitGoal;
     ptr->setParam<double>("p", p);
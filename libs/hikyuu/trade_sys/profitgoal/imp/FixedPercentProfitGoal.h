@@ -19,6 +19,8 @@ class FixedPercentProfitGoal: public ProfitGoalBase {
 public:
     FixedPercentProfitGoal();
     virtual ~FixedPercentProfitGoal();
+
+    virtual price_t getGoalAt(size_t pos, price_t price);
 };
 
 } /* namespace hku */
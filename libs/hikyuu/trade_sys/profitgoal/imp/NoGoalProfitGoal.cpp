@@ -25,6 +25,10 @@ price_t NoGoalProfitGoal::getGoal(const Datetime& datetime, price_t price) {
     return 0.0;
 }
 
+price_t NoGoalProfitGoal::getGoalAt(size_t pos, price_t price) {
+    return 0.0;
+}
+
 ProfitGoalPtr HKU_API PG_NoGoal() {
     return ProfitGoalPtr(new NoGoalProfitGoal);
 }
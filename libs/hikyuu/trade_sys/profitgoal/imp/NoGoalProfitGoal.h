@@ -19,6 +19,8 @@ class NoGoalProfitGoal: public ProfitGoalBase {
 public:
     NoGoalProfitGoal();
     virtual ~NoGoalProfitGoal();
+
+    virtual price_t getGoalAt(size_t pos, price_t price);
 };
 
 } /* namespace hku */
@@ -25,11 +25,13 @@ HKU_API std::ostream & operator<<(std::ostream& os, const SignalPtr& sg) {
 }
 
 
-SignalBase::SignalBase() : m_name("SignalBase"), m_hold(false) {
+SignalBase::SignalBase()
+: m_name("SignalBase"), m_hold(false), m_param_alternate("alternate") {
     setParam<bool>("alternate", true); //买入卖出信号交替出现
 }
 
-SignalBase::SignalBase(const string& name): m_name(name), m_hold(false) {
+SignalBase::SignalBase(const string& name)
+: m_name(name), m_hold(false), m_param_alternate("alternate") {
     setParam<bool>("alternate", true);
 }
 
@@ -51,8 +53,10 @@ SignalPtr SignalBase::clone() {
 
 
 void SignalBase::setTO(const KData& kdata) {
-    reset();
     m_kdata = kdata;
+    m_buySig.setKData(kdata);
+    m_sellSig.setKData(kdata);
+    reset();
     if (!kdata.empty()) {
         _calculate();
     }
@@ -68,45 +72,55 @@ void SignalBase::reset() {
 
 
 DatetimeList SignalBase::getBuySignal() const {
-    DatetimeList result;
-    result.reserve(m_buySig.size());
-    std::set<Datetime>::const_iterator iter = m_buySig.begin();
-    for (; iter != m_buySig.end(); ++iter) {
-        result.push_back(*iter);
-    }
-    return result;
+    return m_buySig.getDatetimeList();
 }
 
 
 DatetimeList SignalBase::getSellSignal() const {
-    DatetimeList result;
-    result.reserve(m_sellSig.size());
-    std::set<Datetime>::const_iterator iter = m_sellSig.begin();
-    for (; iter != m_sellSig.end(); ++iter) {
-        result.push_back(*iter);
+    return m_sellSig.getDatetimeList();
+}
+
+bool SignalBase::_acceptSignal(bool buy) {
+    if (!m_param_alternate.get(m_params)) {
+        return true;
     }
-    return result;
+
+    if (m_hold == buy) {
+        return false;
+    }
+    m_hold = buy;
+    return true;
 }
 
 void SignalBase::_addBuySignal(const Datetime& datetime) {
-    if (!getParam<bool>("alternate")) {
-        m_buySig.insert(datetime);
-    } else {
-        if (!m_hold) {
-            m_buySig.insert(datetime);
-            m_hold = true;
-        }
+    if (_acceptSignal(true)) {
+        m_buySig.set(datetime);
+    }
+}
+
+void SignalBase::_addBuySignal(size_t pos) {
+    if (pos >= m_kdata.size()) {
+        HKU_WARN("pos out of range! [SignalBase::_addBuySignal]");
+        return;
+    }
+    if (_acceptSignal(true)) {
+        m_buySig.set(pos);
     }
 }
 
 void SignalBase::_addSellSignal(const Datetime& datetime) {
-    if (!getParam<bool>("alternate")) {
-        m_sellSig.insert(datetime);
-    } else {
-        if (m_hold) {
-            m_sellSig.insert(datetime);
-            m_hold = false;
-        }
+    if (_acceptSignal(false)) {
+        m_sellSig.set(datetime);
+    }
+}
+
+void SignalBase::_addSellSignal(size_t pos) {
+    if (pos >= m_kdata.size()) {
+        HKU_WARN("pos out of range! [SignalBase::_addSellSignal]");
+        return;
+    }
+    if (_acceptSignal(false)) {
+        m_sellSig.set(pos);
     }
 }
 
@@ -8,17 +8,17 @@
 #ifndef SIGNALBASE_H_
 #define SIGNALBASE_H_
 
-#include <set>
-#include "../../KData.h"
+#include "../../KDataFlags.h"
 #include "../../utilities/Parameter.h"
 #include "../../trade_manage/TradeManager.h"
 #include "../../serialization/Datetime_serialization.h"
+#include "../../serialization/KDataFlags_serialization.h"
 
 #if HKU_SUPPORT_SERIALIZATION
 #include <boost/serialization/shared_ptr.hpp>
-#include <boost/serialization/set.hpp>
 #include <boost/serialization/assume_abstract.hpp>
 #include <boost/serialization/base_object.hpp>
+#include <boost/serialization/version.hpp>
 #endif
 
 namespace hku {
@@ -42,6 +42,13 @@ public:
      */
     bool shouldBuy(const Datetime& datetime) const;
 
+    /**
+     * 交易对象中第pos根K线是否可以买入
+     * @param pos K线位置，越界时返回false
+     * @return true 可以买入 | false 不可买入
+     */
+    bool shouldBuy(size_t pos) const;
+
     /**
      * 指定时刻是否可以卖出
      * @param datetime 指定时刻
@@ -49,6 +56,19 @@ public:
      */
     bool shouldSell(const Datetime& datetime) const;
 
+    /**
+     * 交易对象中第pos根K线是否可以卖出
+     * @param pos K线位置，越界时返回false
+     * @return true 可以卖出 | false 不可卖出
+     */
+    bool shouldSell(size_t pos) const;
+
+    /**
+     * 查找交易对象中第pos根及其之后第一根存在买入或卖出信号的K线
+     * @return K线位置，不存在时返回Null<size_t>()
+     */
+    size_t findNextSignal(size_t pos) const;
+
     /** 获取所有买入指示日期列表 */
     DatetimeList getBuySignal() const;
 
@@ -61,12 +81,24 @@ public:
      */
     void _addBuySignal(const Datetime& datetime);
 
+    /**
+     * 按K线位置加入买入信号，在_calculate中调用
+     * @param pos 发生买入信号的K线在交易对象中的位置
+     */
+    void _addBuySignal(size_t pos);
+
     /**
      * 加入卖出信号，在_calculate中调用
      * @param datetime
      */
     void _addSellSignal(const Datetime& datetime);
 
+    /**
+     * 按K线位置加入卖出信号，在_calculate中调用
+     * @param pos 发生卖出信号的K线在交易对象中的位置
+     */
+    void _addSellSignal(size_t pos);
+
     /**
      * 指定交易对象，指K线数据
      * @param kdata 指定的交易对象
@@ -105,8 +137,14 @@ protected:
     string m_name;
     KData  m_kdata;
     bool   m_hold;
-    std::set<Datetime> m_buySig;
-    std::set<Datetime> m_sellSig;
+    KDataFlags m_buySig;  //按m_kdata位置对齐
+    KDataFlags m_sellSig;
+
+private:
+    //按买入卖出交替的要求判断是否可加入信号，并更新持仓状态
+    bool _acceptSignal(bool buy);
+
+    CachedParam<bool> m_param_alternate;
 
 //============================================
 // 序列化支持
@@ -120,10 +158,9 @@ private:
         ar & boost::serialization::make_nvp("name", name_str);
         ar & BOOST_SERIALIZATION_NVP(m_params);
         ar & BOOST_SERIALIZATION_NVP(m_hold);
+        //信号中已包含对齐的K线数据，加载后据此恢复m_kdata
         ar & BOOST_SERIALIZATION_NVP(m_buySig);
         ar & BOOST_SERIALIZATION_NVP(m_sellSig);
-        // m_kdata都是系统运行时临时设置，不需要序列化
-        //ar & BOOST_SERIALIZATION_NVP(m_kdata);
     }
 
     template<class Archive>
@@ -131,10 +168,15 @@ private:
         ar & boost::serialization::make_nvp("name", m_name);
         ar & BOOST_SERIALIZATION_NVP(m_params);
         ar & BOOST_SERIALIZATION_NVP(m_hold);
-        ar & BOOST_SERIALIZATION_NVP(m_buySig);
-        ar & BOOST_SERIALIZATION_NVP(m_sellSig);
-        // m_kdata都是系统运行时临时设置，不需要序列化
-        //ar & BOOST_SERIALIZATION_NVP(m_kdata);
+        if (version < 1) {
+            //版本0以std::set<Datetime>保存信号，不含K线数据，只能按日期查询
+            load_datetime_set(ar, "m_buySig", m_buySig);
+            load_datetime_set(ar, "m_sellSig", m_sellSig);
+        } else {
+            ar & BOOST_SERIALIZATION_NVP(m_buySig);
+            ar & BOOST_SERIALIZATION_NVP(m_sellSig);
+        }
+        m_kdata = m_buySig.getKData();
     }
 
     BOOST_SERIALIZATION_SPLIT_MEMBER()
@@ -201,12 +243,32 @@ inline void SignalBase::name(const string& name) {
 }
 
 inline bool SignalBase::shouldBuy(const Datetime& datetime) const {
-    return m_buySig.count(datetime) ? true : false;
+    return m_buySig.test(datetime);
+}
+
+inline bool SignalBase::shouldBuy(size_t pos) const {
+    return m_buySig.test(pos);
 }
 
 inline bool SignalBase::shouldSell(const Datetime& datetime) const {
-    return m_sellSig.count(datetime) ? true : false;
+    return m_sellSig.test(datetime);
+}
+
+inline bool SignalBase::shouldSell(size_t pos) const {
+    return m_sellSig.test(pos);
+}
+
+inline size_t SignalBase::findNextSignal(size_t pos) const {
+    size_t buy = m_buySig.findNext(pos);
+    size_t sell = m_sellSig.findNext(pos);
+    return buy < sell ? buy : sell;
 }
 
 } /* namespace hku */
+
+#if HKU_SUPPORT_SERIALIZATION
+//版本1：买入、卖出信号由std::set<Datetime>改为KDataFlags
+BOOST_CLASS_VERSION(hku::SignalBase, 1)
+#endif
+
 #endif /* SIGNALBASE_H_ */
@@ -47,8 +47,8 @@ void BoolSignal::_calculate() {
 
     size_t total = buy.size();
     for (size_t i = discard; i < total; ++i) {
-        if (buy[i] > 0.0) _addBuySignal(m_kdata[i].datetime);
-        if (sell[i] > 0.0) _addSellSignal(m_kdata[i].datetime);
+        if (buy[i] > 0.0) _addBuySignal(i);
+        if (sell[i] > 0.0) _addSellSignal(i);
     }
 }
 
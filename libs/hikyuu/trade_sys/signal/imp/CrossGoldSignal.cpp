@@ -53,12 +53,12 @@ void CrossGoldSignal::_calculate() {
                 fast[i] > slow[i] &&
                 fast[i-1] < fast[i] &&
                 slow[i-1] < slow[i]) {
-            _addBuySignal(m_kdata[i].datetime);
+            _addBuySignal(i);
         } else if (fast[i-1] > slow[i-1] &&
                 fast[i] < slow[i] &&
                 fast[i-1] > fast[i] &&
                 slow[i-1] > slow[i]) {
-            _addSellSignal(m_kdata[i].datetime);
+            _addSellSignal(i);
         }
     }
 }
@@ -49,9 +49,9 @@ void CrossSignal::_calculate() {
     size_t total = fast.size();
     for (size_t i = discard + 1; i < total; ++i) {
         if (fast[i-1] < slow[i-1] && fast[i] > slow[i]) {
-            _addBuySignal(m_kdata[i].datetime);
+            _addBuySignal(i);
         } else if (fast[i-1] > slow[i-1] && fast[i] < slow[i]) {
-            _addSellSignal(m_kdata[i].datetime);
+            _addSellSignal(i);
         }
     }
 }
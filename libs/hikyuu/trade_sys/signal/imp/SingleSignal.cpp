@@ -55,9 +55,9 @@ void SingleSignal::_calculate() {
         double dama3 = ind[i] - ind[i-3];
         double sdama = dev[i] * filter_p;
         if (dama > 0 && (dama > sdama || dama2 > sdama || dama3 > sdama)) {
-            _addBuySignal(m_kdata[i].datetime);
+            _addBuySignal(i);
         } else if (dama < 0 && (dama < sdama || dama2 < sdama || dama3 < sdama)) {
-            _addSellSignal(m_kdata[i].datetime);
+            _addSellSignal(i);
         }
     }
 }
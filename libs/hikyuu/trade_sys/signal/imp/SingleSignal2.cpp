@@ -57,9 +57,9 @@ void SingleSignal2::_calculate() {
     for (size_t i = start; i < total; ++i) {
         double filter = filter_p * dev[i];
         if (buy[i] > filter) {
-            _addBuySignal(m_kdata[i].datetime);
+            _addBuySignal(i);
         } else if (sell[i] > filter) {
-            _addSellSignal(m_kdata[i].datetime);
+            _addSellSignal(i);
         }
     }
 }
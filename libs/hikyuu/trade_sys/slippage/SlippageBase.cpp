@@ -39,6 +39,16 @@ SlippagePtr SlippageBase::clone() {
     return p;
 }
 
+price_t SlippageBase::getRealBuyPriceAt(size_t pos, price_t planPrice) {
+    return pos < m_kdata.size()
+           ? getRealBuyPrice(m_kdata[pos].datetime, planPrice) : planPrice;
+}
+
+price_t SlippageBase::getRealSellPriceAt(size_t pos, price_t planPrice) {
+    return pos < m_kdata.size()
+           ? getRealSellPrice(m_kdata[pos].datetime, planPrice) : planPrice;
+}
+
 void SlippageBase::setTO(const KData& kdata) {
     reset();
     m_kdata = kdata;
@@ -69,6 +69,20 @@ public:
     virtual price_t getRealSellPrice(const Datetime& datetime,
             price_t planPrice) = 0;
 
+    /**
+     * 按交易对象中的K线位置计算实际买入价格，供系统逐根K线运行时使用
+     * @param pos 在交易对象中的位置
+     * @param planPrice 计划买入价格
+     * @note 默认实现按第pos根K线的日期调用getRealBuyPrice，越界时返回planPrice
+     */
+    virtual price_t getRealBuyPriceAt(size_t pos, price_t planPrice);
+
+    /**
+     * 按交易对象中的K线位置计算实际卖出价格
+     * @note 默认实现按第pos根K线的日期调用getRealSellPrice，越界时返回planPrice
+     */
+    virtual price_t getRealSellPriceAt(size_t pos, price_t planPrice);
+
     /** 子类克隆接口 */
     virtual SlippagePtr _clone() = 0;
 
@@ -27,6 +27,14 @@ price_t FixedPercentSlippage
     return price * (1 - getParam<double>("p"));
 }
 
+price_t FixedPercentSlippage::getRealBuyPriceAt(size_t pos, price_t price) {
+    return price * (1 + getParam<double>("p"));
+}
+
+price_t FixedPercentSlippage::getRealSellPriceAt(size_t pos, price_t price) {
+    return price * (1 - getParam<double>("p"));
+}
+
 void FixedPercentSlippage::_calculate() {
 
 }
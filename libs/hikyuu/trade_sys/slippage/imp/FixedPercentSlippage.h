@@ -19,6 +19,9 @@ class FixedPercentSlippage: public SlippageBase {
 public:
     FixedPercentSlippage();
     virtual ~FixedPercentSlippage();
+
+    virtual price_t getRealBuyPriceAt(size_t pos, price_t price);
+    virtual price_t getRealSellPriceAt(size_t pos, price_t price);
 };
 
 } /* namespace hku */
@@ -27,6 +27,14 @@ price_t FixedValueSlippage
     return price - getParam<double>("value");
 }
 
+price_t FixedValueSlippage::getRealBuyPriceAt(size_t pos, price_t price) {
+    return price + getParam<double>("value");
+}
+
+price_t FixedValueSlippage::getRealSellPriceAt(size_t pos, price_t price) {
+    return price - getParam<double>("value");
+}
+
 void FixedValueSlippage::_calculate() {
 
 }
@@ -19,6 +19,9 @@ class FixedValueSlippage: public SlippageBase {
 public:
     FixedValueSlippage();
     virtual ~FixedValueSlippage();
+
+    virtual price_t getRealBuyPriceAt(size_t pos, price_t price);
+    virtual price_t getRealSellPriceAt(size_t pos, price_t price);
 };
 
 } /* namespace hku */
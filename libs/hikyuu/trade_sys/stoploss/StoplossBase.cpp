@@ -45,6 +45,17 @@ StoplossPtr StoplossBase::clone() {
 }
 
 
+price_t StoplossBase::getPriceAt(size_t pos, price_t price) {
+    return pos < m_kdata.size() ? getPrice(m_kdata[pos].datetime, price) : 0.0;
+}
+
+
+price_t StoplossBase::getShortPriceAt(size_t pos, price_t price) {
+    return pos < m_kdata.size()
+           ? getShortPrice(m_kdata[pos].datetime, price) : 0.0;
+}
+
+
 void StoplossBase::setTO(const KData& kdata) {
     reset();
     m_kdata = kdata;
@@ -81,6 +81,21 @@ public:
         return getPrice(datetime, price);
     }
 
+    /**
+     * 按交易对象中的K线位置获取计划止损价格，供系统逐根K线运行时使用，
+     * 子类可直接按位置取值，避免再按日期查找
+     * @param pos 在交易对象中的位置
+     * @param price 计划买入的价格
+     * @note 默认实现按第pos根K线的日期调用getPrice，越界时返回0
+     */
+    virtual price_t getPriceAt(size_t pos, price_t price);
+
+    /**
+     * 按交易对象中的K线位置获取卖空时的计划止损价格
+     * @note 默认实现按第pos根K线的日期调用getShortPrice，越界时返回0
+     */
+    virtual price_t getShortPriceAt(size_t pos, price_t price);
+
     /** 子类复位接口 */
     virtual void _reset() {}
 
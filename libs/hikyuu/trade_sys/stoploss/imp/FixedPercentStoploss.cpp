@@ -24,6 +24,11 @@ price_t FixedPercentStoploss
     return roundEx(price * (1 - getParam<double>("p")), precision);
 }
 
+//止损价与日期无关，无需取第pos根K线的日期
+price_t FixedPercentStoploss::getPriceAt(size_t pos, price_t price) {
+    return getPrice(Null<Datetime>(), price);
+}
+
 
 void FixedPercentStoploss::_calculate() {
 
@@ -22,6 +22,8 @@ class FixedPercentStoploss: public StoplossBase {
 public:
     FixedPercentStoploss();
     virtual ~FixedPercentStoploss();
+
+    virtual price_t getPriceAt(size_t pos, price_t price);
 };
 
 } /* namespace hku */
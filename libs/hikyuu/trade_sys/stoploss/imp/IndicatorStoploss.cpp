@@ -26,7 +26,11 @@ IndicatorStoploss::~IndicatorStoploss() {
 }
 
 price_t IndicatorStoploss::getPrice(const Datetime& datetime, price_t price) {
-    return m_result.count(datetime) ? m_result[datetime] : 0.0;
+    return getPriceAt(m_kdata.getPos(datetime), price);
+}
+
+price_t IndicatorStoploss::getPriceAt(size_t pos, price_t price) {
+    return pos < m_result.size() ? m_result[pos] : 0.0;
 }
 
 void IndicatorStoploss::_reset() {
@@ -42,8 +46,9 @@ StoplossPtr IndicatorStoploss::_clone() {
 void IndicatorStoploss::_calculate() {
     Indicator ind = m_op(KDATA_PART(m_kdata, getParam<string>("kpart")));
     size_t total = ind.size();
+    m_result.assign(total, 0.0);
     for (size_t i = ind.discard(); i < total; ++i) {
-        m_result[m_kdata[i].datetime] = ind[i];
+        m_result[i] = ind[i];
     }
 }
 
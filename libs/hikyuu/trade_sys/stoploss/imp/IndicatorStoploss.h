@@ -21,13 +21,14 @@ public:
     virtual ~IndicatorStoploss();
 
     virtual price_t getPrice(const Datetime& datetime, price_t price);
+    virtual price_t getPriceAt(size_t pos, price_t price);
     virtual void _reset();
     virtual StoplossPtr _clone();
     virtual void _calculate();
 
 private:
     Operand m_op;
-    map<Datetime, price_t> m_result;
+    PriceList m_result; //按m_kdata位置对齐，指标无效的位置为0
 
 //========================================
 //序列化支持
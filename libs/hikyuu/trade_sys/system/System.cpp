@@ -41,13 +41,25 @@ HKU_API std::ostream& operator <<(std::ostream &os, const SystemPtr& sys) {
 
 System::System()
 : m_name("SYS_Simple"), m_buy_days(0), m_sell_short_days(0),
-  m_lastTakeProfit(0.0), m_lastShortTakeProfit(0.0) {
+  m_trade_tm_reset(0),
+  m_lastTakeProfit(0.0), m_lastShortTakeProfit(0.0),
+  m_cur_pos(Null<size_t>()),
+  m_param_delay("delay"),
+  m_param_delay_use_current_price("delay_use_current_price"),
+  m_param_max_delay_count("max_delay_count"),
+  m_param_support_borrow_stock("support_borrow_stock") {
     initParam();
 }
 
 System::System(const string& name)
 : m_name(name), m_buy_days(0), m_sell_short_days(0),
-  m_lastTakeProfit(0.0), m_lastShortTakeProfit(0.0) {
+  m_trade_tm_reset(0),
+  m_lastTakeProfit(0.0), m_lastShortTakeProfit(0.0),
+  m_cur_pos(Null<size_t>()),
+  m_param_delay("delay"),
+  m_param_delay_use_current_price("delay_use_current_price"),
+  m_param_max_delay_count("max_delay_count"),
+  m_param_support_borrow_stock("support_borrow_stock") {
     initParam();
 }
 
@@ -73,8 +85,14 @@ System::System(const TradeManagerPtr& tm,
   m_name(name),
   m_buy_days(0),
   m_sell_short_days(0),
+  m_trade_tm_reset(tm ? tm->resetCount() : 0),
   m_lastTakeProfit(0.0),
-  m_lastShortTakeProfit(0.0) {
+  m_lastShortTakeProfit(0.0),
+  m_cur_pos(Null<size_t>()),
+  m_param_delay("delay"),
+  m_param_delay_use_current_price("delay_use_current_price"),
+  m_param_max_delay_count("max_delay_count"),
+  m_param_support_borrow_stock("support_borrow_stock") {
     initParam();
 }
 
@@ -117,9 +135,11 @@ void System::reset() {
 
     m_buy_days = 0;
     m_sell_short_days = 0;
-    m_trade_list.clear();
+    m_trade_index.clear();
+    m_trade_tm_reset = m_tm ? m_tm->resetCount() : 0;
     m_lastTakeProfit = 0.0;
     m_lastShortTakeProfit = 0.0;
+    m_ev_valid.clear();
 
     m_buyRequest.clear();
     m_sellRequest.clear();
@@ -133,6 +153,9 @@ void System::setTO(const KData& kdata) {
     }
 
     m_kdata = kdata;
+    m_stock = kdata.getStock();
+    m_cur_pos = Null<size_t>();
+    m_cur_datetime = Null<Datetime>();
 
     //sg->setTO必须在cn->setTO之前，cn会使用到sg，防止sg被计算两次
     if (m_sg) m_sg->setTO(kdata);
@@ -145,6 +168,13 @@ void System::setTO(const KData& kdata) {
     KQuery query = kdata.getQuery();
     if (m_ev) m_ev->setQuery(query);
     if (m_mm) m_mm->setQuery(query);
+
+    //外部环境按日期计算，预先对齐到交易对象，逐根K线时只需按位置判断
+    if (m_ev) {
+        m_ev_valid = m_ev->getValidMask(kdata);
+    } else {
+        m_ev_valid.clear();
+    }
 }
 
 
@@ -164,10 +194,12 @@ SystemPtr System::clone() {
     //p->m_name = m_name;
     p->m_stock = m_stock;
     p->m_kdata = m_kdata;
+    p->m_ev_valid = m_ev_valid;
 
     p->m_buy_days = m_buy_days;
     p->m_sell_short_days = m_sell_short_days;
-    p->m_trade_list = m_trade_list;
+    p->m_trade_index = getTradeIndexList();
+    p->m_trade_tm_reset = p->m_tm ? p->m_tm->resetCount() : 0;
     p->m_lastTakeProfit = m_lastTakeProfit;
     p->m_lastShortTakeProfit = m_lastShortTakeProfit;
 
@@ -180,6 +212,52 @@ SystemPtr System::clone() {
 }
 
 
+void System::setTM(const TradeManagerPtr& tm) {
+    if (tm != m_tm) {
+        m_trade_index.clear();
+        m_trade_tm_reset = tm ? tm->resetCount() : 0;
+    }
+    m_tm = tm;
+}
+
+
+bool System::_tradeIndexValid() const {
+    return m_tm && m_tm->resetCount() == m_trade_tm_reset;
+}
+
+
+vector<size_t> System::getTradeIndexList() const {
+    return _tradeIndexValid() ? m_trade_index : vector<size_t>();
+}
+
+
+TradeRecordList System::getTradeRecordList() const {
+    TradeRecordList result;
+    if (!_tradeIndexValid()) {
+        return result;
+    }
+
+    const TradeRecordList& trades = m_tm->getTradeList();
+    result.reserve(m_trade_index.size());
+    for (size_t i = 0; i < m_trade_index.size(); ++i) {
+        if (m_trade_index[i] < trades.size()) {
+            result.push_back(trades[m_trade_index[i]]);
+        }
+    }
+    return result;
+}
+
+
+void System::_addTradeIndex() {
+    //交易管理实例在系统之外被复位过，原有位置已失效
+    if (!_tradeIndexValid()) {
+        m_trade_index.clear();
+        m_trade_tm_reset = m_tm->resetCount();
+    }
+    m_trade_index.push_back(m_tm->getTradeList().size() - 1);
+}
+
+
 void System::_buyNotifyAll(const TradeRecord& record) {
     //TODO _buyNotifyAll
     if (m_mm) m_mm->buyNotify(record);
@@ -193,31 +271,29 @@ void System::_sellNotifyAll(const TradeRecord& record) {
 
 
 void System::run(const Stock& stock, const KQuery& query, bool reset) {
-    if (!m_tm) {
-        HKU_ERROR("Not setTradeManager! [SystemBase::run]");
+    if( stock.isNull() ){
+        HKU_ERROR("Stock is NULL! [System::run] ");
         return;
     }
 
-    if( !m_mm ){
-        HKU_ERROR("Not setMoneyManager! [System::run]");
-        return;
-    }
+    run(stock.getKData(query), reset);
+}
 
-    if( !m_sg ){
-        HKU_ERROR("Not setSignal! [System::run] ");
-        return;
+
+bool System::readyForRun() {
+    if (!m_tm) {
+        HKU_ERROR("Not setTradeManager! [System::readyForRun]");
+        return false;
     }
 
-    if( stock.isNull() ){
-        HKU_ERROR("Stock is NULL! [System::run] ");
-        return;
+    if( !m_mm ){
+        HKU_ERROR("Not setMoneyManager! [System::readyForRun]");
+        return false;
     }
 
-    m_stock = stock;
-    KData kdata = stock.getKData(query);
-    if( kdata.empty() ){
-        HKU_INFO("KData is empty! [System::run]");
-        return;
+    if( !m_sg ){
+        HKU_ERROR("Not setSignal! [System::readyForRun] ");
+        return false;
     }
 
     if (m_cn) {
@@ -229,21 +305,65 @@ void System::run(const Stock& stock, const KQuery& query, bool reset) {
     if (m_st) m_st->setTM(m_tm);
     if (m_tp) m_tp->setTM(m_tm);
 
-    if (reset)  this->reset();
-
     m_tm->setParam<bool>("support_borrow_cash", getParam<bool>("support_borrow_cash"));
     m_tm->setParam<bool>("support_borrow_stock", getParam<bool>("support_borrow_stock"));
+    return true;
+}
+
+
+void System::run(const KData& kdata, bool reset) {
+    if (!readyForRun()) {
+        return;
+    }
+
+    if( kdata.getStock().isNull() ){
+        HKU_ERROR("Stock is NULL! [System::run] ");
+        return;
+    }
+
+    m_stock = kdata.getStock();
+    if( kdata.empty() ){
+        HKU_INFO("KData is empty! [System::run]");
+        return;
+    }
+
+    if (reset)  this->reset();
 
     setTO(kdata);
     size_t total = kdata.size();
-    for (size_t i = 0; i < total; ++i) {
-        if (kdata[i].datetime >= m_tm->initDatetime()) {
-            runMoment(kdata[i]);
+    size_t i = 0;
+    while (i < total) {
+        KRecord today = kdata[i++];
+        if (today.datetime < m_tm->initDatetime()) {
+            continue;
+        }
+
+        m_buy_days++;
+        m_sell_short_days++;
+        _runMoment(today, i - 1);
+
+        //空仓且没有待处理的交易请求时，在下一个信号之前的K线上不会发生任何
+        //操作，直接跳至下一个信号，仅累计跳过的天数
+        if (i < total && _isIdle()) {
+            size_t next = m_sg->findNextSignal(i);
+            if (next > total) {
+                next = total;
+            }
+            m_buy_days += int(next - i);
+            m_sell_short_days += int(next - i);
+            i = next;
         }
     }
 }
 
 
+bool System::_isIdle() const {
+    return !m_buyRequest.valid && !m_sellRequest.valid
+            && !m_sellShortRequest.valid && !m_buyShortRequest.valid
+            && !m_tm->have(m_stock) && !m_tm->haveShort(m_stock);
+}
+
+
 void System::clearRequest() {
     m_buyRequest.clear();
     m_sellRequest.clear();
@@ -260,27 +380,44 @@ void System::runMoment(const KRecord& record) {
 
 
 void System::runMoment(const Datetime& datetime) {
-    KRecord today = m_kdata.getKRecordByDate(datetime);
-    if (today.isValid()) {
+    size_t pos = m_kdata.getPos(datetime);
+    if (pos != Null<size_t>()) {
         m_buy_days++;
         m_sell_short_days++;
-        _runMoment(today);
+        _runMoment(m_kdata[pos], pos);
+    }
+}
+
+
+void System::runMomentAt(size_t pos) {
+    if (pos < m_kdata.size()) {
+        m_buy_days++;
+        m_sell_short_days++;
+        _runMoment(m_kdata[pos], pos);
     }
 }
 
 
 void System::_runMoment(const KRecord& today) {
+    _runMoment(today, m_kdata.getPos(today.datetime));
+}
+
+
+void System::_runMoment(const KRecord& today, size_t pos) {
     if (today.highPrice == today.lowPrice
         || today.closePrice > today.highPrice
         || today.closePrice < today.lowPrice) {
         return;
     }
 
+    m_cur_pos = pos;
+    m_cur_datetime = today.datetime;
+
     //处理当前已有的交易请求
     _processRequest(today);
 
     //如果系统环境失效，则立即清仓
-    if (!_environmentIsValid(today.datetime)) {
+    if (!_environmentIsValid(pos, today.datetime)) {
         //如果持有多头仓位，则立即卖出
         if (m_tm->have(m_stock)) {
             _sell(today, PART_ENVIRONMENT);
@@ -295,7 +432,7 @@ void System::_runMoment(const KRecord& today) {
     }
 
     //如果系统自身条件失效，则立即清仓
-    if (!_conditionIsValid(today.datetime)) {
+    if (!_conditionIsValid(pos, today.datetime)) {
         //如果持有多头仓位，则立即卖出
         if (m_tm->have(m_stock)) {
             _sell(today, PART_CONDITION);
@@ -309,21 +446,21 @@ void System::_runMoment(const KRecord& today) {
     }
 
     //如果有买入信号
-    if (m_sg->shouldBuy(today.datetime)) {
+    if (_shouldBuy(pos, today.datetime)) {
         _buy(today);
         if (m_tm->haveShort(m_stock)) _sellShort(today);
         return;
     }
 
     //发出卖出信号
-    if (m_sg->shouldSell(today.datetime)) {
+    if (_shouldSell(pos, today.datetime)) {
         if (m_tm->have(m_stock)) _sell(today, PART_SIGNAL);
         _buyShort(today, PART_SIGNAL);
         return;
     }
 
     //如果延迟操作，当前价格取收盘价，否则取开盘价
-    price_t current_price = getParam<bool>("delay") ? today.closePrice : today.openPrice;
+    price_t current_price = m_param_delay.get(m_params) ? today.closePrice : today.openPrice;
 
     PositionRecord position = m_tm->getPosition(m_stock);
     if( position.number != 0) {
@@ -360,7 +497,7 @@ void System::_runMoment(const KRecord& today) {
 
 
 void System::_buy(const KRecord& today) {
-    if (getParam<bool>("delay")) {
+    if (m_param_delay.get(m_params)) {
         _submitBuyRequest(today);
     } else {
         _buyNow(today);
@@ -400,7 +537,7 @@ void System::_buyNow(const KRecord& today) {
     }
 
     m_lastTakeProfit = _getTakeProfitPrice(record.datetime);
-    m_trade_list.push_back(record);
+    _addTradeIndex();
     _buyNotifyAll(record);
 }
 
@@ -419,7 +556,7 @@ void System::_buyDelay(const KRecord& today) {
     price_t stoploss = 0;
     size_t number = 0;
     price_t goalPrice = 0;
-    if (getParam<bool>("delay_use_current_price")) {
+    if (m_param_delay_use_current_price.get(m_params)) {
         //使用当前计划价格计算止损价和可买入数量
         stoploss = _getStoplossPrice(today.datetime, planPrice);
         number = _getBuyNumber(today.datetime, planPrice, planPrice - stoploss);
@@ -452,14 +589,14 @@ void System::_buyDelay(const KRecord& today) {
 
     m_buy_days = 0;
     m_lastTakeProfit = realPrice;
-    m_trade_list.push_back(record);
+    _addTradeIndex();
     _buyNotifyAll(record);
     m_buyRequest.clear();
 }
 
 void System::_submitBuyRequest(const KRecord& today) {
     if (m_buyRequest.valid) {
-        if (m_buyRequest.count > getParam<int>("max_delay_count")) {
+        if (m_buyRequest.count > m_param_max_delay_count.get(m_params)) {
             //超出最大延迟次数，清除买入请求
             m_buyRequest.clear();
             return;
@@ -486,7 +623,7 @@ void System::_submitBuyRequest(const KRecord& today) {
 
 
 void System::_sell(const KRecord& today, Part from) {
-    if (getParam<bool>("delay")) {
+    if (m_param_delay.get(m_params)) {
         _submitSellRequest(today, from);
     } else {
         _sellNow(today, from);
@@ -528,7 +665,7 @@ void System::_sellNow(const KRecord& today, Part from) {
         m_lastTakeProfit = _getTakeProfitPrice(today.datetime);
     }
 
-    m_trade_list.push_back(record);
+    _addTradeIndex();
     _sellNotifyAll(record);
 }
 
@@ -546,7 +683,7 @@ void System::_sellDelay(const KRecord& today) {
     price_t stoploss = 0.0;
     size_t number = 0;
     price_t goalPrice = 0.0;
-    if (getParam<bool>("delay_use_current_price")) {
+    if (m_param_delay_use_current_price.get(m_params)) {
         stoploss = _getStoplossPrice(today.datetime, planPrice);
         if (planPrice  < stoploss) {
             number = m_tm->getHoldNumber(today.datetime, m_stock);
@@ -578,7 +715,7 @@ void System::_sellDelay(const KRecord& today) {
         m_lastTakeProfit = 0.0;
     }
 
-    m_trade_list.push_back(record);
+    _addTradeIndex();
     _sellNotifyAll(record);
     m_sellRequest.clear();
 }
@@ -586,7 +723,7 @@ void System::_sellDelay(const KRecord& today) {
 
 void System::_submitSellRequest(const KRecord& today, Part from) {
     if (m_sellRequest.valid) {
-        if (m_sellRequest.count > getParam<int>("max_delay_count")) {
+        if (m_sellRequest.count > m_param_max_delay_count.get(m_params)) {
             //超出最大延迟次数，清除买入请求
             m_sellRequest.clear();
             return;
@@ -614,10 +751,10 @@ void System::_submitSellRequest(const KRecord& today, Part from) {
 
 
 void System::_buyShort(const KRecord& today, Part from) {
-    if (getParam<bool>("support_borrow_stock") == false)
+    if (m_param_support_borrow_stock.get(m_params) == false)
         return;
 
-    if (getParam<bool>("delay")) {
+    if (m_param_delay.get(m_params)) {
         _submitBuyShortRequest(today, from);
     } else {
         _buyShortNow(today, from);
@@ -667,7 +804,7 @@ void System::_buyShortNow(const KRecord& today, Part from) {
 
     m_sell_short_days = 0;
     m_lastTakeProfit = realPrice; //止赢赋值给买入价格
-    m_trade_list.push_back(record);
+    _addTradeIndex();
     _buyNotifyAll(record);
     m_buyShortRequest.clear();
 }
@@ -685,7 +822,7 @@ void System::_buyShortDelay(const KRecord& today) {
     price_t stoploss = 0.0;
     size_t number = 0;
     price_t goalPrice = 0.0;
-    if (getParam<bool>("delay_use_current_price")) {
+    if (m_param_delay_use_current_price.get(m_params)) {
         //取当前时刻的收盘价对应的止损价
         stoploss = _getShortStoplossPrice(m_buyRequest.datetime, planPrice);
         number = _getBuyShortNumber(today.datetime, planPrice, stoploss - planPrice);
@@ -723,7 +860,7 @@ void System::_buyShortDelay(const KRecord& today) {
 
     m_sell_short_days = 0;
     m_lastTakeProfit = realPrice; //止赢赋值给买入价格
-    m_trade_list.push_back(record);
+    _addTradeIndex();
     _buyNotifyAll(record);
     m_buyShortRequest.clear();
 }
@@ -731,7 +868,7 @@ void System::_buyShortDelay(const KRecord& today) {
 
 void System::_submitBuyShortRequest(const KRecord& today, Part from) {
     if (m_buyShortRequest.valid) {
-        if (m_buyShortRequest.count > getParam<int>("max_delay_count")) {
+        if (m_buyShortRequest.count > m_param_max_delay_count.get(m_params)) {
             //超出最大延迟次数，清除买入请求
             m_buyRequest.clear();
             return;
@@ -758,10 +895,10 @@ void System::_submitBuyShortRequest(const KRecord& today, Part from) {
 
 
 void System::_sellShort(const KRecord& today) {
-    if (getParam<bool>("support_borrow_stock") == false)
+    if (m_param_support_borrow_stock.get(m_params) == false)
         return;
 
-    if (getParam<bool>("delay")) {
+    if (m_param_delay.get(m_params)) {
         _submitSellShortRequest(today);
     } else {
         _sellShortNow(today);
@@ -798,7 +935,7 @@ void System::_sellShortNow(const KRecord& today) {
 
     m_sell_short_days = 0;
     m_lastShortTakeProfit = realPrice;
-    m_trade_list.push_back(record);
+    _addTradeIndex();
     _sellNotifyAll(record);
     m_sellShortRequest.clear();
 }
@@ -817,7 +954,7 @@ void System::_sellShortDelay(const KRecord& today) {
     price_t stoploss = 0.0;
     size_t number = 0;
     price_t goalPrice = 0.0;
-    if (getParam<bool>("delay_use_current_price")) {
+    if (m_param_delay_use_current_price.get(m_params)) {
         stoploss = _getShortStoplossPrice(today.datetime, planPrice);
         number = _getSellShortNumber(today.datetime, planPrice, stoploss - planPrice);
         goalPrice = _getShortGoalPrice(today.datetime, planPrice);
@@ -843,7 +980,7 @@ void System::_sellShortDelay(const KRecord& today) {
 
     m_sell_short_days = 0;
     m_lastShortTakeProfit = realPrice;
-    m_trade_list.push_back(record);
+    _addTradeIndex();
     _sellNotifyAll(record);
     m_sellShortRequest.clear();
 }
@@ -851,7 +988,7 @@ void System::_sellShortDelay(const KRecord& today) {
 
 void System::_submitSellShortRequest(const KRecord& today) {
     if (m_sellShortRequest.valid) {
-        if (m_sellShortRequest.count > getParam<int>("max_delay_count")) {
+        if (m_sellShortRequest.count > m_param_max_delay_count.get(m_params)) {
             //超出最大延迟次数，清除买入请求
             m_sellShortRequest.clear();
             return;
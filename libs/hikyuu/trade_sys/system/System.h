@@ -62,7 +62,8 @@ public:
     ProfitGoalPtr getPG() const { return m_pg; }
     SlippagePtr getSP() const { return m_sp; }
 
-    void setTM(const TradeManagerPtr& tm) { m_tm = tm; }
+    /** 设置交易管理实例，更换实例时清除已记录的交易位置 */
+    void setTM(const TradeManagerPtr& tm);
     void setMM(const MoneyManagerPtr& mm) { m_mm = mm; }
     void setEV(const EnvironmentPtr& ev) { m_ev = ev; }
     void setCN(const ConditionPtr& cn) { m_cn = cn; }
@@ -74,7 +75,19 @@ public:
 
     Stock getStock() const { return m_stock; }
 
-    const TradeRecordList& getTradeRecordList() const { return m_trade_list;}
+    /**
+     * 获取系统实际执行的交易记录
+     * @note 系统只保存交易记录在交易管理实例中的位置，此处按位置从交易管理
+     *       实例中复制。交易管理实例在系统之外被复位后，已记录的位置失效，
+     *       返回空列表
+     */
+    TradeRecordList getTradeRecordList() const;
+
+    /**
+     * 系统实际执行的交易记录在交易管理实例交易记录列表中的位置，
+     * 交易管理实例在系统之外被复位后返回空列表
+     */
+    vector<size_t> getTradeIndexList() const;
 
     const TradeRequest& getBuyTradeRequest() const { return m_buyRequest; }
     const TradeRequest& getSellTradeRequest() const { return m_sellRequest; }
@@ -104,9 +117,30 @@ public:
     void setTO(const KData& kdata);
 
     void run(const Stock& stock, const KQuery& query, bool reset=true);
+
+    /**
+     * 在指定的K线数据上运行系统，K线数据可由多个系统共享（只读）
+     * @param kdata K线数据
+     * @param reset 是否复位
+     */
+    void run(const KData& kdata, bool reset=true);
     void runMoment(const Datetime& datetime);
     void runMoment(const KRecord& record);
 
+    /**
+     * 运行交易对象中的第pos根K线，无需按日期查找K线位置
+     * @param pos 在交易对象中的位置，越界时不做任何处理
+     * @note 需先调用setTO设置交易对象，并调用readyForRun
+     */
+    void runMomentAt(size_t pos);
+
+    /**
+     * 检查必需的部件，并将交易管理实例设置给需要的部件，由run自动调用，
+     * 不经run而直接逐根K线运行（如多个系统共享同一账户）时须先调用
+     * @return 缺少交易管理、资金管理或信号指示器时返回false
+     */
+    bool readyForRun();
+
     //清除已有的交易请求，供Portolio使用
     void clearRequest();
 
@@ -163,6 +197,32 @@ public:
 
     void _runMoment(const KRecord& record);
 
+private:
+    /**
+     * 处理交易对象中第pos根K线，各部件按位置判断
+     * @param today 当前K线记录
+     * @param pos 在m_kdata中的位置，不在m_kdata中时为Null<size_t>()，此时按日期判断
+     */
+    void _runMoment(const KRecord& today, size_t pos);
+
+    //记录交易管理实例中刚刚加入的交易记录
+    void _addTradeIndex();
+
+    //m_trade_index是否仍对应m_tm当前的交易记录
+    bool _tradeIndexValid() const;
+
+    //空仓（含空头仓位）且没有任何待处理的交易请求
+    bool _isIdle() const;
+
+    //datetime为当前正在处理的K线时返回其位置，否则返回Null<size_t>()
+    size_t _getCurrentPos(const Datetime& datetime) const;
+
+    //以下按K线位置判断，pos为Null<size_t>()时按日期判断
+    bool _environmentIsValid(size_t pos, const Datetime& datetime);
+    bool _conditionIsValid(size_t pos, const Datetime& datetime);
+    bool _shouldBuy(size_t pos, const Datetime& datetime);
+    bool _shouldSell(size_t pos, const Datetime& datetime);
+
 protected:
     TradeManagerPtr m_tm;
     MoneyManagerPtr m_mm;
@@ -177,18 +237,30 @@ protected:
     string m_name;
     Stock m_stock;
     KData m_kdata;
+    boost::dynamic_bitset<> m_ev_valid; //按m_kdata位置对齐的外部环境有效标记
 
     int m_buy_days; //每一次买入清零，计算一次加1，即买入后的天数
     int m_sell_short_days; //每一次卖空清零
-    TradeRecordList m_trade_list; //保存实际执行的交易记录
+    vector<size_t> m_trade_index; //实际执行的交易记录在m_tm交易记录中的位置
+    size_t m_trade_tm_reset;      //记录m_trade_index时m_tm的复位次数
     price_t m_lastTakeProfit;     //上一次多头止损价，用于保证止赢价单调递增
     price_t m_lastShortTakeProfit; //上一次空头止赢价
 
+    //当前正在处理的K线位置及日期，止损、目标价、移滑价差等部件据此按位置取值
+    size_t m_cur_pos;
+    Datetime m_cur_datetime;
+
     TradeRequest m_buyRequest;
     TradeRequest m_sellRequest;
     TradeRequest m_sellShortRequest;
     TradeRequest m_buyShortRequest;
 
+    //逐根K线处理时频繁读取的参数
+    CachedParam<bool> m_param_delay;
+    CachedParam<bool> m_param_delay_use_current_price;
+    CachedParam<int>  m_param_max_delay_count;
+    CachedParam<bool> m_param_support_borrow_stock;
+
 private:
     void initParam(); //初始化参数及其默认值
 
@@ -220,7 +292,8 @@ private:
         ar & BOOST_SERIALIZATION_NVP(m_buy_days);
         ar & BOOST_SERIALIZATION_NVP(m_lastTakeProfit);
         ar & BOOST_SERIALIZATION_NVP(m_lastShortTakeProfit);
-        ar & BOOST_SERIALIZATION_NVP(m_trade_list);
+        vector<size_t> trade_index = getTradeIndexList();
+        ar & boost::serialization::make_nvp("m_trade_index", trade_index);
     }
 
     template<class Archive>
@@ -247,7 +320,8 @@ private:
         ar & BOOST_SERIALIZATION_NVP(m_buy_days);
         ar & BOOST_SERIALIZATION_NVP(m_lastTakeProfit);
         ar & BOOST_SERIALIZATION_NVP(m_lastShortTakeProfit);
-        ar & BOOST_SERIALIZATION_NVP(m_trade_list);
+        ar & BOOST_SERIALIZATION_NVP(m_trade_index);
+        m_trade_tm_reset = m_tm ? m_tm->resetCount() : 0;
     }
 
     BOOST_SERIALIZATION_SPLIT_MEMBER()
@@ -285,6 +359,34 @@ _shouldBuy(const Datetime& datetime) {
     return m_sg ? m_sg->shouldBuy(datetime) : false;
 }
 
+inline bool System::
+_environmentIsValid(size_t pos, const Datetime& datetime) {
+    if (!m_ev) {
+        return true;
+    }
+    return pos < m_ev_valid.size() ? m_ev_valid[pos] : m_ev->isValid(datetime);
+}
+
+inline bool System::
+_conditionIsValid(size_t pos, const Datetime& datetime) {
+    if (!m_cn) {
+        return true;
+    }
+    return pos != Null<size_t>() ? m_cn->isValid(pos) : m_cn->isValid(datetime);
+}
+
+inline bool System::
+_shouldBuy(size_t pos, const Datetime& datetime) {
+    return pos != Null<size_t>() ? m_sg->shouldBuy(pos)
+                                 : m_sg->shouldBuy(datetime);
+}
+
+inline bool System::
+_shouldSell(size_t pos, const Datetime& datetime) {
+    return pos != Null<size_t>() ? m_sg->shouldSell(pos)
+                                 : m_sg->shouldSell(datetime);
+}
+
 inline size_t System
 ::_getBuyNumber(const Datetime& datetime, price_t price, price_t risk) {
     return m_mm ? m_mm->getBuyNumber(datetime, m_stock, price, risk) : 0;
@@ -305,39 +407,78 @@ inline size_t System
     return m_mm ? m_mm->getBuyShortNumber(datetime, m_stock, price, risk) : 0;
 }
 
+inline size_t System::_getCurrentPos(const Datetime& datetime) const {
+    return datetime == m_cur_datetime ? m_cur_pos : Null<size_t>();
+}
+
 inline price_t System
 ::_getRealBuyPrice(const Datetime& datetime, price_t planPrice) {
-    return m_sp ? m_sp->getRealBuyPrice(datetime, planPrice) : planPrice;
+    if (!m_sp) {
+        return planPrice;
+    }
+    size_t pos = _getCurrentPos(datetime);
+    return pos != Null<size_t>() ? m_sp->getRealBuyPriceAt(pos, planPrice)
+                                 : m_sp->getRealBuyPrice(datetime, planPrice);
 }
 
 inline price_t System
 ::_getRealSellPrice(const Datetime& datetime, price_t planPrice) {
-    return m_sp ? m_sp->getRealSellPrice(datetime, planPrice) : planPrice;
+    if (!m_sp) {
+        return planPrice;
+    }
+    size_t pos = _getCurrentPos(datetime);
+    return pos != Null<size_t>() ? m_sp->getRealSellPriceAt(pos, planPrice)
+                                 : m_sp->getRealSellPrice(datetime, planPrice);
 }
 
 inline price_t System
 ::_getStoplossPrice(const Datetime& datetime, price_t price) {
-    return m_st ? m_st->getPrice(datetime, price) : 0.0;
+    if (!m_st) {
+        return 0.0;
+    }
+    size_t pos = _getCurrentPos(datetime);
+    return pos != Null<size_t>() ? m_st->getPriceAt(pos, price)
+                                 : m_st->getPrice(datetime, price);
 }
 
 inline price_t System
 ::_getShortStoplossPrice(const Datetime& datetime, price_t price) {
-    return m_st ? m_st->getShortPrice(datetime, price) : 0.0;
+    if (!m_st) {
+        return 0.0;
+    }
+    size_t pos = _getCurrentPos(datetime);
+    return pos != Null<size_t>() ? m_st->getShortPriceAt(pos, price)
+                                 : m_st->getShortPrice(datetime, price);
 }
 
 inline price_t System
 ::_getTakeProfitPrice(const Datetime& datetime) {
-    return m_tp ? m_tp->getPrice(datetime, 0.0) : 0.0;
+    if (!m_tp) {
+        return 0.0;
+    }
+    size_t pos = _getCurrentPos(datetime);
+    return pos != Null<size_t>() ? m_tp->getPriceAt(pos, 0.0)
+                                 : m_tp->getPrice(datetime, 0.0);
 }
 
 inline price_t System
 ::_getGoalPrice(const Datetime& datetime, price_t price) {
-    return m_pg ? m_pg->getGoal(datetime, price) : 0.0;
+    if (!m_pg) {
+        return 0.0;
+    }
+    size_t pos = _getCurrentPos(datetime);
+    return pos != Null<size_t>() ? m_pg->getGoalAt(pos, price)
+                                 : m_pg->getGoal(datetime, price);
 }
 
 inline price_t System
 ::_getShortGoalPrice(const Datetime& datetime, price_t price) {
-    return m_pg ? m_pg->getShortGoal(datetime, price) : 0.0;
+    if (!m_pg) {
+        return 0.0;
+    }
+    size_t pos = _getCurrentPos(datetime);
+    return pos != Null<size_t>() ? m_pg->getShortGoalAt(pos, price)
+                                 : m_pg->getShortGoal(datetime, price);
 }
 
 } /* namespace hku */
@@ -0,0 +1,181 @@
+/*
+ * SystemOptimizer.cpp
+ *
+ *  Created on: 2017年6月20日
+ *      Author: fasiondog
+ */
+
+#include "../../utilities/Parallel.h"
+#include "../../indicator/IndicatorArena.h"
+#include "SystemOptimizer.h"
+
+namespace hku {
+
+namespace {
+
+template <class PartPtr>
+bool apply_part_param(const PartPtr& part, const ParamGrid& grid, size_t i) {
+    if (!part) {
+        return false;
+    }
+    Parameter param = part->getParameter();
+    grid.apply(i, param);
+    part->setParameter(param);
+    return true;
+}
+
+//设置系统中指定部件的参数，部件不存在时返回false
+bool apply_system_part_param(const SystemPtr& sys, SystemPart part,
+        const ParamGrid& grid, size_t i) {
+    switch (part) {
+    case PART_ENVIRONMENT:
+        return apply_part_param(sys->getEV(), grid, i);
+    case PART_CONDITION:
+        return apply_part_param(sys->getCN(), grid, i);
+    case PART_SIGNAL:
+        return apply_part_param(sys->getSG(), grid, i);
+    case PART_STOPLOSS:
+        return apply_part_param(sys->getST(), grid, i);
+    case PART_TAKEPROFIT:
+        return apply_part_param(sys->getTP(), grid, i);
+    case PART_MONEYMANAGER:
+        return apply_part_param(sys->getMM(), grid, i);
+    case PART_PROFITGOAL:
+        return apply_part_param(sys->getPG(), grid, i);
+    case PART_SLIPPAGE:
+        return apply_part_param(sys->getSP(), grid, i);
+    default:
+        return false;
+    }
+}
+
+} /* namespace */
+
+
+SystemOptimizer::SystemOptimizer() {
+
+}
+
+SystemOptimizer::SystemOptimizer(const SystemPtr& sys): m_sys(sys) {
+
+}
+
+SystemOptimizer::~SystemOptimizer() {
+
+}
+
+void SystemOptimizer::setGrid(SystemPart part, const ParamGrid& grid) {
+    if (part >= PART_INVALID) {
+        HKU_ERROR("Invalid system part! [SystemOptimizer::setGrid]");
+        return;
+    }
+
+    for (size_t i = 0; i < m_grids.size(); ++i) {
+        if (m_grids[i].first == part) {
+            m_grids[i].second = grid;
+            return;
+        }
+    }
+    m_grids.push_back(PartGrid(part, grid));
+}
+
+size_t SystemOptimizer::size() const {
+    if (m_grids.empty()) {
+        return 0;
+    }
+
+    size_t total = 1;
+    for (size_t i = 0; i < m_grids.size(); ++i) {
+        total *= m_grids[i].second.size();
+    }
+    return total;
+}
+
+vector<size_t> SystemOptimizer::_split(size_t i) const {
+    if (i >= size()) {
+        throw std::out_of_range("out_of_range in SystemOptimizer::_split");
+    }
+
+    //最后设置的部件变化最快
+    vector<size_t> result(m_grids.size());
+    for (size_t k = m_grids.size(); k > 0; --k) {
+        size_t n = m_grids[k - 1].second.size();
+        result[k - 1] = i % n;
+        i /= n;
+    }
+    return result;
+}
+
+Parameter SystemOptimizer::getParameter(size_t i, SystemPart part) const {
+    vector<size_t> pos = _split(i);
+    for (size_t k = 0; k < m_grids.size(); ++k) {
+        if (m_grids[k].first == part) {
+            return m_grids[k].second.get(pos[k]);
+        }
+    }
+    return Parameter();
+}
+
+SystemPtr SystemOptimizer::getSystem(size_t i) const {
+    if (!m_sys || i >= size()) {
+        return SystemPtr();
+    }
+
+    vector<size_t> pos = _split(i);
+    SystemPtr sys = m_sys->clone();
+    for (size_t k = 0; k < m_grids.size(); ++k) {
+        SystemPart part = m_grids[k].first;
+        if (!apply_system_part_param(sys, part, m_grids[k].second, pos[k])) {
+            HKU_ERROR("System has no " << getSystemPartName(part)
+                    << "! [SystemOptimizer::getSystem]");
+            return SystemPtr();
+        }
+    }
+    return sys;
+}
+
+PerformanceList SystemOptimizer::run(const Stock& stock, const KQuery& query,
+        size_t threads) {
+    return run(stock.getKData(query), threads);
+}
+
+PerformanceList SystemOptimizer::run(const KData& kdata, size_t threads) {
+    if (!m_sys || !m_sys->getTM() || !m_sys->getMM() || !m_sys->getSG()) {
+        HKU_ERROR("System is incomplete! [SystemOptimizer::run]");
+        return PerformanceList();
+    }
+
+    if (kdata.empty()) {
+        HKU_WARN("KData is empty! [SystemOptimizer::run]");
+        return PerformanceList();
+    }
+
+    //在调用线程中完成所有克隆，避免多个线程同时读取模板系统
+    size_t total = size();
+    SystemList systems(total);
+    for (size_t i = 0; i < total; ++i) {
+        systems[i] = getSystem(i);
+        if (!systems[i]) {
+            return PerformanceList();
+        }
+    }
+
+    Datetime last_datetime = kdata[kdata.size() - 1].datetime;
+    PerformanceList result(total);
+    parallel_for(total, threads, [&](size_t i) {
+        //各组合计算的临时指标从内存池中分配，系统释放后一并归还
+        IndicatorArena arena;
+        SystemPtr sys = systems[i];
+        systems[i].reset();
+
+        sys->run(kdata);
+        TradeManagerPtr tm = sys->getTM();
+        Datetime datetime = tm->lastDatetime() > last_datetime
+                          ? tm->lastDatetime() : last_datetime;
+        result[i].statistics(tm, datetime);
+    });
+
+    return result;
+}
+
+} /* namespace hku */
@@ -0,0 +1,105 @@
+/*
+ * SystemOptimizer.h
+ *
+ *  Created on: 2017年6月20日
+ *      Author: fasiondog
+ */
+
+#ifndef TRADE_SYS_SYSTEM_SYSTEMOPTIMIZER_H_
+#define TRADE_SYS_SYSTEM_SYSTEMOPTIMIZER_H_
+
+#include "../../utilities/ParamGrid.h"
+#include "../../trade_manage/Performance.h"
+#include "System.h"
+
+namespace hku {
+
+/**
+ * 交易系统参数寻优
+ * @details 为系统的各个部件指定参数网格，对所有部件参数组合的笛卡尔积逐一克隆
+ *          系统、设置参数并运行，返回各组合的绩效统计。K线数据只读取一次，由
+ *          所有系统实例共享，各组合在多个线程中并行运行。如:
+ * <pre>
+ * ParamGrid st_grid;
+ * st_grid.addRange("n", 5, 30, 5);
+ * ParamGrid mm_grid;
+ * mm_grid.add("n", ...);
+ *
+ * SystemOptimizer opt(sys);
+ * opt.setGrid(PART_STOPLOSS, st_grid);
+ * opt.setGrid(PART_MONEYMANAGER, mm_grid);
+ * PerformanceList result = opt.run(stock, query);
+ * for (size_t i = 0; i < result.size(); ++i) {
+ *     opt.getParameter(i, PART_STOPLOSS); //第i个结果使用的止损参数
+ *     result[i].get("帐户年复合收益率%");
+ * }
+ * </pre>
+ * @note 运行结果的顺序只与参数组合的序号有关，与线程数及调度无关；
+ *       先设置的部件参数变化最慢，同一部件内按ParamGrid的顺序
+ * @ingroup System
+ */
+class HKU_API SystemOptimizer {
+public:
+    SystemOptimizer();
+    SystemOptimizer(const SystemPtr& sys);
+    virtual ~SystemOptimizer();
+
+    /** 设置作为模板的交易系统，运行时不会修改该系统 */
+    void setSystem(const SystemPtr& sys) {
+        m_sys = sys;
+    }
+
+    SystemPtr getSystem() const {
+        return m_sys;
+    }
+
+    /**
+     * 设置指定部件的参数网格，同一部件重复设置时替换原有网格
+     * @param part 系统部件，不支持PART_INVALID
+     * @param grid 参数网格，参数类型须与部件中的同名参数一致
+     */
+    void setGrid(SystemPart part, const ParamGrid& grid);
+
+    /** 清除所有部件的参数网格 */
+    void clearGrid() {
+        m_grids.clear();
+    }
+
+    /** 参数组合的数量，未设置任何网格时为0 */
+    size_t size() const;
+
+    /** 获取第i个参数组合中指定部件的参数，仅包含网格中的参数，部件无网格时为空 */
+    Parameter getParameter(size_t i, SystemPart part) const;
+
+    /**
+     * 按第i个参数组合克隆系统并设置部件参数
+     * @return 系统未设置、部件不存在或索引越界时返回空指针
+     */
+    SystemPtr getSystem(size_t i) const;
+
+    /**
+     * 对所有参数组合运行系统
+     * @param kdata K线数据，所有参数组合共享
+     * @param threads 线程数，为0时使用default_thread_count()
+     * @return 与参数组合一一对应的绩效统计，统计截至K线数据的最后日期
+     */
+    PerformanceList run(const KData& kdata, size_t threads = 0);
+
+    /** 同run(stock.getKData(query), threads) */
+    PerformanceList run(const Stock& stock, const KQuery& query,
+            size_t threads = 0);
+
+private:
+    typedef std::pair<SystemPart, ParamGrid> PartGrid;
+
+    //将参数组合序号分解为各部件网格中的序号
+    vector<size_t> _split(size_t i) const;
+
+private:
+    SystemPtr m_sys;
+    vector<PartGrid> m_grids;
+};
+
+} /* namespace hku */
+
+#endif /* TRADE_SYS_SYSTEM_SYSTEMOPTIMIZER_H_ */
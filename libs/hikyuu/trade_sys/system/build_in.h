@@ -9,6 +9,7 @@
 #define SYSTEM_BUILD_IN_H_
 
 #include <hikyuu/trade_sys/system/crt/SYS_Simple.h>
+#include <hikyuu/trade_sys/system/SystemOptimizer.h>
 
 
 #endif /* BUILD_IN_H_ */
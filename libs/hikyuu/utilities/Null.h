@@ -107,6 +107,19 @@ public:
     }
 };
 
+/**
+ * 提供float的Null值
+ * @ingroup Common-Utilities
+ */
+template <>
+class Null<float> {
+public:
+    Null() {}
+    operator float() {
+        return (std::numeric_limits<float>::max)();
+    }
+};
+
 } /* namesapce hku */
 
 #endif /* NULL_H_ */
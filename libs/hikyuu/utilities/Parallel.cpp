@@ -0,0 +1,268 @@
+/*
+ * Parallel.cpp
+ *
+ *  Created on: 2017年6月12日
+ *      Author: fasiondog
+ */
+
+#include <deque>
+#include <exception>
+#include <boost/atomic.hpp>
+#include <boost/bind.hpp>
+#include <boost/thread.hpp>
+#include <boost/thread/tss.hpp>
+#include "Parallel.h"
+
+namespace hku {
+
+size_t HKU_API default_thread_count() {
+    size_t n = boost::thread::hardware_concurrency();
+    return n ? n : 1;
+}
+
+namespace {
+
+/**
+ * 进程内共享的工作线程池
+ * @details 每个工作线程拥有自己的任务队列，工作线程提交的任务放入自身队列
+ *          尾部并优先从尾部取出，空闲时从全局队列及其他线程队列的头部窃取
+ *          任务；非工作线程提交的任务放入全局队列。线程数只增不减，嵌套的
+ *          parallel_for共用同一组线程，不会成倍创建线程。
+ */
+class ThreadPool: boost::noncopyable {
+public:
+    typedef boost::function<void()> Job;
+
+    /** 工作线程数的上限，避免队列列表扩容时与窃取线程竞争 */
+    static const size_t MAX_WORKERS = 256;
+
+    static ThreadPool& instance() {
+        static ThreadPool pool;
+        return pool;
+    }
+
+    ThreadPool(): m_worker_count(0), m_pending(0), m_stop(false) {
+        m_queues.reserve(MAX_WORKERS + 1);
+        m_queues.push_back(make_shared<WorkQueue>()); //全局队列
+    }
+
+    ~ThreadPool() {
+        {
+            boost::mutex::scoped_lock lock(m_mutex);
+            m_stop = true;
+        }
+        m_cond.notify_all();
+        m_threads.join_all();
+    }
+
+    size_t size() const {
+        return m_worker_count.load();
+    }
+
+    /** 保证至少有n个工作线程 */
+    void reserve(size_t n) {
+        if (n > MAX_WORKERS) {
+            n = MAX_WORKERS;
+        }
+
+        boost::mutex::scoped_lock lock(m_grow_mutex);
+        for (size_t i = m_worker_count.load(); i < n; ++i) {
+            m_queues.push_back(make_shared<WorkQueue>());
+            m_worker_count.store(i + 1);
+            m_threads.create_thread(
+                    boost::bind(&ThreadPool::_workerLoop, this, i + 1));
+        }
+    }
+
+    void submit(const Job& job) {
+        size_t *index = s_worker_index.get();
+        WorkQueue& queue = *m_queues[index ? *index : 0];
+        {
+            boost::mutex::scoped_lock lock(m_mutex);
+            m_pending++;
+        }
+        {
+            boost::mutex::scoped_lock lock(queue.mutex);
+            queue.jobs.push_back(job);
+        }
+        m_cond.notify_one();
+    }
+
+private:
+    struct WorkQueue {
+        boost::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    bool _tryPop(size_t index, Job& job) {
+        //先取自身队列尾部最近提交的任务
+        {
+            WorkQueue& own = *m_queues[index];
+            boost::mutex::scoped_lock lock(own.mutex);
+            if (!own.jobs.empty()) {
+                job = own.jobs.back();
+                own.jobs.pop_back();
+                return true;
+            }
+        }
+
+        //再从全局队列及其他线程队列头部窃取
+        size_t total = m_worker_count.load() + 1;
+        for (size_t i = 0; i < total; ++i) {
+            size_t victim = (index + i) % total;
+            if (victim == index) {
+                continue;
+            }
+            WorkQueue& other = *m_queues[victim];
+            boost::mutex::scoped_lock lock(other.mutex);
+            if (!other.jobs.empty()) {
+                job = other.jobs.front();
+                other.jobs.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void _workerLoop(size_t index) {
+        s_worker_index.reset(new size_t(index));
+        Job job;
+        while (true) {
+            if (_tryPop(index, job)) {
+                {
+                    boost::mutex::scoped_lock lock(m_mutex);
+                    m_pending--;
+                }
+                job();
+                job.clear();
+                continue;
+            }
+
+            boost::mutex::scoped_lock lock(m_mutex);
+            while (!m_stop && m_pending == 0) {
+                m_cond.wait(lock);
+            }
+            if (m_stop && m_pending == 0) {
+                break;
+            }
+        }
+    }
+
+private:
+    vector<shared_ptr<WorkQueue> > m_queues; //0为全局队列，其余为各工作线程队列
+    boost::atomic<size_t> m_worker_count;
+    boost::mutex m_grow_mutex;
+
+    boost::mutex m_mutex;
+    boost::condition_variable m_cond;
+    size_t m_pending;  //已提交但尚未取出的任务数，不小于各队列任务数之和
+    bool m_stop;
+
+    boost::thread_group m_threads;
+    static boost::thread_specific_ptr<size_t> s_worker_index;
+};
+
+boost::thread_specific_ptr<size_t> ThreadPool::s_worker_index;
+
+/**
+ * 一次parallel_for调用的共享状态，由调用线程及线程池中的协助任务共同持有，
+ * 协助任务在所有任务完成后才开始执行时将直接返回
+ */
+class ParallelForTask {
+public:
+    ParallelForTask(size_t total, const boost::function<void(size_t)>& func)
+    : m_total(total), m_next(0), m_done(0), m_func(func) {}
+
+    void run() {
+        size_t i;
+        while (_fetch(i)) {
+            try {
+                m_func(i);
+                _finish(1);
+            } catch (...) {
+                boost::mutex::scoped_lock lock(m_mutex);
+                if (!m_exception) {
+                    m_exception = std::current_exception();
+                }
+                //放弃剩余任务
+                m_done += m_total - m_next + 1;
+                m_next = m_total;
+                m_cond.notify_all();
+            }
+        }
+    }
+
+    /** 等待其他线程中已领取的任务执行完毕 */
+    void wait() {
+        boost::mutex::scoped_lock lock(m_mutex);
+        while (m_done < m_total) {
+            m_cond.wait(lock);
+        }
+    }
+
+    void rethrow() {
+        if (m_exception) {
+            std::rethrow_exception(m_exception);
+        }
+    }
+
+private:
+    bool _fetch(size_t& i) {
+        boost::mutex::scoped_lock lock(m_mutex);
+        if (m_next >= m_total) {
+            return false;
+        }
+        i = m_next++;
+        return true;
+    }
+
+    void _finish(size_t n) {
+        boost::mutex::scoped_lock lock(m_mutex);
+        m_done += n;
+        if (m_done >= m_total) {
+            m_cond.notify_all();
+        }
+    }
+
+private:
+    size_t m_total;
+    size_t m_next;
+    size_t m_done;
+    const boost::function<void(size_t)>& m_func;
+    boost::mutex m_mutex;
+    boost::condition_variable m_cond;
+    std::exception_ptr m_exception;
+};
+
+} /* namespace */
+
+void HKU_API parallel_for(size_t total, size_t threads,
+        const boost::function<void(size_t)>& func) {
+    if (total == 0) {
+        return;
+    }
+
+    if (threads == 0) {
+        threads = default_thread_count();
+    }
+
+    if (threads > total) {
+        threads = total;
+    }
+
+    shared_ptr<ParallelForTask> task = make_shared<ParallelForTask>(total, func);
+    if (threads > 1) {
+        ThreadPool& pool = ThreadPool::instance();
+        pool.reserve(threads - 1);
+        for (size_t i = 1; i < threads; ++i) {
+            pool.submit(boost::bind(&ParallelForTask::run, task));
+        }
+    }
+
+    //调用线程同样参与执行，剩余任务全部被领取后只需等待其他线程中的任务
+    task->run();
+    task->wait();
+    task->rethrow();
+}
+
+} /* namespace hku */
@@ -0,0 +1,45 @@
+/*
+ * Parallel.h
+ *
+ *  Created on: 2017年6月12日
+ *      Author: fasiondog
+ */
+
+#ifndef UTILITIES_PARALLEL_H_
+#define UTILITIES_PARALLEL_H_
+
+#include <boost/function.hpp>
+#include "../DataType.h"
+
+namespace hku {
+
+/**
+ * @ingroup Common-Utilities
+ * @{
+ */
+
+/**
+ * 获取默认的并行线程数，即CPU的硬件线程数，无法获取时返回1
+ */
+size_t HKU_API default_thread_count();
+
+/**
+ * 使用多个线程并行执行func(0), func(1), ..., func(total-1)
+ * @details 各线程从共享的任务序号中动态领取任务，执行完毕后继续领取，直至所有
+ *          任务完成，调用线程本身也参与执行。任务耗时不均时可自动平衡负载。
+ *          除调用线程外，其余线程来自进程内共享的工作线程池（按需增加，不会
+ *          退出），空闲的工作线程会从其他线程的任务队列中窃取任务，因此在
+ *          任务中嵌套调用parallel_for不会成倍创建线程。
+ * @param total 任务总数
+ * @param threads 线程数（包含调用线程），为0时使用default_thread_count()
+ * @param func 任务函数，参数为任务序号，必须是线程安全的
+ * @note 如任务抛出异常，在所有线程结束后将第一个捕获的异常重新抛出
+ */
+void HKU_API parallel_for(size_t total, size_t threads,
+        const boost::function<void(size_t)>& func);
+
+/** @} */
+
+} /* namespace hku */
+
+#endif /* UTILITIES_PARALLEL_H_ */
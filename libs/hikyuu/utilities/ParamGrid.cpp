@@ -0,0 +1,119 @@
+/*
+ * ParamGrid.cpp
+ *
+ *  Created on: 2017年6月19日
+ *      Author: fasiondog
+ */
+
+#include "../Log.h"
+#include "ParamGrid.h"
+
+namespace hku {
+
+ParamGrid::ParamGrid() {
+
+}
+
+ParamGrid::~ParamGrid() {
+
+}
+
+ParamGrid::Axis& ParamGrid::_axis(const string& name) {
+    for (size_t i = 0; i < m_axes.size(); ++i) {
+        if (m_axes[i].name == name) {
+            return m_axes[i];
+        }
+    }
+    m_axes.push_back(Axis());
+    m_axes.back().name = name;
+    return m_axes.back();
+}
+
+ParamGrid& ParamGrid::add(const string& name, const vector<int>& values) {
+    Axis& axis = _axis(name);
+    axis.is_int = true;
+    axis.int_values = values;
+    axis.double_values.clear();
+    return *this;
+}
+
+ParamGrid& ParamGrid::add(const string& name, const vector<double>& values) {
+    Axis& axis = _axis(name);
+    axis.is_int = false;
+    axis.int_values.clear();
+    axis.double_values = values;
+    return *this;
+}
+
+ParamGrid& ParamGrid::addRange(const string& name,
+        int start, int stop, int step) {
+    vector<int> values;
+    if (step > 0) {
+        for (int v = start; v < stop; v += step) {
+            values.push_back(v);
+        }
+    } else if (step < 0) {
+        for (int v = start; v > stop; v += step) {
+            values.push_back(v);
+        }
+    } else {
+        HKU_WARN("step is zero! [ParamGrid::addRange]");
+    }
+    return add(name, values);
+}
+
+size_t ParamGrid::size() const {
+    if (m_axes.empty()) {
+        return 0;
+    }
+
+    size_t total = 1;
+    for (size_t i = 0; i < m_axes.size(); ++i) {
+        total *= m_axes[i].size();
+    }
+    return total;
+}
+
+bool ParamGrid::have(const string& name) const {
+    for (size_t i = 0; i < m_axes.size(); ++i) {
+        if (m_axes[i].name == name) {
+            return true;
+        }
+    }
+    return false;
+}
+
+StringList ParamGrid::getNameList() const {
+    StringList result;
+    for (size_t i = 0; i < m_axes.size(); ++i) {
+        result.push_back(m_axes[i].name);
+    }
+    return result;
+}
+
+Parameter ParamGrid::get(size_t i) const {
+    Parameter result;
+    apply(i, result);
+    return result;
+}
+
+void ParamGrid::apply(size_t i, Parameter& param) const {
+    if (i >= size()) {
+        throw std::out_of_range("out_of_range in ParamGrid::apply");
+    }
+
+    //最后添加的参数变化最快
+    for (size_t k = m_axes.size(); k > 0; --k) {
+        const Axis& axis = m_axes[k - 1];
+        size_t n = axis.size();
+        size_t pos = i % n;
+        i /= n;
+        if (axis.is_int) {
+            param.set<int>(axis.name, axis.int_values[pos]);
+        } else {
+            param.set<double>(axis.name, axis.double_values[pos]);
+        }
+    }
+}
+
+} /* namespace hku */
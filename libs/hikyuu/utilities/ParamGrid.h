@@ -0,0 +1,77 @@
+/*
+ * ParamGrid.h
+ *
+ *  Created on: 2017年6月19日
+ *      Author: fasiondog
+ */
+
+#ifndef UTILITIES_PARAMGRID_H_
+#define UTILITIES_PARAMGRID_H_
+
+#include "../DataType.h"
+#include "Parameter.h"
+
+namespace hku {
+
+/**
+ * 参数网格，各参数取值的笛卡尔积，先添加的参数变化最慢
+ * @details 如:
+ * <pre>
+ * ParamGrid grid;
+ * grid.addRange("n", 5, 251);          //n = 5, 6, ..., 250
+ * grid.addRange("fast_n", 2, 4);       //fast_n = 2, 3
+ * grid.size();                         //492
+ * grid.get(1);                         //n=5, fast_n=3
+ * </pre>
+ * @ingroup Common-Utilities
+ */
+class HKU_API ParamGrid {
+public:
+    ParamGrid();
+    virtual ~ParamGrid();
+
+    /** 添加整数参数的取值列表，同名参数已存在时替换其取值列表 */
+    ParamGrid& add(const string& name, const vector<int>& values);
+
+    /** 添加浮点参数的取值列表，同名参数已存在时替换其取值列表 */
+    ParamGrid& add(const string& name, const vector<double>& values);
+
+    /** 添加整数参数的取值范围[start, stop)，步长为step */
+    ParamGrid& addRange(const string& name, int start, int stop, int step = 1);
+
+    /** 参数组合的数量，未添加任何参数时为0 */
+    size_t size() const;
+
+    /** 是否包含指定名称的参数 */
+    bool have(const string& name) const;
+
+    /** 获取参数名称列表，按添加顺序排列 */
+    StringList getNameList() const;
+
+    /** 获取第i个参数组合，仅包含网格中的参数 */
+    Parameter get(size_t i) const;
+
+    /** 将第i个参数组合写入param，param中的同名参数须为相同类型 */
+    void apply(size_t i, Parameter& param) const;
+
+private:
+    struct Axis {
+        string name;
+        bool is_int;
+        vector<int> int_values;
+        vector<double> double_values;
+
+        size_t size() const {
+            return is_int ? int_values.size() : double_values.size();
+        }
+    };
+
+    Axis& _axis(const string& name);
+
+private:
+    vector<Axis> m_axes;
+};
+
+} /* namespace hku */
+
+#endif /* UTILITIES_PARAMGRID_H_ */
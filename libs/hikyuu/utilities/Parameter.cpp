@@ -5,6 +5,7 @@
  *      Author: fasiondog
  */
 
+#include <boost/atomic.hpp>
 #include "Parameter.h"
 
 namespace hku {
@@ -39,13 +40,21 @@ HKU_API std::ostream& operator <<(std::ostream &os, const Parameter& param) {
 }
 
 
-Parameter::Parameter() {
+unsigned long long Parameter::_newVersion() {
+    //0保留给CachedParam表示尚未缓存
+    static boost::atomic<unsigned long long> s_version(0);
+    return ++s_version;
+}
 
+
+Parameter::Parameter() {
+    m_version = _newVersion();
 }
 
 
 Parameter::Parameter(const Parameter& p) {
     m_params = p.m_params;
+    m_version = p.m_version;
 }
 
 
@@ -60,6 +69,7 @@ Parameter& Parameter::operator=(const Parameter& p) {
     }
 
     m_params = p.m_params;
+    m_version = p.m_version;
     return *this;
 }
 
@@ -142,9 +142,22 @@ public:
     template <typename ValueType>
     ValueType get(const string& name) const;
 
+    /**
+     * 参数版本号，参数每次修改后都会变为一个全局唯一的新值，版本号相同则
+     * 参数内容一定相同，用于判断缓存的参数值是否需要更新
+     * @see CachedParam
+     */
+    unsigned long long version() const {
+        return m_version;
+    }
+
+private:
+    static unsigned long long _newVersion();
+
 private:
     typedef map<string, boost::any> param_map_t;
     param_map_t m_params;
+    unsigned long long m_version;
 
 //================================
 // 序列化支持
@@ -224,12 +237,62 @@ private:
                 std::cout << "Unknown type! [Parameter::load]" << std::endl;
             }
         }
+        m_version = _newVersion();
     }
     BOOST_SERIALIZATION_SPLIT_MEMBER()
 #endif /* HKU_SUPPORT_SERIALIZATION */
 };
 
 
+/**
+ * 参数值缓存，用于在逐根K线处理等频繁调用的代码中代替getParam，参数未修改时
+ * 直接返回缓存值，避免按名称查找参数及any_cast
+ * @code
+ * class Test {
+ *     PARAMETER_SUPPORT
+ *
+ * public:
+ *     Test(): m_n("n") {
+ *         setParam<int>("n", 10);
+ *     }
+ *
+ *     void calculate() {
+ *         int n = m_n.get(m_params);
+ *         ....
+ *     }
+ *
+ * private:
+ *     CachedParam<int> m_n;
+ * };
+ * @endcode
+ * @ingroup Common-Utilities
+ */
+template <typename ValueType>
+class CachedParam {
+public:
+    explicit CachedParam(const string& name)
+    : m_name(name), m_value(), m_version(0) {}
+
+    /** 获取参数值，参数已修改时重新从param中读取 */
+    const ValueType& get(const Parameter& param) const {
+        if (m_version != param.version()) {
+            m_value = param.get<ValueType>(m_name);
+            m_version = param.version();
+        }
+        return m_value;
+    }
+
+    const string& name() const {
+        return m_name;
+    }
+
+private:
+    string m_name;
+    mutable ValueType m_value;
+    mutable unsigned long long m_version;
+};
+
+
 #define PARAMETER_SUPPORT protected: \
     Parameter m_params; \
     public: \
@@ -275,6 +338,7 @@ void Parameter::set(const string& name, const ValueType& value) {
             return;
         }
         m_params[name] = value;
+        m_version = _newVersion();
         return;
     }
 
@@ -284,6 +348,7 @@ void Parameter::set(const string& name, const ValueType& value) {
     }
 
     m_params[name] = value;
+    m_version = _newVersion();
 }
 
 } /* namespace hku */
@@ -0,0 +1,82 @@
+/*
+ * _ArrayView.cpp
+ *
+ *  Created on: 2017年6月13日
+ *      Author: fasiondog
+ */
+
+#include "_ArrayView.h"
+
+using namespace boost::python;
+using namespace hku;
+
+namespace {
+
+int array_view_getbuffer(PyObject *obj, Py_buffer *view, int flags) {
+    view->obj = NULL;
+    ArrayView *p = (ArrayView *)converter::get_lvalue_from_python(obj,
+            converter::registered<ArrayView>::converters);
+    if (!p) {
+        PyErr_SetString(PyExc_BufferError, "Invalid ArrayView!");
+        return -1;
+    }
+
+    if ((flags & PyBUF_WRITABLE) == PyBUF_WRITABLE) {
+        PyErr_SetString(PyExc_BufferError, "ArrayView is read-only!");
+        return -1;
+    }
+
+    size_t itemsize = p->itemsize();
+    if (p->stride() != itemsize && (flags & PyBUF_STRIDES) != PyBUF_STRIDES) {
+        PyErr_SetString(PyExc_BufferError, "ArrayView is not contiguous!");
+        return -1;
+    }
+
+    //shape与strides需在缓冲区释放前一直有效
+    Py_ssize_t *shape = new Py_ssize_t[2];
+    shape[0] = p->size();
+    shape[1] = p->stride();
+
+    static double empty_buf = 0.0;
+    view->buf = p->size() ? (void *)p->address() : (void *)&empty_buf;
+    view->obj = obj;
+    Py_INCREF(obj);
+    view->len = p->size() * itemsize;
+    view->readonly = 1;
+    view->itemsize = itemsize;
+    view->format = (flags & PyBUF_FORMAT) ?
+            (char *)(itemsize == sizeof(float) ? "f" : "d") : NULL;
+    view->ndim = 1;
+    view->shape = (flags & PyBUF_ND) == PyBUF_ND ? shape : NULL;
+    view->strides = (flags & PyBUF_STRIDES) == PyBUF_STRIDES
+                  ? shape + 1 : NULL;
+    view->suboffsets = NULL;
+    view->internal = shape;
+    return 0;
+}
+
+void array_view_releasebuffer(PyObject *obj, Py_buffer *view) {
+    delete[] (Py_ssize_t *)view->internal;
+    view->internal = NULL;
+}
+
+PyBufferProcs g_array_view_buffer_procs = {
+    array_view_getbuffer,
+    array_view_releasebuffer
+};
+
+} /* namespace */
+
+void export_ArrayView() {
+    class_<ArrayView> cls("ArrayView", init<>());
+    cls.def("__len__", &ArrayView::size)
+       .def("size", &ArrayView::size)
+       .add_property("itemsize", &ArrayView::itemsize)
+       .add_property("format", &ArrayView::format)
+       .add_property("stride", &ArrayView::stride)
+       ;
+
+    //boost.python未提供缓冲区协议的导出方式，直接设置类型的tp_as_buffer
+    PyTypeObject *type = (PyTypeObject *)cls.ptr();
+    type->tp_as_buffer = &g_array_view_buffer_procs;
+}
@@ -0,0 +1,73 @@
+/*
+ * _ArrayView.h
+ *
+ *  Created on: 2017年6月13日
+ *      Author: fasiondog
+ */
+
+#ifndef PYTHON_ARRAYVIEW_H_
+#define PYTHON_ARRAYVIEW_H_
+
+#include <boost/python.hpp>
+#include <hikyuu/DataType.h>
+
+namespace hku {
+
+/*
+ * 只读的一维数组视图，通过Python缓冲区协议（memoryview、numpy.asarray）
+ * 直接访问C++中的数据，不做复制。
+ * 视图持有数据所有者（如指标结果缓存、K线缓存）的引用，因此在视图及由其
+ * 创建的numpy数组存在期间，数据始终有效。
+ */
+class ArrayView {
+public:
+    ArrayView(): m_address(NULL), m_size(0), m_stride(0) {
+        m_format[0] = 'd';
+        m_format[1] = '\0';
+    }
+
+    /**
+     * @param owner 数据所有者
+     * @param address 首个元素的地址
+     * @param size 元素个数
+     * @param stride 相邻元素之间的字节数
+     */
+    template <typename ValueType>
+    ArrayView(const shared_ptr<void>& owner, const ValueType *address,
+            size_t size, size_t stride)
+    : m_owner(owner), m_address(address), m_size(size), m_stride(stride) {
+        m_format[0] = sizeof(ValueType) == sizeof(float) ? 'f' : 'd';
+        m_format[1] = '\0';
+    }
+
+    size_t size() const {
+        return m_size;
+    }
+
+    size_t itemsize() const {
+        return m_format[0] == 'f' ? sizeof(float) : sizeof(double);
+    }
+
+    string format() const {
+        return string(m_format);
+    }
+
+    const void* address() const {
+        return m_address;
+    }
+
+    size_t stride() const {
+        return m_stride;
+    }
+
+private:
+    shared_ptr<void> m_owner;
+    const void *m_address;
+    size_t m_size;
+    size_t m_stride;
+    char m_format[2];
+};
+
+} /* namespace hku */
+
+#endif /* PYTHON_ARRAYVIEW_H_ */
@@ -8,10 +8,53 @@
 #include <boost/python.hpp>
 #include <hikyuu/serialization/KData_serialization.h>
 #include "pickle_support.h"
+#include "_ArrayView.h"
 
 using namespace boost::python;
 using namespace hku;
 
+/*
+ * 获取K线数据中指定列的只读视图
+ * 如Stock已缓存对应类型的K线数据，视图直接引用该缓存，否则一次性读取后引用
+ */
+ArrayView kdata_get_array_view(const KData& kdata, const string& field) {
+    price_storage_t KRecord::*member;
+    if (field == "open") {
+        member = &KRecord::openPrice;
+    } else if (field == "high") {
+        member = &KRecord::highPrice;
+    } else if (field == "low") {
+        member = &KRecord::lowPrice;
+    } else if (field == "close") {
+        member = &KRecord::closePrice;
+    } else if (field == "amount") {
+        member = &KRecord::transAmount;
+    } else if (field == "volume") {
+        member = &KRecord::transCount;
+    } else {
+        throw std::invalid_argument("Invalid field: " + field
+                + "! [KData.getArrayView]");
+    }
+
+    size_t total = kdata.size();
+    if (total == 0) {
+        return ArrayView();
+    }
+
+    Stock stock = kdata.getStock();
+    KQuery::KType ktype = kdata.getQuery().kType();
+    size_t start = kdata.startPos();
+    KRecordListPtr buffer = stock.getKDataBuffer(ktype);
+    if (!buffer || kdata.endPos() > buffer->size()) {
+        buffer = KRecordListPtr(new KRecordList(
+                stock.getKRecordList(start, kdata.endPos(), ktype)));
+        start = 0;
+    }
+
+    return ArrayView(buffer, &((*buffer)[start].*member),
+                     total, sizeof(KRecord));
+}
+
 void export_KData() {
     docstring_options doc_options(false);
 
@@ -36,6 +79,7 @@ void export_KData() {
             .def("getQuery", &KData::getQuery)
             .def("getStock", &KData::getStock)
             .def("tocsv", &KData::tocsv)
+            .def("getArrayView", kdata_get_array_view)
 
             .def("__len__", &KData::size)
 #if HKU_PYTHON_SUPPORT_PICKLE
@@ -9,10 +9,16 @@
 #include <hikyuu/serialization/Stock_serialization.h>
 #include <hikyuu/KData.h>
 #include "pickle_support.h"
+#include "gil_support.h"
 
 using namespace boost::python;
 using namespace hku;
 
+void stock_loadKDataToBuffer(Stock& stock, KQuery::KType ktype) {
+    ReleaseGIL gil;
+    stock.loadKDataToBuffer(ktype);
+}
+
 BOOST_PYTHON_MEMBER_FUNCTION_OVERLOADS(getCount_overloads, getCount, 0, 1)
 BOOST_PYTHON_MEMBER_FUNCTION_OVERLOADS(getIndex_overloads, getIndex, 1, 2)
 BOOST_PYTHON_MEMBER_FUNCTION_OVERLOADS(getRecord_overloads, getKRecord, 1, 2)
@@ -61,7 +67,7 @@ void export_Stock() {
             .def("realtimeUpdate", &Stock::realtimeUpdate)
             .def("getWeight", getWeight1)
             .def("getWeight", getWeight2)
-            .def("loadKDataToBuffer", &Stock::loadKDataToBuffer)
+            .def("loadKDataToBuffer", stock_loadKDataToBuffer)
             .def("releaseKDataBuffer", &Stock::releaseKDataBuffer)
 
             .def("__eq__", &Stock::operator==)
@@ -0,0 +1,48 @@
+/*
+ * gil_support.h
+ *
+ *  Created on: 2017年6月14日
+ *      Author: fasiondog
+ */
+
+#ifndef GIL_SUPPORT_H_
+#define GIL_SUPPORT_H_
+
+#include <boost/python.hpp>
+#include <boost/noncopyable.hpp>
+
+namespace hku {
+
+/*
+ * 在作用域内释放GIL，用于包装耗时较长的纯C++调用，使其他Python线程可同时运行。
+ * 作用域内不得访问任何Python对象。
+ */
+class ReleaseGIL: boost::noncopyable {
+public:
+    ReleaseGIL(): m_state(PyEval_SaveThread()) {}
+    ~ReleaseGIL() {
+        PyEval_RestoreThread(m_state);
+    }
+
+private:
+    PyThreadState *m_state;
+};
+
+/*
+ * 在作用域内获取GIL，用于C++回调由Python继承实现的虚函数。
+ * 当前线程已持有GIL时亦可使用。
+ */
+class AcquireGIL: boost::noncopyable {
+public:
+    AcquireGIL(): m_state(PyGILState_Ensure()) {}
+    ~AcquireGIL() {
+        PyGILState_Release(m_state);
+    }
+
+private:
+    PyGILState_STATE m_state;
+};
+
+} /* namespace hku */
+
+#endif /* GIL_SUPPORT_H_ */
@@ -9,10 +9,32 @@
 #include <hikyuu/indicator/Indicator.h>
 #include "../_Parameter.h"
 #include "../pickle_support.h"
+#include "../_ArrayView.h"
+#include "../gil_support.h"
 
 using namespace boost::python;
 using namespace hku;
 
+Indicator indicator_call(Indicator& ind, const Indicator& data) {
+    ReleaseGIL gil;
+    return ind(data);
+}
+
+/* 获取指定结果集的只读视图，视图持有结果缓存的引用，不随指标重新计算而改变 */
+ArrayView indicator_get_array_view(const Indicator& ind, size_t num) {
+    IndicatorImpPtr imp = ind.getImp();
+    if (!imp || imp->size() == 0) {
+        return ArrayView();
+    }
+
+    if (num >= imp->getResultNumber()) {
+        throw std::out_of_range("num out of range! [Indicator.getArrayView]");
+    }
+
+    return ArrayView(imp->getBuffer(), imp->data(num), imp->size(),
+                     sizeof(price_storage_t));
+}
+
 BOOST_PYTHON_MEMBER_FUNCTION_OVERLOADS(get_overloads, get, 1, 2)
 
 Indicator (*indicator_add1)(const Indicator&, const Indicator&) = operator+;
@@ -58,8 +80,10 @@ void export_Indicator() {
         .def("get", &Indicator::get, get_overloads())
         .def("getResult", &Indicator::getResult)
         .def("getResultAsPriceList", &Indicator::getResultAsPriceList)
+        .def("getArrayView", indicator_get_array_view,
+                (arg("num")=0))
         .def("__len__", &Indicator::size)
-        .def("__call__", &Indicator::operator())
+        .def("__call__", indicator_call)
 #if HKU_PYTHON_SUPPORT_PICKLE
         .def_pickle(normal_pickle_suite<Indicator>())
 #endif
@@ -0,0 +1,28 @@
+/*
+ * _IndicatorCache.cpp
+ *
+ *  Created on: 2017年6月14日
+ *      Author: fasiondog
+ */
+
+#include <boost/python.hpp>
+#include <hikyuu/indicator/IndicatorCache.h>
+
+using namespace boost::python;
+using namespace hku;
+
+void export_IndicatorCache() {
+    class_<IndicatorCache>("IndicatorCache", no_init)
+            .def("setMaxBytes", &IndicatorCache::setMaxBytes).staticmethod("setMaxBytes")
+            .def("getMaxBytes", &IndicatorCache::getMaxBytes).staticmethod("getMaxBytes")
+            .def("enabled", &IndicatorCache::enabled).staticmethod("enabled")
+            .def("invalidate", &IndicatorCache::invalidate).staticmethod("invalidate")
+            .def("clear", &IndicatorCache::clear).staticmethod("clear")
+            .def("size", &IndicatorCache::size).staticmethod("size")
+            .def("bytes", &IndicatorCache::bytes).staticmethod("bytes")
+            .def("hits", &IndicatorCache::hits).staticmethod("hits")
+            .def("misses", &IndicatorCache::misses).staticmethod("misses")
+            .def("evictions", &IndicatorCache::evictions).staticmethod("evictions")
+            .def("resetStatistics", &IndicatorCache::resetStatistics).staticmethod("resetStatistics")
+            ;
+}
@@ -9,6 +9,7 @@
 #include <hikyuu/indicator/Indicator.h>
 #include "../_Parameter.h"
 #include "../pickle_support.h"
+#include "../gil_support.h"
 
 using namespace boost::python;
 using namespace hku;
@@ -21,6 +22,7 @@ public:
         IndicatorImp(name, result_num) {}
 
     IndicatorImpPtr operator()(const Indicator& ind) {
+        AcquireGIL gil;
         if (override call = get_override("__call__")) {
             return call(ind);
         }
@@ -32,6 +34,7 @@ public:
     }
 
     void _calculate(const Indicator& ind) {
+        AcquireGIL gil;
         if (override call = get_override("_calculate")) {
             call(ind);
         } else {
@@ -44,6 +47,7 @@ public:
     }
 
     bool check() {
+        AcquireGIL gil;
         if (override call = get_override("check")) {
             return call();
         } else {
@@ -56,6 +60,11 @@ public:
     }
 };
 
+void imp_calculate(IndicatorImp& imp, const Indicator& data) {
+    ReleaseGIL gil;
+    imp.calculate(data);
+}
+
 BOOST_PYTHON_MEMBER_FUNCTION_OVERLOADS(_set_overloads, _set, 2, 3)
 BOOST_PYTHON_MEMBER_FUNCTION_OVERLOADS(_append_overloads, _append, 1, 2)
 
@@ -78,7 +87,7 @@ void export_IndicatorImp() {
             .def("_readyBuffer", &IndicatorImp::_readyBuffer)
             .def("getResultNumber", &IndicatorImp::getResultNumber)
             .def("getResultAsPriceList", &IndicatorImp::getResultAsPriceList)
-            .def("calculate", &IndicatorImp::calculate)
+            .def("calculate", imp_calculate)
             .def("check", &IndicatorImp::check, &IndicatorImpWrap::default_check)
             .def("_calculate", &IndicatorImp::_calculate, &IndicatorImpWrap::default_calculate)
             .def("__call__", &IndicatorImp::operator(), &IndicatorImpWrap::default_call)
@@ -8,6 +8,7 @@
 #include <boost/python.hpp>
 #include <hikyuu/indicator/Operand.h>
 #include "../pickle_support.h"
+#include "../gil_support.h"
 
 using namespace boost::python;
 using namespace hku;
@@ -15,7 +16,11 @@ using namespace hku;
 string (Operand::*op_read_name)() const = &Operand::name;
 void (Operand::*op_write_name)(const string&) = &Operand::name;
 
-Indicator (Operand::*bracket1)(const Indicator&) = &Operand::operator();
+Indicator operand_call(Operand& op, const Indicator& ind) {
+    ReleaseGIL gil;
+    return op(ind);
+}
+
 Operand (Operand::*bracket2)(const Operand&) = &Operand::operator();
 
 Operand (*Operand_add2)(const Operand&, price_t) = operator+;
@@ -45,7 +50,7 @@ void export_Operand() {
         .def(init<const Operand&, const Operand&>())
         .add_property("name", op_read_name, op_write_name)
         .def(self_ns::str(self))
-        .def("__call__", bracket1)
+        .def("__call__", operand_call)
         .def("__call__", bracket2)
         .def("__add__", &Operand::operator+)
         .def("__add__", Operand_add2)
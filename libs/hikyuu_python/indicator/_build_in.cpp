@@ -73,6 +73,15 @@ Indicator (*MACD_2)(const Indicator&, int, int, int) = MACD;
 //BOOST_PYTHON_FUNCTION_OVERLOADS(MACD_1_overload, MACD, 0, 3);
 //BOOST_PYTHON_FUNCTION_OVERLOADS(MACD_2_overload, MACD, 1, 4);
 
+Indicator (*BOLL_1)(int, double) = BOLL;
+Indicator (*BOLL_2)(const Indicator&, int, double) = BOLL;
+
+Indicator (*KDJ_1)(int, int, int) = KDJ;
+Indicator (*KDJ_2)(const Indicator&, int, int, int) = KDJ;
+
+Indicator (*RSI_1)(int) = RSI;
+Indicator (*RSI_2)(const Indicator&, int) = RSI;
+
 Indicator (*REF_1)(int) = REF;
 Indicator (*REF_2)(const Indicator&, int) = REF;
 
@@ -100,6 +109,11 @@ Indicator (*WEAVE_2)(const Indicator&) = WEAVE;
 Indicator (*CVAL_1)(double, size_t, size_t) = CVAL;
 Indicator (*CVAL_2)(const Indicator&, double) = CVAL;
 
+#if HKU_SUPPORT_TA_LIB
+Indicator (*TA_LIB_1)(const string&) = TA_LIB;
+Indicator (*TA_LIB_2)(const Indicator&, const string&) = TA_LIB;
+#endif
+
 Indicator (*IND_AND1)(const Indicator&, const Indicator&) = IND_AND;
 Indicator (*IND_AND2)(const Indicator&, price_t) = IND_AND;
 Indicator (*IND_AND3)(price_t, const Indicator&) = IND_AND;
@@ -167,6 +181,15 @@ void export_Indicator_build_in() {
     def("MACD", MACD_1, (arg("n1")=12, arg("n2")=26, arg("n3")=9));
     def("MACD", MACD_2, (arg("data"), arg("n1")=12, arg("n2")=26, arg("n3")=9));
 
+    def("BOLL", BOLL_1, (arg("n")=20, arg("p")=2.0));
+    def("BOLL", BOLL_2, (arg("data"), arg("n")=20, arg("p")=2.0));
+
+    def("KDJ", KDJ_1, (arg("n")=9, arg("m1")=3, arg("m2")=3));
+    def("KDJ", KDJ_2, (arg("data"), arg("n")=9, arg("m1")=3, arg("m2")=3));
+
+    def("RSI", RSI_1, (arg("n")=14));
+    def("RSI", RSI_2, (arg("data"), arg("n")=14));
+
     def("VIGOR", VIGOR_1, (arg("kdata"), arg("n")=2));
     def("VIGOR", VIGOR_2, (arg("n")=2));
     def("VIGOR", VIGOR_3, (arg("ind"), arg("n")=2));
@@ -196,6 +219,11 @@ void export_Indicator_build_in() {
     def("CVAL", CVAL_1, (arg("value")=0.0, arg("len")=0, arg("discard")=0));
     def("CVAL", CVAL_2, (arg("data"), arg("value")=0.0));
 
+#if HKU_SUPPORT_TA_LIB
+    def("TA_LIB", TA_LIB_1, (arg("func_name")));
+    def("TA_LIB", TA_LIB_2, (arg("data"), arg("func_name")));
+#endif
+
     def("IND_AND", IND_AND1);
     def("IND_AND", IND_AND2);
     def("IND_AND", IND_AND3);
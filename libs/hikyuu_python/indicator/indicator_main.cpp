@@ -15,10 +15,12 @@ void export_Indicator();
 void export_IndicatorImp();
 void export_Indicator_build_in();
 void export_Operand();
+void export_IndicatorCache();
 
 BOOST_PYTHON_MODULE(_indicator) {
     export_Indicator();
     export_IndicatorImp();
     export_Indicator_build_in();
     export_Operand();
+    export_IndicatorCache();
 }
@@ -7,6 +7,7 @@
 
 #include <boost/python.hpp>
 #include <hikyuu/hikyuu.h>
+#include "gil_support.h"
 
 void export_DataType();
 void export_Constant();
@@ -23,11 +24,18 @@ void export_KReord();
 void export_KData();
 void export_Parameter();
 void export_save_load();
+void export_ArrayView();
+
+void hikyuu_init_release_gil(const std::string& config_file_name) {
+    hku::ReleaseGIL gil;
+    hku::hikyuu_init(config_file_name);
+}
 
 BOOST_PYTHON_MODULE(_hikyuu){
-    boost::python::def("hikyuu_init", hku::hikyuu_init);
+    boost::python::def("hikyuu_init", hikyuu_init_release_gil);
     boost::python::def("getStock", hku::getStock);
 
+    export_ArrayView();
     export_DataType();
     export_Constant();
     export_util();
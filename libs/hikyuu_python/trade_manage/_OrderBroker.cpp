@@ -9,6 +9,7 @@
 #include <hikyuu/trade_manage/OrderBrokerBase.h>
 #include "../_Parameter.h"
 #include "../pickle_support.h"
+#include "../gil_support.h"
 
 using namespace boost::python;
 using namespace hku;
@@ -18,10 +19,12 @@ public:
     OrderBrokerWrap(): OrderBrokerBase() {}
 
     void _buy(const string& code, price_t price, int num) {
+        AcquireGIL gil;
         this->get_override("_buy")(code, price, num);
     }
 
     void _sell(const string& code, price_t price, int num) {
+        AcquireGIL gil;
         this->get_override("_sell")(code, price, num);
     }
 };
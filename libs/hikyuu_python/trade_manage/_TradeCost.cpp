@@ -9,6 +9,7 @@
 #include <hikyuu/trade_manage/TradeCostBase.h>
 #include "../_Parameter.h"
 #include "../pickle_support.h"
+#include "../gil_support.h"
 
 using namespace boost::python;
 using namespace hku;
@@ -19,20 +20,24 @@ public:
 
     CostRecord getBuyCost(const Datetime& datetime, const Stock& stock,
             price_t price, size_t num) const {
+        AcquireGIL gil;
         return this->get_override("getBuyCost")(datetime, stock, price, num);
     }
 
     CostRecord getSellCost(const Datetime& datetime, const Stock& stock,
             price_t price, size_t num) const {
+        AcquireGIL gil;
         return this->get_override("getSellCost")(datetime, stock, price, num);
     }
 
     TradeCostPtr _clone() {
+        AcquireGIL gil;
         return this->get_override("_clone")();
     }
 
     CostRecord getBorrowCashCost(const Datetime& datetime,
             price_t cash) const {
+        AcquireGIL gil;
         if (override getBorrowCashCost = get_override("getBorrowCashCost")) {
             return getBorrowCashCost(datetime, cash);
         }
@@ -46,6 +51,7 @@ public:
 
     CostRecord getReturnCashCost(const Datetime& borrow_datetime,
             const Datetime& return_datetime, price_t cash) const {
+        AcquireGIL gil;
         if (override getReturnCashCost = get_override("getReturnCashCost")) {
             return getReturnCashCost(borrow_datetime, return_datetime, cash);
         }
@@ -59,6 +65,7 @@ public:
 
     CostRecord getBorrowStockCost(const Datetime& datetime,
             const Stock& stock, price_t price, size_t num) const {
+        AcquireGIL gil;
         if (override getBorrowStockCost = get_override("getBorrowStockCost")) {
             return getBorrowStockCost(datetime, stock, price, num);
         }
@@ -73,6 +80,7 @@ public:
     CostRecord getReturnStockCost(const Datetime& borrow_datetime,
             const Datetime& return_datetime,
             const Stock& stock, price_t price, size_t num)  const {
+        AcquireGIL gil;
         if (override getReturnStockCost = get_override("getReturnStockCost")) {
             return getReturnStockCost(borrow_datetime, return_datetime,
                     stock, price, num);
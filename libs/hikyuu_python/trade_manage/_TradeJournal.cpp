@@ -0,0 +1,51 @@
+/*
+ * _TradeJournal.cpp
+ *
+ *  Created on: 2017年6月22日
+ *      Author: fasiondog
+ */
+
+#include <boost/python.hpp>
+#include <hikyuu/trade_manage/TradeJournalBase.h>
+#include "../gil_support.h"
+
+using namespace boost::python;
+using namespace hku;
+
+class TradeJournalWrap : public TradeJournalBase, public wrapper<TradeJournalBase> {
+public:
+    TradeJournalWrap(): TradeJournalBase() {}
+    TradeJournalWrap(const string& name): TradeJournalBase(name) {}
+
+    void _write(const TradeRecord& record) {
+        AcquireGIL gil;
+        this->get_override("_write")(record);
+    }
+
+    void flush() {
+        AcquireGIL gil;
+        if (override call = this->get_override("flush")) {
+            call();
+        } else {
+            TradeJournalBase::flush();
+        }
+    }
+
+    void default_flush() {
+        this->TradeJournalBase::flush();
+    }
+};
+
+
+void export_TradeJournal() {
+    class_<TradeJournalWrap, boost::noncopyable>("TradeJournalBase", init<>())
+            .def(init<const string&>())
+            .add_property("name", make_function(&TradeJournalBase::name,
+                    return_value_policy<copy_const_reference>()))
+            .def("write", &TradeJournalBase::write)
+            .def("flush", &TradeJournalBase::flush, &TradeJournalWrap::default_flush)
+            .def("_write", pure_virtual(&TradeJournalBase::_write))
+            ;
+
+    register_ptr_to_python<TradeJournalPtr>();
+}
@@ -89,6 +89,8 @@ void export_TradeManager() {
 
             .def("regBroker", &TradeManager::regBroker)
             .def("clearBroker", &TradeManager::clearBroker)
+            .def("regJournal", &TradeManager::regJournal)
+            .def("clearJournal", &TradeManager::clearJournal)
             .def("getMarginRate", &TradeManager::getMarginRate)
             .def("have", &TradeManager::have)
             .def("getStockNumber", &TradeManager::getStockNumber)
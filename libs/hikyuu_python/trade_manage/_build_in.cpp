@@ -11,11 +11,26 @@
 using namespace boost::python;
 using namespace hku;
 
+TradeManagerPtr crtTMFromMerge_py(object o, const string& name) {
+    TradeManagerList tm_list;
+    size_t total = extract<size_t>(o.attr("__len__")());
+    for (size_t i = 0; i < total; ++i) {
+        tm_list.push_back(extract<TradeManagerPtr>(o.attr("__getitem__")(i)));
+    }
+    return crtTMFromMerge(tm_list, name);
+}
+
 void export_build_in() {
     def("crtTM", crtTM, (arg("datetime") = Datetime(199001010000LL),
             arg("initCash") = 100000, arg("costFunc") = TC_Zero(),
             arg("name")="SYS"));
 
+    def("crtTMFromJournal", crtTMFromJournal, (arg("filename"),
+            arg("costFunc") = TC_Zero(), arg("name")="SYS"));
+
+    def("crtTMFromMerge", crtTMFromMerge_py, (arg("tm_list"),
+            arg("name")="SYS"));
+
     def("TC_TestStub", TC_TestStub);
 
     def("TC_FixedA", TC_FixedA, (arg("commission") = 0.0018,
@@ -30,5 +45,8 @@ void export_build_in() {
             arg("transferfee") = 0.00002));
 
     def("TC_Zero", TC_Zero);
+
+    def("TJ_Binary", TJ_Binary);
+    def("TJ_Csv", TJ_Csv);
 }
 
@@ -20,6 +20,7 @@ void export_LoanRecord();
 void export_TradeManager();
 void export_Performance();
 void export_OrderBroker();
+void export_TradeJournal();
 
 BOOST_PYTHON_MODULE(_trade_manage) {
     docstring_options doc_options(false);
@@ -31,6 +32,7 @@ BOOST_PYTHON_MODULE(_trade_manage) {
     export_BorrowRecord();
     export_LoanRecord();
     export_OrderBroker();
+    export_TradeJournal();
     export_TradeManager();
     export_Performance();
     export_build_in();
@@ -9,6 +9,7 @@
 #include <hikyuu/trade_sys/portfolio/build_in.h>
 #include "../_Parameter.h"
 #include "../pickle_support.h"
+#include "../gil_support.h"
 
 using namespace boost::python;
 using namespace hku;
@@ -20,6 +21,7 @@ public:
     virtual ~AllocateMoneyWrap() {}
 
     string name() const {
+        AcquireGIL gil;
         if (override name = this->get_override("name"))
 #if defined(BOOST_WINDOWS)
             return call<char const*>(name.ptr());
@@ -34,6 +36,7 @@ public:
     }
 
     void _reset() {
+        AcquireGIL gil;
         if (override func = this->get_override("_reset")) {
             func();
         } else {
@@ -46,6 +49,7 @@ public:
     }
 
     StockList tryAllocate(Datetime date, const StockList& stocks) {
+        AcquireGIL gil;
         if (override func = this->get_override("tryAllocate")) {
             return func(date, stocks);
         } else {
@@ -58,6 +62,7 @@ public:
     }
 
     AllocateMoneyPtr _clone() {
+        AcquireGIL gil;
         return this->get_override("_clone")();
     }
 };
@@ -10,6 +10,7 @@
 #include <hikyuu/trade_sys/condition/build_in.h>
 #include "../_Parameter.h"
 #include "../pickle_support.h"
+#include "../gil_support.h"
 
 using namespace boost::python;
 using namespace hku;
@@ -20,6 +21,7 @@ public:
     ConditionWrap(const string& name): ConditionBase(name) {}
 
     void _reset() {
+        AcquireGIL gil;
         if (override func = get_override("_reset")) {
             func();
         } else {
@@ -32,10 +34,12 @@ public:
     }
 
     void _calculate() {
+        AcquireGIL gil;
         this->get_override("_calculate")();
     }
 
     ConditionPtr _clone() {
+        AcquireGIL gil;
         return this->get_override("_clone")();
     }
 };
@@ -44,6 +48,11 @@ public:
 string (ConditionBase::*cn_get_name)() const = &ConditionBase::name;
 void (ConditionBase::*cn_set_name)(const string&) = &ConditionBase::name;
 
+bool (ConditionBase::*cn_is_valid_1)(const Datetime&) const = &ConditionBase::isValid;
+bool (ConditionBase::*cn_is_valid_2)(size_t) const = &ConditionBase::isValid;
+void (ConditionBase::*cn_add_valid_1)(const Datetime&) = &ConditionBase::_addValid;
+void (ConditionBase::*cn_add_valid_2)(size_t) = &ConditionBase::_addValid;
+
 
 void export_Condition() {
     class_<ConditionWrap, boost::noncopyable>("ConditionBase", init<>())
@@ -52,7 +61,8 @@ void export_Condition() {
             .add_property("name", cn_get_name, cn_set_name)
             .def("getParam", &ConditionBase::getParam<boost::any>)
             .def("setParam", &ConditionBase::setParam<object>)
-            .def("isValid", &ConditionBase::isValid)
+            .def("isValid", cn_is_valid_1)
+            .def("isValid", cn_is_valid_2)
             .def("setTO", &ConditionBase::setTO)
             .def("getTO", &ConditionBase::getTO)
             .def("setTM", &ConditionBase::setTM)
@@ -61,7 +71,8 @@ void export_Condition() {
             .def("getSG", &ConditionBase::getSG)
             .def("reset", &ConditionBase::reset)
             .def("clone", &ConditionBase::clone)
-            .def("_addValid", &ConditionBase::_addValid)
+            .def("_addValid", cn_add_valid_1)
+            .def("_addValid", cn_add_valid_2)
             .def("_calculate", pure_virtual(&ConditionBase::_calculate))
             .def("_reset", &ConditionBase::_reset, &ConditionWrap::default_reset)
             .def("_clone", pure_virtual(&ConditionBase::_clone))
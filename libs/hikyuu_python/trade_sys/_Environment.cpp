@@ -17,6 +17,7 @@
 #include <hikyuu/trade_sys/environment/build_in.h>
 #include "../_Parameter.h"
 #include "../pickle_support.h"
+#include "../gil_support.h"
 
 using namespace boost::python;
 using namespace hku;
@@ -27,6 +28,7 @@ public:
     EnvironmentWrap(const string& name): EnvironmentBase(name) {}
 
     void _reset() {
+        AcquireGIL gil;
         if (override func = get_override("_reset")) {
             func();
         } else {
@@ -39,10 +41,12 @@ public:
     }
 
     EnvironmentPtr _clone() {
+        AcquireGIL gil;
         return this->get_override("_clone")();
     }
 
     void _calculate() {
+        AcquireGIL gil;
         this->get_override("_calculate")();
     }
 };
@@ -9,6 +9,7 @@
 #include <hikyuu/trade_sys/moneymanager/build_in.h>
 #include "../_Parameter.h"
 #include "../pickle_support.h"
+#include "../gil_support.h"
 
 using namespace boost::python;
 using namespace hku;
@@ -19,6 +20,7 @@ public:
     MoneyManagerWrap(const string& name): MoneyManagerBase(name) {}
 
     void buyNotify(const TradeRecord& record) {
+        AcquireGIL gil;
         if (override buyNotify = this->get_override("buyNotify")) {
             buyNotify(record);
             return;
@@ -31,6 +33,7 @@ public:
     }
 
     void sellNotify(const TradeRecord& record) {
+        AcquireGIL gil;
         if (override sellNotify = this->get_override("sellNotify")) {
             sellNotify(record);
             return;
@@ -44,6 +47,7 @@ public:
 
     size_t _getSellNumber(const Datetime& datetime, const Stock& stock,
             price_t price, price_t risk) {
+        AcquireGIL gil;
         if (override _getSellNumber = this->get_override("_getSellNumber")) {
             return _getSellNumber(datetime, stock, price, risk);
         }
@@ -57,11 +61,13 @@ public:
 
     size_t _getBuyNumber(const Datetime& datetime, const Stock& stock,
             price_t price, price_t risk) {
+        AcquireGIL gil;
         return this->get_override("_getBuyNumber")(datetime, stock, price, risk);
     }
 
     size_t _getSellShortNumber(const Datetime& datetime, const Stock& stock,
             price_t price, price_t risk) {
+        AcquireGIL gil;
         if (override _getSellShortNumber = this->get_override("_getSellShortNumber")) {
             return _getSellShortNumber(datetime, stock, price, risk);
         }
@@ -75,6 +81,7 @@ public:
 
     size_t getBuyShortNumber(const Datetime& datetime, const Stock& stock,
             price_t price, price_t risk) {
+        AcquireGIL gil;
         if (override _getBuyShortNumber = this->get_override("_getBuyShortNumber")) {
             return _getBuyShortNumber(datetime, stock, price, risk);
         }
@@ -87,10 +94,12 @@ public:
     }
 
     void _reset() {
+        AcquireGIL gil;
         this->get_override("_reset")();
     }
 
     MoneyManagerPtr _clone() {
+        AcquireGIL gil;
         return this->get_override("_clone")();
     }
 };
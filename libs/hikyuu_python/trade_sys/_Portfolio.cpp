@@ -9,6 +9,7 @@
 #include <hikyuu/trade_sys/portfolio/build_in.h>
 #include "../_Parameter.h"
 #include "../pickle_support.h"
+#include "../gil_support.h"
 
 using namespace boost::python;
 using namespace hku;
@@ -16,6 +17,37 @@ using namespace hku;
 void (Portfolio::*pf_set_name)(const string&) = &Portfolio::name;
 string (Portfolio::*pf_get_name)() const= &Portfolio::name;
 
+template <class T>
+bool is_python_derived(const shared_ptr<T>& p) {
+    return p && detail::wrapper_base_::owner(p.get()) != 0;
+}
+
+/*
+ * Portfolio::run为每只选中的证券克隆系统，并在返回前释放这些克隆。由Python
+ * 继承实现的部件，其克隆由Python的_clone创建，释放时需持有GIL，因此系统中
+ * 存在此类部件时不释放GIL。
+ */
+bool sys_has_python_part(const SystemPtr& sys) {
+    return is_python_derived(sys->getEV()) || is_python_derived(sys->getCN())
+        || is_python_derived(sys->getMM()) || is_python_derived(sys->getSG())
+        || is_python_derived(sys->getST()) || is_python_derived(sys->getTP())
+        || is_python_derived(sys->getPG()) || is_python_derived(sys->getSP());
+}
+
+void portfolio_run(Portfolio& pf, const KQuery& query) {
+    SystemPtr sys = pf.getSYS();
+    if (!sys || sys_has_python_part(sys)) {
+        pf.run(query);
+        return;
+    }
+
+    //run中会以pf的tm替换系统原有的tm，先在持有GIL时替换，避免在释放GIL
+    //期间释放由Python传入的tm
+    sys->setTM(pf.getTM());
+    ReleaseGIL gil;
+    pf.run(query);
+}
+
 void export_Portfolio() {
     class_<Portfolio>("Portfolio", init<>())
             .def(init<const string&>())
@@ -34,7 +66,7 @@ void export_Portfolio() {
             .add_property("se", &Portfolio::getSE, &Portfolio::setSE)
             .def("addStock", &Portfolio::addStock)
             .def("addStockList", &Portfolio::addStockList)
-            .def("run", &Portfolio::run)
+            .def("run", portfolio_run)
 #if HKU_PYTHON_SUPPORT_PICKLE
             .def_pickle(name_init_pickle_suite<Portfolio>())
 #endif
@@ -9,6 +9,7 @@
 #include <hikyuu/trade_sys/profitgoal/build_in.h>
 #include "../_Parameter.h"
 #include "../pickle_support.h"
+#include "../gil_support.h"
 
 using namespace boost::python;
 using namespace hku;
@@ -20,6 +21,7 @@ public:
     virtual ~ProfitGoalWrap() {}
 
     void _reset() {
+        AcquireGIL gil;
         if (override func = get_override("_reset")) {
             func();
         } else {
@@ -32,14 +34,17 @@ public:
     }
 
     ProfitGoalPtr _clone() {
+        AcquireGIL gil;
         return this->get_override("_clone")();
     }
 
     void _calculate() {
+        AcquireGIL gil;
         this->get_override("_calculate")();
     }
 
     price_t getGoal(const Datetime& datetime, price_t price) {
+        AcquireGIL gil;
         return this->get_override("getGoal")(datetime, price);
     }
 
@@ -48,6 +53,7 @@ public:
     }
 
     price_t getShortGoal(const Datetime& datetime, price_t price) {
+        AcquireGIL gil;
         if (override getShortGoal = get_override("getShortGoal")) {
             return getShortGoal(datetime, price);
         }
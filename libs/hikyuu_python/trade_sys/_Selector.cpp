@@ -9,6 +9,7 @@
 #include <hikyuu/trade_sys/selector/build_in.h>
 #include "../_Parameter.h"
 #include "../pickle_support.h"
+#include "../gil_support.h"
 
 using namespace boost::python;
 using namespace hku;
@@ -19,6 +20,7 @@ public:
     virtual ~SelectorWrap() {}
 
     string name() const {
+        AcquireGIL gil;
         if (override name = this->get_override("name"))
 #if defined(BOOST_WINDOWS)
             return call<char const*>(name.ptr());
@@ -33,6 +35,7 @@ public:
     }
 
     void _reset() {
+        AcquireGIL gil;
         if (override func = this->get_override("_reset")) {
             func();
         } else {
@@ -45,6 +48,7 @@ public:
     }
 
     StockList getSelectedStock(Datetime date) {
+        AcquireGIL gil;
         if (override func = this->get_override("getSelectedStock")) {
             return func(date);
         } else {
@@ -57,6 +61,7 @@ public:
     }
 
     SelectorPtr _clone() {
+        AcquireGIL gil;
         return this->get_override("_clone")();
     }
 };
@@ -76,6 +81,7 @@ void export_Selector() {
             .def("addStockList", &SelectorBase::addStockList)
             .def("getRawStockList", &SelectorBase::getRawStockList, &SelectorWrap::getRawStockList)
             .def("clearStockList", &SelectorBase::clearStockList)
+            .def("getSelectedStock", &SelectorBase::getSelectedStock, &SelectorWrap::default_getSelectedStock)
 #if HKU_PYTHON_SUPPORT_PICKLE
             .def_pickle(name_init_pickle_suite<SelectorBase>())
 #endif
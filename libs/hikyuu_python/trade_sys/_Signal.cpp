@@ -9,6 +9,7 @@
 #include <hikyuu/trade_sys/signal/build_in.h>
 #include "../_Parameter.h"
 #include "../pickle_support.h"
+#include "../gil_support.h"
 
 using namespace boost::python;
 using namespace hku;
@@ -19,6 +20,7 @@ public:
     SignalWrap(const string& name) : SignalBase(name) {}
 
     void _reset() {
+        AcquireGIL gil;
         if (override func = this->get_override("_reset")) {
             func();
         } else {
@@ -31,10 +33,12 @@ public:
     }
 
     SignalPtr _clone() {
+        AcquireGIL gil;
         return this->get_override("_clone")();
     }
 
     void _calculate() {
+        AcquireGIL gil;
         this->get_override("_calculate")();
     }
 };
@@ -43,6 +47,15 @@ public:
 string (SignalBase::*sg_get_name)() const = &SignalBase::name;
 void (SignalBase::*sg_set_name)(const string&) = &SignalBase::name;
 
+bool (SignalBase::*sg_should_buy_1)(const Datetime&) const = &SignalBase::shouldBuy;
+bool (SignalBase::*sg_should_buy_2)(size_t) const = &SignalBase::shouldBuy;
+bool (SignalBase::*sg_should_sell_1)(const Datetime&) const = &SignalBase::shouldSell;
+bool (SignalBase::*sg_should_sell_2)(size_t) const = &SignalBase::shouldSell;
+void (SignalBase::*sg_add_buy_1)(const Datetime&) = &SignalBase::_addBuySignal;
+void (SignalBase::*sg_add_buy_2)(size_t) = &SignalBase::_addBuySignal;
+void (SignalBase::*sg_add_sell_1)(const Datetime&) = &SignalBase::_addSellSignal;
+void (SignalBase::*sg_add_sell_2)(size_t) = &SignalBase::_addSellSignal;
+
 void export_Signal() {
     class_<SignalWrap, boost::noncopyable>("SignalBase", init<>())
             .def(init<const string&>())
@@ -56,12 +69,16 @@ void export_Signal() {
             .def("setParam", &SignalBase::setParam<object>)
             .def("setTO", &SignalBase::setTO)
             .def("getTO", &SignalBase::getTO)
-            .def("shouldBuy", &SignalBase::shouldBuy)
-            .def("shouldSell", &SignalBase::shouldSell)
+            .def("shouldBuy", sg_should_buy_1)
+            .def("shouldBuy", sg_should_buy_2)
+            .def("shouldSell", sg_should_sell_1)
+            .def("shouldSell", sg_should_sell_2)
             .def("getBuySignal", &SignalBase::getBuySignal)
             .def("getSellSignal", &SignalBase::getSellSignal)
-            .def("_addBuySignal", &SignalBase::_addBuySignal)
-            .def("_addSellSignal", &SignalBase::_addSellSignal)
+            .def("_addBuySignal", sg_add_buy_1)
+            .def("_addBuySignal", sg_add_buy_2)
+            .def("_addSellSignal", sg_add_sell_1)
+            .def("_addSellSignal", sg_add_sell_2)
             .def("reset", &SignalBase::reset)
             .def("clone", &SignalBase::clone)
             .def("_calculate", pure_virtual(&SignalBase::_calculate))
@@ -10,6 +10,7 @@
 #include <hikyuu/trade_sys/slippage/build_in.h>
 #include "../_Parameter.h"
 #include "../pickle_support.h"
+#include "../gil_support.h"
 
 using namespace boost::python;
 using namespace hku;
@@ -21,6 +22,7 @@ public:
     virtual ~SlippageWrap() {}
 
     void _reset() {
+        AcquireGIL gil;
         if (override func = get_override("_reset")) {
             func();
         } else {
@@ -33,18 +35,22 @@ public:
     }
 
     SlippagePtr _clone() {
+        AcquireGIL gil;
         return this->get_override("_clone")();
     }
 
     void _calculate() {
+        AcquireGIL gil;
         this->get_override("_calculate");
     }
 
     price_t getRealBuyPrice(const Datetime& datetime, price_t price) {
+        AcquireGIL gil;
         return this->get_override("getRealBuyPrice")(datetime, price);
     }
 
     price_t getRealSellPrice(const Datetime& datetime, price_t price) {
+        AcquireGIL gil;
         return this->get_override("getRealSellPrice")(datetime, price);
     }
 };
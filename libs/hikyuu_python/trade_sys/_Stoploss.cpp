@@ -9,6 +9,7 @@
 #include <hikyuu/trade_sys/stoploss/build_in.h>
 #include "../_Parameter.h"
 #include "../pickle_support.h"
+#include "../gil_support.h"
 
 using namespace boost::python;
 using namespace hku;
@@ -20,6 +21,7 @@ public:
     virtual ~StoplossWrap() {}
 
     void _reset() {
+        AcquireGIL gil;
         if (override func = this->get_override("_reset")) {
             func();
         } else {
@@ -32,18 +34,22 @@ public:
     }
 
     StoplossPtr _clone() {
+        AcquireGIL gil;
         return this->get_override("_clone")();
     }
 
     void _calculate() {
+        AcquireGIL gil;
         this->get_override("_calculate")();
     }
 
     price_t getPrice(const Datetime& datetime, price_t price) {
+        AcquireGIL gil;
         return this->get_override("getPrice")(datetime, price);
     }
 
     price_t getShortPrice(const Datetime& datetime, price_t price) {
+        AcquireGIL gil;
         if (override getShortPrice = get_override("getShortPrice")) {
             return getShortPrice(datetime, price);
         }
@@ -9,14 +9,28 @@
 #include <hikyuu/trade_sys/system/build_in.h>
 #include "../_Parameter.h"
 #include "../pickle_support.h"
+#include "../gil_support.h"
 
 using namespace boost::python;
 using namespace hku;
 
 void (System::*run_monent_1)(const Datetime&) = &System::runMoment;
 void (System::*run_monent_2)(const KRecord&) = &System::runMoment;
+void (System::*sys_run_moment)(const KRecord&) = &System::_runMoment;
+bool (System::*sys_ev_is_valid)(const Datetime&) = &System::_environmentIsValid;
+bool (System::*sys_cn_is_valid)(const Datetime&) = &System::_conditionIsValid;
+bool (System::*sys_should_buy)(const Datetime&) = &System::_shouldBuy;
+
+void system_run(System& sys, const Stock& stock, const KQuery& query,
+        bool reset) {
+    ReleaseGIL gil;
+    sys.run(stock, query, reset);
+}
 
-BOOST_PYTHON_MEMBER_FUNCTION_OVERLOADS(run_overload, run, 2, 3);
+void system_run_kdata(System& sys, const KData& kdata, bool reset) {
+    ReleaseGIL gil;
+    sys.run(kdata, reset);
+}
 
 BOOST_PYTHON_FUNCTION_OVERLOADS(SYS_Simple_overload, SYS_Simple, 0, 9);
 
@@ -70,8 +84,7 @@ void export_System() {
             .add_property("sp", &System::getSP, &System::setSP)
 
             .def("getStock", &System::getStock)
-            .def("getTradeRecordList", &System::getTradeRecordList,
-                    return_value_policy<copy_const_reference>())
+            .def("getTradeRecordList", &System::getTradeRecordList)
             .def("getBuyTradeRequest", &System::getBuyTradeRequest,
                     return_value_policy<copy_const_reference>())
             .def("getSellTradeRequest", &System::getSellTradeRequest,
@@ -87,14 +100,17 @@ void export_System() {
             .def("getTO", &System::getTO)
             .def("setTO", &System::setTO)
 
-            .def("run", &System::run, run_overload(args("stock", "query", "reset")))
+            .def("run", system_run,
+                    (arg("stock"), arg("query"), arg("reset")=true))
+            .def("run", system_run_kdata,
+                    (arg("kdata"), arg("reset")=true))
             .def("runMoment", run_monent_1)
             .def("runMoment", run_monent_2)
-            .def("_runMoment", &System::_runMoment)
+            .def("_runMoment", sys_run_moment)
 
-            .def("_environmentIsValid", &System::_environmentIsValid)
-            .def("_conditionIsValid", &System::_conditionIsValid)
-            .def("_shouldBuy", &System::_shouldBuy)
+            .def("_environmentIsValid", sys_ev_is_valid)
+            .def("_conditionIsValid", sys_cn_is_valid)
+            .def("_shouldBuy", sys_should_buy)
             .def("_buyNotifyAll", &System::_buyNotifyAll)
             .def("_sellNotifyAll", &System::_sellNotifyAll)
             .def("_buy", &System::_buy)
@@ -19,6 +19,7 @@ void export_Slippage();
 void export_System();
 void export_Selector();
 void export_AllocateMoney();
+void export_Portfolio();
 
 BOOST_PYTHON_MODULE(_trade_sys) {
     export_Environment();
@@ -31,6 +32,7 @@ BOOST_PYTHON_MODULE(_trade_sys) {
     export_System();
     export_Selector();
     export_AllocateMoney();
+    export_Portfolio();
 }
 
 
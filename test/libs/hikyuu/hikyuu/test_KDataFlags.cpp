@@ -0,0 +1,100 @@
+/*
+ * test_KDataFlags.cpp
+ *
+ *  Created on: 2017年6月21日
+ *      Author: fasiondog
+ */
+
+#ifdef TEST_ALL_IN_ONE
+    #include <boost/test/unit_test.hpp>
+#else
+    #define BOOST_TEST_MODULE test_hikyuu_base
+    #include <boost/test/unit_test.hpp>
+#endif
+
+#include <hikyuu/StockManager.h>
+#include <hikyuu/KDataFlags.h>
+
+using namespace hku;
+
+/**
+ * @defgroup test_hikyuu_KDataFlags test_hikyuu_KDataFlags
+ * @ingroup test_hikyuu_base_suite
+ * @{
+ */
+
+/** @par 检测点 */
+BOOST_AUTO_TEST_CASE( test_KDataFlags ) {
+    StockManager& sm = StockManager::instance();
+    KData kdata = sm.getStock("sh000001").getKData(KQuery(0, 10));
+    BOOST_CHECK(kdata.size() == 10);
+
+    /** @arg 未对齐K线数据时按日期保存 */
+    KDataFlags empty;
+    BOOST_CHECK(empty.count() == 0);
+    BOOST_CHECK(empty.test(0) == false);
+    empty.set(Datetime(200101030000LL));
+    empty.set(Datetime(200101010000LL));
+    empty.set(Datetime(200101030000LL));
+    BOOST_CHECK(empty.count() == 2);
+    BOOST_CHECK(empty.test(Datetime(200101010000LL)) == true);
+    BOOST_CHECK(empty.test(Datetime(200101020000LL)) == false);
+    DatetimeList dates = empty.getDatetimeList();
+    BOOST_CHECK(dates.size() == 2);
+    BOOST_CHECK(dates[0] == Datetime(200101010000LL));
+    BOOST_CHECK(dates[1] == Datetime(200101030000LL));
+
+    /** @arg 按位置标记，越界时忽略 */
+    KDataFlags flags(kdata);
+    BOOST_CHECK(flags.set(2) == true);
+    BOOST_CHECK(flags.set(10) == false);
+    BOOST_CHECK(flags.test(2) == true);
+    BOOST_CHECK(flags.test(3) == false);
+    BOOST_CHECK(flags.test(10) == false);
+    BOOST_CHECK(flags.test(kdata[2].datetime) == true);
+
+    /** @arg 按日期标记，K线数据中的日期与位置对应 */
+    flags.set(kdata[5].datetime);
+    BOOST_CHECK(flags.test(5) == true);
+    flags.set(Datetime(199001010000LL));
+    BOOST_CHECK(flags.count() == 3);
+    BOOST_CHECK(flags.test(Datetime(199001010000LL)) == true);
+
+    /** @arg 获取的日期列表有序 */
+    dates = flags.getDatetimeList();
+    BOOST_CHECK(dates.size() == 3);
+    BOOST_CHECK(dates[0] == Datetime(199001010000LL));
+    BOOST_CHECK(dates[1] == kdata[2].datetime);
+    BOOST_CHECK(dates[2] == kdata[5].datetime);
+
+    /** @arg 按另一K线数据对齐 */
+    KData other = sm.getStock("sh000001").getKData(KQuery(2, 8));
+    boost::dynamic_bitset<> mask = flags.align(other);
+    BOOST_CHECK(mask.size() == 6);
+    BOOST_CHECK(mask.count() == 2);
+    BOOST_CHECK(mask[0] && mask[3]);
+    mask = empty.align(kdata);
+    BOOST_CHECK(mask.size() == 10);
+    BOOST_CHECK(mask.none());
+
+    /** @arg 查找下一个被标记的位置，不含不在K线数据中的日期 */
+    BOOST_CHECK(flags.findNext(0) == 2);
+    BOOST_CHECK(flags.findNext(2) == 2);
+    BOOST_CHECK(flags.findNext(3) == 5);
+    BOOST_CHECK(flags.findNext(6) == Null<size_t>());
+    BOOST_CHECK(flags.findNext(10) == Null<size_t>());
+    BOOST_CHECK(empty.findNext(0) == Null<size_t>());
+
+    /** @arg 清除标记，保留对齐的K线数据 */
+    flags.clear();
+    BOOST_CHECK(flags.count() == 0);
+    BOOST_CHECK(flags.set(9) == true);
+    BOOST_CHECK(flags.getKData().size() == 10);
+
+    /** @arg 重新对齐 */
+    flags.setKData(other);
+    BOOST_CHECK(flags.count() == 0);
+    BOOST_CHECK(flags.set(6) == false);
+}
+
+/** @} */
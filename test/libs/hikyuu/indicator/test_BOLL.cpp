@@ -0,0 +1,83 @@
+/*
+ * test_BOLL.cpp
+ *
+ *  Created on: 2017年6月18日
+ *      Author: fasiondog
+ */
+
+#ifdef TEST_ALL_IN_ONE
+    #include <boost/test/unit_test.hpp>
+#else
+    #define BOOST_TEST_MODULE test_hikyuu_indicator_suite
+    #include <boost/test/unit_test.hpp>
+#endif
+
+#include <hikyuu/StockManager.h>
+#include <hikyuu/indicator/Operand.h>
+#include <hikyuu/indicator/crt/BOLL.h>
+#include <hikyuu/indicator/crt/KDATA.h>
+#include <hikyuu/indicator/crt/MA.h>
+#include <hikyuu/indicator/crt/STDEV.h>
+#include <hikyuu/indicator/crt/PRICELIST.h>
+
+using namespace hku;
+
+/**
+ * @defgroup test_indicator_BOLL test_indicator_BOLL
+ * @ingroup test_hikyuu_indicator_suite
+ * @{
+ */
+
+/** @par 检测点 */
+BOOST_AUTO_TEST_CASE( test_BOLL ) {
+    /** @arg 源数据为空 */
+    Indicator boll = BOLL(Indicator(), 20, 2.0);
+    BOOST_CHECK(boll.empty());
+
+    /** @arg 非法参数 */
+    PriceList d;
+    for (size_t i = 0; i < 10; ++i) {
+        d.push_back(i);
+    }
+    boll = BOLL(PRICELIST(d), 1);
+    BOOST_CHECK(boll.size() == 10);
+    BOOST_CHECK(boll[9] == Null<price_t>());
+
+    /** @arg 数据长度不足一个窗口 */
+    boll = BOLL(PRICELIST(d), 20);
+    BOOST_CHECK(boll.getResultNumber() == 3);
+    BOOST_CHECK(boll.discard() == 10);
+
+    /** @arg 简单数据 */
+    boll = BOLL(PRICELIST(d), 3, 2.0);
+    BOOST_CHECK(boll.discard() == 2);
+    BOOST_CHECK(boll.name() == "BOLL");
+    BOOST_CHECK_CLOSE(boll.get(2, 0), 1.0, 0.00001);
+    BOOST_CHECK_CLOSE(boll.get(2, 1), 3.0, 0.00001);
+    BOOST_CHECK_CLOSE(boll.get(2, 2), -1.0, 0.00001);
+    BOOST_CHECK_CLOSE(boll.get(9, 0), 8.0, 0.00001);
+
+    /** @arg 与 MA ± p * STDEV 的组合相同 */
+    StockManager& sm = StockManager::instance();
+    Stock stock = sm.getStock("sh000001");
+    Indicator close = CLOSE(stock.getKData(KQuery(0)));
+    OP mid_op = OP(MA(20));
+    OP upper_op = mid_op + OP(STDEV(20)) * 2.0;
+    OP lower_op = mid_op - OP(STDEV(20)) * 2.0;
+
+    Indicator mid = mid_op(close);
+    Indicator upper = upper_op(close);
+    Indicator lower = lower_op(close);
+
+    boll = BOLL(close, 20, 2.0);
+
+    BOOST_CHECK(boll.size() == close.size());
+    BOOST_CHECK(boll.discard() == upper.discard());
+    for (size_t i = boll.discard(); i < boll.size(); ++i) {
+        BOOST_CHECK_CLOSE(boll.get(i, 0), mid[i], 0.00001);
+        BOOST_CHECK_CLOSE(boll.get(i, 1), upper[i], 0.00001);
+        BOOST_CHECK_CLOSE(boll.get(i, 2), lower[i], 0.00001);
+    }
+}
+
+/** @} */
@@ -12,9 +12,12 @@
     #include <boost/test/unit_test.hpp>
 #endif
 
+#include <cmath>
 #include <hikyuu/indicator/Indicator.h>
 #include <hikyuu/indicator/crt/PRICELIST.h>
 #include <hikyuu/indicator/crt/KDATA.h>
+#include <hikyuu/indicator/crt/MA.h>
+#include <hikyuu/indicator/crt/IND_LOGIC.h>
 #include <hikyuu/StockManager.h>
 
 using namespace hku;
@@ -527,4 +530,151 @@ BOOST_AUTO_TEST_CASE( test_getResult_getResultAsPriceList ) {
     BOOST_CHECK(result2[9] == 26.55);
 }
 
+/** @par 检测点 */
+BOOST_AUTO_TEST_CASE( test_getResult_shared_buffer ) {
+    StockManager& sm = StockManager::instance();
+    Stock stock = sm.getStock("sh600000");
+    KData kdata = stock.getKData(KQuery(0, 10));
+    Indicator ikdata = KDATA(kdata);
+    BOOST_CHECK(ikdata.getResultNumber() == 6);
+
+    /** @arg 各结果集连续存放 */
+    IndicatorImpPtr imp = ikdata.getImp();
+    for (size_t i = 1; i < ikdata.getResultNumber(); ++i) {
+        BOOST_CHECK(imp->data(i) == imp->data(i-1) + ikdata.size());
+    }
+
+    /** @arg getResult返回的视图不复制数据 */
+    Indicator open = ikdata.getResult(0);
+    BOOST_CHECK(open.getImp()->data() == imp->data(0));
+    BOOST_CHECK(open[0] == 29.5);
+
+    /** @arg 修改视图的discard不影响原指标 */
+    open.setDiscard(2);
+    BOOST_CHECK(open.getImp()->data() != imp->data(0));
+    BOOST_CHECK(open.discard() == 2);
+    BOOST_CHECK(Null<price_t>() == open[0]);
+    BOOST_CHECK(ikdata.discard() == 0);
+    BOOST_CHECK(ikdata.get(0, 0) == 29.5);
+
+    /** @arg 原指标重新准备缓存后，视图中的数据保持不变 */
+    Indicator high = ikdata.getResult(1);
+    imp->_readyBuffer(10, 6);
+    BOOST_CHECK(Null<price_t>() == ikdata.get(0, 1));
+    BOOST_CHECK(high.size() == 10);
+    BOOST_CHECK(high[0] == 29.8);
+
+    /** @arg 通过getResult共享缓存后修改原指标，视图中的数据保持不变 */
+    ikdata = KDATA(kdata);
+    imp = ikdata.getImp();
+    Indicator close = ikdata.getResult(3);
+    const price_storage_t *close_data = close.getImp()->data();
+    price_t close0 = close[0];
+    imp->_set(1.0, 0, 3);
+    BOOST_CHECK(ikdata.get(0, 3) == 1.0);
+    BOOST_CHECK(imp->data(3) != close_data);
+    BOOST_CHECK(close.getImp()->data() == close_data);
+    BOOST_CHECK(close[0] == close0);
+
+    /** @arg 修改视图的结果，原指标中的数据保持不变 */
+    Indicator low = ikdata.getResult(2);
+    price_t low0 = ikdata.get(0, 2);
+    low.getImp()->_set(2.0, 0);
+    BOOST_CHECK(low[0] == 2.0);
+    BOOST_CHECK(ikdata.get(0, 2) == low0);
+
+    /** @arg 持有getBuffer返回的缓存时，通过_data写入不改写该缓存 */
+    IndicatorBufferPtr buffer = imp->getBuffer();
+    const price_storage_t *old_data = imp->data();
+    price_storage_t old_val = old_data[0];
+    imp->_data(0)[0] = 3.0;
+    BOOST_CHECK(ikdata.get(0, 0) == 3.0);
+    BOOST_CHECK(buffer.get() == old_data);
+    BOOST_CHECK(old_data[0] == old_val);
+
+    /** @arg 缓存未被共享时，直接在原缓存上修改 */
+    buffer.reset();
+    close = Indicator();
+    const price_storage_t *own_data = imp->data();
+    imp->_set(4.0, 1);
+    BOOST_CHECK(imp->data() == own_data);
+    BOOST_CHECK(ikdata.get(1, 0) == 4.0);
+}
+
+/** @par 检测点 */
+BOOST_AUTO_TEST_CASE( test_operator_null ) {
+    PriceList data(100);
+    for (size_t i = 0; i < 100; ++i) {
+        data[i] = i % 7 == 0 ? Null<price_t>() : (price_t)i;
+    }
+    Indicator ind = PRICELIST(data);
+    Indicator other = PRICELIST(PriceList(100, 50.0));
+
+    /** @arg 比较及逻辑运算中Null值按数值参与比较，结果与逐元素计算相同 */
+    Indicator gt = ind > other;
+    Indicator logic = IND_AND(gt, ind);
+    for (size_t i = 0; i < 100; ++i) {
+        BOOST_CHECK(gt[i] == ((ind[i] - 50.0) >= IND_EQ_THRESHOLD ? 1.0 : 0.0));
+        BOOST_CHECK(logic[i] == (gt[i] >= IND_EQ_THRESHOLD
+                && ind[i] >= IND_EQ_THRESHOLD ? 1.0 : 0.0));
+    }
+
+    /** @arg 除数为0时结果为Null */
+    Indicator div = ind / PRICELIST(PriceList(100, 0.0));
+    for (size_t i = 0; i < 100; ++i) {
+        BOOST_CHECK(div[i] == Null<price_t>());
+    }
+
+    /** @arg 四则运算逐元素计算 */
+    Indicator sum = ind + other;
+    for (size_t i = 0; i < 100; ++i) {
+        BOOST_CHECK(sum[i] == ind[i] + 50.0);
+    }
+}
+
+/** @par 检测点 */
+BOOST_AUTO_TEST_CASE( test_storage_precision ) {
+    //参考数据始终为double，不经过K线记录的存储类型
+    size_t total = 1000;
+    PriceList close(total), amount(total);
+    for (size_t i = 0; i < total; ++i) {
+        close[i] = 2000.0 + 300.0 * std::sin(i * 0.05) + i / 7.0;
+        amount[i] = 1.0e10 + 3.0e9 * std::cos(i * 0.03) + i / 3.0;
+    }
+
+#if HKU_USE_FLOAT32_STORAGE
+    BOOST_CHECK(sizeof(price_storage_t) == sizeof(float));
+    price_t max_err = 1.0e-6;
+#else
+    BOOST_CHECK(sizeof(price_storage_t) == sizeof(double));
+    price_t max_err = 1.0e-10;
+#endif
+
+    /** @arg Null值在存储类型与price_t间正确转换 */
+    Indicator ma = MA(PRICELIST(close), 20);
+    BOOST_CHECK(ma.size() == total);
+    Indicator null_ma = MA(PRICELIST(close), 20);
+    null_ma.setDiscard(19);
+    BOOST_CHECK(null_ma[0] == Null<price_t>());
+    BOOST_CHECK(null_ma.getResultAsPriceList(0)[18] == Null<price_t>());
+    BOOST_CHECK(null_ma[19] == ma[19]);
+
+    /** @arg 与使用double逐点计算的结果比较，相对误差在限定范围内 */
+    for (size_t i = 19; i < total; ++i) {
+        price_t sum = 0.0;
+        for (size_t j = i - 19; j <= i; ++j) {
+            sum += close[j];
+        }
+        price_t expect = sum / 20;
+        BOOST_CHECK(std::fabs(ma[i] - expect) <= max_err * std::fabs(expect));
+    }
+
+    /** @arg 成交金额等大数值的存储误差 */
+    Indicator amo = PRICELIST(amount);
+    for (size_t i = 0; i < total; ++i) {
+        BOOST_CHECK(std::fabs(amo[i] - amount[i])
+                    <= max_err * std::fabs(amount[i]));
+    }
+}
+
 /** @} */
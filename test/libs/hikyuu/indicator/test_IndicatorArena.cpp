@@ -0,0 +1,92 @@
+/*
+ * test_IndicatorArena.cpp
+ */
+
+#ifdef TEST_ALL_IN_ONE
+    #include <boost/test/unit_test.hpp>
+#else
+    #define BOOST_TEST_MODULE test_hikyuu_indicator_suite
+    #include <boost/test/unit_test.hpp>
+#endif
+
+#include <hikyuu/StockManager.h>
+#include <hikyuu/indicator/IndicatorArena.h>
+#include <hikyuu/indicator/crt/MA.h>
+#include <hikyuu/indicator/crt/KDATA.h>
+
+using namespace hku;
+
+/**
+ * @defgroup test_indicator_IndicatorArena test_indicator_IndicatorArena
+ * @ingroup test_hikyuu_indicator_suite
+ * @{
+ */
+
+/** @par 检测点 */
+BOOST_AUTO_TEST_CASE( test_IndicatorArena ) {
+    StockManager& sm = StockManager::instance();
+    Stock stock = sm.getStock("sh000001");
+    KData kdata = stock.getKData(KQuery(-100));
+    Indicator expect = MA(CLOSE(kdata), 10);
+
+    BOOST_CHECK(IndicatorArena::current() == NULL);
+
+    Indicator result;
+    {
+        IndicatorArena arena;
+        BOOST_CHECK(IndicatorArena::current() == &arena);
+
+        /** @arg 结果缓存及其shared_ptr控制块均从内存池中分配 */
+        size_t count = arena.allocCount();
+        IndicatorBufferPtr buffer = arena.allocBuffer(100);
+        BOOST_CHECK(arena.allocCount() == count + 2);
+        BOOST_CHECK(arena.blockCount() == 1);
+        BOOST_CHECK((size_t)buffer.get() % INDICATOR_BUFFER_ALIGN == 0);
+
+        /** @arg 释放后的缓存被相同大小的分配复用 */
+        price_storage_t *old_data = buffer.get();
+        size_t reuse = arena.reuseCount();
+        size_t bytes = arena.allocatedBytes();
+        buffer.reset();
+        buffer = arena.allocBuffer(100);
+        BOOST_CHECK(buffer.get() == old_data);
+        BOOST_CHECK(arena.reuseCount() == reuse + 2);
+        BOOST_CHECK(arena.allocatedBytes() == bytes);
+        buffer.reset();
+
+        /** @arg 反复计算临时指标时，内存池不再增长 */
+        for (int i = 0; i < 2; ++i) {
+            result = MA(CLOSE(kdata), 10);
+        }
+        bytes = arena.allocatedBytes();
+        reuse = arena.reuseCount();
+        for (int i = 0; i < 1000; ++i) {
+            result = MA(CLOSE(kdata), 10);
+        }
+        BOOST_CHECK(arena.blockCount() == 1);
+        BOOST_CHECK(arena.allocatedBytes() == bytes);
+        BOOST_CHECK(arena.reuseCount() > reuse + 1000);
+        BOOST_CHECK((size_t)result.getImp()->data() % INDICATOR_BUFFER_ALIGN == 0);
+
+        /** @arg 嵌套使用 */
+        {
+            count = arena.allocCount();
+            IndicatorArena inner(64);
+            BOOST_CHECK(IndicatorArena::current() == &inner);
+            Indicator tmp = CLOSE(kdata);
+            BOOST_CHECK(inner.allocCount() == 2);
+            BOOST_CHECK(arena.allocCount() == count);
+        }
+        BOOST_CHECK(IndicatorArena::current() == &arena);
+    }
+
+    /** @arg 作用域结束后，保留的指标仍然有效 */
+    BOOST_CHECK(IndicatorArena::current() == NULL);
+    BOOST_CHECK(result.size() == expect.size());
+    BOOST_CHECK(result.discard() == expect.discard());
+    for (size_t i = expect.discard(); i < expect.size(); ++i) {
+        BOOST_CHECK(result[i] == expect[i]);
+    }
+}
+
+/** @} */
@@ -0,0 +1,175 @@
+/*
+ * test_IndicatorCache.cpp
+ *
+ *  Created on: 2017年6月14日
+ *      Author: fasiondog
+ */
+
+#ifdef TEST_ALL_IN_ONE
+    #include <boost/test/unit_test.hpp>
+#else
+    #define BOOST_TEST_MODULE test_hikyuu_indicator_suite
+    #include <boost/test/unit_test.hpp>
+#endif
+
+#include <hikyuu/StockManager.h>
+#include <hikyuu/indicator/IndicatorCache.h>
+#include <hikyuu/indicator/Operand.h>
+#include <hikyuu/indicator/crt/MA.h>
+#include <hikyuu/indicator/crt/EMA.h>
+#include <hikyuu/indicator/crt/KDATA.h>
+#include <hikyuu/indicator/crt/PRICELIST.h>
+
+using namespace hku;
+
+/**
+ * @defgroup test_indicator_IndicatorCache test_indicator_IndicatorCache
+ * @ingroup test_hikyuu_indicator_suite
+ * @{
+ */
+
+/** @par 检测点 */
+BOOST_AUTO_TEST_CASE( test_IndicatorCache ) {
+    StockManager& sm = StockManager::instance();
+    Stock stock = sm.getStock("sh000001");
+    KData kdata = stock.getKData(KQuery(-100));
+
+    /** @arg 默认不启用缓存 */
+    BOOST_CHECK(!IndicatorCache::enabled());
+    Indicator expect = MA(CLOSE(kdata), 10);
+    BOOST_CHECK(IndicatorCache::size() == 0);
+
+    IndicatorCache::setMaxBytes(1024 * 1024);
+    IndicatorCache::clear();
+    IndicatorCache::resetStatistics();
+    BOOST_CHECK(IndicatorCache::enabled());
+
+    /** @arg 第一次计算未命中，结果加入缓存 */
+    Indicator first = MA(CLOSE(kdata), 10);
+    BOOST_CHECK(IndicatorCache::misses() == 1);
+    BOOST_CHECK(IndicatorCache::hits() == 0);
+    BOOST_CHECK(IndicatorCache::size() == 1);
+    BOOST_CHECK(IndicatorCache::bytes() == 100 * sizeof(price_storage_t));
+    BOOST_CHECK(first.getImp()->getSource()->expression
+            == "SMA(n=10)(CLOSE)");
+
+    /** @arg 相同的证券、查询条件及表达式命中缓存，共享结果缓存 */
+    Indicator second = MA(CLOSE(kdata), 10);
+    BOOST_CHECK(IndicatorCache::hits() == 1);
+    BOOST_CHECK(second.name() == "SMA");
+    BOOST_CHECK(second.getImp()->data() == first.getImp()->data());
+    BOOST_CHECK(second.size() == expect.size());
+    BOOST_CHECK(second.discard() == expect.discard());
+    for (size_t i = expect.discard(); i < expect.size(); ++i) {
+        BOOST_CHECK(second[i] == expect[i]);
+    }
+
+    /** @arg 通过公式计算同样命中缓存 */
+    Indicator third = MA(10)(CLOSE(kdata));
+    BOOST_CHECK(IndicatorCache::hits() == 2);
+    BOOST_CHECK(third.getImp()->data() == first.getImp()->data());
+
+    /** @arg 修改命中的结果不影响缓存及其他结果 */
+    second.setDiscard(50);
+    BOOST_CHECK(second.discard() == 50);
+    BOOST_CHECK(first.discard() == expect.discard());
+    Indicator fourth = MA(CLOSE(kdata), 10);
+    BOOST_CHECK(fourth.discard() == expect.discard());
+    BOOST_CHECK(fourth[20] == expect[20]);
+
+    /** @arg 参数或查询条件不同时不命中 */
+    size_t misses = IndicatorCache::misses();
+    Indicator other = MA(CLOSE(kdata), 20);
+    BOOST_CHECK(IndicatorCache::misses() == misses + 1);
+    other = MA(CLOSE(stock.getKData(KQuery(-50))), 10);
+    BOOST_CHECK(IndicatorCache::misses() == misses + 2);
+    BOOST_CHECK(other.size() == 50);
+
+    /** @arg 按日期查询时，不同的日期范围不命中 */
+    KData k2008 = stock.getKData(KQueryByDate(Datetime(200801010000),
+                                              Datetime(200901010000)));
+    KData k2011 = stock.getKData(KQueryByDate(Datetime(201101010000),
+                                              Datetime(201111010000)));
+    Indicator expect2008 = MA(CLOSE(k2008), 10);
+    IndicatorCache::clear();
+    misses = IndicatorCache::misses();
+    Indicator ma2011 = MA(CLOSE(k2011), 10);
+    Indicator ma2008 = MA(CLOSE(k2008), 10);
+    BOOST_CHECK(IndicatorCache::misses() == misses + 2);
+    BOOST_CHECK(ma2011.size() == k2011.size());
+    BOOST_CHECK(ma2008.size() == k2008.size());
+    BOOST_CHECK(ma2008.size() != ma2011.size());
+    for (size_t i = expect2008.discard(); i < expect2008.size(); ++i) {
+        BOOST_CHECK(ma2008[i] == expect2008[i]);
+    }
+
+    /** @arg 按日期查询的Operand二元运算结果同样按日期范围区分 */
+    OP diff_op = OP(MA(5)) - OP(MA(10));
+    Indicator diff2011 = diff_op(CLOSE(k2011));
+    Indicator diff2008 = diff_op(CLOSE(k2008));
+    BOOST_CHECK(diff2008.size() == k2008.size());
+    BOOST_CHECK(diff2008[20]
+            == MA(CLOSE(k2008), 5)[20] - MA(CLOSE(k2008), 10)[20]);
+
+    /** @arg 非K线数据来源的指标不使用缓存 */
+    size_t hits = IndicatorCache::hits();
+    misses = IndicatorCache::misses();
+    PriceList prices(100, 1.0);
+    Indicator tmp = MA(PRICELIST(prices), 10);
+    tmp = MA(PRICELIST(prices), 10);
+    BOOST_CHECK(IndicatorCache::hits() == hits);
+    BOOST_CHECK(IndicatorCache::misses() == misses);
+
+    /** @arg Operand二元运算结果同样缓存 */
+    Indicator close = CLOSE(kdata);
+    OP formula = OP(MA(5)) - OP(EMA(10));
+    Indicator result = formula(close);
+    hits = IndicatorCache::hits();
+    Indicator result2 = formula(close);
+    BOOST_CHECK(IndicatorCache::hits() == hits + 3);
+    BOOST_CHECK(result2.getImp()->data() == result.getImp()->data());
+    BOOST_CHECK(result.getImp()->getSource()->expression
+            == "SUB(SMA(n=5)(CLOSE),EMA(n=10)(CLOSE))");
+
+    /** @arg 失效指定证券的缓存 */
+    Stock other_stock = sm.getStock("sz000001");
+    Indicator tmp2 = MA(CLOSE(other_stock.getKData(KQuery(-100))), 10);
+    size_t total = IndicatorCache::size();
+    IndicatorCache::invalidate(stock);
+    BOOST_CHECK(IndicatorCache::size() == 1);
+    BOOST_CHECK(total > 1);
+
+    /** @arg 重新加载K线缓存时自动失效 */
+    MA(CLOSE(kdata), 10);
+    BOOST_CHECK(IndicatorCache::size() == 2);
+    if (stock.isBuffer(KQuery::DAY)) {
+        stock.loadKDataToBuffer(KQuery::DAY);
+        BOOST_CHECK(IndicatorCache::size() == 1);
+    }
+
+    /** @arg 超过内存上限时淘汰最久未使用的结果 */
+    IndicatorCache::clear();
+    IndicatorCache::resetStatistics();
+    IndicatorCache::setMaxBytes(250 * sizeof(price_storage_t));
+    MA(CLOSE(kdata), 5);
+    MA(CLOSE(kdata), 10);
+    BOOST_CHECK(IndicatorCache::size() == 2);
+    MA(CLOSE(kdata), 5);
+    MA(CLOSE(kdata), 20);
+    BOOST_CHECK(IndicatorCache::size() == 2);
+    BOOST_CHECK(IndicatorCache::evictions() == 1);
+    BOOST_CHECK(IndicatorCache::bytes() <= IndicatorCache::getMaxBytes());
+    hits = IndicatorCache::hits();
+    MA(CLOSE(kdata), 5);
+    BOOST_CHECK(IndicatorCache::hits() == hits + 1);
+    misses = IndicatorCache::misses();
+    MA(CLOSE(kdata), 10);
+    BOOST_CHECK(IndicatorCache::misses() == misses + 1);
+
+    /** @arg 上限设为0时禁用并清除缓存 */
+    IndicatorCache::setMaxBytes(0);
+    BOOST_CHECK(!IndicatorCache::enabled());
+    BOOST_CHECK(IndicatorCache::size() == 0);
+}
+
+/** @} */
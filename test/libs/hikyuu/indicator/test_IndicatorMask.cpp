@@ -0,0 +1,224 @@
+/*
+ * test_IndicatorMask.cpp
+ *
+ *  Created on: 2017年6月16日
+ *      Author: fasiondog
+ */
+
+#ifdef TEST_ALL_IN_ONE
+    #include <boost/test/unit_test.hpp>
+#else
+    #define BOOST_TEST_MODULE test_hikyuu_indicator_suite
+    #include <boost/test/unit_test.hpp>
+#endif
+
+#include <hikyuu/StockManager.h>
+#include <hikyuu/indicator/IndicatorMask.h>
+#include <hikyuu/indicator/IndicatorKernel.h>
+#include <hikyuu/indicator/crt/MA.h>
+#include <hikyuu/indicator/crt/KDJ.h>
+#include <hikyuu/indicator/crt/KDATA.h>
+#include <hikyuu/indicator/crt/PRICELIST.h>
+
+using namespace hku;
+
+/**
+ * @defgroup test_indicator_IndicatorMask test_indicator_IndicatorMask
+ * @ingroup test_hikyuu_indicator_suite
+ * @{
+ */
+
+/** 检查指标各结果集的位图与 i >= discard && 值非Null 一致 */
+static bool check_mask(const Indicator& ind) {
+    IndicatorImpPtr imp = ind.getImp();
+    for (size_t r = 0; r < ind.getResultNumber(); ++r) {
+        IndicatorMaskPtr mask = imp->getMask(r);
+        if (!mask || mask->size() != ind.size()
+                || mask->discard() != ind.discard()) {
+            return false;
+        }
+        for (size_t i = 0; i < ind.size(); ++i) {
+            bool expect = i >= ind.discard()
+                       && ind.get(i, r) != Null<price_t>();
+            if (mask->valid(i) != expect) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/** @par 检测点 */
+BOOST_AUTO_TEST_CASE( test_IndicatorMask ) {
+    /** @arg 空位图 */
+    IndicatorMask empty;
+    BOOST_CHECK(empty.size() == 0);
+    BOOST_CHECK(empty.wordCount() == 0);
+    BOOST_CHECK(empty.count() == 0);
+    BOOST_CHECK(!empty.valid(0));
+
+    /** @arg discard之后全部有效 */
+    IndicatorMask all(130, 3);
+    BOOST_CHECK(all.size() == 130);
+    BOOST_CHECK(all.discard() == 3);
+    BOOST_CHECK(all.wordCount() == 3);
+    BOOST_CHECK(all.count() == 127);
+    BOOST_CHECK(!all.valid(2));
+    BOOST_CHECK(all.valid(3));
+    BOOST_CHECK(all.valid(129));
+    BOOST_CHECK(!all.valid(130));
+    BOOST_CHECK(all.word(1) == ~IndicatorMask::word_type(0));
+    BOOST_CHECK(all.word(2) == 3);
+
+    /** @arg rangeBits */
+    BOOST_CHECK(IndicatorMask::rangeBits(0, 0, 64) == ~IndicatorMask::word_type(0));
+    BOOST_CHECK(IndicatorMask::rangeBits(0, 3, 5) == 0x18);
+    BOOST_CHECK(IndicatorMask::rangeBits(1, 64, 66) == 3);
+    BOOST_CHECK(IndicatorMask::rangeBits(1, 0, 64) == 0);
+    BOOST_CHECK(IndicatorMask::rangeBits(0, 5, 5) == 0);
+
+    /** @arg 按数据生成，Null值及discard之前的位置无效 */
+    price_storage_t null_price = Null<price_storage_t>();
+    vector<price_storage_t> data(70, 1);
+    data[1] = 0;
+    data[5] = null_price;
+    data[65] = null_price;
+    IndicatorMask from_data(&data.front(), data.size(), 2);
+    BOOST_CHECK(from_data.size() == 70);
+    BOOST_CHECK(from_data.count() == 66);
+    BOOST_CHECK(!from_data.valid(1));
+    BOOST_CHECK(from_data.valid(2));
+    BOOST_CHECK(!from_data.valid(5));
+    BOOST_CHECK(from_data.valid(64));
+    BOOST_CHECK(!from_data.valid(65));
+    BOOST_CHECK(from_data.valid(69));
+}
+
+/** @par 检测点 */
+BOOST_AUTO_TEST_CASE( test_IndicatorMask_indicator ) {
+    StockManager& sm = StockManager::instance();
+    Stock stock = sm.getStock("sh000001");
+    KData kdata = stock.getKData(KQuery(-300));
+
+    /** @arg 普通指标计算后即生成位图，与discard及Null值位置一致 */
+    PriceList d;
+    for (size_t i = 0; i < 300; ++i) {
+        d.push_back(i % 7 == 0 ? Null<price_t>() : price_t(i));
+    }
+    Indicator list = PRICELIST(d, 3);
+    BOOST_CHECK(check_mask(list));
+    BOOST_CHECK(list.getImp()->getMask()->count() == 255);
+
+    Indicator ma = MA(CLOSE(kdata), 10);
+    BOOST_CHECK(check_mask(ma));
+    BOOST_CHECK(ma.getImp()->getMask()->count() == 300 - ma.discard());
+
+    /** @arg 多结果集指标 */
+    Indicator kdj = KDJ(KDATA(kdata));
+    BOOST_CHECK(kdj.getResultNumber() == 3);
+    BOOST_CHECK(check_mask(kdj));
+
+    /** @arg getResult共享位图 */
+    Indicator d_line = kdj.getResult(1);
+    BOOST_CHECK(d_line.getImp()->getMask() == kdj.getImp()->getMask(1));
+
+    /** @arg setDiscard更新位图 */
+    Indicator ma2 = MA(CLOSE(kdata), 10);
+    ma2.setDiscard(100);
+    BOOST_CHECK(check_mask(ma2));
+    BOOST_CHECK(ma2.getImp()->getMask()->count() == 200);
+
+    /** @arg 四则运算的结果位图为操作数位图按字相与 */
+    Indicator sum = list + ma;
+    BOOST_CHECK(sum.discard() == std::max(list.discard(), ma.discard()));
+    BOOST_CHECK(check_mask(sum));
+    for (size_t i = 0; i < sum.size(); ++i) {
+        bool valid = list.getImp()->getMask()->valid(i)
+                  && ma.getImp()->getMask()->valid(i);
+        BOOST_CHECK(sum.getImp()->getMask()->valid(i) == valid);
+        if (valid) {
+            BOOST_CHECK(std::fabs(sum[i] - (list[i] + ma[i])) < 0.0001);
+        } else {
+            BOOST_CHECK(sum[i] == Null<price_t>());
+        }
+    }
+
+    /** @arg 任一操作数为Null时四则运算结果为Null */
+    Indicator diff = list - list;
+    BOOST_CHECK(check_mask(diff));
+    BOOST_CHECK(diff[7] == Null<price_t>());
+    BOOST_CHECK(diff[8] == 0.0);
+    Indicator half = list * 0.5;
+    BOOST_CHECK(check_mask(half));
+    BOOST_CHECK(half[7] == Null<price_t>());
+    BOOST_CHECK(half[8] == 4.0);
+
+    /** @arg 数值为Null时四则运算结果全部为Null */
+    Indicator null_sum = ma + Null<price_t>();
+    BOOST_CHECK(null_sum.size() == ma.size());
+    BOOST_CHECK(null_sum.getImp()->getMask()->count() == 0);
+    for (size_t i = 0; i < null_sum.size(); ++i) {
+        BOOST_CHECK(null_sum[i] == Null<price_t>());
+    }
+
+    /** @arg 除数为0时结果为Null，位图相应位被清除 */
+    Indicator div = ma / (list - 8.0);
+    BOOST_CHECK(check_mask(div));
+    BOOST_CHECK(div[8] == Null<price_t>());
+    BOOST_CHECK(!div.getImp()->getMask()->valid(8));
+    BOOST_CHECK(div.getImp()->getMask()->valid(9));
+
+    /** @arg 比较运算中Null按数值参与运算，discard之后的结果均有效 */
+    Indicator cmp = list > ma;
+    BOOST_CHECK(cmp.discard() == sum.discard());
+    BOOST_CHECK(cmp.getImp()->getMask()->count() == cmp.size() - cmp.discard());
+    BOOST_CHECK(check_mask(cmp));
+    BOOST_CHECK(cmp[14] == 1.0);
+}
+
+/** @par 检测点 */
+BOOST_AUTO_TEST_CASE( test_IndicatorMask_kernel_skip ) {
+    /** @arg 全部无效的字直接跳过，不调用运算函数 */
+    PriceList d;
+    for (size_t i = 0; i < 300; ++i) {
+        d.push_back(i >= 64 && i < 256 ? Null<price_t>() : price_t(i));
+    }
+    Indicator a = PRICELIST(d);
+    Indicator b = PRICELIST(d);
+
+    size_t count = 0;
+    Indicator result = ind_binary_kernel<IND_KERNEL_NULL_AWARE>(a, b,
+            [&count](price_t x, price_t y) {
+                ++count;
+                return x + y;
+            });
+    BOOST_CHECK(count == 300 - 192);
+    BOOST_CHECK(result.size() == 300);
+    BOOST_CHECK(check_mask(result));
+    BOOST_CHECK(result[10] == 20.0);
+    BOOST_CHECK(result[100] == Null<price_t>());
+    BOOST_CHECK(result[299] == 598.0);
+
+    /** @arg 一元运算同样跳过全部无效的字 */
+    count = 0;
+    result = ind_unary_kernel<IND_KERNEL_NULL_AWARE>(a,
+            [&count](price_t x) {
+                ++count;
+                return x * 2.0;
+            });
+    BOOST_CHECK(count == 300 - 192);
+    BOOST_CHECK(check_mask(result));
+    BOOST_CHECK(result[299] == 598.0);
+
+    /** @arg 比较及逻辑运算不跳过 */
+    count = 0;
+    result = ind_binary_kernel<IND_KERNEL_NUMERIC>(a, b,
+            [&count](price_t x, price_t y) {
+                ++count;
+                return x >= y ? 1.0 : 0.0;
+            });
+    BOOST_CHECK(count == 300);
+    BOOST_CHECK(result.getImp()->getMask()->count() == 300);
+}
+
+/** @} */
@@ -0,0 +1,79 @@
+/*
+ * test_KDJ.cpp
+ *
+ *  Created on: 2017年6月18日
+ *      Author: fasiondog
+ */
+
+#ifdef TEST_ALL_IN_ONE
+    #include <boost/test/unit_test.hpp>
+#else
+    #define BOOST_TEST_MODULE test_hikyuu_indicator_suite
+    #include <boost/test/unit_test.hpp>
+#endif
+
+#include <hikyuu/StockManager.h>
+#include <hikyuu/indicator/crt/KDJ.h>
+#include <hikyuu/indicator/crt/KDATA.h>
+#include <hikyuu/indicator/crt/EMA.h>
+#include <hikyuu/indicator/crt/HHV.h>
+#include <hikyuu/indicator/crt/LLV.h>
+#include <hikyuu/indicator/crt/PRICELIST.h>
+
+using namespace hku;
+
+/**
+ * @defgroup test_indicator_KDJ test_indicator_KDJ
+ * @ingroup test_hikyuu_indicator_suite
+ * @{
+ */
+
+/** @par 检测点 */
+BOOST_AUTO_TEST_CASE( test_KDJ ) {
+    /** @arg 源数据为空 */
+    Indicator kdj = KDJ(Indicator());
+    BOOST_CHECK(kdj.empty());
+
+    /** @arg 单一结果集输入，最高价等于最低价时RSV为50 */
+    PriceList d(10, 5.0);
+    kdj = KDJ(PRICELIST(d), 3, 3, 3);
+    BOOST_CHECK(kdj.getResultNumber() == 3);
+    BOOST_CHECK(kdj.discard() == 2);
+    BOOST_CHECK(kdj.get(2, 0) == 50.0);
+    BOOST_CHECK(kdj.get(9, 1) == 50.0);
+    BOOST_CHECK(kdj.get(9, 2) == 50.0);
+
+    /** @arg 非法参数 */
+    kdj = KDJ(PRICELIST(d), 0);
+    BOOST_CHECK(kdj.size() == 10);
+    BOOST_CHECK(kdj.get(9, 0) == Null<price_t>());
+
+    /** @arg 与HHV、LLV、EMA的组合相同 */
+    StockManager& sm = StockManager::instance();
+    Stock stock = sm.getStock("sh000001");
+    KData kdata = stock.getKData(KQuery(0));
+    Indicator high = HIGH(kdata);
+    Indicator low = LOW(kdata);
+    Indicator close = CLOSE(kdata);
+
+    //平滑系数1/m与周期为2m-1的EMA相同
+    Indicator llv = LLV(low, 9);
+    Indicator rsv = (close - llv) / (HHV(high, 9) - llv) * 100.0;
+    Indicator k = EMA(rsv, 5);
+    Indicator dd = EMA(k, 5);
+    Indicator j = k * 3.0 - dd * 2.0;
+
+    Indicator kd = KDATA(kdata);
+    kdj = KDJ(kd, 9, 3, 3);
+
+    BOOST_CHECK(kdj.size() == kdata.size());
+    BOOST_CHECK(kdj.discard() == 8);
+    BOOST_CHECK(kdj.discard() == k.discard());
+    for (size_t i = kdj.discard(); i < kdj.size(); ++i) {
+        BOOST_CHECK_CLOSE(kdj.get(i, 0), k[i], 0.0001);
+        BOOST_CHECK_CLOSE(kdj.get(i, 1), dd[i], 0.0001);
+        BOOST_CHECK_CLOSE(kdj.get(i, 2), j[i], 0.0001);
+    }
+}
+
+/** @} */
@@ -0,0 +1,120 @@
+/*
+ * test_Operand.cpp
+ *
+ *  Created on: 2017年6月13日
+ *      Author: fasiondog
+ */
+
+#ifdef TEST_ALL_IN_ONE
+    #include <boost/test/unit_test.hpp>
+#else
+    #define BOOST_TEST_MODULE test_hikyuu_indicator_suite
+    #include <boost/test/unit_test.hpp>
+#endif
+
+#include <boost/atomic.hpp>
+#include <hikyuu/StockManager.h>
+#include <hikyuu/indicator/Operand.h>
+#include <hikyuu/indicator/crt/MA.h>
+#include <hikyuu/indicator/crt/EMA.h>
+#include <hikyuu/indicator/crt/KDATA.h>
+
+using namespace hku;
+
+/**
+ * @defgroup test_indicator_Operand test_indicator_Operand
+ * @ingroup test_hikyuu_indicator_suite
+ * @{
+ */
+
+//原样输出输入数据，并记录被计算的次数
+class CountedImp: public IndicatorImp {
+    INDICATOR_IMP(CountedImp)
+
+public:
+    CountedImp(): IndicatorImp("COUNTED", 1) {}
+
+    static boost::atomic<int> s_count;
+};
+
+boost::atomic<int> CountedImp::s_count(0);
+
+bool CountedImp::check() {
+    return true;
+}
+
+void CountedImp::_calculate(const Indicator& data) {
+    s_count++;
+    m_discard = data.discard();
+    for (size_t i = m_discard; i < data.size(); ++i) {
+        _set(data[i], i);
+    }
+}
+
+/** @par 检测点 */
+BOOST_AUTO_TEST_CASE( test_Operand_parallel ) {
+    StockManager& sm = StockManager::instance();
+    Stock stock = sm.getStock("sh000001");
+    KData kdata = stock.getKData(KQuery(-500));
+    Indicator close = CLOSE(kdata);
+
+    OP ma5 = OP(MA(5));
+    OP formula = (ma5 + OP(MA(10))) * (OP(EMA(20)) - OP(MA(30)));
+
+    Indicator expect = (MA(close, 5) + MA(close, 10))
+                     * (EMA(close, 20) - MA(close, 30));
+
+    size_t old_threshold = OperandNode::getParallelThreshold();
+
+    /** @arg 低于阈值，顺序计算 */
+    OperandNode::setParallelThreshold(Null<size_t>());
+    Indicator result = formula(close);
+    BOOST_CHECK(result.size() == expect.size());
+    BOOST_CHECK(result.discard() == expect.discard());
+    for (size_t i = expect.discard(); i < expect.size(); ++i) {
+        BOOST_CHECK(result[i] == expect[i]);
+    }
+
+    /** @arg 超过阈值，并行计算结果与顺序计算相同 */
+    OperandNode::setParallelThreshold(0);
+    result = formula(close);
+    BOOST_CHECK(result.size() == expect.size());
+    BOOST_CHECK(result.discard() == expect.discard());
+    for (size_t i = expect.discard(); i < expect.size(); ++i) {
+        BOOST_CHECK(result[i] == expect[i]);
+    }
+
+    /** @arg 公式中重复引用的节点只计算一次 */
+    OP counted = OP(Indicator(make_shared<CountedImp>()));
+    OP twice = counted - counted;
+    CountedImp::s_count = 0;
+    result = twice(close);
+    BOOST_CHECK(CountedImp::s_count == 1);
+    BOOST_CHECK(result.size() == close.size());
+    for (size_t i = result.discard(); i < result.size(); ++i) {
+        BOOST_CHECK(result[i] == 0.0);
+    }
+
+    /** @arg 在不同子树中重复引用的节点只计算一次，并行计算时同样如此 */
+    OP shared = (counted + counted) * (counted - OP(MA(5)));
+    CountedImp::s_count = 0;
+    result = shared(close);
+    BOOST_CHECK(CountedImp::s_count == 1);
+    OperandNode::setParallelThreshold(Null<size_t>());
+    Indicator serial = shared(close);
+    BOOST_CHECK(CountedImp::s_count == 2);
+    for (size_t i = result.discard(); i < result.size(); ++i) {
+        BOOST_CHECK(result[i] == serial[i]);
+    }
+
+    /** @arg 不同的节点各自计算 */
+    OP other = OP(Indicator(make_shared<CountedImp>()));
+    CountedImp::s_count = 0;
+    result = (counted - other)(close);
+    BOOST_CHECK(CountedImp::s_count == 2);
+
+    OperandNode::setParallelThreshold(old_threshold);
+    BOOST_CHECK(OperandNode::getParallelThreshold() == old_threshold);
+}
+
+/** @} */
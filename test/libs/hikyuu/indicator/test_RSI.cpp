@@ -0,0 +1,73 @@
+/*
+ * test_RSI.cpp
+ *
+ *  Created on: 2017年6月18日
+ *      Author: fasiondog
+ */
+
+#ifdef TEST_ALL_IN_ONE
+    #include <boost/test/unit_test.hpp>
+#else
+    #define BOOST_TEST_MODULE test_hikyuu_indicator_suite
+    #include <boost/test/unit_test.hpp>
+#endif
+
+#include <hikyuu/StockManager.h>
+#include <hikyuu/indicator/crt/RSI.h>
+#include <hikyuu/indicator/crt/KDATA.h>
+#include <hikyuu/indicator/crt/EMA.h>
+#include <hikyuu/indicator/crt/DIFF.h>
+#include <hikyuu/indicator/crt/PRICELIST.h>
+
+using namespace hku;
+
+/**
+ * @defgroup test_indicator_RSI test_indicator_RSI
+ * @ingroup test_hikyuu_indicator_suite
+ * @{
+ */
+
+/** @par 检测点 */
+BOOST_AUTO_TEST_CASE( test_RSI ) {
+    /** @arg 源数据为空 */
+    Indicator rsi = RSI(Indicator());
+    BOOST_CHECK(rsi.empty());
+
+    /** @arg 简单数据：持续上涨为100，持续下跌为0，无涨跌为50 */
+    PriceList d;
+    for (size_t i = 0; i < 10; ++i) {
+        d.push_back(i);
+    }
+    rsi = RSI(PRICELIST(d), 3);
+    BOOST_CHECK(rsi.discard() == 1);
+    BOOST_CHECK(rsi[0] == Null<price_t>());
+    BOOST_CHECK_CLOSE(rsi[9], 100.0, 0.00001);
+
+    std::reverse(d.begin(), d.end());
+    rsi = RSI(PRICELIST(d), 3);
+    BOOST_CHECK(rsi[9] == 0.0);
+
+    rsi = RSI(PRICELIST(PriceList(10, 1.0)), 3);
+    BOOST_CHECK(rsi[9] == 50.0);
+
+    /** @arg 与DIFF、EMA的组合相同 */
+    StockManager& sm = StockManager::instance();
+    Stock stock = sm.getStock("sh000001");
+    Indicator close = CLOSE(stock.getKData(KQuery(0)));
+
+    //平滑系数1/n与周期为2n-1的EMA相同
+    Indicator diff = DIFF(close);
+    Indicator up = diff * (diff > 0.0);
+    Indicator all = up - diff * (diff < 0.0);
+    Indicator expect = EMA(up, 27) / EMA(all, 27) * 100.0;
+
+    rsi = RSI(close, 14);
+
+    BOOST_CHECK(rsi.size() == close.size());
+    BOOST_CHECK(rsi.discard() == expect.discard());
+    for (size_t i = rsi.discard(); i < rsi.size(); ++i) {
+        BOOST_CHECK_CLOSE(rsi[i], expect[i], 0.0001);
+    }
+}
+
+/** @} */
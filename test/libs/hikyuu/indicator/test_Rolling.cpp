@@ -0,0 +1,211 @@
+/*
+ * test_Rolling.cpp
+ *
+ *  Created on: 2017年6月18日
+ *      Author: fasiondog
+ */
+
+#ifdef TEST_ALL_IN_ONE
+    #include <boost/test/unit_test.hpp>
+#else
+    #define BOOST_TEST_MODULE test_hikyuu_indicator_suite
+    #include <boost/test/unit_test.hpp>
+#endif
+
+#include <chrono>
+#include <hikyuu/StockManager.h>
+#include <hikyuu/indicator/Rolling.h>
+#include <hikyuu/indicator/Operand.h>
+#include <hikyuu/indicator/crt/BOLL.h>
+#include <hikyuu/indicator/crt/KDJ.h>
+#include <hikyuu/indicator/crt/RSI.h>
+#include <hikyuu/indicator/crt/DIFF.h>
+#include <hikyuu/indicator/crt/KDATA.h>
+#include <hikyuu/indicator/crt/MA.h>
+#include <hikyuu/indicator/crt/EMA.h>
+#include <hikyuu/indicator/crt/STDEV.h>
+#include <hikyuu/indicator/crt/HHV.h>
+#include <hikyuu/indicator/crt/LLV.h>
+
+using namespace hku;
+
+/**
+ * @defgroup test_indicator_Rolling test_indicator_Rolling
+ * @ingroup test_hikyuu_indicator_suite
+ * @{
+ */
+
+/** @par 检测点 */
+BOOST_AUTO_TEST_CASE( test_RollingWindow ) {
+    /** @arg 空窗口 */
+    RollingWindow empty(3);
+    BOOST_CHECK(empty.count() == 0);
+    BOOST_CHECK(!empty.full());
+    BOOST_CHECK(empty.mean() == Null<price_t>());
+    BOOST_CHECK(empty.min() == Null<price_t>());
+    BOOST_CHECK(empty.max() == Null<price_t>());
+    BOOST_CHECK(empty.variance() == 0.0);
+
+    /** @arg 窗口未满及已满时的各统计量 */
+    RollingWindow win(3);
+    win.push(1.0);
+    win.push(5.0);
+    BOOST_CHECK(win.count() == 2);
+    BOOST_CHECK_CLOSE(win.mean(), 3.0, 0.00001);
+    BOOST_CHECK_CLOSE(win.variance(), 8.0, 0.00001);
+    BOOST_CHECK(win.min() == 1.0);
+    BOOST_CHECK(win.max() == 5.0);
+    win.push(3.0);
+    win.push(2.0);
+    BOOST_CHECK(win.full());
+    BOOST_CHECK(win.count() == 3);
+    BOOST_CHECK_CLOSE(win.sum(), 10.0, 0.00001);
+    BOOST_CHECK_CLOSE(win.variance(), 7.0 / 3.0, 0.00001);
+    BOOST_CHECK(win.min() == 2.0);
+    BOOST_CHECK(win.max() == 5.0);
+    win.push(2.0);
+    BOOST_CHECK(win.max() == 3.0);
+
+    /** @arg 清除 */
+    win.reset();
+    BOOST_CHECK(win.count() == 0);
+    win.push(4.0);
+    BOOST_CHECK(win.min() == 4.0);
+    BOOST_CHECK(win.mean() == 4.0);
+
+    /** @arg 与MA、STDEV、HHV、LLV的结果相同 */
+    StockManager& sm = StockManager::instance();
+    Stock stock = sm.getStock("sh000001");
+    Indicator close = CLOSE(stock.getKData(KQuery(-500)));
+    int n = 20;
+    Indicator ma = MA(close, n);
+    Indicator std = STDEV(close, n);
+    Indicator hhv = HHV(close, n);
+    Indicator llv = LLV(close, n);
+    RollingWindow roll(n);
+    for (size_t i = 0; i < close.size(); ++i) {
+        roll.push(close[i]);
+        BOOST_CHECK_CLOSE(roll.mean(), ma[i], 0.00001);
+        if (i + 1 < (size_t)n) {
+            continue;
+        }
+        BOOST_CHECK_CLOSE(roll.stdev(), std[i], 0.0001);
+        BOOST_CHECK(roll.max() == hhv[i]);
+        BOOST_CHECK(roll.min() == llv[i]);
+    }
+}
+
+/** @par 检测点 */
+BOOST_AUTO_TEST_CASE( test_EmaBank ) {
+    StockManager& sm = StockManager::instance();
+    Stock stock = sm.getStock("sh000001");
+    Indicator close = CLOSE(stock.getKData(KQuery(-500)));
+
+    /** @arg 多个周期的EMA与EMA指标相同 */
+    EmaBank bank;
+    BOOST_CHECK(bank.size() == 0);
+    size_t e5 = bank.addPeriod(5);
+    size_t e12 = bank.addPeriod(12);
+    size_t e26 = bank.addPeriod(26);
+    BOOST_CHECK(bank.size() == 3);
+    Indicator ema5 = EMA(close, 5);
+    Indicator ema12 = EMA(close, 12);
+    Indicator ema26 = EMA(close, 26);
+    for (size_t i = 0; i < close.size(); ++i) {
+        bank.push(close[i]);
+        BOOST_CHECK(bank.value(e5) == ema5[i]);
+        BOOST_CHECK(bank.value(e12) == ema12[i]);
+        BOOST_CHECK(bank.value(e26) == ema26[i]);
+    }
+
+    /** @arg 清除后以新的第一个值为初始值 */
+    bank.reset();
+    bank.push(10.0);
+    BOOST_CHECK(bank.value(e5) == 10.0);
+    BOOST_CHECK(bank.value(e26) == 10.0);
+}
+
+/** @par 检测点 */
+BOOST_AUTO_TEST_CASE( test_rolling_benchmark ) {
+    StockManager& sm = StockManager::instance();
+    KData kdata = sm.getStock("sh000001").getKData(KQuery(0));
+    Indicator kd = KDATA(kdata);
+    Indicator close = CLOSE(kdata);
+
+    /** @arg BOLL(20, 2) 与 MA ± 2 * STDEV 的Operand组合 */
+    auto start = std::chrono::high_resolution_clock::now();
+    Indicator boll = BOLL(close, 20, 2.0);
+    auto end = std::chrono::high_resolution_clock::now();
+    auto builtin_time = std::chrono::duration_cast<
+            std::chrono::microseconds>(end - start).count();
+
+    OP mid_op = OP(MA(20));
+    OP upper_op = mid_op + OP(STDEV(20)) * 2.0;
+    OP lower_op = mid_op - OP(STDEV(20)) * 2.0;
+    start = std::chrono::high_resolution_clock::now();
+    Indicator mid = mid_op(close);
+    Indicator upper = upper_op(close);
+    Indicator lower = lower_op(close);
+    end = std::chrono::high_resolution_clock::now();
+    auto op_time = std::chrono::duration_cast<
+            std::chrono::microseconds>(end - start).count();
+
+    size_t last = close.size() - 1;
+    BOOST_CHECK_CLOSE(boll.get(last, 0), mid[last], 0.00001);
+    BOOST_CHECK_CLOSE(boll.get(last, 1), upper[last], 0.00001);
+    BOOST_CHECK_CLOSE(boll.get(last, 2), lower[last], 0.00001);
+    BOOST_TEST_MESSAGE("BOLL on " << close.size() << " bars, built-in: "
+            << builtin_time << "us, Operand: " << op_time << "us");
+
+    /** @arg KDJ(9, 3, 3) 与 LLV/HHV/EMA 的Operand组合 */
+    start = std::chrono::high_resolution_clock::now();
+    Indicator kdj = KDJ(kd, 9, 3, 3);
+    end = std::chrono::high_resolution_clock::now();
+    builtin_time = std::chrono::duration_cast<
+            std::chrono::microseconds>(end - start).count();
+
+    //平滑系数1/m与周期为2m-1的EMA相同
+    OP llv_op = OP(LLV(9))(OP(LOW()));
+    OP rsv_op = (OP(CLOSE()) - llv_op)
+              / (OP(HHV(9))(OP(HIGH())) - llv_op) * 100.0;
+    OP k_op = OP(EMA(5))(rsv_op);
+    OP d_op = OP(EMA(5))(k_op);
+    OP j_op = k_op * 3.0 - d_op * 2.0;
+    start = std::chrono::high_resolution_clock::now();
+    Indicator k = k_op(kd);
+    Indicator d = d_op(kd);
+    Indicator j = j_op(kd);
+    end = std::chrono::high_resolution_clock::now();
+    op_time = std::chrono::duration_cast<
+            std::chrono::microseconds>(end - start).count();
+
+    BOOST_CHECK_CLOSE(kdj.get(last, 0), k[last], 0.0001);
+    BOOST_CHECK_CLOSE(kdj.get(last, 1), d[last], 0.0001);
+    BOOST_CHECK_CLOSE(kdj.get(last, 2), j[last], 0.0001);
+    BOOST_TEST_MESSAGE("KDJ on " << kd.size() << " bars, built-in: "
+            << builtin_time << "us, Operand: " << op_time << "us");
+
+    /** @arg RSI(14) 与 DIFF/EMA 的Operand组合 */
+    start = std::chrono::high_resolution_clock::now();
+    Indicator rsi = RSI(close, 14);
+    end = std::chrono::high_resolution_clock::now();
+    builtin_time = std::chrono::duration_cast<
+            std::chrono::microseconds>(end - start).count();
+
+    //平滑系数1/n与周期为2n-1的EMA相同
+    OP diff_op = OP(DIFF());
+    OP up_op = diff_op * (diff_op > 0.0);
+    OP all_op = up_op - diff_op * (diff_op < 0.0);
+    OP rsi_op = OP(EMA(27))(up_op) / OP(EMA(27))(all_op) * 100.0;
+    start = std::chrono::high_resolution_clock::now();
+    Indicator expect = rsi_op(close);
+    end = std::chrono::high_resolution_clock::now();
+    op_time = std::chrono::duration_cast<
+            std::chrono::microseconds>(end - start).count();
+
+    BOOST_CHECK_CLOSE(rsi[last], expect[last], 0.0001);
+    BOOST_TEST_MESSAGE("RSI on " << close.size() << " bars, built-in: "
+            << builtin_time << "us, Operand: " << op_time << "us");
+}
+
+/** @} */
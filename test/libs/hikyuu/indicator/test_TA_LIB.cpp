@@ -0,0 +1,67 @@
+/*
+ * test_TA_LIB.cpp
+ *
+ *  Created on: 2017年6月12日
+ *      Author: fasiondog
+ */
+
+#ifdef TEST_ALL_IN_ONE
+    #include <boost/test/unit_test.hpp>
+#else
+    #define BOOST_TEST_MODULE test_hikyuu_indicator_suite
+    #include <boost/test/unit_test.hpp>
+#endif
+
+#include <hikyuu/indicator/crt/TA_LIB.h>
+
+#if HKU_SUPPORT_TA_LIB
+
+#include <hikyuu/indicator/crt/PRICELIST.h>
+#include <hikyuu/indicator/crt/MA.h>
+
+using namespace hku;
+
+/**
+ * @defgroup test_indicator_TA_LIB test_indicator_TA_LIB
+ * @ingroup test_hikyuu_indicator_suite
+ * @{
+ */
+
+/** @par 检测点 */
+BOOST_AUTO_TEST_CASE( test_TA_LIB ) {
+    PriceList d;
+    for (size_t i = 0; i < 30; ++i) {
+        d.push_back(i);
+    }
+    Indicator data = PRICELIST(d);
+
+    /** @arg 不存在的函数 */
+    BOOST_CHECK_THROW(TA_LIB("NOT_EXIST_FUNC"), std::invalid_argument);
+
+    /** @arg 参数名称及默认值取自TA-Lib */
+    Indicator sma = TA_LIB("SMA");
+    BOOST_CHECK(sma.name() == "TA_SMA");
+    BOOST_CHECK(sma.getParam<int>("timeperiod") == 30);
+
+    /** @arg 与MA的计算结果一致 */
+    sma.setParam<int>("timeperiod", 10);
+    Indicator result = sma(data);
+    Indicator expect = MA(data, 10);
+    BOOST_CHECK(result.size() == 30);
+    BOOST_CHECK(result.discard() == 9);
+    for (size_t i = 0; i < 9; ++i) {
+        BOOST_CHECK(result[i] == Null<price_t>());
+    }
+    for (size_t i = 9; i < 30; ++i) {
+        BOOST_CHECK_CLOSE(result[i], expect[i], 0.0001);
+    }
+
+    /** @arg 多个结果集 */
+    Indicator bbands = TA_LIB(data, "BBANDS");
+    BOOST_CHECK(bbands.getResultNumber() == 3);
+    BOOST_CHECK(bbands.discard() == 4);
+}
+
+/** @} */
+
+#endif /* HKU_SUPPORT_TA_LIB */
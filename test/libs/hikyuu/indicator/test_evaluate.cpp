@@ -0,0 +1,106 @@
+/*
+ * test_evaluate.cpp
+ *
+ *  Created on: 2017年6月12日
+ *      Author: fasiondog
+ */
+
+#ifdef TEST_ALL_IN_ONE
+    #include <boost/test/unit_test.hpp>
+#else
+    #define BOOST_TEST_MODULE test_hikyuu_indicator_suite
+    #include <boost/test/unit_test.hpp>
+#endif
+
+#include <hikyuu/StockManager.h>
+#include <hikyuu/indicator/Evaluate.h>
+#include <hikyuu/indicator/crt/MA.h>
+#include <hikyuu/indicator/crt/KDATA.h>
+#include <hikyuu/indicator/crt/PRICELIST.h>
+
+using namespace hku;
+
+/**
+ * @defgroup test_indicator_evaluate test_indicator_evaluate
+ * @ingroup test_hikyuu_indicator_suite
+ * @{
+ */
+
+/** @par 检测点 */
+BOOST_AUTO_TEST_CASE( test_align ) {
+    DatetimeList calendar, dates;
+    for (int i = 1; i <= 5; ++i) {
+        calendar.push_back(Datetime(201701000000LL + i * 10000));
+    }
+    dates.push_back(calendar[1]);
+    dates.push_back(calendar[3]);
+    dates.push_back(calendar[4]);
+
+    PriceList data;
+    data.push_back(1.0);
+    data.push_back(2.0);
+    data.push_back(3.0);
+    Indicator ind = PRICELIST(data);
+
+    /** @arg 长度不匹配 */
+    DatetimeList bad_dates(2);
+    BOOST_CHECK(align(ind, bad_dates, calendar).size() == 0);
+
+    /** @arg 正常对齐 */
+    Indicator result = align(ind, dates, calendar);
+    BOOST_CHECK(result.size() == 5);
+    BOOST_CHECK(result.discard() == 1);
+    BOOST_CHECK(result[0] == Null<price_t>());
+    BOOST_CHECK(result[1] == 1.0);
+    BOOST_CHECK(result[2] == Null<price_t>());
+    BOOST_CHECK(result[3] == 2.0);
+    BOOST_CHECK(result[4] == 3.0);
+
+    /** @arg 原指标的discard */
+    ind.setDiscard(2);
+    result = align(ind, dates, calendar);
+    BOOST_CHECK(result.discard() == 4);
+    BOOST_CHECK(result[3] == Null<price_t>());
+    BOOST_CHECK(result[4] == 3.0);
+}
+
+/** @par 检测点 */
+BOOST_AUTO_TEST_CASE( test_evaluate ) {
+    StockManager& sm = StockManager::instance();
+    StockList stocks;
+    stocks.push_back(sm.getStock("sh000001"));
+    stocks.push_back(sm.getStock("sh600000"));
+    stocks.push_back(sm.getStock("sz000001"));
+    stocks.push_back(sm.getStock("sh600004"));
+
+    KQuery query(-200);
+    Operand op = OP(MA(10));
+    DatetimeList calendar = sm.getTradingCalendar(query);
+    BOOST_CHECK(calendar.size() == 200);
+
+    /** @arg 股票列表为空 */
+    BOOST_CHECK(evaluate(op, StockList(), query).empty());
+
+    /** @arg 多线程计算结果与逐只计算结果相同 */
+    IndicatorList result = evaluate(op, stocks, query, 3);
+    BOOST_CHECK(result.size() == stocks.size());
+    for (size_t i = 0; i < stocks.size(); ++i) {
+        KData kdata = stocks[i].getKData(query);
+        DatetimeList dates = stocks[i].getDatetimeList(query);
+        Indicator expect = align(MA(CLOSE(kdata), 10), dates, calendar);
+        BOOST_CHECK(result[i].size() == calendar.size());
+        BOOST_CHECK(result[i].discard() == expect.discard());
+        for (size_t j = expect.discard(); j < expect.size(); ++j) {
+            BOOST_CHECK(result[i][j] == expect[j]);
+        }
+    }
+
+    /** @arg 上证指数与交易日历一致 */
+    Indicator expect = MA(CLOSE(stocks[0].getKData(query)), 10);
+    BOOST_CHECK(result[0].discard() == expect.discard());
+    for (size_t j = expect.discard(); j < expect.size(); ++j) {
+        BOOST_CHECK(result[0][j] == expect[j]);
+    }
+}
+
+/** @} */
@@ -0,0 +1,222 @@
+/*
+ * test_sweep.cpp
+ *
+ *  Created on: 2017年6月19日
+ *      Author: fasiondog
+ */
+
+#ifdef TEST_ALL_IN_ONE
+    #include <boost/test/unit_test.hpp>
+#else
+    #define BOOST_TEST_MODULE test_hikyuu_indicator_suite
+    #include <boost/test/unit_test.hpp>
+#endif
+
+#include <cmath>
+#include <chrono>
+#include <hikyuu/StockManager.h>
+#include <hikyuu/indicator/Sweep.h>
+#include <hikyuu/indicator/crt/AMA.h>
+#include <hikyuu/indicator/crt/EMA.h>
+#include <hikyuu/indicator/crt/HHV.h>
+#include <hikyuu/indicator/crt/KDATA.h>
+#include <hikyuu/indicator/crt/MA.h>
+#include <hikyuu/indicator/crt/PRICELIST.h>
+
+using namespace hku;
+
+/**
+ * @defgroup test_indicator_sweep test_indicator_sweep
+ * @ingroup test_hikyuu_indicator_suite
+ * @{
+ */
+
+//两个指标的所有结果集在相对误差范围内相等
+static bool sweep_result_equal(const Indicator& a, const Indicator& b) {
+    if (a.size() != b.size() || a.discard() != b.discard()
+            || a.getResultNumber() != b.getResultNumber()) {
+        return false;
+    }
+
+    for (size_t r = 0; r < a.getResultNumber(); ++r) {
+        for (size_t i = 0; i < a.size(); ++i) {
+            price_t x = a.get(i, r), y = b.get(i, r);
+            if (x == y || (x != x && y != y)) {
+                continue;
+            }
+            if (x == Null<price_t>() || y == Null<price_t>()
+                    || std::fabs(x - y) > IND_EQ_THRESHOLD
+                                          * std::max(1.0, std::fabs(y))) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/** @par 检测点 */
+BOOST_AUTO_TEST_CASE( test_IndicatorImp_clone ) {
+    /** @arg 复制类型、名称及参数，不复制结果 */
+    PriceList d;
+    for (size_t i = 0; i < 10; ++i) {
+        d.push_back(i);
+    }
+    Indicator ma = MA(PRICELIST(d), 3);
+    IndicatorImpPtr p = ma.getImp()->clone();
+    BOOST_CHECK(p->name() == "SMA");
+    BOOST_CHECK(p->getParam<int>("n") == 3);
+    BOOST_CHECK(p->size() == 0);
+
+    p->setParam<int>("n", 2);
+    BOOST_CHECK(ma.getParam<int>("n") == 3);
+    Indicator result(p->operator()(PRICELIST(d)));
+    BOOST_CHECK(result.size() == 10);
+    BOOST_CHECK(result[9] == 8.5);
+}
+
+/** @par 检测点 */
+BOOST_AUTO_TEST_CASE( test_sweep ) {
+    StockManager& sm = StockManager::instance();
+    KData kdata = sm.getStock("sh000001").getKData(KQuery(0));
+    Indicator close = CLOSE(kdata);
+
+    /** @arg 空网格或空模板 */
+    ParamGrid grid;
+    BOOST_CHECK(sweep(MA(), close, grid).empty());
+    grid.addRange("n", 1, 61);
+    BOOST_CHECK(sweep(Indicator(), close, grid).empty());
+
+    /** @arg SMA，与逐一计算的结果相同，并带有各自的参数 */
+    IndicatorList result = sweep(MA(), close, grid);
+    BOOST_CHECK(result.size() == 60);
+    for (size_t i = 0; i < result.size(); ++i) {
+        int n = grid.get(i).get<int>("n");
+        BOOST_CHECK(result[i].getParam<int>("n") == n);
+        BOOST_CHECK(result[i].name() == "SMA");
+        BOOST_CHECK(sweep_result_equal(result[i], MA(close, n)));
+    }
+
+    /** @arg 带有discard的输入 */
+    Indicator ma10 = MA(close, 10);
+    ma10.setDiscard(9);
+    result = sweep(MA(), ma10, grid);
+    for (size_t i = 0; i < result.size(); ++i) {
+        int n = grid.get(i).get<int>("n");
+        BOOST_CHECK(result[i].discard() == 9);
+        BOOST_CHECK(sweep_result_equal(result[i], MA(ma10, n)));
+    }
+
+    /** @arg EMA */
+    result = sweep(EMA(), close, grid);
+    for (size_t i = 0; i < result.size(); ++i) {
+        int n = grid.get(i).get<int>("n");
+        BOOST_CHECK(result[i].name() == "EMA");
+        BOOST_CHECK(sweep_result_equal(result[i], EMA(close, n)));
+    }
+
+    /** @arg AMA，多个参数，模板中未包含在网格中的参数保持不变 */
+    ParamGrid ama_grid;
+    ama_grid.addRange("n", 2, 31, 4);
+    ama_grid.addRange("fast_n", 2, 5);
+    result = sweep(AMA(10, 2, 20), close, ama_grid);
+    BOOST_CHECK(result.size() == 24);
+    for (size_t i = 0; i < result.size(); ++i) {
+        Parameter param = ama_grid.get(i);
+        int n = param.get<int>("n");
+        int fast_n = param.get<int>("fast_n");
+        BOOST_CHECK(result[i].getParam<int>("slow_n") == 20);
+        BOOST_CHECK(result[i].getResultNumber() == 2);
+        BOOST_CHECK(sweep_result_equal(result[i], AMA(close, n, fast_n, 20)));
+    }
+
+    /** @arg 其他指标逐一并行计算 */
+    result = sweep(HHV(), close, grid, 4);
+    for (size_t i = 0; i < result.size(); ++i) {
+        int n = grid.get(i).get<int>("n");
+        BOOST_CHECK(sweep_result_equal(result[i], HHV(close, n)));
+    }
+
+    /** @arg 输入数据中含有Null值 */
+    PriceList d;
+    for (size_t i = 0; i < 20; ++i) {
+        d.push_back(i % 3 == 0 ? Null<price_t>() : price_t(i));
+    }
+    Indicator data = PRICELIST(d);
+    ParamGrid small_grid;
+    small_grid.addRange("n", 1, 5);
+    result = sweep(MA(), data, small_grid);
+    for (size_t i = 0; i < result.size(); ++i) {
+        int n = small_grid.get(i).get<int>("n");
+        BOOST_CHECK(sweep_result_equal(result[i], MA(data, n)));
+    }
+
+    /** @arg 非法参数 */
+    ParamGrid bad_grid;
+    bad_grid.addRange("n", 0, 2);
+    result = sweep(MA(), close, bad_grid);
+    BOOST_CHECK(result[0].size() == close.size());
+    BOOST_CHECK(result[0][close.size() - 1] == Null<price_t>());
+    BOOST_CHECK(sweep_result_equal(result[1], MA(close, 1)));
+
+    /** @arg 参数类型与指标不一致 */
+    vector<double> double_n;
+    double_n.push_back(5.0);
+    ParamGrid type_grid;
+    type_grid.add("n", double_n);
+    BOOST_CHECK_THROW(sweep(MA(), close, type_grid), std::logic_error);
+}
+
+/** @par 检测点 */
+BOOST_AUTO_TEST_CASE( test_sweep_benchmark ) {
+    StockManager& sm = StockManager::instance();
+    KData kdata = sm.getStock("sh000001").getKData(KQuery(0));
+    Indicator close = CLOSE(kdata);
+
+    ParamGrid grid;
+    grid.addRange("n", 5, 251);
+
+    /** @arg 一次遍历与逐一计算MA(n), n = 5..250 */
+    auto start = std::chrono::high_resolution_clock::now();
+    IndicatorList result = sweep(MA(), close, grid);
+    auto end = std::chrono::high_resolution_clock::now();
+    auto sweep_time = std::chrono::duration_cast<
+            std::chrono::microseconds>(end - start).count();
+
+    start = std::chrono::high_resolution_clock::now();
+    IndicatorList expect;
+    for (int n = 5; n < 251; ++n) {
+        expect.push_back(MA(close, n));
+    }
+    end = std::chrono::high_resolution_clock::now();
+    auto loop_time = std::chrono::duration_cast<
+            std::chrono::microseconds>(end - start).count();
+
+    BOOST_CHECK(result.size() == expect.size());
+    BOOST_CHECK(sweep_result_equal(result.back(), expect.back()));
+    BOOST_TEST_MESSAGE("MA(n) x " << grid.size() << " on " << close.size()
+            << " bars, sweep: " << sweep_time << "us, one by one: "
+            << loop_time << "us");
+
+    /** @arg EMA(n), n = 5..250 */
+    start = std::chrono::high_resolution_clock::now();
+    result = sweep(EMA(), close, grid);
+    end = std::chrono::high_resolution_clock::now();
+    sweep_time = std::chrono::duration_cast<
+            std::chrono::microseconds>(end - start).count();
+
+    start = std::chrono::high_resolution_clock::now();
+    expect.clear();
+    for (int n = 5; n < 251; ++n) {
+        expect.push_back(EMA(close, n));
+    }
+    end = std::chrono::high_resolution_clock::now();
+    loop_time = std::chrono::duration_cast<
+            std::chrono::microseconds>(end - start).count();
+
+    BOOST_CHECK(sweep_result_equal(result.back(), expect.back()));
+    BOOST_TEST_MESSAGE("EMA(n) x " << grid.size() << " on " << close.size()
+            << " bars, sweep: " << sweep_time << "us, one by one: "
+            << loop_time << "us");
+}
+
+/** @} */
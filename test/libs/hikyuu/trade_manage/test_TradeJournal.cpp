@@ -0,0 +1,128 @@
+/*
+ * test_TradeJournal.cpp
+ *
+ *  Created on: 2017年6月22日
+ *      Author: fasiondog
+ */
+
+#ifdef TEST_ALL_IN_ONE
+    #include <boost/test/unit_test.hpp>
+#else
+    #define BOOST_TEST_MODULE test_hikyuu_trade_manage_suite
+    #include <boost/test/unit_test.hpp>
+#endif
+
+#include <cstdio>
+#include <fstream>
+#include <hikyuu/StockManager.h>
+#include <hikyuu/trade_manage/crt/crtTM.h>
+#include <hikyuu/trade_manage/crt/TC_TestStub.h>
+#include <hikyuu/trade_manage/crt/TJ_Binary.h>
+#include <hikyuu/trade_manage/crt/TJ_Csv.h>
+#include <hikyuu/trade_manage/imp/BinaryTradeJournal.h>
+
+using namespace hku;
+
+/**
+ * @defgroup test_TradeJournal test_TradeJournal
+ * @ingroup test_hikyuu_trade_manage_suite
+ * @{
+ */
+
+static size_t count_lines(const string& filename) {
+    std::ifstream file(filename.c_str());
+    size_t count = 0;
+    string line;
+    while (std::getline(file, line)) {
+        count++;
+    }
+    return count;
+}
+
+/** @par 检测点 */
+BOOST_AUTO_TEST_CASE( test_TradeJournal ) {
+    StockManager& sm = StockManager::instance();
+    Stock stock = sm.getStock("sh600000");
+    Stock stock2 = sm.getStock("sz000001");
+    string bin_file = sm.tmpdir() + "/test_TradeJournal.bin";
+    string csv_file = sm.tmpdir() + "/test_TradeJournal.csv";
+    std::remove(bin_file.c_str());
+    std::remove(csv_file.c_str());
+
+    /** @arg 注册后写入已有的建立账户记录及之后的所有交易记录 */
+    TradeManagerPtr tm = crtTM(Datetime(199901010000), 100000, TC_TestStub(),
+            "test_TradeJournal");
+    tm->regJournal(TJ_Binary(bin_file));
+    tm->regJournal(TJ_Csv(csv_file));
+    tm->regJournal(TradeJournalPtr());
+    tm->checkin(Datetime(199911010000), 20000);
+    tm->buy(Datetime(199911170000), stock, 27.18, 1000, 26.0, 30.0, 27.2, PART_SIGNAL);
+    tm->borrowCash(Datetime(199911180000), 10000);
+    tm->buy(Datetime(199911180000), stock2, 18.2, 500);
+    tm->sell(Datetime(199911190000), stock, 27.5, 500, 0.0, 0.0, 27.5, PART_STOPLOSS);
+    tm->returnCash(Datetime(199911220000), 5000);
+    tm->checkout(Datetime(199911230000), 1000);
+    tm->borrowStock(Datetime(199911240000), stock2, 18.0, 100);
+    tm->returnStock(Datetime(199911250000), stock2, 18.0, 100);
+    tm->clearJournal();
+    const TradeRecordList& trade_list = tm->getTradeList();
+    BOOST_CHECK(trade_list.size() == 10);
+
+    TradeRecordList journal = BinaryTradeJournal::read(bin_file);
+    BOOST_CHECK(journal.size() == trade_list.size());
+    for (size_t i = 0; i < journal.size() && i < trade_list.size(); ++i) {
+        BOOST_CHECK(journal[i] == trade_list[i]);
+        BOOST_CHECK(journal[i].from == trade_list[i].from);
+    }
+    BOOST_CHECK(count_lines(csv_file) == trade_list.size() + 1);
+
+    /** @arg 注册流水后清除已保存的交易动作，且不再保存新的交易动作 */
+    string action_file = sm.tmpdir() + "/test_TradeJournal_actions.txt";
+    tm->tocsv(sm.tmpdir());
+    BOOST_CHECK(count_lines(action_file) == 0);
+
+    /** @arg 清空流水后不再写入，恢复保存交易动作 */
+    tm->sell(Datetime(199911260000), stock, 27.5, 500);
+    BOOST_CHECK(BinaryTradeJournal::read(bin_file).size() == 10);
+    tm->tocsv(sm.tmpdir());
+    BOOST_CHECK(count_lines(action_file) == 1);
+
+    /** @arg 根据流水重建账户 */
+    TradeManagerPtr tm2 = crtTMFromJournal(bin_file, TC_TestStub());
+    BOOST_CHECK(tm2);
+    BOOST_CHECK(tm2->getTradeList().size() == 10);
+    for (size_t i = 0; i < 10; ++i) {
+        BOOST_CHECK(tm2->getTradeList()[i] == trade_list[i]);
+    }
+    BOOST_CHECK(tm2->initCash() == tm->initCash());
+    BOOST_CHECK(tm2->initDatetime() == tm->initDatetime());
+    BOOST_CHECK(tm2->currentCash() == trade_list[9].cash);
+    BOOST_CHECK(tm2->getHoldNumber(Datetime(199911250000), stock) == 500);
+    BOOST_CHECK(tm2->getHoldNumber(Datetime(199911250000), stock2) == 500);
+    BOOST_CHECK(tm2->getDebtCash(Datetime(199911250000)) == 5000);
+
+    /** @arg 追加写入，重新注册及复位后的流水均从新的建立账户记录开始 */
+    tm->regJournal(TJ_Binary(bin_file));
+    tm->reset();
+    tm->buy(Datetime(199911170000), stock, 27.18, 100);
+    tm->clearJournal();
+    journal = BinaryTradeJournal::read(bin_file);
+    BOOST_CHECK(journal.size() == 10 + 11 + 2);
+    BOOST_CHECK(journal[10].business == BUSINESS_INIT);
+    BOOST_CHECK(journal[21].business == BUSINESS_INIT);
+    tm2 = crtTMFromJournal(bin_file, TC_TestStub());
+    BOOST_CHECK(tm2->getTradeList().size() == 2);
+    BOOST_CHECK(tm2->currentCash() == tm->currentCash());
+    BOOST_CHECK(tm2->getHoldNumber(Datetime(199911170000), stock) == 100);
+
+    /** @arg 文件不存在或格式错误 */
+    BOOST_CHECK(BinaryTradeJournal::read(bin_file + ".none").empty());
+    BOOST_CHECK(!crtTMFromJournal(bin_file + ".none"));
+    BOOST_CHECK(BinaryTradeJournal::read(csv_file).empty());
+    BOOST_CHECK(!crtTMFromJournal(csv_file));
+
+    std::remove(bin_file.c_str());
+    std::remove(csv_file.c_str());
+}
+
+/** @} */
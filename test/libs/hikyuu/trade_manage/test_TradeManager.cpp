@@ -13,11 +13,13 @@
 #endif
 
 #include <hikyuu/StockManager.h>
+#include <hikyuu/KData.h>
 #include <hikyuu/trade_manage/crt/TC_TestStub.h>
 #include <hikyuu/trade_manage/crt/TC_FixedA.h>
 #include <hikyuu/trade_manage/crt/crtTM.h>
 
 #include <fstream>
+#include <chrono>
 #include <boost/archive/xml_oarchive.hpp>
 #include <boost/archive/xml_iarchive.hpp>
 
@@ -1241,4 +1243,412 @@ BOOST_AUTO_TEST_CASE( test_TradeManager_trade_financing_securities_lending_no_ri
 
 }
 
+//两个资产记录的各项完全相同
+static bool funds_identical(const FundsRecord& a, const FundsRecord& b) {
+    return a.cash == b.cash && a.market_value == b.market_value
+        && a.short_market_value == b.short_market_value
+        && a.base_cash == b.base_cash && a.base_asset == b.base_asset
+        && a.borrow_cash == b.borrow_cash && a.borrow_asset == b.borrow_asset;
+}
+
+/** @par 检测点 */
+BOOST_AUTO_TEST_CASE( test_TradeManager_getFundsList ) {
+    StockManager& sm = StockManager::instance();
+    TradeManagerPtr tm = crtTM(Datetime(199901010000), 1000000, TC_TestStub());
+    tm->setParam<bool>("reinvest", false); //忽略权息
+
+    /** @arg 多个证券交替买入卖出，期间存入资金 */
+    const char *codes[] = {"sh600000", "sz000001", "sh600004"};
+    for (size_t k = 0; k < 3; ++k) {
+        Stock stock = sm.getStock(codes[k]);
+        KData kdata = stock.getKData(KQueryByDate(Datetime(199901010000),
+                Datetime(200801010000)));
+        for (size_t i = 5 * k; i + 10 < kdata.size(); i += 20) {
+            KRecord buy_k = kdata[i], sell_k = kdata[i + 5 + k];
+            if (!tm->have(stock)) {
+                tm->buy(buy_k.datetime, stock, buy_k.closePrice, 100,
+                        0.0, buy_k.closePrice, buy_k.closePrice);
+            }
+            tm->sell(sell_k.datetime, stock, sell_k.closePrice, 100,
+                     0.0, sell_k.closePrice, sell_k.closePrice);
+        }
+        tm->buy(kdata[kdata.size() - 1].datetime, stock,
+                kdata[kdata.size() - 1].closePrice, 200);
+    }
+    tm->checkin(tm->lastDatetime(), 10000);
+    BOOST_CHECK(tm->getTradeList().size() > 100);
+
+    /** @arg 包含建仓之前及最后交易日期之后的日期，与逐一计算的结果完全相同 */
+    DatetimeList dates = sm.getStock("sh000001").getDatetimeList(
+            KQueryByDate(Datetime(199812010000), Datetime(201101010000)));
+    auto start = std::chrono::high_resolution_clock::now();
+    FundsList funds_list = tm->getFundsList(dates);
+    auto end = std::chrono::high_resolution_clock::now();
+    auto list_time = std::chrono::duration_cast<
+            std::chrono::microseconds>(end - start).count();
+
+    BOOST_CHECK(funds_list.size() == dates.size());
+    start = std::chrono::high_resolution_clock::now();
+    size_t diff_count = 0;
+    for (size_t i = 0; i < dates.size(); ++i) {
+        if (!funds_identical(funds_list[i], tm->getFunds(dates[i]))) {
+            diff_count++;
+        }
+    }
+    end = std::chrono::high_resolution_clock::now();
+    auto loop_time = std::chrono::duration_cast<
+            std::chrono::microseconds>(end - start).count();
+    BOOST_CHECK(diff_count == 0);
+    BOOST_TEST_MESSAGE("getFunds x " << dates.size() << " with "
+            << tm->getTradeList().size() << " trades, getFundsList: "
+            << list_time << "us, one by one: " << loop_time << "us");
+
+    /** @arg 资产净值曲线及收益曲线 */
+    PriceList funds_curve = tm->getFundsCurve(dates);
+    PriceList profit_curve = tm->getProfitCurve(dates);
+    BOOST_CHECK(profit_curve[0] == 0.0);
+    for (size_t i = 0; i < dates.size(); ++i) {
+        const FundsRecord& funds = funds_list[i];
+        BOOST_CHECK(funds_curve[i] == roundEx(funds.cash + funds.market_value
+                - funds.borrow_cash - funds.borrow_asset, 2));
+        if (dates[i] >= tm->initDatetime()) {
+            BOOST_CHECK(profit_curve[i] == roundEx(funds.cash
+                    + funds.market_value - funds.borrow_cash
+                    - funds.borrow_asset - funds.base_cash - funds.base_asset, 2));
+        }
+    }
+
+    /** @arg 日期无序 */
+    DatetimeList unordered;
+    unordered.push_back(dates[300]);
+    unordered.push_back(dates[100]);
+    unordered.push_back(dates[200]);
+    unordered.push_back(Null<Datetime>());
+    funds_list = tm->getFundsList(unordered);
+    for (size_t i = 0; i < unordered.size(); ++i) {
+        BOOST_CHECK(funds_identical(funds_list[i], tm->getFunds(unordered[i])));
+    }
+
+    /** @arg 空列表 */
+    BOOST_CHECK(tm->getFundsList(DatetimeList()).empty());
+    BOOST_CHECK(tm->getProfitCurve(DatetimeList()).empty());
+}
+
+//逐条遍历交易记录计算历史持仓及借入情况，用于核对快照回放的结果
+static size_t replay_hold_number(const TradeRecordList& trade_list,
+        const Datetime& datetime, const Stock& stock) {
+    size_t number = 0;
+    for (size_t i = 0; i < trade_list.size(); ++i) {
+        const TradeRecord& record = trade_list[i];
+        if (record.datetime > datetime) {
+            break;
+        }
+        if (record.stock != stock) {
+            continue;
+        }
+        if (record.business == BUSINESS_BUY
+                || record.business == BUSINESS_GIFT
+                || record.business == BUSINESS_CHECKIN_STOCK) {
+            number += record.number;
+        } else if (record.business == BUSINESS_SELL
+                || record.business == BUSINESS_CHECKOUT_STOCK) {
+            number -= record.number;
+        }
+    }
+    return number;
+}
+
+static size_t replay_debt_number(const TradeRecordList& trade_list,
+        const Datetime& datetime, const Stock& stock) {
+    size_t number = 0;
+    for (size_t i = 0; i < trade_list.size(); ++i) {
+        const TradeRecord& record = trade_list[i];
+        if (record.datetime > datetime) {
+            break;
+        }
+        if (record.stock != stock) {
+            continue;
+        }
+        if (record.business == BUSINESS_BORROW_STOCK) {
+            number += record.number;
+        } else if (record.business == BUSINESS_RETURN_STOCK) {
+            number -= record.number;
+        }
+    }
+    return number;
+}
+
+static price_t replay_debt_cash(const TradeRecordList& trade_list,
+        const Datetime& datetime) {
+    price_t debt_cash = 0.0;
+    for (size_t i = 0; i < trade_list.size(); ++i) {
+        const TradeRecord& record = trade_list[i];
+        if (record.datetime > datetime) {
+            break;
+        }
+        if (record.business == BUSINESS_BORROW_CASH) {
+            debt_cash += record.realPrice;
+        } else if (record.business == BUSINESS_RETURN_CASH) {
+            debt_cash -= record.realPrice;
+        }
+    }
+    return debt_cash;
+}
+
+static price_t replay_cash(const TradeRecordList& trade_list,
+        const Datetime& datetime) {
+    price_t cash = 0.0;
+    for (size_t i = 0; i < trade_list.size(); ++i) {
+        if (trade_list[i].datetime > datetime) {
+            break;
+        }
+        cash = trade_list[i].cash;
+    }
+    return cash;
+}
+
+//核对所有历史日期的查询结果，返回不一致的数量
+static size_t check_snapshot_queries(const TradeManagerPtr& tm,
+        const DatetimeList& dates, const Stock& stock, const Stock& stock2) {
+    const TradeRecordList& trade_list = tm->getTradeList();
+    size_t diff_count = 0;
+    for (size_t i = 0; i < dates.size(); ++i) {
+        const Datetime& d = dates[i];
+        if (d < tm->initDatetime() || d >= tm->lastDatetime()) {
+            continue;
+        }
+
+        Datetime funds_d(d.year(), d.month(), d.day(), 11, 59);
+        if (tm->getHoldNumber(d, stock) != replay_hold_number(trade_list, d, stock)
+            || tm->getHoldNumber(d, stock2) != replay_hold_number(trade_list, d, stock2)
+            || tm->getDebtNumber(d, stock2) != replay_debt_number(trade_list, d, stock2)
+            || tm->getShortHoldNumber(d, stock) != 0
+            || tm->getDebtCash(d) != replay_debt_cash(trade_list, d)
+            || tm->getFunds(d).cash != replay_cash(trade_list, funds_d)
+            || tm->getFunds(d).borrow_cash != replay_debt_cash(trade_list, funds_d)) {
+            diff_count++;
+        }
+    }
+    return diff_count;
+}
+
+/** @par 检测点 */
+BOOST_AUTO_TEST_CASE( test_TradeManager_snapshot ) {
+    StockManager& sm = StockManager::instance();
+    Stock stock = sm.getStock("sh600000");
+    Stock stock2 = sm.getStock("sz000001");
+    TradeManagerPtr tm = crtTM(Datetime(199901010000), 1000000, TC_TestStub());
+    tm->setParam<bool>("reinvest", false); //忽略权息
+
+    KData kdata = stock.getKData(KQueryByDate(Datetime(199901010000),
+            Datetime(200801010000)));
+    DatetimeList dates = stock.getDatetimeList(
+            KQueryByDate(Datetime(199812010000), Datetime(200901010000)));
+    size_t half = kdata.size() / 2;
+
+    /** @arg 买入卖出、融资及融券交替进行，交易记录超过多个快照间隔 */
+    for (size_t i = 0; i < half; i += 5) {
+        const KRecord& k = kdata[i];
+        if (i % 10 == 0) {
+            tm->buy(k.datetime, stock, k.closePrice, 100);
+        } else {
+            tm->sell(k.datetime, stock, k.closePrice, 100);
+        }
+        if (i % 30 == 0) {
+            tm->borrowCash(k.datetime, 1000);
+        } else if (i % 30 == 15) {
+            tm->returnCash(k.datetime, 1000);
+        }
+        if (i % 40 == 0) {
+            tm->borrowStock(k.datetime, stock2, 10.0, 100);
+        } else if (i % 40 == 20) {
+            tm->returnStock(k.datetime, stock2, 10.0, 100);
+        }
+    }
+    BOOST_CHECK(tm->getTradeList().size() > 200);
+    BOOST_CHECK(check_snapshot_queries(tm, dates, stock, stock2) == 0);
+
+    /** @arg 已生成快照后继续交易，快照延续至新的交易记录 */
+    for (size_t i = half; i < kdata.size(); i += 5) {
+        const KRecord& k = kdata[i];
+        if (i % 10 == 0) {
+            tm->buy(k.datetime, stock, k.closePrice, 100);
+        } else {
+            tm->sell(k.datetime, stock, k.closePrice, 100);
+        }
+        if (i % 40 == 0) {
+            tm->borrowStock(k.datetime, stock2, 10.0, 100);
+        } else if (i % 40 == 20) {
+            tm->returnStock(k.datetime, stock2, 10.0, 100);
+        }
+    }
+    BOOST_CHECK(check_snapshot_queries(tm, dates, stock, stock2) == 0);
+
+    /** @arg 克隆的实例与原实例结果一致 */
+    TradeManagerPtr tm2 = tm->clone();
+    BOOST_CHECK(check_snapshot_queries(tm2, dates, stock, stock2) == 0);
+    for (size_t i = 0; i < dates.size(); i += 50) {
+        BOOST_CHECK(funds_identical(tm->getFunds(dates[i]),
+                                    tm2->getFunds(dates[i])));
+    }
+
+    /** @arg 复位后重新交易，原有快照失效 */
+    tm->reset();
+    for (size_t i = 0; i < kdata.size(); i += 7) {
+        tm->buy(kdata[i].datetime, stock2, kdata[i].closePrice, 200);
+    }
+    BOOST_CHECK(check_snapshot_queries(tm, dates, stock, stock2) == 0);
+    BOOST_CHECK(tm->getHoldNumber(kdata[half].datetime, stock) == 0);
+    BOOST_CHECK(tm->getDebtCash(kdata[half].datetime) == 0.0);
+}
+
+/** @par 检测点 */
+BOOST_AUTO_TEST_CASE( test_TradeManager_getPositionMap ) {
+    StockManager& sm = StockManager::instance();
+    TradeManagerPtr tm = crtTM(Datetime(199901010000), 1000000, TC_TestStub());
+    tm->setParam<bool>("reinvest", false); //忽略权息
+
+    /** @arg 无持仓 */
+    BOOST_CHECK(tm->getPositionMap().empty());
+    BOOST_CHECK(tm->getShortPositionMap().empty());
+
+    /** @arg 多个证券持仓，按证券id排序，与getPositionList一致 */
+    const char *codes[] = {"sz000001", "sh600004", "sh600000"};
+    for (size_t i = 0; i < 3; ++i) {
+        Stock stock = sm.getStock(codes[i]);
+        BOOST_CHECK(tm->buy(Datetime(200001040000), stock, 10.0, 100 * (i + 1))
+                    .business == BUSINESS_BUY);
+    }
+    const TradeManager::position_map_type& positions = tm->getPositionMap();
+    PositionRecordList position_list = tm->getPositionList();
+    BOOST_CHECK(positions.size() == 3);
+    BOOST_CHECK(position_list.size() == 3);
+    size_t i = 0;
+    TradeManager::position_map_type::const_iterator iter = positions.begin();
+    for (; iter != positions.end(); ++iter, ++i) {
+        BOOST_CHECK(iter->first == iter->second.stock.id());
+        BOOST_CHECK(iter->second.stock == position_list[i].stock);
+        BOOST_CHECK(iter->second.number == position_list[i].number);
+        BOOST_CHECK(tm->have(iter->second.stock));
+        if (i > 0) {
+            BOOST_CHECK((iter - 1)->first < iter->first);
+        }
+    }
+
+    /** @arg 清仓后从持仓中删除 */
+    Stock stock = sm.getStock("sh600004");
+    tm->sell(Datetime(200001050000), stock, 10.0, 200);
+    BOOST_CHECK(tm->getPositionMap().size() == 2);
+    BOOST_CHECK(tm->getPositionMap().find(stock.id()) == tm->getPositionMap().end());
+    BOOST_CHECK(tm->getPosition(stock) == Null<PositionRecord>());
+    BOOST_CHECK(tm->getPosition(sm.getStock("sh600000")).number == 300);
+}
+
+/** @par 检测点 */
+BOOST_AUTO_TEST_CASE( test_TradeManager_update_weight ) {
+    StockManager& sm = StockManager::instance();
+    Stock stock = sm.getStock("sh600000");
+    Stock stock2 = sm.getStock("sz000001");
+    Datetime mid_date(200301020000), end_date(200612010000);
+
+    /** @arg 逐日查询与一次性跳至结束日期的权息处理结果相同 */
+    TradeManagerPtr tm1 = crtTM(Datetime(199901010000), 1000000, TC_Zero());
+    TradeManagerPtr tm2 = crtTM(Datetime(199901010000), 1000000, TC_Zero());
+    tm1->setParam<bool>("reinvest", true);
+    tm2->setParam<bool>("reinvest", true);
+    tm1->buy(Datetime(199911170000), stock, 27.18, 1000);
+    tm2->buy(Datetime(199911170000), stock, 27.18, 1000);
+
+    DatetimeList dates = stock.getDatetimeList(
+            KQueryByDate(Datetime(199911180000), end_date));
+    for (size_t i = 0; i < dates.size(); ++i) {
+        if (dates[i] == mid_date) {
+            tm1->buy(mid_date, stock2, 10.0, 1000);
+        }
+        tm1->getHoldNumber(dates[i], stock);
+    }
+    tm2->buy(mid_date, stock2, 10.0, 1000);
+
+    BOOST_CHECK(tm1->getHoldNumber(end_date, stock)
+                == tm2->getHoldNumber(end_date, stock));
+    BOOST_CHECK(tm1->getHoldNumber(end_date, stock2)
+                == tm2->getHoldNumber(end_date, stock2));
+    BOOST_CHECK(tm1->getHoldNumber(end_date, stock) > 1000);
+    BOOST_CHECK(tm1->cash(end_date) == tm2->cash(end_date));
+    BOOST_CHECK(tm1->cash(end_date) > 1000000 - 27180 - 10000);
+
+    //两个账户的权息记录相同，一次处理多个权息时记录中的现金余额另行累计，不做比较
+    const TradeRecordList& list1 = tm1->getTradeList();
+    const TradeRecordList& list2 = tm2->getTradeList();
+    BOOST_CHECK(list1.size() == list2.size());
+    size_t weight_count = 0;
+    for (size_t i = 0; i < list1.size() && i < list2.size(); ++i) {
+        BOOST_CHECK(list1[i].stock == list2[i].stock);
+        BOOST_CHECK(list1[i].datetime == list2[i].datetime);
+        BOOST_CHECK(list1[i].business == list2[i].business);
+        BOOST_CHECK(list1[i].realPrice == list2[i].realPrice);
+        BOOST_CHECK(list1[i].number == list2[i].number);
+        if (list1[i].business == BUSINESS_BONUS
+                || list1[i].business == BUSINESS_GIFT) {
+            weight_count++;
+        }
+    }
+    BOOST_CHECK(weight_count > 5);
+
+    /** @arg 处理权息期间关闭再开启，重新计算下一权息日期 */
+    TradeManagerPtr tm3 = crtTM(Datetime(199901010000), 1000000, TC_Zero());
+    tm3->setParam<bool>("reinvest", true);
+    tm3->buy(Datetime(199911170000), stock, 27.18, 1000);
+    tm3->setParam<bool>("reinvest", false);
+    tm3->buy(mid_date, stock2, 10.0, 1000);
+    tm3->setParam<bool>("reinvest", true);
+    BOOST_CHECK(tm3->getHoldNumber(end_date, stock2)
+                == tm2->getHoldNumber(end_date, stock2));
+}
+
+/** @par 检测点 */
+BOOST_AUTO_TEST_CASE( test_crtTMFromMerge ) {
+    StockManager& sm = StockManager::instance();
+    Stock stock = sm.getStock("sh600000");
+    Stock stock2 = sm.getStock("sz000001");
+
+    /** @arg 空列表或存在空指针 */
+    TradeManagerList tm_list;
+    BOOST_CHECK(!crtTMFromMerge(tm_list));
+    tm_list.push_back(TradeManagerPtr());
+    BOOST_CHECK(!crtTMFromMerge(tm_list));
+
+    /** @arg 合并后的初始资金、持仓、已平仓记录及现金为各账户之和 */
+    TradeManagerPtr tm1 = crtTM(Datetime(199901010000), 100000, TC_Zero());
+    TradeManagerPtr tm2 = crtTM(Datetime(199801010000), 200000, TC_Zero());
+    tm1->buy(Datetime(200101030000), stock, 10.0, 1000);
+    tm1->sell(Datetime(200102050000), stock, 11.0, 1000);
+    tm1->buy(Datetime(200103010000), stock, 12.0, 500);
+    tm2->checkin(Datetime(200012010000), 50000);
+    tm2->buy(Datetime(200101030000), stock2, 20.0, 300);
+    tm2->buy(Datetime(200102050000), stock, 10.5, 200);
+
+    tm_list.clear();
+    tm_list.push_back(tm1);
+    tm_list.push_back(tm2);
+    TradeManagerPtr tm = crtTMFromMerge(tm_list, "MERGE");
+    BOOST_CHECK(tm);
+    BOOST_CHECK(tm->name() == "MERGE");
+    BOOST_CHECK(tm->initDatetime() == Datetime(199801010000));
+    BOOST_CHECK(tm->initCash() == 300000);
+    BOOST_CHECK(tm->getTradeList().size() == 7);
+    BOOST_CHECK(tm->currentCash() == tm1->currentCash() + tm2->currentCash());
+    BOOST_CHECK(tm->getHoldNumber(Null<Datetime>(), stock) == 700);
+    BOOST_CHECK(tm->getHoldNumber(Null<Datetime>(), stock2) == 300);
+    BOOST_CHECK(tm->getHistoryPositionList().size() == 1);
+
+    /** @arg 日期相同时按账户在列表中的顺序 */
+    const TradeRecordList& trades = tm->getTradeList();
+    BOOST_CHECK(trades[1].business == BUSINESS_CHECKIN);
+    BOOST_CHECK(trades[2].stock == stock);
+    BOOST_CHECK(trades[3].stock == stock2);
+    BOOST_CHECK(trades[4].business == BUSINESS_SELL);
+    BOOST_CHECK(trades[5].number == 200);
+}
+
 /** @} */
@@ -97,6 +97,35 @@ BOOST_AUTO_TEST_CASE( test_Condition ) {
     BOOST_CHECK(p_clone->isValid(Datetime(200001010000)) == false);
 }
 
+/** @par 检测点 */
+BOOST_AUTO_TEST_CASE( test_Condition_pos ) {
+    StockManager& sm = StockManager::instance();
+    Stock stock = sm.getStock("sh000001");
+    KData kdata = stock.getKData(KQuery(0, 10));
+
+    ConditionPtr p(new ConditionTest);
+    p->setTO(kdata);
+
+    /** @arg 按位置加入有效时间，按位置及日期均可查询 */
+    p->_addValid(size_t(3));
+    p->_addValid(kdata[6].datetime);
+    BOOST_CHECK(p->isValid(size_t(3)) == true);
+    BOOST_CHECK(p->isValid(kdata[3].datetime) == true);
+    BOOST_CHECK(p->isValid(size_t(6)) == true);
+    BOOST_CHECK(p->isValid(size_t(4)) == false);
+    BOOST_CHECK(p->isValid(size_t(10)) == false);
+
+    /** @arg 不在交易对象中的日期 */
+    p->_addValid(Datetime(200101010000));
+    BOOST_CHECK(p->isValid(Datetime(200101010000)) == true);
+
+    /** @arg 克隆及复位 */
+    ConditionPtr p_clone = p->clone();
+    p->reset();
+    BOOST_CHECK(p->isValid(size_t(3)) == false);
+    BOOST_CHECK(p_clone->isValid(size_t(3)) == true);
+}
+
 /** @} */
 
 
@@ -0,0 +1,164 @@
+/*
+ * test_BacktestEngine.cpp
+ *
+ *  Created on: 2017年6月23日
+ *      Author: fasiondog
+ */
+
+#ifdef TEST_ALL_IN_ONE
+    #include <boost/test/unit_test.hpp>
+#else
+    #define BOOST_TEST_MODULE test_hikyuu_trade_sys_suite
+    #include <boost/test/unit_test.hpp>
+#endif
+
+#include <hikyuu/StockManager.h>
+#include <hikyuu/indicator/crt/MA.h>
+#include <hikyuu/trade_manage/crt/crtTM.h>
+#include <hikyuu/trade_sys/moneymanager/crt/MM_FixedCount.h>
+#include <hikyuu/trade_sys/signal/crt/SG_Cross.h>
+#include <hikyuu/trade_sys/stoploss/crt/ST_FixedPercent.h>
+#include <hikyuu/trade_sys/system/crt/SYS_Simple.h>
+#include <hikyuu/trade_sys/portfolio/BacktestEngine.h>
+
+using namespace hku;
+
+/**
+ * @defgroup test_BacktestEngine test_BacktestEngine
+ * @ingroup test_hikyuu_trade_sys_suite
+ * @{
+ */
+
+static SystemPtr create_engine_sys(price_t init_cash) {
+    TradeManagerPtr tm = crtTM(Datetime(199001010000LL), init_cash);
+    SignalPtr sg = SG_Cross(OP(MA(5)), OP(MA(20)));
+    return SYS_Simple(tm, MM_FixedCount(100), EnvironmentPtr(),
+            ConditionPtr(), sg, ST_FixedPercent(0.03));
+}
+
+//取出交易记录中指定证券的买卖记录
+static TradeRecordList stock_trade_list(const TradeRecordList& trades,
+        const Stock& stock) {
+    TradeRecordList result;
+    for (size_t i = 0; i < trades.size(); ++i) {
+        if (trades[i].stock == stock) {
+            result.push_back(trades[i]);
+        }
+    }
+    return result;
+}
+
+static bool same_trade_list(const TradeRecordList& x,
+        const TradeRecordList& y) {
+    if (x.size() != y.size()) {
+        return false;
+    }
+
+    for (size_t i = 0; i < x.size(); ++i) {
+        if (x[i].datetime != y[i].datetime
+                || x[i].business != y[i].business
+                || x[i].number != y[i].number
+                || x[i].realPrice != y[i].realPrice) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/** @par 检测点 */
+BOOST_AUTO_TEST_CASE( test_BacktestEngine_addStock ) {
+    StockManager& sm = StockManager::instance();
+    BacktestEngine engine;
+
+    /** @arg 忽略空证券及重复的证券 */
+    engine.addStock(Stock());
+    engine.addStock(sm.getStock("sh600000"));
+    StockList stocks;
+    stocks.push_back(sm.getStock("sz000001"));
+    stocks.push_back(sm.getStock("sh600000"));
+    engine.addStockList(stocks);
+    BOOST_CHECK(engine.getStockList().size() == 2);
+    BOOST_CHECK(engine.getStockList()[0] == sm.getStock("sh600000"));
+    BOOST_CHECK(engine.getStockList()[1] == sm.getStock("sz000001"));
+
+    /** @arg 未设置账户或系统时不运行 */
+    engine.run(KQuery(-100));
+    BOOST_CHECK(engine.getSystemList().empty());
+    BOOST_CHECK(engine.getEventCount() == 0);
+
+    /** @arg 系统缺少必需的部件时不运行 */
+    engine.setTM(crtTM(Datetime(199001010000LL), 100000));
+    engine.setSYS(SystemPtr(new System()));
+    engine.run(KQuery(-100));
+    BOOST_CHECK(engine.getSystemList().empty());
+
+    engine.clearStockList();
+    BOOST_CHECK(engine.getStockList().empty());
+}
+
+/** @par 检测点 */
+BOOST_AUTO_TEST_CASE( test_BacktestEngine_run ) {
+    StockManager& sm = StockManager::instance();
+    KQuery query(-1000);
+
+    /** @arg 单只证券时与直接运行系统的结果相同 */
+    Stock stock = sm.getStock("sz000001");
+    SystemPtr sys = create_engine_sys(1000000.0);
+    sys->run(stock, query);
+    BOOST_CHECK(sys->getTM()->getTradeList().size() > 1);
+
+    SystemPtr tpl = create_engine_sys(1000000.0);
+    TradeManagerPtr tm = crtTM(Datetime(199001010000LL), 1000000.0);
+    BacktestEngine engine(tm, tpl);
+    engine.addStock(stock);
+    engine.run(query);
+    BOOST_CHECK(engine.getSystemList().size() == 1);
+    BOOST_CHECK(engine.getSystemList()[0]->getTM() == tm);
+    BOOST_CHECK(engine.getSystemList()[0]->getStock() == stock);
+    BOOST_CHECK(engine.getEventCount() == stock.getKData(query).size());
+    BOOST_CHECK(same_trade_list(tm->getTradeList(),
+                                sys->getTM()->getTradeList()));
+    BOOST_CHECK(tm->currentCash() == sys->getTM()->currentCash());
+    BOOST_CHECK(tpl->getTradeRecordList().empty());
+
+    /** @arg 多只证券共享账户，资金充足时各证券的交易与单独运行相同 */
+    StockList stocks;
+    stocks.push_back(sm.getStock("sh600000"));
+    stocks.push_back(sm.getStock("sz000001"));
+    stocks.push_back(sm.getStock("sh600004"));
+    engine.addStockList(stocks);
+    engine.run(query);
+    BOOST_CHECK(engine.getSystemList().size() == 3);
+
+    size_t total = 0;
+    price_t cash = 1000000.0;
+    for (size_t i = 0; i < engine.getStockList().size(); ++i) {
+        Stock stk = engine.getStockList()[i];
+        total += stk.getKData(query).size();
+
+        SystemPtr one = create_engine_sys(1000000.0);
+        one->run(stk, query);
+        TradeRecordList expect = one->getTM()->getTradeList();
+        expect.erase(expect.begin()); //去掉INIT记录
+        BOOST_CHECK(same_trade_list(
+                stock_trade_list(tm->getTradeList(), stk), expect));
+        BOOST_CHECK(engine.getSystemList()[i]->getTradeRecordList().size()
+                    == expect.size());
+        cash += one->getTM()->currentCash() - 1000000.0;
+    }
+    BOOST_CHECK(engine.getEventCount() == total);
+    BOOST_CHECK(std::fabs(tm->currentCash() - cash) < 0.01);
+
+    /** @arg 交易记录按时间顺序 */
+    const TradeRecordList& trades = tm->getTradeList();
+    for (size_t i = 1; i < trades.size(); ++i) {
+        BOOST_CHECK(trades[i - 1].datetime <= trades[i].datetime);
+    }
+
+    /** @arg 重复运行时复位账户 */
+    size_t count = trades.size();
+    engine.run(query);
+    BOOST_CHECK(tm->getTradeList().size() == count);
+}
+
+/** @} */
@@ -0,0 +1,105 @@
+/*
+ * test_ParallelRunner.cpp
+ *
+ *  Created on: 2017年6月23日
+ *      Author: fasiondog
+ */
+
+#ifdef TEST_ALL_IN_ONE
+    #include <boost/test/unit_test.hpp>
+#else
+    #define BOOST_TEST_MODULE test_hikyuu_trade_sys_suite
+    #include <boost/test/unit_test.hpp>
+#endif
+
+#include <hikyuu/StockManager.h>
+#include <hikyuu/indicator/crt/MA.h>
+#include <hikyuu/trade_manage/crt/crtTM.h>
+#include <hikyuu/trade_sys/moneymanager/crt/MM_FixedCount.h>
+#include <hikyuu/trade_sys/signal/crt/SG_Cross.h>
+#include <hikyuu/trade_sys/stoploss/crt/ST_FixedPercent.h>
+#include <hikyuu/trade_sys/system/crt/SYS_Simple.h>
+#include <hikyuu/trade_sys/portfolio/ParallelRunner.h>
+
+using namespace hku;
+
+/**
+ * @defgroup test_ParallelRunner test_ParallelRunner
+ * @ingroup test_hikyuu_trade_sys_suite
+ * @{
+ */
+
+static SystemPtr create_runner_sys() {
+    TradeManagerPtr tm = crtTM(Datetime(199001010000LL), 100000.0);
+    SignalPtr sg = SG_Cross(OP(MA(5)), OP(MA(20)));
+    return SYS_Simple(tm, MM_FixedCount(100), EnvironmentPtr(),
+            ConditionPtr(), sg, ST_FixedPercent(0.03));
+}
+
+/** @par 检测点 */
+BOOST_AUTO_TEST_CASE( test_ParallelRunner ) {
+    StockManager& sm = StockManager::instance();
+    KQuery query(-1000);
+
+    /** @arg 未设置系统 */
+    ParallelRunner empty_runner;
+    empty_runner.addStock(sm.getStock("sh600000"));
+    BOOST_CHECK(!empty_runner.run(query));
+    BOOST_CHECK(empty_runner.getSystemList().empty());
+
+    /** @arg 忽略空证券及重复的证券 */
+    SystemPtr sys = create_runner_sys();
+    ParallelRunner runner(sys);
+    StockList stocks;
+    stocks.push_back(sm.getStock("sh600000"));
+    stocks.push_back(sm.getStock("sz000001"));
+    stocks.push_back(Stock());
+    stocks.push_back(sm.getStock("sh600004"));
+    stocks.push_back(sm.getStock("sz000001"));
+    runner.addStockList(stocks);
+    BOOST_CHECK(runner.getStockList().size() == 3);
+
+    /** @arg 各证券独立运行，与单独运行的结果相同，汇总账户为各账户之和 */
+    TradeManagerPtr tm = runner.run(query, 1);
+    BOOST_CHECK(tm);
+    BOOST_CHECK(runner.getSystemList().size() == 3);
+    BOOST_CHECK(tm->initCash() == 300000.0);
+    BOOST_CHECK(sys->getTradeRecordList().empty());
+
+    size_t total = 1;
+    price_t cash = 0.0;
+    for (size_t i = 0; i < runner.getStockList().size(); ++i) {
+        Stock stock = runner.getStockList()[i];
+        SystemPtr one = create_runner_sys();
+        one->run(stock, query);
+
+        SystemPtr run_sys = runner.getSystemList()[i];
+        BOOST_CHECK(run_sys->getStock() == stock);
+        BOOST_CHECK(run_sys->getTM() != sys->getTM());
+        BOOST_CHECK(run_sys->getTM()->getTradeList().size()
+                    == one->getTM()->getTradeList().size());
+        BOOST_CHECK(run_sys->getTM()->currentCash()
+                    == one->getTM()->currentCash());
+        BOOST_CHECK(tm->getHoldNumber(Null<Datetime>(), stock)
+                    == one->getTM()->getHoldNumber(Null<Datetime>(), stock));
+        total += one->getTM()->getTradeList().size() - 1;
+        cash += one->getTM()->currentCash();
+    }
+    BOOST_CHECK(tm->getTradeList().size() == total);
+    BOOST_CHECK(std::fabs(tm->currentCash() - cash) < 0.01);
+
+    /** @arg 合并结果与线程数无关 */
+    TradeManagerPtr tm4 = runner.run(query, 4);
+    const TradeRecordList& trades = tm->getTradeList();
+    const TradeRecordList& trades4 = tm4->getTradeList();
+    BOOST_CHECK(trades.size() == trades4.size());
+    for (size_t i = 0; i < trades.size() && i < trades4.size(); ++i) {
+        BOOST_CHECK(trades[i].stock == trades4[i].stock);
+        BOOST_CHECK(trades[i].datetime == trades4[i].datetime);
+        BOOST_CHECK(trades[i].business == trades4[i].business);
+        BOOST_CHECK(trades[i].number == trades4[i].number);
+    }
+    BOOST_CHECK(tm4->currentCash() == tm->currentCash());
+}
+
+/** @} */
@@ -73,6 +73,15 @@ BOOST_AUTO_TEST_CASE( test_ProfitGoal) {
     p_src = (ProfitGoalTest *)p_clone.get();
     BOOST_CHECK(p_src->getX() == 10);
     BOOST_CHECK(p != p_clone);
+
+    /** @arg 按K线位置计算，默认实现越界时返回0 */
+    KData kdata = StockManager::instance().getStock("sh600000")
+                                          .getKData(KQuery(-10));
+    p_clone->setTO(kdata);
+    p_src->setX(10);
+    BOOST_CHECK(p_clone->getGoalAt(0, 5.0) == 1.0);
+    BOOST_CHECK(p_clone->getGoalAt(10, 5.0) == 0.0);
+    BOOST_CHECK(p_clone->getShortGoalAt(0, 5.0) == 0.0);
 }
 
 /** @} */
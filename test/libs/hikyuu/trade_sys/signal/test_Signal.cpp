@@ -80,6 +80,51 @@ BOOST_AUTO_TEST_CASE( test_Signal) {
     BOOST_CHECK(p_clone->shouldSell(Datetime(200101030000)) == true);
 }
 
+/** @par 检测点 */
+BOOST_AUTO_TEST_CASE( test_Signal_pos ) {
+    StockManager& sm = StockManager::instance();
+    Stock stock = sm.getStock("sh000001");
+    KData kdata = stock.getKData(KQuery(0, 10));
+
+    SignalPtr p(new SignalTest);
+    p->setTO(kdata);
+
+    /** @arg 按位置加入信号，按位置及日期均可查询 */
+    p->_addBuySignal(2);
+    p->_addSellSignal(5);
+    BOOST_CHECK(p->shouldBuy(size_t(2)) == true);
+    BOOST_CHECK(p->shouldBuy(size_t(3)) == false);
+    BOOST_CHECK(p->shouldBuy(kdata[2].datetime) == true);
+    BOOST_CHECK(p->shouldSell(size_t(5)) == true);
+    BOOST_CHECK(p->shouldSell(kdata[5].datetime) == true);
+
+    /** @arg 按日期加入的信号与位置对应 */
+    p->_addBuySignal(kdata[7].datetime);
+    BOOST_CHECK(p->shouldBuy(size_t(7)) == true);
+
+    /** @arg 买入卖出信号交替出现 */
+    p->_addBuySignal(8);
+    BOOST_CHECK(p->shouldBuy(size_t(8)) == false);
+
+    /** @arg 越界 */
+    p->_addBuySignal(10);
+    BOOST_CHECK(p->shouldBuy(size_t(10)) == false);
+
+    /** @arg 信号列表按日期排序 */
+    DatetimeList buy = p->getBuySignal();
+    BOOST_CHECK(buy.size() == 2);
+    BOOST_CHECK(buy[0] == kdata[2].datetime);
+    BOOST_CHECK(buy[1] == kdata[7].datetime);
+
+    /** @arg 克隆后信号不变，复位后清除 */
+    SignalPtr p_clone = p->clone();
+    BOOST_CHECK(p_clone->shouldBuy(size_t(7)) == true);
+    p->reset();
+    BOOST_CHECK(p->shouldBuy(size_t(2)) == false);
+    BOOST_CHECK(p->getBuySignal().empty());
+    BOOST_CHECK(p_clone->shouldBuy(size_t(2)) == true);
+}
+
 /** @} */
 
 
@@ -54,6 +54,126 @@ BOOST_AUTO_TEST_CASE( test_SG_AMA_export ) {
     BOOST_CHECK(sg1->name() == sg2->name());
 }
 
+/** @par 检测点 */
+BOOST_AUTO_TEST_CASE( test_SG_flags_export ) {
+    StockManager& sm = StockManager::instance();
+    string filename(sm.tmpdir());
+    filename += "/SG_flags.xml";
+
+    /** @arg 保存及加载按K线位置对齐的信号 */
+    Stock stock = sm.getStock("sh000001");
+    KData kdata = stock.getKData(KQuery(-200));
+    SignalPtr sg1 = SG_Single(AMA());
+    sg1->setTO(kdata);
+    BOOST_CHECK(!sg1->getBuySignal().empty());
+    {
+        std::ofstream ofs(filename);
+        boost::archive::xml_oarchive oa(ofs);
+        oa << BOOST_SERIALIZATION_NVP(sg1);
+    }
+
+    SignalPtr sg2;
+    {
+        std::ifstream ifs(filename);
+        boost::archive::xml_iarchive ia(ifs);
+        ia >> BOOST_SERIALIZATION_NVP(sg2);
+    }
+
+    BOOST_CHECK(sg2->getTO().size() == kdata.size());
+    BOOST_CHECK(sg2->getTO().getStock() == stock);
+    BOOST_CHECK(sg2->getBuySignal() == sg1->getBuySignal());
+    BOOST_CHECK(sg2->getSellSignal() == sg1->getSellSignal());
+    for (size_t i = 0; i < kdata.size(); ++i) {
+        BOOST_CHECK(sg2->shouldBuy(i) == sg1->shouldBuy(i));
+        BOOST_CHECK(sg2->shouldSell(i) == sg1->shouldSell(i));
+    }
+}
+
+
+/** 仅包含基类成员的信号，用于按对象（非指针）方式序列化 */
+class SignalVersionTest: public SignalBase {
+    SIGNAL_NO_PRIVATE_MEMBER_SERIALIZATION
+
+public:
+    SignalVersionTest(): SignalBase("SignalVersionTest") {}
+    virtual ~SignalVersionTest() {}
+    virtual void _reset() {}
+    virtual SignalPtr _clone() { return SignalPtr(new SignalVersionTest); }
+    virtual void _calculate() {}
+};
+
+/** @par 检测点 */
+BOOST_AUTO_TEST_CASE( test_SG_version0_load ) {
+    StockManager& sm = StockManager::instance();
+    string filename(sm.tmpdir());
+    filename += "/SG_version0.xml";
+
+    /** @arg 加载版本0中以std::set<Datetime>保存的信号，只能按日期查询 */
+    {
+        std::ofstream ofs(filename);
+        ofs << "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\" ?>\n"
+            "<!DOCTYPE boost_serialization>\n"
+            "<boost_serialization signature=\"serialization::archive\" version=\"12\">\n"
+            "<sg class_id=\"0\" tracking_level=\"0\" version=\"0\">\n"
+            "<SignalBase class_id=\"1\" tracking_level=\"0\" version=\"0\">\n"
+            "<name>SignalVersionTest</name>\n"
+            "<m_params class_id=\"2\" tracking_level=\"0\" version=\"0\">\n"
+            "<count>1</count>\n"
+            "<Item class_id=\"3\" tracking_level=\"0\" version=\"0\">\n"
+            "<name>alternate</name><type>bool</type><value>1</value>\n"
+            "</Item>\n"
+            "</m_params>\n"
+            "<m_hold>0</m_hold>\n"
+            "<m_buySig class_id=\"4\" tracking_level=\"0\" version=\"0\">\n"
+            "<count>2</count>\n"
+            "<item_version>0</item_version>\n"
+            "<item class_id=\"5\" tracking_level=\"0\" version=\"0\">\n"
+            "<datetime>2011-Mar-25 00:00:00</datetime>\n"
+            "</item>\n"
+            "<item><datetime>2011-Jun-24 00:00:00</datetime></item>\n"
+            "</m_buySig>\n"
+            "<m_sellSig>\n"
+            "<count>1</count>\n"
+            "<item_version>0</item_version>\n"
+            "<item><datetime>2011-Apr-01 00:00:00</datetime></item>\n"
+            "</m_sellSig>\n"
+            "</SignalBase>\n"
+            "</sg>\n"
+            "</boost_serialization>\n";
+    }
+
+    SignalVersionTest sg;
+    {
+        std::ifstream ifs(filename);
+        boost::archive::xml_iarchive ia(ifs);
+        ia >> BOOST_SERIALIZATION_NVP(sg);
+    }
+
+    BOOST_CHECK(sg.name() == "SignalVersionTest");
+    BOOST_CHECK(sg.getTO().size() == 0);
+    BOOST_CHECK(sg.getBuySignal().size() == 2);
+    BOOST_CHECK(sg.getSellSignal().size() == 1);
+    BOOST_CHECK(sg.shouldBuy(Datetime(201103250000LL)));
+    BOOST_CHECK(sg.shouldBuy(Datetime(201106240000LL)));
+    BOOST_CHECK(sg.shouldSell(Datetime(201104010000LL)));
+    BOOST_CHECK(!sg.shouldBuy(Datetime(201104010000LL)));
+
+    /** @arg 重新保存为当前版本后可再次加载 */
+    {
+        std::ofstream ofs(filename);
+        boost::archive::xml_oarchive oa(ofs);
+        oa << BOOST_SERIALIZATION_NVP(sg);
+    }
+
+    SignalVersionTest sg2;
+    {
+        std::ifstream ifs(filename);
+        boost::archive::xml_iarchive ia(ifs);
+        ia >> BOOST_SERIALIZATION_NVP(sg2);
+    }
+    BOOST_CHECK(sg2.getBuySignal() == sg.getBuySignal());
+    BOOST_CHECK(sg2.getSellSignal() == sg.getSellSignal());
+}
 
 /** @} */
 
@@ -79,6 +79,16 @@ BOOST_AUTO_TEST_CASE( test_Slippage) {
     p_src = (SlippageTest *)p_clone.get();
     BOOST_CHECK(p_src->getX() == 10);
     BOOST_CHECK(p != p_clone);
+
+    /** @arg 按K线位置计算，默认实现越界时返回计划价格 */
+    KData kdata = StockManager::instance().getStock("sh600000")
+                                          .getKData(KQuery(-10));
+    p_clone->setTO(kdata);
+    p_src->setX(10);
+    BOOST_CHECK(p_clone->getRealBuyPriceAt(0, 5.0) == 1.0);
+    BOOST_CHECK(p_clone->getRealSellPriceAt(9, 5.0) == 1.0);
+    BOOST_CHECK(p_clone->getRealBuyPriceAt(10, 5.0) == 5.0);
+    BOOST_CHECK(p_clone->getRealSellPriceAt(10, 5.0) == 5.0);
 }
 
 /** @} */
@@ -15,6 +15,8 @@
 
 #include <hikyuu/StockManager.h>
 #include <hikyuu/trade_sys/stoploss/StoplossBase.h>
+#include <hikyuu/trade_sys/stoploss/crt/ST_FixedPercent.h>
+#include <hikyuu/trade_sys/stoploss/crt/ST_Saftyloss.h>
 
 using namespace hku;
 
@@ -76,6 +78,39 @@ BOOST_AUTO_TEST_CASE( test_Stoploss) {
     BOOST_CHECK(p != p_clone);
 }
 
+/** @par 检测点 */
+BOOST_AUTO_TEST_CASE( test_Stoploss_getPriceAt ) {
+    StockManager& sm = StockManager::instance();
+    KData kdata = sm.getStock("sh600000").getKData(KQuery(-200));
+
+    /** @arg 默认实现按K线日期调用getPrice，越界时返回0 */
+    StoplossPtr p(new StoplossTest);
+    p->setTO(kdata);
+    ((StoplossTest *)p.get())->setX(10);
+    BOOST_CHECK(p->getPriceAt(0, 1.0) == 1.0);
+    BOOST_CHECK(p->getShortPriceAt(199, 1.0) == 1.0);
+    BOOST_CHECK(p->getPriceAt(200, 1.0) == 0.0);
+    BOOST_CHECK(p->getShortPriceAt(Null<size_t>(), 1.0) == 0.0);
+
+    /** @arg 按位置与按日期取值相同 */
+    StoplossPtr st = ST_Saftyloss();
+    StoplossPtr fixed = ST_FixedPercent(0.1);
+    st->setTO(kdata);
+    fixed->setTO(kdata);
+    size_t valid = 0;
+    for (size_t i = 0; i < kdata.size(); ++i) {
+        Datetime datetime = kdata[i].datetime;
+        BOOST_CHECK(st->getPriceAt(i, 10.0) == st->getPrice(datetime, 10.0));
+        BOOST_CHECK(fixed->getPriceAt(i, 10.0) == fixed->getPrice(datetime, 10.0));
+        if (st->getPriceAt(i, 10.0) != 0.0) {
+            valid++;
+        }
+    }
+    BOOST_CHECK(valid > 0 && valid < kdata.size());
+    BOOST_CHECK(st->getPriceAt(kdata.size(), 10.0) == 0.0);
+    BOOST_CHECK(st->getPrice(Datetime(199001010000LL), 10.0) == 0.0);
+}
+
 /** @} */
 
 
@@ -14,7 +14,13 @@
 #endif
 
 #include <hikyuu/StockManager.h>
+#include <hikyuu/indicator/crt/MA.h>
+#include <hikyuu/trade_manage/crt/crtTM.h>
+#include <hikyuu/trade_sys/moneymanager/crt/MM_FixedCount.h>
+#include <hikyuu/trade_sys/signal/crt/SG_Cross.h>
+#include <hikyuu/trade_sys/stoploss/crt/ST_FixedPercent.h>
 #include <hikyuu/trade_sys/system/crt/SYS_Simple.h>
+#include <type_traits>
 
 using namespace hku;
 
@@ -31,6 +37,159 @@ BOOST_AUTO_TEST_CASE( test_SYS_Simple) {
     //std::cout << sys << std::endl;
 }
 
+static SystemPtr create_simple_sys() {
+    TradeManagerPtr tm = crtTM(Datetime(199001010000LL), 1000000.0);
+    SignalPtr sg = SG_Cross(OP(MA(5)), OP(MA(20)));
+    return SYS_Simple(tm, MM_FixedCount(100), EnvironmentPtr(),
+            ConditionPtr(), sg, ST_FixedPercent(0.03));
+}
+
+/** @par 检测点 */
+BOOST_AUTO_TEST_CASE( test_System_run_kdata ) {
+    StockManager& sm = StockManager::instance();
+    Stock stock = sm.getStock("sz000001");
+    KQuery query(-1000);
+
+    /** @arg 使用K线数据运行与使用证券及查询条件运行的结果相同 */
+    SystemPtr sys1 = create_simple_sys();
+    SystemPtr sys2 = create_simple_sys();
+    sys1->run(stock, query);
+    sys2->run(stock.getKData(query));
+    BOOST_CHECK(sys1->getTradeRecordList().size() > 0);
+    BOOST_CHECK(sys1->getTradeRecordList().size()
+                == sys2->getTradeRecordList().size());
+    BOOST_CHECK(sys2->getStock() == stock);
+    BOOST_CHECK(sys1->getTM()->currentCash() == sys2->getTM()->currentCash());
+
+    /** @arg 空K线数据 */
+    SystemPtr sys3 = create_simple_sys();
+    sys3->run(KData());
+    BOOST_CHECK(sys3->getTradeRecordList().empty());
+}
+
+//不跳过任何K线，逐根运行系统，作为System::run的参照
+static void run_every_bar(const SystemPtr& sys, const KData& kdata) {
+    sys->readyForRun();
+    sys->reset();
+    sys->setTO(kdata);
+    for (size_t i = 0; i < kdata.size(); ++i) {
+        sys->runMomentAt(i);
+    }
+}
+
+/** @par 检测点 */
+BOOST_AUTO_TEST_CASE( test_System_run_skip_idle ) {
+    StockManager& sm = StockManager::instance();
+    KData kdata = sm.getStock("sh600000").getKData(KQuery(-2000));
+    TradeManagerPtr tm = crtTM(Datetime(199001010000LL), 1000000.0);
+
+    /** @arg 跳过空仓无信号的K线，与逐根运行的结果相同，含延迟及非延迟操作 */
+    for (int delay = 0; delay < 2; ++delay) {
+        SignalPtr sg = SG_Cross(OP(MA(10)), OP(MA(60)));
+        SystemPtr sys1 = SYS_Simple(tm->clone(), MM_FixedCount(100),
+                EnvironmentPtr(), ConditionPtr(), sg, ST_FixedPercent(0.05));
+        sys1->setParam<bool>("delay", delay == 1);
+        SystemPtr sys2 = sys1->clone();
+        sys1->run(kdata);
+        run_every_bar(sys2, kdata);
+
+        const TradeRecordList& trades1 = sys1->getTM()->getTradeList();
+        const TradeRecordList& trades2 = sys2->getTM()->getTradeList();
+        BOOST_CHECK(trades1.size() > 3);
+        BOOST_CHECK(trades1.size() == trades2.size());
+        for (size_t i = 0; i < trades1.size() && i < trades2.size(); ++i) {
+            BOOST_CHECK(trades1[i].datetime == trades2[i].datetime);
+            BOOST_CHECK(trades1[i].business == trades2[i].business);
+            BOOST_CHECK(trades1[i].number == trades2[i].number);
+            BOOST_CHECK(trades1[i].realPrice == trades2[i].realPrice);
+            BOOST_CHECK(trades1[i].from == trades2[i].from);
+        }
+        BOOST_CHECK(sys1->getTM()->currentCash() == sys2->getTM()->currentCash());
+    }
+
+    /** @arg 没有任何信号时不发生交易 */
+    SystemPtr sys3 = SYS_Simple(tm->clone(), MM_FixedCount(100),
+            EnvironmentPtr(), ConditionPtr(), SG_Cross(OP(MA(5)), OP(MA(5))),
+            ST_FixedPercent(0.05));
+    sys3->run(kdata);
+    BOOST_CHECK(sys3->getTradeRecordList().empty());
+}
+
+/** @par 检测点 */
+BOOST_AUTO_TEST_CASE( test_System_trade_index ) {
+    StockManager& sm = StockManager::instance();
+    Stock stock = sm.getStock("sh600000");
+    KData kdata = stock.getKData(KQuery(0));
+
+    /** @arg 交易记录可无异常移动，容器扩容时移动而不复制 */
+    BOOST_CHECK(std::is_nothrow_move_constructible<Stock>::value);
+    BOOST_CHECK(std::is_nothrow_move_constructible<TradeRecord>::value);
+    BOOST_CHECK(std::is_nothrow_move_assignable<TradeRecord>::value);
+
+    /** @arg 被移动的Stock恢复为默认构造的状态，仍可正常使用 */
+    Stock moved_from(stock);
+    Stock moved_to(std::move(moved_from));
+    BOOST_CHECK(moved_to == stock);
+    BOOST_CHECK(moved_from.isNull());
+    BOOST_CHECK(moved_from.getKDataDriver());
+    BOOST_CHECK(moved_from.getKDataDriver() == Stock().getKDataDriver());
+    moved_from = stock;
+    BOOST_CHECK(moved_from == stock);
+    moved_to = std::move(moved_from);
+    BOOST_CHECK(moved_to == stock);
+    BOOST_CHECK(moved_from.isNull());
+    BOOST_CHECK(moved_from.getKDataDriver());
+    BOOST_CHECK(moved_from.getKDataDriver() == Stock().getKDataDriver());
+
+    /** @arg 系统按位置引用交易管理实例中的交易记录 */
+    SystemPtr sys = create_simple_sys();
+    sys->setParam<bool>("delay", false);
+    sys->run(kdata);
+
+    vector<size_t> index = sys->getTradeIndexList();
+    const TradeRecordList& trades = sys->getTM()->getTradeList();
+    TradeRecordList sys_trades = sys->getTradeRecordList();
+    BOOST_CHECK(index.size() > 10);
+    BOOST_CHECK(sys_trades.size() == index.size());
+    for (size_t i = 0; i < index.size() && i < sys_trades.size(); ++i) {
+        BOOST_CHECK(index[i] < trades.size());
+        BOOST_CHECK(trades[index[i]].datetime == sys_trades[i].datetime);
+        BOOST_CHECK(trades[index[i]].business == sys_trades[i].business);
+        BOOST_CHECK(trades[index[i]].business == BUSINESS_BUY
+                    || trades[index[i]].business == BUSINESS_SELL);
+    }
+
+    /** @arg 克隆后按位置引用克隆的交易管理实例 */
+    SystemPtr sys2 = sys->clone();
+    BOOST_CHECK(sys2->getTM() != sys->getTM());
+    BOOST_CHECK(sys2->getTradeRecordList().size() == sys_trades.size());
+
+    /** @arg 更换交易管理实例后不再引用原实例中的位置 */
+    TradeManagerPtr other_tm = sys->getTM()->clone();
+    sys2->setTM(other_tm);
+    BOOST_CHECK(sys2->getTradeIndexList().empty());
+    BOOST_CHECK(sys2->getTradeRecordList().empty());
+    sys2->setTM(other_tm);
+    BOOST_CHECK(sys2->getTradeIndexList().empty());
+
+    /** @arg 交易管理实例在系统之外复位后，原有位置失效，重新运行后恢复 */
+    SystemPtr sys3 = sys->clone();
+    sys3->getTM()->reset();
+    BOOST_CHECK(sys3->getTradeIndexList().empty());
+    BOOST_CHECK(sys3->getTradeRecordList().empty());
+    sys3->getTM()->buy(kdata[0].datetime, stock, kdata[0].closePrice, 100);
+    BOOST_CHECK(sys3->getTradeRecordList().empty());
+    SystemPtr sys4 = sys3->clone();
+    BOOST_CHECK(sys4->getTradeIndexList().empty());
+    sys3->run(kdata);
+    BOOST_CHECK(sys3->getTradeRecordList().size() == sys_trades.size());
+
+    /** @arg 复位后清除 */
+    sys->reset();
+    BOOST_CHECK(sys->getTradeIndexList().empty());
+    BOOST_CHECK(sys->getTradeRecordList().empty());
+}
+
 /** @} */
 
 
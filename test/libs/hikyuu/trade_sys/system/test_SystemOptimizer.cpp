@@ -0,0 +1,127 @@
+/*
+ * test_SystemOptimizer.cpp
+ *
+ *  Created on: 2017年6月20日
+ *      Author: fasiondog
+ */
+
+#ifdef TEST_ALL_IN_ONE
+    #include <boost/test/unit_test.hpp>
+#else
+    #define BOOST_TEST_MODULE test_hikyuu_trade_sys_suite
+    #include <boost/test/unit_test.hpp>
+#endif
+
+#include <hikyuu/StockManager.h>
+#include <hikyuu/indicator/crt/MA.h>
+#include <hikyuu/trade_manage/crt/crtTM.h>
+#include <hikyuu/trade_sys/moneymanager/crt/MM_FixedCount.h>
+#include <hikyuu/trade_sys/signal/crt/SG_Cross.h>
+#include <hikyuu/trade_sys/stoploss/crt/ST_FixedPercent.h>
+#include <hikyuu/trade_sys/system/crt/SYS_Simple.h>
+#include <hikyuu/trade_sys/system/SystemOptimizer.h>
+
+using namespace hku;
+
+/**
+ * @defgroup test_SystemOptimizer test_SystemOptimizer
+ * @ingroup test_hikyuu_trade_sys_suite
+ * @{
+ */
+
+static SystemPtr create_optimizer_sys() {
+    TradeManagerPtr tm = crtTM(Datetime(199001010000LL), 1000000.0);
+    SignalPtr sg = SG_Cross(OP(MA(5)), OP(MA(20)));
+    return SYS_Simple(tm, MM_FixedCount(100), EnvironmentPtr(),
+            ConditionPtr(), sg, ST_FixedPercent(0.03));
+}
+
+/** @par 检测点 */
+BOOST_AUTO_TEST_CASE( test_SystemOptimizer ) {
+    StockManager& sm = StockManager::instance();
+    Stock stock = sm.getStock("sz000001");
+    KQuery query(-1000);
+    KData kdata = stock.getKData(query);
+    SystemPtr sys = create_optimizer_sys();
+
+    /** @arg 未设置网格 */
+    SystemOptimizer opt(sys);
+    BOOST_CHECK(opt.size() == 0);
+    BOOST_CHECK(opt.run(stock, query).empty());
+
+    /** @arg 未设置系统 */
+    SystemOptimizer empty_opt;
+    BOOST_CHECK(!empty_opt.getSystem());
+    BOOST_CHECK(empty_opt.run(kdata).empty());
+
+    /** @arg 先设置的部件变化最慢 */
+    ParamGrid mm_grid;
+    mm_grid.addRange("n", 100, 400, 100);
+    vector<double> st_values;
+    st_values.push_back(0.02);
+    st_values.push_back(0.05);
+    ParamGrid st_grid;
+    st_grid.add("p", st_values);
+    opt.setGrid(PART_MONEYMANAGER, mm_grid);
+    opt.setGrid(PART_STOPLOSS, st_grid);
+    BOOST_CHECK(opt.size() == 6);
+    BOOST_CHECK(opt.getParameter(0, PART_MONEYMANAGER).get<int>("n") == 100);
+    BOOST_CHECK(opt.getParameter(0, PART_STOPLOSS).get<double>("p") == 0.02);
+    BOOST_CHECK(opt.getParameter(1, PART_MONEYMANAGER).get<int>("n") == 100);
+    BOOST_CHECK(opt.getParameter(1, PART_STOPLOSS).get<double>("p") == 0.05);
+    BOOST_CHECK(opt.getParameter(5, PART_MONEYMANAGER).get<int>("n") == 300);
+    BOOST_CHECK(opt.getParameter(5, PART_SIGNAL).getNameList().empty());
+    BOOST_CHECK_THROW(opt.getParameter(6, PART_STOPLOSS), std::out_of_range);
+
+    /** @arg 克隆的系统使用对应的参数，模板系统不变 */
+    SystemPtr sys5 = opt.getSystem(5);
+    BOOST_CHECK(sys5 && sys5 != sys);
+    BOOST_CHECK(sys5->getMM()->getParam<int>("n") == 300);
+    BOOST_CHECK(sys5->getST()->getParam<double>("p") == 0.05);
+    BOOST_CHECK(sys->getMM()->getParam<int>("n") == 100);
+    BOOST_CHECK(sys->getST()->getParam<double>("p") == 0.03);
+    BOOST_CHECK(!opt.getSystem(6));
+
+    /** @arg 运行结果与逐一运行相同，且与线程数无关 */
+    PerformanceList result = opt.run(kdata, 1);
+    PerformanceList result4 = opt.run(stock, query, 4);
+    BOOST_CHECK(result.size() == 6);
+    BOOST_CHECK(result4.size() == 6);
+    Datetime last_datetime = kdata[kdata.size() - 1].datetime;
+    for (size_t i = 0; i < opt.size(); ++i) {
+        SystemPtr one = opt.getSystem(i);
+        one->run(stock, query);
+        Performance per;
+        per.statistics(one->getTM(), last_datetime);
+        StringList names = per.names();
+        for (size_t k = 0; k < names.size(); ++k) {
+            BOOST_CHECK(result[i][names[k]] == per[names[k]]);
+            BOOST_CHECK(result4[i][names[k]] == per[names[k]]);
+        }
+    }
+    BOOST_CHECK(result[0]["当前总资产"] != result[4]["当前总资产"]);
+    BOOST_CHECK(sys->getTradeRecordList().empty());
+
+    /** @arg 系统中不存在网格对应的部件 */
+    opt.setGrid(PART_PROFITGOAL, mm_grid);
+    BOOST_CHECK(!opt.getSystem(0));
+    BOOST_CHECK(opt.run(kdata).empty());
+
+    /** @arg 清除网格 */
+    opt.clearGrid();
+    BOOST_CHECK(opt.size() == 0);
+}
+
+/** @par 检测点 */
+BOOST_AUTO_TEST_CASE( test_Performance_names ) {
+    Performance per;
+    StringList names = per.names();
+    BOOST_CHECK(names.size() == 50);
+    BOOST_CHECK(names[0] == "帐户初始金额");
+    BOOST_CHECK(names[8] == "当前总资产");
+    for (size_t i = 0; i < names.size(); ++i) {
+        BOOST_CHECK(per.get(names[i]) == 0.0);
+    }
+}
+
+/** @} */
@@ -0,0 +1,85 @@
+/*
+ * test_Parallel.cpp
+ *
+ *  Created on: 2017年6月12日
+ *      Author: fasiondog
+ */
+
+#ifdef TEST_ALL_IN_ONE
+    #include <boost/test/unit_test.hpp>
+#else
+    #define BOOST_TEST_MODULE test_hikyuu_utilities
+    #include <boost/test/unit_test.hpp>
+#endif
+
+#include <set>
+#include <stdexcept>
+#include <boost/thread.hpp>
+#include <hikyuu/utilities/Parallel.h>
+
+using namespace hku;
+
+/**
+ * @defgroup test_hikyuu_Parallel test_hikyuu_Parallel
+ * @ingroup test_hikyuu_utilities
+ * @{
+ */
+
+/** @par 检测点 */
+BOOST_AUTO_TEST_CASE( test_parallel_for ) {
+    BOOST_CHECK(default_thread_count() >= 1);
+
+    /** @arg 任务数为0 */
+    int count = 0;
+    parallel_for(0, 4, [&](size_t i) { count++; });
+    BOOST_CHECK(count == 0);
+
+    /** @arg 每个任务执行且仅执行一次 */
+    vector<int> result(1000, 0);
+    parallel_for(result.size(), 4, [&](size_t i) { result[i] += (int)i; });
+    for (size_t i = 0; i < result.size(); ++i) {
+        BOOST_CHECK(result[i] == (int)i);
+    }
+
+    /** @arg 任务抛出异常 */
+    BOOST_CHECK_THROW(parallel_for(100, 4, [](size_t i) {
+        if (i == 50) throw std::logic_error("test");
+    }), std::logic_error);
+
+    /** @arg 多次调用复用线程池中的线程 */
+    std::set<boost::thread::id> ids;
+    boost::mutex mutex;
+    for (int n = 0; n < 10; ++n) {
+        parallel_for(8, 4, [&](size_t i) {
+            boost::this_thread::sleep_for(boost::chrono::milliseconds(1));
+            boost::mutex::scoped_lock lock(mutex);
+            ids.insert(boost::this_thread::get_id());
+        });
+    }
+    BOOST_CHECK(ids.size() <= 4);
+
+    /** @arg 嵌套调用共用线程池，不会成倍创建线程，也不会死锁 */
+    ids.clear();
+    vector<int> nested(16, 0);
+    parallel_for(4, 4, [&](size_t i) {
+        parallel_for(4, 4, [&](size_t j) {
+            boost::this_thread::sleep_for(boost::chrono::milliseconds(5));
+            boost::mutex::scoped_lock lock(mutex);
+            ids.insert(boost::this_thread::get_id());
+            nested[i * 4 + j]++;
+        });
+    });
+    BOOST_CHECK(ids.size() <= 4);
+    for (size_t i = 0; i < nested.size(); ++i) {
+        BOOST_CHECK(nested[i] == 1);
+    }
+
+    /** @arg 嵌套调用中抛出异常 */
+    BOOST_CHECK_THROW(parallel_for(4, 4, [&](size_t i) {
+        parallel_for(4, 4, [&](size_t j) {
+            if (i == 2 && j == 3) throw std::logic_error("test");
+        });
+    }), std::logic_error);
+}
+
+/** @} */
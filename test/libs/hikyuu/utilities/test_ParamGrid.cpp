@@ -0,0 +1,74 @@
+/*
+ * test_ParamGrid.cpp
+ *
+ *  Created on: 2017年6月19日
+ *      Author: fasiondog
+ */
+
+#ifdef TEST_ALL_IN_ONE
+    #include <boost/test/unit_test.hpp>
+#else
+    #define BOOST_TEST_MODULE test_hikyuu_utilities
+    #include <boost/test/unit_test.hpp>
+#endif
+
+#include <stdexcept>
+#include <hikyuu/utilities/ParamGrid.h>
+
+using namespace hku;
+
+/**
+ * @defgroup test_hikyuu_ParamGrid test_hikyuu_ParamGrid
+ * @ingroup test_hikyuu_utilities
+ * @{
+ */
+
+/** @par 检测点 */
+BOOST_AUTO_TEST_CASE( test_ParamGrid ) {
+    /** @arg 空网格 */
+    ParamGrid grid;
+    BOOST_CHECK(grid.size() == 0);
+    BOOST_CHECK(grid.getNameList().empty());
+
+    /** @arg 先添加的参数变化最慢 */
+    grid.addRange("n", 5, 8);
+    vector<double> p;
+    p.push_back(1.5);
+    p.push_back(2.5);
+    grid.add("p", p);
+    BOOST_CHECK(grid.size() == 6);
+    BOOST_CHECK(grid.have("n"));
+    BOOST_CHECK(!grid.have("m"));
+    BOOST_CHECK(grid.getNameList().size() == 2);
+    BOOST_CHECK(grid.getNameList()[0] == "n");
+    BOOST_CHECK(grid.get(0).get<int>("n") == 5);
+    BOOST_CHECK(grid.get(0).get<double>("p") == 1.5);
+    BOOST_CHECK(grid.get(1).get<int>("n") == 5);
+    BOOST_CHECK(grid.get(1).get<double>("p") == 2.5);
+    BOOST_CHECK(grid.get(5).get<int>("n") == 7);
+    BOOST_CHECK(grid.get(5).get<double>("p") == 2.5);
+    BOOST_CHECK_THROW(grid.get(6), std::out_of_range);
+
+    /** @arg 同名参数替换取值列表 */
+    grid.addRange("n", 10, 4, -2);
+    BOOST_CHECK(grid.size() == 6);
+    BOOST_CHECK(grid.get(0).get<int>("n") == 10);
+    BOOST_CHECK(grid.get(2).get<int>("n") == 8);
+    BOOST_CHECK(grid.get(4).get<int>("n") == 6);
+
+    /** @arg 某一参数无取值时网格为空 */
+    grid.addRange("n", 1, 1);
+    BOOST_CHECK(grid.size() == 0);
+
+    /** @arg apply保留原有的其他参数 */
+    ParamGrid grid2;
+    grid2.addRange("n", 3, 5);
+    Parameter param;
+    param.set<int>("n", 1);
+    param.set<bool>("b", true);
+    grid2.apply(1, param);
+    BOOST_CHECK(param.get<int>("n") == 4);
+    BOOST_CHECK(param.get<bool>("b") == true);
+}
+
+/** @} */
@@ -64,6 +64,42 @@ BOOST_AUTO_TEST_CASE( test_Parameter ) {
 }
 
 
+/** @par 检测点 */
+BOOST_AUTO_TEST_CASE( test_CachedParam ) {
+    Parameter p1;
+    p1.set<int>("n", 10);
+    p1.set<bool>("bool", true);
+
+    CachedParam<int> n("n");
+    CachedParam<bool> b("bool");
+    BOOST_CHECK(n.name() == "n");
+    BOOST_CHECK(n.get(p1) == 10);
+    BOOST_CHECK(b.get(p1) == true);
+
+    /** @arg 参数修改后版本号变化，缓存值随之更新 */
+    unsigned long long version = p1.version();
+    p1.set<int>("n", 20);
+    BOOST_CHECK(p1.version() != version);
+    BOOST_CHECK(n.get(p1) == 20);
+
+    /** @arg 复制后的参数版本号相同 */
+    Parameter p2(p1);
+    BOOST_CHECK(p2.version() == p1.version());
+    BOOST_CHECK(n.get(p2) == 20);
+
+    /** @arg 不同的Parameter实例内容不同时，版本号不同 */
+    Parameter p3;
+    p3.set<int>("n", 30);
+    BOOST_CHECK(p3.version() != p1.version());
+    BOOST_CHECK(n.get(p3) == 30);
+    p3 = p1;
+    BOOST_CHECK(n.get(p3) == 20);
+
+    /** @arg 参数不存在 */
+    CachedParam<int> x("x");
+    BOOST_CHECK_THROW(x.get(p1), std::out_of_range);
+}
+
 #if HKU_SUPPORT_SERIALIZATION
 /** @par 检测点 */
 BOOST_AUTO_TEST_CASE( test_Parameter_serialize ) {
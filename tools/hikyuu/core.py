@@ -294,15 +294,29 @@ try:
         k_type = np.dtype({'names':['datetime','open', 'high', 'low','close', 
                                     'amount', 'volume'], 
                 'formats':['datetime64[D]','d','d','d','d','d','d']})
-        return np.array([(k.datetime, k.openPrice, k.highPrice, 
-                          k.lowPrice, k.closePrice, k.transAmount, 
-                          k.transCount) for k in kdata], dtype=k_type)
+        result = np.empty(len(kdata), dtype=k_type)
+        if len(kdata) == 0:
+            return result
+        result['datetime'] = np.array(kdata.getDatetimeList(), 
+                                      dtype='datetime64[D]')
+        for name in k_type.names[1:]:
+            result[name] = kdata.getArrayView(name)
+        return result
+    
+    def KData_as_np(kdata, field):
+        """
+        返回指定列的只读np.array视图，K线数据已缓存时直接引用缓存，不复制
+        
+        :param str field: 'open' | 'high' | 'low' | 'close' | 'amount' | 'volume'
+        """
+        return np.asarray(kdata.getArrayView(field))
         
     def KData_to_df(kdata):
         """转化为pandas的DataFrame"""
         return pd.DataFrame.from_records(KData_to_np(kdata), index='datetime')    
 
     KData.to_np = KData_to_np
+    KData.as_np = KData_as_np
     KData.to_df = KData_to_df
     
     def PriceList_to_np(data):
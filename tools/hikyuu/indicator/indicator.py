@@ -113,7 +113,15 @@ try:
     
     def indicator_to_np(indicator):
         """转化为np.array，如果indicator存在多个值，只返回第一个"""
-        return np.array(indicator, dtype='d')
+        return np.array(indicator.getArrayView(0), dtype='d')
+    
+    def indicator_as_np(indicator, num=0):
+        """
+        返回指定结果集的只读np.array视图，直接引用指标结果数据，不复制
+        
+        :param int num: 结果集序号
+        """
+        return np.asarray(indicator.getArrayView(num))
     
     def indicator_to_df(indicator):
         """转化为pandas.DataFrame"""
@@ -129,6 +137,7 @@ try:
         return pd.DataFrame(data, columns=columns)
     
     Indicator.to_np = indicator_to_np
+    Indicator.as_np = indicator_as_np
     Indicator.to_df = indicator_to_df
 
 except:
@@ -53,6 +53,22 @@ AMO([data])
 """
 
 
+BOLL.__doc__ = """
+BOLL([data, n=20, p=2.0])
+
+    布林带，一次遍历同时计算三个结果集，结果与 MA(n) ± p * STDEV(n) 相同
+    
+    :param Indicator data: 输入数据
+    :param int n: 计算均值及标准差的时间窗口
+    :param float p: 标准差的倍数
+    :return: 具有三个结果集的 Indicator
+
+    * result(0): MID: 中轨，即n周期均值
+    * result(1): UPPER: 上轨，即中轨 + p倍n周期样本标准差
+    * result(2): LOWER: 下轨，即中轨 - p倍n周期样本标准差
+"""
+
+
 CLOSE.__doc__ = """
 CLOSE([data])
    
@@ -143,6 +159,25 @@ KDATA_PART([data, kpart])
 """
 
 
+KDJ.__doc__ = """
+KDJ([data, n=9, m1=3, m2=3])
+
+    KDJ随机指标，RSV = (收盘价 - n周期最低价) / (n周期最高价 - n周期最低价) * 100，
+    最高价等于最低价时RSV取50。输入为KDATA时使用其最高价、最低价及收盘价，
+    否则均使用第一个结果集。
+    
+    :param Indicator data: 输入数据，一般为KDATA
+    :param int n: 计算RSV的时间窗口
+    :param int m1: K值的平滑周期
+    :param int m2: D值的平滑周期
+    :return: 具有三个结果集的 Indicator
+
+    * result(0): K: RSV的m1周期平滑，K = (m1-1)/m1 * 前K + 1/m1 * RSV
+    * result(1): D: K的m2周期平滑
+    * result(2): J: 3K - 2D
+"""
+
+
 LLV.__doc__ = """
 LLV([data, n=20])
 
@@ -214,6 +249,18 @@ REF([data, n])
     :return: Indicator
 """    
 
+RSI.__doc__ = """
+RSI([data, n=14])
+
+    相对强弱指标，RSI = 涨幅的n周期平滑 / 涨跌幅绝对值的n周期平滑 * 100，
+    平滑方式为 Y = (n-1)/n * 前Y + 1/n * X
+    
+    :param Indicator data: 输入数据
+    :param int n: 平滑周期
+    :return: Indicator
+"""
+
+
 SAFTYLOSS.__doc__ = """
 SAFTYLOSS([data, n1=10, n2=3, p=2.0])
 
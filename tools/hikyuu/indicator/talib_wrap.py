@@ -1559,4 +1559,42 @@ try:
 
     
 except:
-    print("warning: can't import talib, maybe loss some Indicator from talib!")
\ No newline at end of file
+    print("warning: can't import talib, maybe loss some Indicator from talib!")
+
+#===============================================================================
+# 如编译时找到了TA-Lib，则使用C++实现的TA_LIB替代上面的Python实现，
+# 指标计算直接在C++中完成，不再经由numpy逐个复制数据
+#===============================================================================
+try:
+    import inspect
+    from ._indicator import TA_LIB
+    
+    def crtNativeTaFunc(ta_name, py_func):
+        sig = inspect.signature(py_func)
+        param_names = [k for k in sig.parameters if k != 'ind']
+        
+        def native_func(*args, **kwargs):
+            bound = sig.bind(*args, **kwargs)
+            bound.apply_defaults()
+            ind = TA_LIB(ta_name)
+            for k in param_names:
+                #保持参数类型与TA-Lib中的定义一致
+                ind.setParam(k, type(ind.getParam(k))(bound.arguments[k]))
+            data = bound.arguments.get('ind')
+            return ind if data is None else ind(data)
+        
+        native_func.__name__ = py_func.__name__
+        native_func.__doc__ = py_func.__doc__
+        return native_func
+    
+    for _name, _func in list(globals().items()):
+        if _name.startswith('TA_') and _name != 'TA_LIB' \
+                and inspect.isfunction(_func):
+            try:
+                TA_LIB(_name[3:])
+                globals()[_name] = crtNativeTaFunc(_name[3:], _func)
+            except Exception:
+                pass
+    
+except ImportError:
+    pass
@@ -140,6 +140,43 @@ class IndicatorTest(unittest.TestCase):
         self.assert_(abs(m[2] - 1.5) < 0.0001)
         self.assert_(abs(m[3] - 2.5) < 0.0001)
         
+    def test_getArrayView(self):
+        a = toPriceList([0,1,2,3])
+        x = PRICELIST(a)
+        m = MA(x, 2)
+        v = memoryview(m.getArrayView())
+        self.assertEqual(v.readonly, True)
+        self.assertEqual(len(v), 4)
+        self.assert_(abs(v[1] - 0.5) < 0.0001)
+        self.assert_(abs(v[3] - 2.5) < 0.0001)
+        
+        #视图持有结果缓存，指标重新计算或释放后仍然有效
+        m = m(PRICELIST(toPriceList([4,5,6,7])))
+        self.assert_(abs(v[3] - 2.5) < 0.0001)
+        self.assert_(abs(m[3] - 6.5) < 0.0001)
+        del m
+        self.assert_(abs(v[1] - 0.5) < 0.0001)
+        
+        self.assertEqual(len(memoryview(Indicator().getArrayView())), 0)
+        self.assertRaises(IndexError, x.getArrayView, 1)
+        
+    def test_IndicatorCache(self):
+        k = sm['sh000001'].getKData(Query(-100))
+        IndicatorCache.setMaxBytes(1024 * 1024)
+        IndicatorCache.clear()
+        IndicatorCache.resetStatistics()
+        a = MA(CLOSE(k), 10)
+        b = MA(CLOSE(k), 10)
+        self.assertEqual(IndicatorCache.misses(), 1)
+        self.assertEqual(IndicatorCache.hits(), 1)
+        self.assertEqual(IndicatorCache.size(), 1)
+        for i in range(a.discard, len(a)):
+            self.assertEqual(a[i], b[i])
+        IndicatorCache.invalidate(sm['sh000001'])
+        self.assertEqual(IndicatorCache.size(), 0)
+        IndicatorCache.setMaxBytes(0)
+        self.assertEqual(IndicatorCache.enabled(), False)
+        
     def test_pickle(self):
         if not constant.pickle_support:
             return
@@ -42,6 +42,19 @@ class KDataTest(unittest.TestCase):
         self.assert_(abs(k[1].openPrice - 104.3) < 0.0001)
         self.assert_(abs(k[9].openPrice - 127.61) < 0.0001)
         
+    def test_getArrayView(self):
+        stock = sm["Sh000001"]
+        k = stock.getKData(KQuery(1, 10))
+        v = memoryview(k.getArrayView("open"))
+        self.assertEqual(v.readonly, True)
+        self.assertEqual(len(v), 9)
+        self.assert_(abs(v[0] - 104.3) < 0.0001)
+        self.assert_(abs(v[8] - 127.61) < 0.0001)
+        v = memoryview(k.getArrayView("volume"))
+        self.assert_(abs(v[0] - 197) < 0.0001)
+        self.assertRaises(ValueError, k.getArrayView, "datetime")
+        self.assertEqual(len(memoryview(KData().getArrayView("close"))), 0)
+        
     def test_pickle(self):
         if not constant.pickle_support:
             return
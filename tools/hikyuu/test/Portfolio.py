@@ -0,0 +1,84 @@
+#!/usr/bin/python
+# -*- coding: utf8 -*-
+# gb18030
+
+#===============================================================================
+# 作者：fasiondog
+# 历史：1）20171019, Added by fasiondog
+#===============================================================================
+
+import unittest
+
+from test_init import *
+from hikyuu.indicator import *
+from hikyuu.trade_manage import *
+from hikyuu.trade_sys.system import *
+from hikyuu.trade_sys.signal import *
+from hikyuu.trade_sys.moneymanager import *
+from hikyuu.trade_sys.portfolio import *
+
+
+class SelectorPython(SelectorBase):
+    def __init__(self):
+        super(SelectorPython, self).__init__()
+        
+    def _clone(self):
+        return SelectorPython()
+
+
+class AllocateMoneyPython(AllocateMoneyBase):
+    def __init__(self):
+        super(AllocateMoneyPython, self).__init__()
+        
+    def _clone(self):
+        return AllocateMoneyPython()
+
+
+class SignalPython(SignalBase):
+    calculate_count = 0
+    
+    def __init__(self):
+        super(SignalPython, self).__init__("SignalPython")
+    
+    def _clone(self):
+        return SignalPython()
+    
+    def _calculate(self):
+        SignalPython.calculate_count += 1
+        self._addBuySignal(Datetime(201103010000))
+        self._addSellSignal(Datetime(201106010000))
+
+
+def crtTestPF(sg):
+    tm = crtTM(initCash = 1000000)
+    sys = SYS_Simple(sg = sg, mm = MM_FixedCount(100))
+    se = SelectorPython()
+    se.addStock(sm['sh000001'])
+    return Portfolio(tm, sys, se, AllocateMoneyPython())
+
+
+class PortfolioTest(unittest.TestCase):
+    def test_run_python_signal(self):
+        query = QueryByDate(Datetime(201101010000), Datetime(201111010000))
+        
+        #系统中包含Python实现的信号指示器，运行时不释放GIL，
+        #由Python克隆的信号指示器在运行结束时释放
+        SignalPython.calculate_count = 0
+        pf = crtTestPF(SignalPython())
+        pf.run(query)
+        self.assert_(SignalPython.calculate_count > 0)
+        
+        count = SignalPython.calculate_count
+        pf.run(query)
+        self.assert_(SignalPython.calculate_count > count)
+        self.assertEqual(pf.sys.tm.name, pf.tm.name)
+        
+        #系统部件均为C++实现时，运行期间释放GIL
+        pf = crtTestPF(SG_Cross(OP(MA(n=5)), OP(MA(n=20))))
+        pf.sys.tm = crtTM(initCash = 1000000, name = "OTHER")
+        pf.run(query)
+        self.assertEqual(pf.sys.tm.name, pf.tm.name)
+
+
+def suite():
+    return unittest.TestLoader().loadTestsFromTestCase(PortfolioTest)
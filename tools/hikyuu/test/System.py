@@ -0,0 +1,77 @@
+#!/usr/bin/python
+# -*- coding: utf8 -*-
+# gb18030
+
+#===============================================================================
+# 作者：fasiondog
+# 历史：1）20170614, Added by fasiondog
+#===============================================================================
+
+import sys
+import unittest
+import threading
+import time
+import os
+
+from test_init import *
+from hikyuu.indicator import *
+from hikyuu.trade_manage import *
+from hikyuu.trade_sys.system import *
+from hikyuu.trade_sys.signal import *
+from hikyuu.trade_sys.moneymanager import *
+
+
+def crtTestSys():
+    tm = crtTM(initCash = 1000000)
+    sg = SG_Cross(OP(MA(n=5)), OP(MA(n=20)))
+    mm = MM_FixedCount(100)
+    return SYS_Simple(tm = tm, sg = sg, mm = mm)
+
+
+class SystemTest(unittest.TestCase):
+    def run_systems(self, systems, stock, query, repeat, use_thread):
+        def work(sys):
+            for i in range(repeat):
+                sys.run(stock, query)
+        
+        start = time.time()
+        if use_thread:
+            threads = [threading.Thread(target=work, args=(s,)) for s in systems]
+            for t in threads:
+                t.start()
+            for t in threads:
+                t.join()
+        else:
+            for s in systems:
+                work(s)
+        return time.time() - start
+    
+    def test_run_in_threads(self):
+        stock = sm['sh000001']
+        query = KQuery(0)
+        n = 4
+        serial_sys = [crtTestSys() for i in range(n)]
+        thread_sys = [crtTestSys() for i in range(n)]
+        
+        serial_time = self.run_systems(serial_sys, stock, query, 20, False)
+        thread_time = self.run_systems(thread_sys, stock, query, 20, True)
+        
+        #各线程中的运行结果与串行执行一致
+        expect = serial_sys[0].tm.getTradeList()
+        self.assert_(len(expect) > 1)
+        for s in serial_sys + thread_sys:
+            trades = s.tm.getTradeList()
+            self.assertEqual(len(trades), len(expect))
+            for x, y in zip(trades, expect):
+                self.assertEqual(x.datetime, y.datetime)
+                self.assertEqual(x.business, y.business)
+                self.assertEqual(x.number, y.number)
+                self.assertEqual(x.realPrice, y.realPrice)
+        
+        #System.run执行期间释放GIL，加速比受CPU核数及负载影响，只记录耗时不做断言
+        sys.stderr.write("\nserial: %.3fs, %d threads: %.3fs, cpu: %d\n"
+                         % (serial_time, n, thread_time, os.cpu_count() or 1))
+        
+        
+def suite():
+    return unittest.TestLoader().loadTestsFromTestCase(SystemTest)
@@ -25,6 +25,8 @@ import Signal
 import Stoploss
 import ProfitGoal
 import Slippage
+import System
+import Portfolio
 
 
 if __name__ == "__main__":
@@ -54,6 +56,8 @@ if __name__ == "__main__":
     suite.addTest(ProfitGoal.suiteTestCrtPG())
     suite.addTest(Slippage.suite())
     suite.addTest(Slippage.suiteTestCrtSL())
+    suite.addTest(System.suite())
+    suite.addTest(Portfolio.suite())
         
     unittest.TextTestRunner(verbosity=2).run(suite)
     #unittest.main()
@@ -153,3 +153,66 @@ FundsRecord.borrow_asset.__doc__ = """当前借入证券资产价值（float）"
 #------------------------------------------------------------------
 # OrderBroker
 #------------------------------------------------------------------
+
+
+#------------------------------------------------------------------
+# TradeJournal
+#------------------------------------------------------------------
+
+TradeJournalBase.__doc__ = """
+交易流水基类，通过TradeManager.regJournal注册后，账户的每一条交易记录都会在
+产生时写入流水，不在内存中累积。自定义流水需实现接口：
+
+    _write(self, record) 【必须】写入一条交易记录
+    flush(self) 【可选】将缓冲中的记录写出
+"""
+
+TradeJournalBase.write.__doc__ = """
+write(self, record)
+
+    写入一条交易记录，由TradeManager在交易记录产生时调用
+    
+    :param TradeRecord record: 交易记录
+"""
+
+TJ_Binary.__doc__ = """
+TJ_Binary(filename)
+
+    创建二进制格式的交易流水，文件已存在时在其后追加。可通过crtTMFromJournal重建账户
+    
+    :param str filename: 流水文件名
+    :rtype: TradeJournalBase
+"""
+
+TJ_Csv.__doc__ = """
+TJ_Csv(filename)
+
+    创建csv格式的交易流水，文件已存在时在其后追加
+    
+    :param str filename: csv文件名
+    :rtype: TradeJournalBase
+"""
+
+crtTMFromJournal.__doc__ = """
+crtTMFromJournal(filename[, costFunc=TC_Zero(), name="SYS"])
+
+    根据TJ_Binary写入的交易流水重新执行交易操作，重建交易管理模块
+    
+    :param str filename: 流水文件名
+    :param TradeCost costFunc: 交易成本算法，应与写入流水的账户相同
+    :param str name: 账户名称
+    :return: 文件不存在或格式错误时返回None
+    :rtype: TradeManager
+"""
+
+crtTMFromMerge.__doc__ = """
+crtTMFromMerge(tm_list[, name="SYS"])
+
+    将多个独立账户合并为一个汇总账户，初始资金为各账户之和，各账户的交易记录
+    按日期顺序重新执行，日期相同时按账户在列表中的顺序执行
+    
+    :param list tm_list: 待合并的账户列表，应使用相同的交易成本算法
+    :param str name: 汇总账户名称
+    :return: 列表为空或存在None时返回None
+    :rtype: TradeManager
+"""
@@ -8,5 +8,5 @@
 #===============================================================================
 
 __all__ = ['system', 'environment', 'condition', 'moneymanager', 'signal',
-           'stoploss', 'profitgoal', 'slippage']
+           'stoploss', 'profitgoal', 'slippage', 'portfolio']
 
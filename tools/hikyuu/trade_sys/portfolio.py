@@ -0,0 +1,23 @@
+#!/usr/bin/python
+# -*- coding: utf8 -*-
+# cp936
+
+#===============================================================================
+# 作者：fasiondog
+# 历史：1）20171019, Added by fasiondog
+#===============================================================================
+
+from . import _trade_sys as csys
+from hikyuu.util.unicode import (unicodeFunc, reprFunc)
+
+SelectorBase = csys.SelectorBase
+SelectorBase.__unicode__ = unicodeFunc
+SelectorBase.__repr__ = reprFunc
+
+AllocateMoneyBase = csys.AllocateMoneyBase
+AllocateMoneyBase.__unicode__ = unicodeFunc
+AllocateMoneyBase.__repr__ = reprFunc
+
+Portfolio = csys.Portfolio
+Portfolio.__unicode__ = unicodeFunc
+Portfolio.__repr__ = reprFunc